@@ -26,6 +26,12 @@
 
 #include "common.h"
 
+#include <cmath>
+#include <iterator>
+#include <map>
+
+#include "convert_utils.h"
+
 namespace triton { namespace client {
 
 //==============================================================================
@@ -45,13 +51,858 @@ operator<<(std::ostream& out, const Error& err)
 
 //==============================================================================
 
+namespace {
+
+constexpr uint64_t kHashPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kHashPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kHashPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kHashPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kHashPrime5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t
+HashRotl(const uint64_t x, const int r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t
+HashRead64(const uint8_t* p)
+{
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t
+HashRound(uint64_t acc, const uint64_t input)
+{
+  acc += input * kHashPrime2;
+  return HashRotl(acc, 31) * kHashPrime1;
+}
+
+inline uint64_t
+HashMergeRound(uint64_t acc, const uint64_t lane)
+{
+  acc ^= HashRound(0, lane);
+  return acc * kHashPrime1 + kHashPrime4;
+}
+
+// XXH64 of 'size' bytes at 'data'. The bulk of the data is consumed in
+// 32 byte stripes by four independent lanes so that the multiplications
+// of the lanes overlap in the pipeline.
+uint64_t
+HashBytes(const uint8_t* data, const size_t size, const uint64_t seed)
+{
+  const uint8_t* p = data;
+  const uint8_t* const end = data + size;
+  uint64_t h;
+
+  if (size >= 32) {
+    const uint8_t* const limit = end - 32;
+    uint64_t v1 = seed + kHashPrime1 + kHashPrime2;
+    uint64_t v2 = seed + kHashPrime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - kHashPrime1;
+    do {
+      v1 = HashRound(v1, HashRead64(p));
+      v2 = HashRound(v2, HashRead64(p + 8));
+      v3 = HashRound(v3, HashRead64(p + 16));
+      v4 = HashRound(v4, HashRead64(p + 24));
+      p += 32;
+    } while (p <= limit);
+
+    h = HashRotl(v1, 1) + HashRotl(v2, 7) + HashRotl(v3, 12) +
+        HashRotl(v4, 18);
+    h = HashMergeRound(h, v1);
+    h = HashMergeRound(h, v2);
+    h = HashMergeRound(h, v3);
+    h = HashMergeRound(h, v4);
+  } else {
+    h = seed + kHashPrime5;
+  }
+
+  h += static_cast<uint64_t>(size);
+
+  while (p + 8 <= end) {
+    h ^= HashRound(0, HashRead64(p));
+    h = HashRotl(h, 27) * kHashPrime1 + kHashPrime4;
+    p += 8;
+  }
+  if (p + 4 <= end) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    h ^= static_cast<uint64_t>(v) * kHashPrime1;
+    h = HashRotl(h, 23) * kHashPrime2 + kHashPrime3;
+    p += 4;
+  }
+  while (p < end) {
+    h ^= static_cast<uint64_t>(*p) * kHashPrime5;
+    h = HashRotl(h, 11) * kHashPrime1;
+    p++;
+  }
+
+  h ^= h >> 33;
+  h *= kHashPrime2;
+  h ^= h >> 29;
+  h *= kHashPrime3;
+  h ^= h >> 32;
+  return h;
+}
+
+void
+AppendKeyField(const std::string& field, std::string* key)
+{
+  key->append(field);
+  key->push_back('\0');
+}
+
+//==============================================================================
+// The outputs of a response held by the response cache.
+//
+struct CachedResponse {
+  struct Output {
+    std::vector<int64_t> shape_;
+    std::string datatype_;
+    std::vector<uint8_t> data_;
+  };
+
+  std::string model_name_;
+  std::string model_version_;
+  std::map<std::string, Output> outputs_;
+};
+
+//==============================================================================
+// The InferResult returned for a request served from the response cache.
+// It shares the cached outputs instead of copying them.
+//
+class CachedInferResult : public InferResult {
+ public:
+  CachedInferResult(
+      std::shared_ptr<const CachedResponse> response,
+      const std::string& request_id)
+      : response_(response), request_id_(request_id)
+  {
+  }
+
+  Error RequestStatus() const override { return Error::Success; }
+  Error ModelName(std::string* name) const override
+  {
+    *name = response_->model_name_;
+    return Error::Success;
+  }
+  Error ModelVersion(std::string* version) const override
+  {
+    *version = response_->model_version_;
+    return Error::Success;
+  }
+  Error Id(std::string* id) const override
+  {
+    *id = request_id_;
+    return Error::Success;
+  }
+  Error Shape(const std::string& output_name, std::vector<int64_t>* shape)
+      const override;
+  Error Datatype(
+      const std::string& output_name, std::string* datatype) const override;
+  Error OutputNames(std::vector<std::string>* names) const override;
+  Error RawData(
+      const std::string& output_name, const uint8_t** buf,
+      size_t* byte_size) const override;
+  Error IsFinalResponse(bool* is_final_response) const override
+  {
+    if (is_final_response == nullptr) {
+      return Error("is_final_response cannot be nullptr");
+    }
+    *is_final_response = true;
+    return Error::Success;
+  }
+  Error IsNullResponse(bool* is_null_response) const override
+  {
+    if (is_null_response == nullptr) {
+      return Error("is_null_response cannot be nullptr");
+    }
+    *is_null_response = false;
+    return Error::Success;
+  }
+  Error StringData(
+      const std::string& output_name,
+      std::vector<std::string>* string_result) const override;
+  std::string DebugString() const override;
+
+ private:
+  Error FindOutput(
+      const std::string& output_name,
+      const CachedResponse::Output** output) const;
+
+  std::shared_ptr<const CachedResponse> response_;
+  const std::string request_id_;
+};
+
+Error
+CachedInferResult::FindOutput(
+    const std::string& output_name, const CachedResponse::Output** output) const
+{
+  auto it = response_->outputs_.find(output_name);
+  if (it == response_->outputs_.end()) {
+    return Error(
+        "The response does not contain results for output name '" +
+        output_name + "'");
+  }
+  *output = &it->second;
+  return Error::Success;
+}
+
+Error
+CachedInferResult::Shape(
+    const std::string& output_name, std::vector<int64_t>* shape) const
+{
+  const CachedResponse::Output* output;
+  Error err = FindOutput(output_name, &output);
+  if (err.IsOk()) {
+    *shape = output->shape_;
+  }
+  return err;
+}
+
+Error
+CachedInferResult::Datatype(
+    const std::string& output_name, std::string* datatype) const
+{
+  const CachedResponse::Output* output;
+  Error err = FindOutput(output_name, &output);
+  if (err.IsOk()) {
+    *datatype = output->datatype_;
+  }
+  return err;
+}
+
+Error
+CachedInferResult::OutputNames(std::vector<std::string>* names) const
+{
+  names->clear();
+  for (const auto& output : response_->outputs_) {
+    names->push_back(output.first);
+  }
+  return Error::Success;
+}
+
+Error
+CachedInferResult::RawData(
+    const std::string& output_name, const uint8_t** buf,
+    size_t* byte_size) const
+{
+  const CachedResponse::Output* output;
+  Error err = FindOutput(output_name, &output);
+  if (err.IsOk()) {
+    *buf = output->data_.data();
+    *byte_size = output->data_.size();
+  }
+  return err;
+}
+
+Error
+CachedInferResult::StringData(
+    const std::string& output_name,
+    std::vector<std::string>* string_result) const
+{
+  const CachedResponse::Output* output;
+  Error err = FindOutput(output_name, &output);
+  if (!err.IsOk()) {
+    return err;
+  }
+  if (output->datatype_.compare("BYTES") != 0) {
+    return Error(
+        "This function supports tensors with datatype 'BYTES', requested "
+        "output tensor '" +
+        output_name + "' with datatype '" + output->datatype_ + "'");
+  }
+
+  const uint8_t* buf = output->data_.data();
+  const size_t byte_size = output->data_.size();
+  string_result->clear();
+  size_t buf_offset = 0;
+  while (byte_size > buf_offset) {
+    uint32_t element_size;
+    std::memcpy(&element_size, buf + buf_offset, sizeof(element_size));
+    string_result->emplace_back(
+        reinterpret_cast<const char*>(buf + buf_offset + sizeof(element_size)),
+        element_size);
+    buf_offset += (sizeof(element_size) + element_size);
+  }
+
+  return Error::Success;
+}
+
+std::string
+CachedInferResult::DebugString() const
+{
+  std::string str(
+      "cached response of model '" + response_->model_name_ + "' version '" +
+      response_->model_version_ + "', outputs:");
+  for (const auto& output : response_->outputs_) {
+    str += " " + output.first + " (" + output.second.datatype_ + ", " +
+           std::to_string(output.second.data_.size()) + " bytes)";
+  }
+  return str;
+}
+
+}  // namespace
+
+//==============================================================================
+
+constexpr size_t LatencyHistogram::BUCKET_COUNT;
+
+uint64_t
+LatencyHistogram::BucketUpperBound(const size_t bucket)
+{
+  return static_cast<uint64_t>(1000.0 * std::exp2((bucket + 1) / 4.0));
+}
+
+void
+LatencyHistogram::Add(const uint64_t latency_ns)
+{
+  size_t bucket = 0;
+  if (latency_ns > 1000) {
+    const double index =
+        std::ceil(4.0 * std::log2(latency_ns / 1000.0)) - 1.0;
+    bucket = std::min(
+        static_cast<size_t>(std::max(index, 0.0)), BUCKET_COUNT - 1);
+    // Correct the rounding of the logarithm at the bucket bounds
+    while ((bucket > 0) && (latency_ns <= BucketUpperBound(bucket - 1))) {
+      bucket--;
+    }
+    while ((bucket < BUCKET_COUNT - 1) &&
+           (latency_ns > BucketUpperBound(bucket))) {
+      bucket++;
+    }
+  }
+  bucket_counts[bucket]++;
+  min_ns = (count == 0) ? latency_ns : std::min(min_ns, latency_ns);
+  max_ns = std::max(max_ns, latency_ns);
+  sum_ns += latency_ns;
+  count++;
+}
+
+uint64_t
+LatencyHistogram::Percentile(const double percentile) const
+{
+  if (count == 0) {
+    return 0;
+  }
+  const size_t rank = std::max(
+      static_cast<size_t>(1),
+      static_cast<size_t>(std::ceil(percentile / 100.0 * count)));
+  // The lowest rank is the recorded minimum, which is exact.
+  if (rank == 1) {
+    return min_ns;
+  }
+  size_t cumulative_count = 0;
+  for (size_t bucket = 0; bucket < bucket_counts.size(); ++bucket) {
+    cumulative_count += bucket_counts[bucket];
+    if (cumulative_count >= rank) {
+      return std::max(min_ns, std::min(max_ns, BucketUpperBound(bucket)));
+    }
+  }
+  return max_ns;
+}
+
+//==============================================================================
+// Client-side cache of inference responses. The responses are kept in a
+// least recently used list bounded by the total byte size of their
+// outputs and keyed by the model, the input descriptors, the hash of the
+// input data, the requested outputs and the request parameters.
+//
+class ResponseCache {
+ public:
+  explicit ResponseCache(const ResponseCacheOptions& options)
+      : options_(options), byte_size_(0), hit_count_(0), miss_count_(0)
+  {
+  }
+
+  // Build the key of the request. Returns false if the request can't be
+  // cached.
+  static bool RequestKey(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      std::string* key);
+
+  // Look up the response for 'key'. On a hit returns true and a new
+  // result reporting 'request_id' as its id in 'result'.
+  bool Lookup(
+      const std::string& key, const std::string& request_id,
+      InferResult** result);
+
+  // Add the response 'result' for 'key'. Responses that are not
+  // successful or that don't fit into the cache are ignored.
+  void Insert(const std::string& key, const InferResult* result);
+
+  // Set the hit and miss counts in 'infer_stat'.
+  void Stat(InferStat* infer_stat) const;
+
+ private:
+  struct Entry {
+    std::string key_;
+    std::shared_ptr<const CachedResponse> response_;
+    size_t byte_size_;
+    std::chrono::steady_clock::time_point expiry_;
+  };
+  using EntryList = std::list<Entry>;
+
+  void Erase(EntryList::iterator it);
+
+  const ResponseCacheOptions options_;
+
+  mutable std::mutex mu_;
+  // Most recently used entry first
+  EntryList lru_;
+  std::unordered_map<std::string, EntryList::iterator> entries_;
+  size_t byte_size_;
+  size_t hit_count_;
+  size_t miss_count_;
+};
+
+bool
+ResponseCache::RequestKey(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs, std::string* key)
+{
+  key->clear();
+
+  // The response of a sequence request depends on the sequence state in
+  // the server and can't be reused.
+  if ((options.sequence_id_ != 0) || !options.sequence_id_str_.empty()) {
+    return false;
+  }
+
+  AppendKeyField(options.model_name_, key);
+  AppendKeyField(options.model_version_, key);
+
+  std::map<std::string, const RequestParameter*> parameters;
+  for (const auto& param : options.request_parameters) {
+    parameters.emplace(param.first, &param.second);
+  }
+  for (const auto& param : parameters) {
+    AppendKeyField(param.first, key);
+    AppendKeyField(param.second->type, key);
+    AppendKeyField(param.second->value, key);
+  }
+
+  uint64_t data_hash = 0;
+  for (const auto input : inputs) {
+    if (input->io_type_ == InferInput::SHARED_MEMORY) {
+      return false;
+    }
+    AppendKeyField(input->name_, key);
+    AppendKeyField(input->datatype_, key);
+    for (const auto dim : input->shape_) {
+      AppendKeyField(std::to_string(dim), key);
+    }
+    AppendKeyField(std::to_string(input->byte_size_), key);
+    for (size_t i = 0; i < input->bufs_.size(); ++i) {
+      data_hash =
+          HashBytes(input->bufs_[i], input->buf_byte_sizes_[i], data_hash);
+    }
+  }
+
+  for (const auto output : outputs) {
+    if (output->IsSharedMemory()) {
+      return false;
+    }
+    AppendKeyField(output->Name(), key);
+    AppendKeyField(std::to_string(output->ClassificationCount()), key);
+    AppendKeyField(output->BinaryData() ? "1" : "0", key);
+  }
+
+  key->append(reinterpret_cast<const char*>(&data_hash), sizeof(data_hash));
+  return true;
+}
+
+bool
+ResponseCache::Lookup(
+    const std::string& key, const std::string& request_id,
+    InferResult** result)
+{
+  std::lock_guard<std::mutex> lock(mu_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    if ((options_.ttl_ms != 0) &&
+        (std::chrono::steady_clock::now() >= it->second->expiry_)) {
+      Erase(it->second);
+    } else {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      *result = new CachedInferResult(it->second->response_, request_id);
+      hit_count_++;
+      return true;
+    }
+  }
+
+  miss_count_++;
+  return false;
+}
+
+void
+ResponseCache::Insert(const std::string& key, const InferResult* result)
+{
+  if (!result->RequestStatus().IsOk()) {
+    return;
+  }
+  bool is_final_response, is_null_response;
+  if (!result->IsFinalResponse(&is_final_response).IsOk() ||
+      !result->IsNullResponse(&is_null_response).IsOk() ||
+      !is_final_response || is_null_response) {
+    return;
+  }
+
+  std::vector<std::string> output_names;
+  std::shared_ptr<CachedResponse> response(new CachedResponse());
+  if (!result->OutputNames(&output_names).IsOk() ||
+      !result->ModelName(&response->model_name_).IsOk() ||
+      !result->ModelVersion(&response->model_version_).IsOk()) {
+    return;
+  }
+
+  size_t byte_size = key.size();
+  for (const auto& name : output_names) {
+    CachedResponse::Output& output = response->outputs_[name];
+    const uint8_t* buf;
+    size_t buf_byte_size;
+    if (!result->Shape(name, &output.shape_).IsOk() ||
+        !result->Datatype(name, &output.datatype_).IsOk() ||
+        !result->RawData(name, &buf, &buf_byte_size).IsOk()) {
+      return;
+    }
+    byte_size += buf_byte_size;
+    if (byte_size > options_.max_byte_size) {
+      return;
+    }
+    output.data_.assign(buf, buf + buf_byte_size);
+  }
+
+  std::lock_guard<std::mutex> lock(mu_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    Erase(it->second);
+  }
+  while (!lru_.empty() && (byte_size_ + byte_size > options_.max_byte_size)) {
+    Erase(std::prev(lru_.end()));
+  }
+
+  lru_.emplace_front();
+  Entry& entry = lru_.front();
+  entry.key_ = key;
+  entry.response_ = std::move(response);
+  entry.byte_size_ = byte_size;
+  entry.expiry_ = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(options_.ttl_ms);
+  entries_.emplace(key, lru_.begin());
+  byte_size_ += byte_size;
+}
+
+void
+ResponseCache::Stat(InferStat* infer_stat) const
+{
+  std::lock_guard<std::mutex> lock(mu_);
+  infer_stat->cache_hit_count = hit_count_;
+  infer_stat->cache_miss_count = miss_count_;
+}
+
+void
+ResponseCache::Erase(EntryList::iterator it)
+{
+  byte_size_ -= it->byte_size_;
+  entries_.erase(it->key_);
+  lru_.erase(it);
+}
+
+//==============================================================================
+
+void
+InferCancellation::Cancel()
+{
+  // The functions are called with the lock held so that a request can't
+  // be destroyed by its completion while it is being cancelled.
+  std::lock_guard<std::mutex> lock(mu_);
+  if (cancelled_) {
+    return;
+  }
+  cancelled_ = true;
+  for (const auto& cancel_fn : cancel_fns_) {
+    cancel_fn.second();
+  }
+}
+
+bool
+InferCancellation::IsCancelled() const
+{
+  std::lock_guard<std::mutex> lock(mu_);
+  return cancelled_;
+}
+
+bool
+InferCancellation::Attach(std::function<void()> cancel_fn, uint64_t* id)
+{
+  std::lock_guard<std::mutex> lock(mu_);
+  if (cancelled_) {
+    return false;
+  }
+  *id = next_id_++;
+  cancel_fns_.emplace(*id, std::move(cancel_fn));
+  return true;
+}
+
+void
+InferCancellation::Detach(const uint64_t id)
+{
+  std::lock_guard<std::mutex> lock(mu_);
+  cancel_fns_.erase(id);
+}
+
+//==============================================================================
+// Admission control of asynchronous requests. A request is admitted while
+// the number of requests in flight is below the limit, otherwise it is
+// handled according to the policy. With adaptive limiting the limit is
+// moved by the ratio between the long-term and the short-term average of
+// the request latency: a short-term latency above the long-term one means
+// requests are queueing in the server and the limit is lowered, while a
+// stable latency lets the limit grow by its square root.
+//
+class AdmissionController {
+ public:
+  explicit AdmissionController(const AdmissionControlOptions& options)
+      : options_(options), limit_(options.max_in_flight), in_flight_(0),
+        queued_(0), shed_count_(0), short_rtt_ns_(0), long_rtt_ns_(0)
+  {
+    if (options_.adaptive) {
+      limit_ = options_.min_in_flight;
+    }
+  }
+
+  Error Acquire();
+  void Release(const uint64_t request_time_ns);
+  void Stat(InferStat* infer_stat) const;
+
+ private:
+  // Adjust the limit with the latency of a completed request. Must be
+  // called with 'mu_' held.
+  void UpdateLimit(const uint64_t request_time_ns);
+
+  const AdmissionControlOptions options_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  double limit_;
+  size_t in_flight_;
+  size_t queued_;
+  size_t shed_count_;
+  double short_rtt_ns_;
+  double long_rtt_ns_;
+};
+
+Error
+AdmissionController::Acquire()
+{
+  std::unique_lock<std::mutex> lock(mu_);
+  const auto admissible = [this] {
+    return in_flight_ < static_cast<size_t>(limit_);
+  };
+  if (!admissible()) {
+    switch (options_.policy) {
+      case AdmissionControlOptions::Policy::FAIL_FAST:
+        shed_count_++;
+        return Error(
+            "request rejected, " + std::to_string(in_flight_) +
+            " requests in flight reached the limit");
+      case AdmissionControlOptions::Policy::TIMEOUT: {
+        queued_++;
+        const bool admitted = cv_.wait_for(
+            lock, std::chrono::microseconds(options_.queue_timeout_us),
+            admissible);
+        queued_--;
+        if (!admitted) {
+          shed_count_++;
+          return Error(
+              "request rejected, no request in flight completed within " +
+              std::to_string(options_.queue_timeout_us) + " usec");
+        }
+        break;
+      }
+      default:
+        queued_++;
+        cv_.wait(lock, admissible);
+        queued_--;
+        break;
+    }
+  }
+  in_flight_++;
+  return Error::Success;
+}
+
+void
+AdmissionController::Release(const uint64_t request_time_ns)
+{
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (options_.adaptive && (request_time_ns != 0)) {
+      UpdateLimit(request_time_ns);
+    }
+    in_flight_--;
+  }
+  cv_.notify_all();
+}
+
+void
+AdmissionController::UpdateLimit(const uint64_t request_time_ns)
+{
+  const double rtt_ns = static_cast<double>(request_time_ns);
+  if (long_rtt_ns_ == 0) {
+    short_rtt_ns_ = rtt_ns;
+    long_rtt_ns_ = rtt_ns;
+    return;
+  }
+  short_rtt_ns_ += (rtt_ns - short_rtt_ns_) * 0.5;
+  long_rtt_ns_ += (rtt_ns - long_rtt_ns_) * 0.01;
+
+  // A long-term latency far above the short-term one is left over from a
+  // past overload, restart the long-term average from the current latency.
+  if (long_rtt_ns_ > (2 * short_rtt_ns_)) {
+    long_rtt_ns_ = short_rtt_ns_;
+  }
+
+  // Only grow the limit when it is being used, otherwise an idle client
+  // would raise it to the maximum without any evidence.
+  if (in_flight_ < (limit_ / 2)) {
+    return;
+  }
+
+  const double gradient =
+      std::max(0.5, std::min(1.0, long_rtt_ns_ / short_rtt_ns_));
+  const double target = limit_ * gradient + std::sqrt(limit_);
+  limit_ = limit_ * 0.8 + target * 0.2;
+  limit_ = std::max(
+      static_cast<double>(options_.min_in_flight),
+      std::min(static_cast<double>(options_.max_in_flight), limit_));
+}
+
+void
+AdmissionController::Stat(InferStat* infer_stat) const
+{
+  std::lock_guard<std::mutex> lock(mu_);
+  infer_stat->in_flight_request_count = in_flight_;
+  infer_stat->queued_request_count = queued_;
+  infer_stat->shed_request_count = shed_count_;
+  infer_stat->in_flight_limit = static_cast<size_t>(limit_);
+}
+
+//==============================================================================
+
+InferenceServerClient::InferenceServerClient(bool verbose)
+    : verbose_(verbose), exiting_(false), connection_count_(0),
+      tls_handshake_count_(0)
+{
+}
+
+InferenceServerClient::~InferenceServerClient() = default;
+
 Error
 InferenceServerClient::ClientInferStat(InferStat* infer_stat) const
 {
   *infer_stat = infer_stat_;
+  {
+    std::lock_guard<std::mutex> lock(connection_stat_mu_);
+    infer_stat->connection_count = connection_count_;
+    infer_stat->tls_handshake_count = tls_handshake_count_;
+  }
+  if (response_cache_ != nullptr) {
+    response_cache_->Stat(infer_stat);
+  }
+  if (admission_controller_ != nullptr) {
+    admission_controller_->Stat(infer_stat);
+  }
+  return Error::Success;
+}
+
+Error
+InferenceServerClient::SetResponseCache(const ResponseCacheOptions& options)
+{
+  if (options.max_byte_size == 0) {
+    response_cache_.reset();
+  } else {
+    response_cache_.reset(new ResponseCache(options));
+  }
+  return Error::Success;
+}
+
+Error
+InferenceServerClient::SetAdmissionControl(
+    const AdmissionControlOptions& options)
+{
+  if (options.max_in_flight == 0) {
+    admission_controller_.reset();
+    return Error::Success;
+  }
+  if ((options.min_in_flight == 0) ||
+      (options.min_in_flight > options.max_in_flight)) {
+    return Error(
+        "the minimum requests in flight must be in range [1, " +
+        std::to_string(options.max_in_flight) + "]");
+  }
+  admission_controller_.reset(new AdmissionController(options));
   return Error::Success;
 }
 
+Error
+InferenceServerClient::AcquireAdmission()
+{
+  if (admission_controller_ == nullptr) {
+    return Error::Success;
+  }
+  return admission_controller_->Acquire();
+}
+
+void
+InferenceServerClient::ReleaseAdmission(const uint64_t request_time_ns)
+{
+  if (admission_controller_ != nullptr) {
+    admission_controller_->Release(request_time_ns);
+  }
+}
+
+bool
+InferenceServerClient::LookupResponseCache(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    std::string* cache_key, InferResult** result)
+{
+  if ((response_cache_ == nullptr) ||
+      !ResponseCache::RequestKey(options, inputs, outputs, cache_key)) {
+    cache_key->clear();
+    return false;
+  }
+  if (response_cache_->Lookup(*cache_key, options.request_id_, result)) {
+    cache_key->clear();
+    return true;
+  }
+  return false;
+}
+
+void
+InferenceServerClient::CacheResponse(
+    const std::string& cache_key, const InferResult* result)
+{
+  if ((response_cache_ != nullptr) && !cache_key.empty()) {
+    response_cache_->Insert(cache_key, result);
+  }
+}
+
+void
+InferenceServerClient::UpdateConnectionStat(
+    const size_t connection_count, const size_t tls_handshake_count)
+{
+  std::lock_guard<std::mutex> lock(connection_stat_mu_);
+  connection_count_ += connection_count;
+  tls_handshake_count_ += tls_handshake_count;
+}
+
 Error
 InferenceServerClient::UpdateInferStat(const RequestTimers& timer)
 {
@@ -129,6 +980,7 @@ InferInput::Reset()
   bufs_.clear();
   buf_byte_sizes_.clear();
   str_bufs_.clear();
+  converted_bufs_used_ = 0;
   bufs_idx_ = 0;
   byte_size_ = 0;
   io_type_ = NONE;
@@ -182,6 +1034,24 @@ InferInput::AppendFromString(const std::vector<std::string>& input)
   return AppendRaw(reinterpret_cast<const uint8_t*>(&sbuf[0]), sbuf.size());
 }
 
+Error
+InferInput::AppendFromFp32(
+    const float* input, size_t element_count, float scale, int32_t zero_point)
+{
+  if (converted_bufs_used_ == converted_bufs_.size()) {
+    converted_bufs_.emplace_back();
+  }
+  std::vector<uint8_t>& cbuf = converted_bufs_[converted_bufs_used_];
+  Error err = ConvertFromFp32(
+      input, element_count, datatype_, &cbuf, scale, zero_point);
+  if (!err.IsOk()) {
+    return err;
+  }
+  converted_bufs_used_++;
+
+  return AppendRaw(cbuf.data(), cbuf.size());
+}
+
 Error
 InferInput::ByteSize(size_t* byte_size) const
 {
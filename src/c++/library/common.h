@@ -31,9 +31,11 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -57,6 +59,10 @@ constexpr int MAX_GRPC_MESSAGE_SIZE = INT32_MAX;
 class InferResult;
 class InferRequest;
 class RequestTimers;
+class ResponseCache;
+class AdmissionController;
+class InferenceServerHttpClient;
+class InferenceServerGrpcClient;
 //==============================================================================
 /// Error status reported by client API.
 ///
@@ -84,6 +90,51 @@ class Error {
   std::string msg_;
 };
 
+//==============================================================================
+/// Histogram of latencies. The buckets are spaced logarithmically, with 4
+/// buckets per power of 2 starting from 1 microsecond, so the percentiles
+/// computed from the histogram are within 19% of the exact values.
+///
+struct LatencyHistogram {
+  /// The number of buckets. The last bucket also counts the latencies
+  /// above its upper bound, which is about 16.7 seconds.
+  static constexpr size_t BUCKET_COUNT = 96;
+
+  /// Create a new LatencyHistogram object with no latency recorded.
+  LatencyHistogram()
+      : bucket_counts(BUCKET_COUNT, 0), count(0), sum_ns(0), min_ns(0),
+        max_ns(0)
+  {
+  }
+
+  /// Get the upper bound of a bucket.
+  /// \param bucket The index of the bucket.
+  /// \return The largest latency, in nanoseconds, counted by the bucket.
+  static uint64_t BucketUpperBound(const size_t bucket);
+
+  /// Record a latency.
+  /// \param latency_ns The latency in nanoseconds.
+  void Add(const uint64_t latency_ns);
+
+  /// Get a percentile of the recorded latencies.
+  /// \param percentile The percentile, in range [0, 100].
+  /// \return The upper bound of the bucket holding the percentile,
+  /// clamped to the recorded minimum and maximum, in nanoseconds. The
+  /// recorded minimum for the lowest rank, and 0 if no latency is
+  /// recorded.
+  uint64_t Percentile(const double percentile) const;
+
+  /// The number of latencies recorded in each bucket.
+  std::vector<size_t> bucket_counts;
+  /// The number of latencies recorded.
+  size_t count;
+  /// The sum, the minimum and the maximum of the latencies recorded, in
+  /// nanoseconds.
+  uint64_t sum_ns;
+  uint64_t min_ns;
+  uint64_t max_ns;
+};
+
 //==============================================================================
 /// Cumulative inference statistics.
 ///
@@ -107,14 +158,124 @@ struct InferStat {
   /// response is completely received.
   uint64_t cumulative_receive_time_ns;
 
+  /// Number of requests served from the client-side response cache.
+  /// These requests are not included in the statistics above.
+  size_t cache_hit_count;
+
+  /// Number of cacheable requests that were not found in the
+  /// client-side response cache and were sent to the server.
+  size_t cache_miss_count;
+
+  /// Number of asynchronous requests currently in flight.
+  size_t in_flight_request_count;
+
+  /// Number of asynchronous requests currently waiting for admission.
+  size_t queued_request_count;
+
+  /// Number of asynchronous requests rejected by the admission control,
+  /// either immediately or after waiting for the admission timeout.
+  size_t shed_request_count;
+
+  /// The current limit of asynchronous requests in flight, 0 if the
+  /// admission control is not enabled.
+  size_t in_flight_limit;
+
+  /// Number of connections the client established to the server.
+  size_t connection_count;
+
+  /// Number of TLS handshakes the client performed. A handshake that
+  /// resumed a cached TLS session is counted the same as a full
+  /// handshake, as neither libcurl nor gRPC tell which kind was
+  /// performed, check the session reuse on the server side.
+  size_t tls_handshake_count;
+
+  /// Time from the start of a streaming request until its first
+  /// response with outputs is received.
+  LatencyHistogram first_response_latency;
+
+  /// Time between consecutive responses with outputs of a streaming
+  /// request.
+  LatencyHistogram inter_response_latency;
+
+  /// Time from the start of a streaming request until its final response
+  /// is received. For decoupled models, the final response is only known
+  /// if the request enables the empty final response, see
+  /// InferOptions::triton_enable_empty_final_response_, otherwise every
+  /// response is taken as final.
+  LatencyHistogram final_response_latency;
+
   /// Create a new InferStat object with zero-ed statistics.
   InferStat()
       : completed_request_count(0), cumulative_total_request_time_ns(0),
-        cumulative_send_time_ns(0), cumulative_receive_time_ns(0)
+        cumulative_send_time_ns(0), cumulative_receive_time_ns(0),
+        cache_hit_count(0), cache_miss_count(0), in_flight_request_count(0),
+        queued_request_count(0), shed_request_count(0), in_flight_limit(0),
+        connection_count(0), tls_handshake_count(0)
+  {
+  }
+};
+
+//==============================================================================
+/// Structure to hold options for the admission control of asynchronous
+/// inference requests.
+///
+struct AdmissionControlOptions {
+  /// The policies applied to a request that arrives when the limit of
+  /// requests in flight is reached.
+  enum class Policy {
+    /// Wait until a request in flight completes.
+    BLOCK,
+    /// Reject the request immediately.
+    FAIL_FAST,
+    /// Wait until a request in flight completes for at most
+    /// 'queue_timeout_us', then reject the request.
+    TIMEOUT
+  };
+
+  explicit AdmissionControlOptions()
+      : max_in_flight(0), policy(Policy::BLOCK), queue_timeout_us(0),
+        adaptive(false), min_in_flight(1)
   {
   }
+  /// The maximum number of asynchronous requests in flight. The default
+  /// value is 0 which disables the admission control.
+  size_t max_in_flight;
+  /// The policy applied when the limit is reached. The default is BLOCK.
+  Policy policy;
+  /// The time, in microseconds, a request waits for admission with the
+  /// TIMEOUT policy.
+  uint64_t queue_timeout_us;
+  /// Whether to adjust the limit between 'min_in_flight' and
+  /// 'max_in_flight' based on the observed request latency. The limit
+  /// is lowered when a short-term exponentially weighted moving average
+  /// of the latency rises above a long-term one, which indicates
+  /// requests queueing in the server, and raised when the two averages
+  /// stay close. Default value is false.
+  bool adaptive;
+  /// The lowest limit the adaptive limiting may set. Default value is 1.
+  size_t min_in_flight;
 };
 
+//==============================================================================
+/// Structure to hold options for the client-side response cache.
+///
+struct ResponseCacheOptions {
+  explicit ResponseCacheOptions() : max_byte_size(0), ttl_ms(0) {}
+  /// The maximum total size, in bytes, of the output data held by the
+  /// cache. The least recently used responses are evicted when the
+  /// budget is exceeded. The default value is 0 which disables the
+  /// cache.
+  size_t max_byte_size;
+  /// The time, in milliseconds, after which a cached response is no
+  /// longer used. The default value is 0 which means the cached
+  /// responses don't expire.
+  uint64_t ttl_ms;
+};
+
+struct InferOptions;
+class InferInput;
+class InferRequestedOutput;
+
 //==============================================================================
 /// The base class for InferenceServerClients
 ///
@@ -123,21 +284,68 @@ class InferenceServerClient {
   using OnCompleteFn = std::function<void(InferResult*)>;
   using OnMultiCompleteFn = std::function<void(std::vector<InferResult*>)>;
 
-  explicit InferenceServerClient(bool verbose)
-      : verbose_(verbose), exiting_(false)
-  {
-  }
+  explicit InferenceServerClient(bool verbose);
 
-  virtual ~InferenceServerClient() = default;
+  virtual ~InferenceServerClient();
 
   /// Obtain the cumulative inference statistics of the client.
   /// \param Returns the InferStat object holding current statistics.
   /// \return Error object indicating success or failure.
   Error ClientInferStat(InferStat* infer_stat) const;
 
+  /// Enable the client-side response cache. When enabled, the response
+  /// of a successful inference is kept in the client and returned for
+  /// later requests with identical model, inputs, requested outputs and
+  /// parameters without contacting the server. Only use the cache with
+  /// models that are deterministic. Requests that belong to a sequence
+  /// or that use shared memory are never cached. The cache must not be
+  /// changed while there are requests in flight.
+  /// \param options The options of the cache. A 'max_byte_size' of 0
+  /// disables the cache and drops all cached responses.
+  /// \return Error object indicating success or failure.
+  Error SetResponseCache(const ResponseCacheOptions& options);
+
+  /// Enable the admission control of asynchronous inference requests.
+  /// When enabled, the number of asynchronous requests in flight is
+  /// limited and the requests that exceed the limit are blocked,
+  /// rejected or rejected after a timeout, based on the policy. A
+  /// blocking AsyncInfer() call must not be made from a completion
+  /// callback, as the callbacks are invoked from the thread that
+  /// completes the requests in flight. The admission control must not
+  /// be changed while there are requests in flight.
+  /// \param options The options of the admission control. A
+  /// 'max_in_flight' of 0 disables the admission control.
+  /// \return Error object indicating success or failure.
+  Error SetAdmissionControl(const AdmissionControlOptions& options);
+
  protected:
   // Update the infer stat with the given timer
   Error UpdateInferStat(const RequestTimers& timer);
+  // Look up the response cache for an inference request. Returns true
+  // and a new result holding the cached response in 'result' on a hit.
+  // On a miss 'cache_key' is set to the key to pass to
+  // CacheResponse() once the response is received, or is left empty
+  // if the request can't be cached.
+  bool LookupResponseCache(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      std::string* cache_key, InferResult** result);
+  // Add the response of a request that missed the response cache.
+  void CacheResponse(const std::string& cache_key, const InferResult* result);
+  // Admit an asynchronous request, waiting for a request in flight to
+  // complete if required by the admission control. Every successful call
+  // must be paired with a ReleaseAdmission() call.
+  Error AcquireAdmission();
+  // Release the admission of an asynchronous request that completed
+  // after 'request_time_ns', or 0 if it was not sent. Call it before the
+  // completion callback of the request, so that the callback may issue
+  // the next request without waiting for the admission of this one.
+  void ReleaseAdmission(const uint64_t request_time_ns);
+  // Update the connection stat with the connections established and the
+  // TLS handshakes performed by a request.
+  void UpdateConnectionStat(
+      const size_t connection_count, const size_t tls_handshake_count);
+
   // Enables verbose operation in the client.
   bool verbose_;
 
@@ -152,6 +360,15 @@ class InferenceServerClient {
 
   // The inference statistic of the current client
   InferStat infer_stat_;
+  // The connection statistic, updated from the threads sending the
+  // synchronous requests and from the worker thread
+  mutable std::mutex connection_stat_mu_;
+  size_t connection_count_;
+  size_t tls_handshake_count_;
+  // The client-side response cache, null if not enabled
+  std::unique_ptr<ResponseCache> response_cache_;
+  // The admission control of asynchronous requests, null if not enabled
+  std::unique_ptr<AdmissionController> admission_controller_;
 };
 
 struct RequestParameter {
@@ -160,6 +377,44 @@ struct RequestParameter {
   std::string type;
 };
 
+//==============================================================================
+/// An InferCancellation object cancels the asynchronous inference requests
+/// that were sent with it in InferOptions::cancellation_. The gRPC client
+/// cancels the RPC and the HTTP client aborts the transfer. A cancelled
+/// request completes with an error result, unless it completed before
+/// the cancellation took effect. An InferCancellation can be shared by
+/// several requests and can be cancelled from any thread.
+///
+class InferCancellation {
+ public:
+  InferCancellation() : cancelled_(false), next_id_(0) {}
+
+  /// Cancel the requests in flight sent with this object, and any request
+  /// sent with it later.
+  void Cancel();
+
+  /// \return Whether Cancel() has been called.
+  bool IsCancelled() const;
+
+ private:
+  friend class InferenceServerHttpClient;
+  friend class InferenceServerGrpcClient;
+
+  // Register the function cancelling a request in flight. Returns false,
+  // without registering, if the object is already cancelled. Otherwise
+  // 'id' is set to the value to pass to Detach() once the request has
+  // completed.
+  bool Attach(std::function<void()> cancel_fn, uint64_t* id);
+  // Unregister the function of a completed request. Waits for the
+  // function to return if it is being called by Cancel().
+  void Detach(const uint64_t id);
+
+  mutable std::mutex mu_;
+  bool cancelled_;
+  uint64_t next_id_;
+  std::map<uint64_t, std::function<void()>> cancel_fns_;
+};
+
 //==============================================================================
 /// Structure to hold options for Inference Request.
 ///
@@ -168,7 +423,8 @@ struct InferOptions {
       : model_name_(model_name), model_version_(""), request_id_(""),
         sequence_id_(0), sequence_id_str_(""), sequence_start_(false),
         sequence_end_(false), priority_(0), server_timeout_(0),
-        client_timeout_(0), triton_enable_empty_final_response_(false)
+        client_timeout_(0), triton_enable_empty_final_response_(false),
+        zero_copy_input_(false)
   {
   }
   /// The name of the model to run inference.
@@ -228,6 +484,18 @@ struct InferOptions {
   uint64_t client_timeout_;
   /// Whether to tell Triton to enable an empty final response.
   bool triton_enable_empty_final_response_;
+  /// Whether the gRPC client may send the contents of the inputs by
+  /// reference to the buffers added with InferInput::AppendRaw() instead of
+  /// copying them into the request message. If true, the buffers must not
+  /// be modified or destroyed until the request has completed. This option
+  /// is ignored by streaming requests and by the HTTP client, which always
+  /// reads the input buffers directly during the transfer. Default value is
+  /// false.
+  bool zero_copy_input_;
+  /// The object to cancel the request with, only used by asynchronous
+  /// requests. Default value is nullptr which means the request can't be
+  /// cancelled.
+  std::shared_ptr<InferCancellation> cancellation_;
   /// Additional parameters to pass to the model
   std::unordered_map<std::string, RequestParameter> request_parameters;
 };
@@ -336,6 +604,23 @@ class InferInput {
   /// \return Error object indicating success or failure.
   Error AppendFromString(const std::vector<std::string>& input);
 
+  /// Append tensor values for this input from FP32 values, converted to
+  /// the datatype of this input. This method can only be used for tensors
+  /// with FP32, FP16, BF16 or INT8 data-type. The values are converted into
+  /// buffers owned by this input, which are reused by later calls once the
+  /// input is Reset(), and so 'input' does not need to be preserved as with
+  /// AppendRaw(). Multiple calls can be made to this API to keep adding
+  /// tensor data for this input. The data will be delivered in the order it
+  /// was added.
+  /// \param input The pointer to the array holding the FP32 values.
+  /// \param element_count The number of values in the array.
+  /// \param scale The quantization scale, only used for INT8 tensors.
+  /// \param zero_point The quantized value of 0, only used for INT8 tensors.
+  /// \return Error object indicating success or failure.
+  Error AppendFromFp32(
+      const float* input, size_t element_count, float scale = 1.0f,
+      int32_t zero_point = 0);
+
   /// Gets the size of data added into this input in bytes.
   /// \param byte_size The size of data added in bytes.
   /// \return Error object indicating success or failure.
@@ -352,6 +637,7 @@ class InferInput {
   friend class TRITON_INFERENCE_SERVER_CLIENT_CLASS;
 #endif
   friend class HttpInferRequest;
+  friend class ResponseCache;
   InferInput(
       const std::string& name, const std::vector<int64_t>& dims,
       const std::string& datatype);
@@ -377,6 +663,13 @@ class InferInput {
   // std::string objects.
   std::list<std::string> str_bufs_;
 
+  // Hold the values converted by AppendFromFp32(). Reset() only marks the
+  // buffers as unused so that their memory is reused by the next request.
+  // A std::deque is used to avoid invalidating the references into the
+  // buffers when adding more.
+  std::deque<std::vector<uint8_t>> converted_bufs_;
+  size_t converted_bufs_used_{0};
+
   // Used only if working with Shared Memory
   enum IOType { NONE, RAW, SHARED_MEMORY };
   IOType io_type_;
@@ -509,6 +802,14 @@ class InferResult {
   virtual Error Datatype(
       const std::string& output_name, std::string* datatype) const = 0;
 
+  /// Get the names of the outputs returned in the response.
+  /// \param names Returns the names of the outputs.
+  /// \return Error object indicating success or failure.
+  virtual Error OutputNames(std::vector<std::string>* names) const
+  {
+    return Error("listing the outputs is not supported by this result");
+  }
+
   /// Get access to the buffer holding raw results of specified output
   /// returned by the server. Note the buffer is owned by InferResult
   /// instance. Users can copy out the data if required to extend the
@@ -0,0 +1,848 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "convert_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TRITON_CONVERT_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define TRITON_CONVERT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace triton { namespace client {
+
+namespace {
+
+//==============================================================================
+// Scalar implementations, also used for the elements left over by the
+// vectorized implementations.
+
+inline uint32_t
+FloatBits(float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+inline float
+BitsFloat(uint32_t bits)
+{
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+inline uint16_t
+Fp32ToFp16Value(float value)
+{
+  const uint32_t bits = FloatBits(value);
+  const uint16_t sign = (bits >> 16) & 0x8000;
+  uint32_t abs = bits & 0x7fffffff;
+  if (abs > 0x7f800000) {
+    // NaN, keep the upper bits of the payload and make it quiet
+    return sign | 0x7e00 | ((abs >> 13) & 0x3ff);
+  }
+  if (abs >= 0x47800000) {
+    // Infinity or >= 2^16
+    return sign | 0x7c00;
+  }
+  if (abs >= 0x38800000) {
+    // Normal FP16 value. Round the mantissa to nearest even and rebias the
+    // exponent, a carry out of the mantissa correctly increments the
+    // exponent up to infinity.
+    abs += 0xfff + ((abs >> 13) & 1);
+    return sign | ((abs - 0x38000000) >> 13);
+  }
+  if (abs >= 0x33000000) {
+    // Subnormal FP16 value, in units of 2^-24
+    const uint32_t exponent = abs >> 23;
+    const uint32_t mantissa = (abs & 0x7fffff) | 0x800000;
+    const uint32_t shift = 126 - exponent;
+    uint32_t result = mantissa >> shift;
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t half = 1u << (shift - 1);
+    if ((remainder > half) || ((remainder == half) && (result & 1))) {
+      result++;
+    }
+    return sign | result;
+  }
+  // Rounds to zero
+  return sign;
+}
+
+inline float
+Fp16ToFp32Value(uint16_t value)
+{
+  const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+  const uint32_t exponent = (value >> 10) & 0x1f;
+  const uint32_t mantissa = value & 0x3ff;
+  if (exponent == 0) {
+    // Zero or subnormal, exactly representable as mantissa * 2^-24
+    return BitsFloat(
+        sign | FloatBits(static_cast<float>(mantissa) / 16777216.0f));
+  }
+  if (exponent == 0x1f) {
+    // Infinity or NaN, NaN is made quiet
+    return BitsFloat(
+        sign | 0x7f800000 | (mantissa << 13) | ((mantissa != 0) << 22));
+  }
+  return BitsFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+inline uint16_t
+Fp32ToBf16Value(float value)
+{
+  const uint32_t bits = FloatBits(value);
+  if ((bits & 0x7fffffff) > 0x7f800000) {
+    return (bits >> 16) | 0x40;
+  }
+  return (bits + 0x7fff + ((bits >> 16) & 1)) >> 16;
+}
+
+inline float
+Bf16ToFp32Value(uint16_t value)
+{
+  return BitsFloat(static_cast<uint32_t>(value) << 16);
+}
+
+inline int8_t
+QuantizeInt8Value(float value, float inv_scale, float zero_point)
+{
+  // The comparisons are ordered so that NaN saturates to -128, the same as
+  // the vectorized implementations.
+  float quantized = std::nearbyint(value * inv_scale) + zero_point;
+  quantized = (quantized > -128.0f) ? quantized : -128.0f;
+  quantized = (quantized < 127.0f) ? quantized : 127.0f;
+  return static_cast<int8_t>(quantized);
+}
+
+inline float
+DequantizeInt8Value(int8_t value, float scale, int32_t zero_point)
+{
+  return static_cast<float>(static_cast<int32_t>(value) - zero_point) * scale;
+}
+
+void
+Fp32ToFp16Scalar(const float* src, uint16_t* dst, size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = Fp32ToFp16Value(src[i]);
+  }
+}
+
+void
+Fp16ToFp32Scalar(const uint16_t* src, float* dst, size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = Fp16ToFp32Value(src[i]);
+  }
+}
+
+void
+Fp32ToBf16Scalar(const float* src, uint16_t* dst, size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = Fp32ToBf16Value(src[i]);
+  }
+}
+
+void
+Bf16ToFp32Scalar(const uint16_t* src, float* dst, size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = Bf16ToFp32Value(src[i]);
+  }
+}
+
+void
+QuantizeInt8Scalar(
+    const float* src, int8_t* dst, size_t count, float scale,
+    int32_t zero_point)
+{
+  const float inv_scale = 1.0f / scale;
+  const float zero = static_cast<float>(zero_point);
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = QuantizeInt8Value(src[i], inv_scale, zero);
+  }
+}
+
+void
+DequantizeInt8Scalar(
+    const int8_t* src, float* dst, size_t count, float scale,
+    int32_t zero_point)
+{
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = DequantizeInt8Value(src[i], scale, zero_point);
+  }
+}
+
+// Transpose a 'rows' x 'cols' row-major matrix, tile by tile so that both
+// the reads and the writes stay within a few cache lines.
+template <typename T>
+void
+TransposeScalar(const T* src, T* dst, size_t rows, size_t cols)
+{
+  constexpr size_t kTile = 32;
+  for (size_t r0 = 0; r0 < rows; r0 += kTile) {
+    const size_t r1 = std::min(rows, r0 + kTile);
+    for (size_t c0 = 0; c0 < cols; c0 += kTile) {
+      const size_t c1 = std::min(cols, c0 + kTile);
+      for (size_t r = r0; r < r1; ++r) {
+        for (size_t c = c0; c < c1; ++c) {
+          dst[c * rows + r] = src[r * cols + c];
+        }
+      }
+    }
+  }
+}
+
+void
+TransposeBytes(
+    const uint8_t* src, uint8_t* dst, size_t rows, size_t cols,
+    size_t element_byte_size)
+{
+  for (size_t r = 0; r < rows; ++r) {
+    for (size_t c = 0; c < cols; ++c) {
+      std::memcpy(
+          dst + (c * rows + r) * element_byte_size,
+          src + (r * cols + c) * element_byte_size, element_byte_size);
+    }
+  }
+}
+
+void
+Transpose32Scalar(const uint32_t* src, uint32_t* dst, size_t rows, size_t cols)
+{
+  TransposeScalar(src, dst, rows, cols);
+}
+
+#ifdef TRITON_CONVERT_X86
+//==============================================================================
+// x86 implementations, compiled for the instruction set through the target
+// attribute so that the library itself doesn't require it.
+
+__attribute__((target("avx2,f16c"))) void
+Fp32ToFp16Avx2(const float* src, uint16_t* dst, size_t count)
+{
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 value = _mm256_loadu_ps(src + i);
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(dst + i),
+        _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+  Fp32ToFp16Scalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2,f16c"))) void
+Fp16ToFp32Avx2(const uint16_t* src, float* dst, size_t count)
+{
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i value =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(value));
+  }
+  Fp16ToFp32Scalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2"))) void
+Fp32ToBf16Avx2(const float* src, uint16_t* dst, size_t count)
+{
+  const __m256i abs_mask = _mm256_set1_epi32(0x7fffffff);
+  const __m256i infinity = _mm256_set1_epi32(0x7f800000);
+  const __m256i round_bias = _mm256_set1_epi32(0x7fff);
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i quiet_bit = _mm256_set1_epi32(0x40);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m256i packed[2];
+    for (size_t j = 0; j < 2; ++j) {
+      const __m256i bits =
+          _mm256_castps_si256(_mm256_loadu_ps(src + i + j * 8));
+      const __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+      const __m256i rounded = _mm256_srli_epi32(
+          _mm256_add_epi32(bits, _mm256_add_epi32(round_bias, lsb)), 16);
+      const __m256i nan =
+          _mm256_or_si256(_mm256_srli_epi32(bits, 16), quiet_bit);
+      const __m256i is_nan =
+          _mm256_cmpgt_epi32(_mm256_and_si256(bits, abs_mask), infinity);
+      packed[j] = _mm256_blendv_epi8(rounded, nan, is_nan);
+    }
+    // Pack within the 128-bit lanes then put the lanes back in order
+    const __m256i result = _mm256_permute4x64_epi64(
+        _mm256_packus_epi32(packed[0], packed[1]), 0xd8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), result);
+  }
+  Fp32ToBf16Scalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2"))) void
+Bf16ToFp32Avx2(const uint16_t* src, float* dst, size_t count)
+{
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256i value = _mm256_cvtepu16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+    _mm256_storeu_ps(
+        dst + i, _mm256_castsi256_ps(_mm256_slli_epi32(value, 16)));
+  }
+  Bf16ToFp32Scalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2"))) void
+QuantizeInt8Avx2(
+    const float* src, int8_t* dst, size_t count, float scale,
+    int32_t zero_point)
+{
+  const float inv_scale = 1.0f / scale;
+  const float zero = static_cast<float>(zero_point);
+  const __m256 inv_scale_v = _mm256_set1_ps(inv_scale);
+  const __m256 zero_v = _mm256_set1_ps(zero);
+  const __m256 min_v = _mm256_set1_ps(-128.0f);
+  const __m256 max_v = _mm256_set1_ps(127.0f);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 value = _mm256_mul_ps(_mm256_loadu_ps(src + i), inv_scale_v);
+    value = _mm256_round_ps(
+        value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    value = _mm256_add_ps(value, zero_v);
+    // max/min return the second operand for NaN
+    value = _mm256_min_ps(_mm256_max_ps(value, min_v), max_v);
+    const __m256i quantized = _mm256_cvtps_epi32(value);
+    const __m128i words = _mm_packs_epi32(
+        _mm256_castsi256_si128(quantized),
+        _mm256_extracti128_si256(quantized, 1));
+    _mm_storel_epi64(
+        reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi16(words, words));
+  }
+  for (; i < count; ++i) {
+    dst[i] = QuantizeInt8Value(src[i], inv_scale, zero);
+  }
+}
+
+__attribute__((target("avx2"))) void
+DequantizeInt8Avx2(
+    const int8_t* src, float* dst, size_t count, float scale,
+    int32_t zero_point)
+{
+  const __m256 scale_v = _mm256_set1_ps(scale);
+  const __m256i zero_v = _mm256_set1_epi32(zero_point);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256i value = _mm256_cvtepi8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+    _mm256_storeu_ps(
+        dst + i, _mm256_mul_ps(
+                     _mm256_cvtepi32_ps(_mm256_sub_epi32(value, zero_v)),
+                     scale_v));
+  }
+  DequantizeInt8Scalar(src + i, dst + i, count - i, scale, zero_point);
+}
+
+// Transpose 8x8 blocks with AVX2, the most common case being FP32 images.
+__attribute__((target("avx2"))) void
+Transpose32Avx2(const uint32_t* src, uint32_t* dst, size_t rows, size_t cols)
+{
+  const size_t block_rows = rows - (rows % 8);
+  const size_t block_cols = cols - (cols % 8);
+  const float* in = reinterpret_cast<const float*>(src);
+  float* out = reinterpret_cast<float*>(dst);
+  for (size_t r = 0; r < block_rows; r += 8) {
+    for (size_t c = 0; c < block_cols; c += 8) {
+      __m256 row[8];
+      for (size_t k = 0; k < 8; ++k) {
+        row[k] = _mm256_loadu_ps(in + (r + k) * cols + c);
+      }
+      __m256 t[8];
+      for (size_t k = 0; k < 8; k += 2) {
+        t[k] = _mm256_unpacklo_ps(row[k], row[k + 1]);
+        t[k + 1] = _mm256_unpackhi_ps(row[k], row[k + 1]);
+      }
+      __m256 s[8];
+      for (size_t k = 0; k < 8; k += 4) {
+        s[k] = _mm256_shuffle_ps(t[k], t[k + 2], 0x44);
+        s[k + 1] = _mm256_shuffle_ps(t[k], t[k + 2], 0xee);
+        s[k + 2] = _mm256_shuffle_ps(t[k + 1], t[k + 3], 0x44);
+        s[k + 3] = _mm256_shuffle_ps(t[k + 1], t[k + 3], 0xee);
+      }
+      for (size_t k = 0; k < 4; ++k) {
+        _mm256_storeu_ps(
+            out + (c + k) * rows + r,
+            _mm256_permute2f128_ps(s[k], s[k + 4], 0x20));
+        _mm256_storeu_ps(
+            out + (c + k + 4) * rows + r,
+            _mm256_permute2f128_ps(s[k], s[k + 4], 0x31));
+      }
+    }
+  }
+  // Edges not covered by the 8x8 blocks
+  for (size_t r = 0; r < rows; ++r) {
+    for (size_t c = (r < block_rows) ? block_cols : 0; c < cols; ++c) {
+      dst[c * rows + r] = src[r * cols + c];
+    }
+  }
+}
+
+// GCC warns about the undefined vectors used by the AVX-512 intrinsics.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+__attribute__((target("avx512f"))) void
+Fp32ToFp16Avx512(const float* src, uint16_t* dst, size_t count)
+{
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m512 value = _mm512_loadu_ps(src + i);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(dst + i),
+        _mm512_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+  Fp32ToFp16Scalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx512f"))) void
+Fp16ToFp32Avx512(const uint16_t* src, float* dst, size_t count)
+{
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m256i value =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    _mm512_storeu_ps(dst + i, _mm512_cvtph_ps(value));
+  }
+  Fp16ToFp32Scalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx512f"))) void
+Fp32ToBf16Avx512(const float* src, uint16_t* dst, size_t count)
+{
+  const __m512i abs_mask = _mm512_set1_epi32(0x7fffffff);
+  const __m512i infinity = _mm512_set1_epi32(0x7f800000);
+  const __m512i round_bias = _mm512_set1_epi32(0x7fff);
+  const __m512i one = _mm512_set1_epi32(1);
+  const __m512i quiet_bit = _mm512_set1_epi32(0x40);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m512i bits = _mm512_castps_si512(_mm512_loadu_ps(src + i));
+    const __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(bits, 16), one);
+    const __m512i rounded = _mm512_srli_epi32(
+        _mm512_add_epi32(bits, _mm512_add_epi32(round_bias, lsb)), 16);
+    const __m512i nan = _mm512_or_si512(_mm512_srli_epi32(bits, 16), quiet_bit);
+    const __mmask16 is_nan =
+        _mm512_cmpgt_epu32_mask(_mm512_and_si512(bits, abs_mask), infinity);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(dst + i),
+        _mm512_cvtepi32_epi16(_mm512_mask_blend_epi32(is_nan, rounded, nan)));
+  }
+  Fp32ToBf16Scalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx512f"))) void
+Bf16ToFp32Avx512(const uint16_t* src, float* dst, size_t count)
+{
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m512i value = _mm512_cvtepu16_epi32(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+    _mm512_storeu_ps(
+        dst + i, _mm512_castsi512_ps(_mm512_slli_epi32(value, 16)));
+  }
+  Bf16ToFp32Scalar(src + i, dst + i, count - i);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif  // TRITON_CONVERT_X86
+
+#ifdef TRITON_CONVERT_NEON
+//==============================================================================
+// Arm implementations, NEON is always available on AArch64.
+
+void
+Fp32ToFp16Neon(const float* src, uint16_t* dst, size_t count)
+{
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    vst1_u16(
+        dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+  }
+  Fp32ToFp16Scalar(src + i, dst + i, count - i);
+}
+
+void
+Fp16ToFp32Neon(const uint16_t* src, float* dst, size_t count)
+{
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    vst1q_f32(
+        dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+  }
+  Fp16ToFp32Scalar(src + i, dst + i, count - i);
+}
+
+void
+Fp32ToBf16Neon(const float* src, uint16_t* dst, size_t count)
+{
+  const uint32x4_t abs_mask = vdupq_n_u32(0x7fffffff);
+  const uint32x4_t infinity = vdupq_n_u32(0x7f800000);
+  const uint32x4_t round_bias = vdupq_n_u32(0x7fff);
+  const uint32x4_t one = vdupq_n_u32(1);
+  const uint32x4_t quiet_bit = vdupq_n_u32(0x40);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const uint32x4_t bits = vreinterpretq_u32_f32(vld1q_f32(src + i));
+    const uint32x4_t lsb = vandq_u32(vshrq_n_u32(bits, 16), one);
+    const uint32x4_t rounded =
+        vshrq_n_u32(vaddq_u32(bits, vaddq_u32(round_bias, lsb)), 16);
+    const uint32x4_t nan = vorrq_u32(vshrq_n_u32(bits, 16), quiet_bit);
+    const uint32x4_t is_nan = vcgtq_u32(vandq_u32(bits, abs_mask), infinity);
+    vst1_u16(dst + i, vmovn_u32(vbslq_u32(is_nan, nan, rounded)));
+  }
+  Fp32ToBf16Scalar(src + i, dst + i, count - i);
+}
+
+void
+Bf16ToFp32Neon(const uint16_t* src, float* dst, size_t count)
+{
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    vst1q_f32(
+        dst + i, vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(src + i), 16)));
+  }
+  Bf16ToFp32Scalar(src + i, dst + i, count - i);
+}
+
+void
+QuantizeInt8Neon(
+    const float* src, int8_t* dst, size_t count, float scale,
+    int32_t zero_point)
+{
+  const float inv_scale = 1.0f / scale;
+  const float zero = static_cast<float>(zero_point);
+  const float32x4_t inv_scale_v = vdupq_n_f32(inv_scale);
+  const float32x4_t zero_v = vdupq_n_f32(zero);
+  const float32x4_t min_v = vdupq_n_f32(-128.0f);
+  const float32x4_t max_v = vdupq_n_f32(127.0f);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    int16x4_t words[2];
+    for (size_t j = 0; j < 2; ++j) {
+      float32x4_t value =
+          vmulq_f32(vld1q_f32(src + i + j * 4), inv_scale_v);
+      value = vaddq_f32(vrndnq_f32(value), zero_v);
+      // Select with comparisons so that NaN saturates to -128
+      value = vbslq_f32(vcgtq_f32(value, min_v), value, min_v);
+      value = vbslq_f32(vcltq_f32(value, max_v), value, max_v);
+      words[j] = vmovn_s32(vcvtq_s32_f32(value));
+    }
+    vst1_s8(dst + i, vmovn_s16(vcombine_s16(words[0], words[1])));
+  }
+  for (; i < count; ++i) {
+    dst[i] = QuantizeInt8Value(src[i], inv_scale, zero);
+  }
+}
+
+void
+DequantizeInt8Neon(
+    const int8_t* src, float* dst, size_t count, float scale,
+    int32_t zero_point)
+{
+  const float32x4_t scale_v = vdupq_n_f32(scale);
+  const int32x4_t zero_v = vdupq_n_s32(zero_point);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const int16x8_t value = vmovl_s8(vld1_s8(src + i));
+    const int32x4_t low = vsubq_s32(vmovl_s16(vget_low_s16(value)), zero_v);
+    const int32x4_t high = vsubq_s32(vmovl_s16(vget_high_s16(value)), zero_v);
+    vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(low), scale_v));
+    vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(high), scale_v));
+  }
+  DequantizeInt8Scalar(src + i, dst + i, count - i, scale, zero_point);
+}
+#endif  // TRITON_CONVERT_NEON
+
+//==============================================================================
+// The implementations used, selected once based on the CPU.
+
+struct ConvertKernels {
+  const char* isa;
+  void (*fp32_to_fp16)(const float*, uint16_t*, size_t);
+  void (*fp16_to_fp32)(const uint16_t*, float*, size_t);
+  void (*fp32_to_bf16)(const float*, uint16_t*, size_t);
+  void (*bf16_to_fp32)(const uint16_t*, float*, size_t);
+  void (*quantize_int8)(const float*, int8_t*, size_t, float, int32_t);
+  void (*dequantize_int8)(const int8_t*, float*, size_t, float, int32_t);
+  void (*transpose_32)(const uint32_t*, uint32_t*, size_t, size_t);
+};
+
+ConvertKernels
+SelectKernels()
+{
+  ConvertKernels kernels{
+      "scalar",           Fp32ToFp16Scalar,   Fp16ToFp32Scalar,
+      Fp32ToBf16Scalar,   Bf16ToFp32Scalar,   QuantizeInt8Scalar,
+      DequantizeInt8Scalar, Transpose32Scalar};
+#if defined(TRITON_CONVERT_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c")) {
+    kernels = ConvertKernels{
+        "avx2",           Fp32ToFp16Avx2,   Fp16ToFp32Avx2,
+        Fp32ToBf16Avx2,   Bf16ToFp32Avx2,   QuantizeInt8Avx2,
+        DequantizeInt8Avx2, Transpose32Avx2};
+    if (__builtin_cpu_supports("avx512f")) {
+      kernels.isa = "avx512";
+      kernels.fp32_to_fp16 = Fp32ToFp16Avx512;
+      kernels.fp16_to_fp32 = Fp16ToFp32Avx512;
+      kernels.fp32_to_bf16 = Fp32ToBf16Avx512;
+      kernels.bf16_to_fp32 = Bf16ToFp32Avx512;
+    }
+  }
+#elif defined(TRITON_CONVERT_NEON)
+  kernels = ConvertKernels{
+      "neon",           Fp32ToFp16Neon,   Fp16ToFp32Neon,
+      Fp32ToBf16Neon,   Bf16ToFp32Neon,   QuantizeInt8Neon,
+      DequantizeInt8Neon, Transpose32Scalar};
+#endif
+  return kernels;
+}
+
+const ConvertKernels&
+Kernels()
+{
+  static const ConvertKernels kernels = SelectKernels();
+  return kernels;
+}
+
+void
+Transpose(
+    const void* src, void* dst, size_t rows, size_t cols,
+    size_t element_byte_size)
+{
+  switch (element_byte_size) {
+    case 1:
+      TransposeScalar(
+          static_cast<const uint8_t*>(src), static_cast<uint8_t*>(dst), rows,
+          cols);
+      break;
+    case 2:
+      TransposeScalar(
+          static_cast<const uint16_t*>(src), static_cast<uint16_t*>(dst),
+          rows, cols);
+      break;
+    case 4:
+      Kernels().transpose_32(
+          static_cast<const uint32_t*>(src), static_cast<uint32_t*>(dst),
+          rows, cols);
+      break;
+    case 8:
+      TransposeScalar(
+          static_cast<const uint64_t*>(src), static_cast<uint64_t*>(dst),
+          rows, cols);
+      break;
+    default:
+      TransposeBytes(
+          static_cast<const uint8_t*>(src), static_cast<uint8_t*>(dst), rows,
+          cols, element_byte_size);
+      break;
+  }
+}
+
+}  // namespace
+
+//==============================================================================
+
+void
+Fp32ToFp16(const float* src, uint16_t* dst, size_t count)
+{
+  Kernels().fp32_to_fp16(src, dst, count);
+}
+
+void
+Fp16ToFp32(const uint16_t* src, float* dst, size_t count)
+{
+  Kernels().fp16_to_fp32(src, dst, count);
+}
+
+void
+Fp32ToBf16(const float* src, uint16_t* dst, size_t count)
+{
+  Kernels().fp32_to_bf16(src, dst, count);
+}
+
+void
+Bf16ToFp32(const uint16_t* src, float* dst, size_t count)
+{
+  Kernels().bf16_to_fp32(src, dst, count);
+}
+
+void
+QuantizeInt8(
+    const float* src, int8_t* dst, size_t count, float scale,
+    int32_t zero_point)
+{
+  Kernels().quantize_int8(src, dst, count, scale, zero_point);
+}
+
+void
+DequantizeInt8(
+    const int8_t* src, float* dst, size_t count, float scale,
+    int32_t zero_point)
+{
+  Kernels().dequantize_int8(src, dst, count, scale, zero_point);
+}
+
+void
+NhwcToNchw(
+    const void* src, void* dst, size_t n, size_t h, size_t w, size_t c,
+    size_t element_byte_size)
+{
+  const size_t image_byte_size = h * w * c * element_byte_size;
+  for (size_t i = 0; i < n; ++i) {
+    Transpose(
+        static_cast<const uint8_t*>(src) + i * image_byte_size,
+        static_cast<uint8_t*>(dst) + i * image_byte_size, h * w, c,
+        element_byte_size);
+  }
+}
+
+void
+NchwToNhwc(
+    const void* src, void* dst, size_t n, size_t c, size_t h, size_t w,
+    size_t element_byte_size)
+{
+  const size_t image_byte_size = c * h * w * element_byte_size;
+  for (size_t i = 0; i < n; ++i) {
+    Transpose(
+        static_cast<const uint8_t*>(src) + i * image_byte_size,
+        static_cast<uint8_t*>(dst) + i * image_byte_size, c, h * w,
+        element_byte_size);
+  }
+}
+
+Error
+ConvertFromFp32(
+    const float* src, size_t count, const std::string& datatype,
+    std::vector<uint8_t>* dst, float scale, int32_t zero_point)
+{
+  if (datatype == "FP32") {
+    dst->resize(count * sizeof(float));
+    if (count != 0) {
+      std::memcpy(dst->data(), src, count * sizeof(float));
+    }
+  } else if (datatype == "FP16") {
+    dst->resize(count * sizeof(uint16_t));
+    Fp32ToFp16(src, reinterpret_cast<uint16_t*>(dst->data()), count);
+  } else if (datatype == "BF16") {
+    dst->resize(count * sizeof(uint16_t));
+    Fp32ToBf16(src, reinterpret_cast<uint16_t*>(dst->data()), count);
+  } else if (datatype == "INT8") {
+    dst->resize(count);
+    QuantizeInt8(
+        src, reinterpret_cast<int8_t*>(dst->data()), count, scale,
+        zero_point);
+  } else {
+    return Error(
+        "conversion from FP32 to datatype '" + datatype + "' is not supported");
+  }
+  return Error::Success;
+}
+
+Error
+ConvertToFp32(
+    const uint8_t* src, size_t byte_size, const std::string& datatype,
+    std::vector<float>* dst, float scale, int32_t zero_point)
+{
+  size_t element_byte_size;
+  if (datatype == "FP32") {
+    element_byte_size = sizeof(float);
+  } else if ((datatype == "FP16") || (datatype == "BF16")) {
+    element_byte_size = sizeof(uint16_t);
+  } else if (datatype == "INT8") {
+    element_byte_size = sizeof(int8_t);
+  } else {
+    return Error(
+        "conversion from datatype '" + datatype + "' to FP32 is not supported");
+  }
+  if ((byte_size % element_byte_size) != 0) {
+    return Error(
+        "byte size " + std::to_string(byte_size) +
+        " is not a multiple of the size of datatype '" + datatype + "'");
+  }
+
+  const size_t count = byte_size / element_byte_size;
+  dst->resize(count);
+  if (datatype == "FP32") {
+    if (count != 0) {
+      std::memcpy(dst->data(), src, byte_size);
+    }
+  } else if (datatype == "FP16") {
+    Fp16ToFp32(reinterpret_cast<const uint16_t*>(src), dst->data(), count);
+  } else if (datatype == "BF16") {
+    Bf16ToFp32(reinterpret_cast<const uint16_t*>(src), dst->data(), count);
+  } else {
+    DequantizeInt8(
+        reinterpret_cast<const int8_t*>(src), dst->data(), count, scale,
+        zero_point);
+  }
+  return Error::Success;
+}
+
+Error
+OutputToFp32(
+    const InferResult& result, const std::string& output_name,
+    std::vector<float>* dst, float scale, int32_t zero_point)
+{
+  std::string datatype;
+  Error err = result.Datatype(output_name, &datatype);
+  if (!err.IsOk()) {
+    return err;
+  }
+  const uint8_t* buf;
+  size_t byte_size;
+  err = result.RawData(output_name, &buf, &byte_size);
+  if (!err.IsOk()) {
+    return err;
+  }
+  return ConvertToFp32(buf, byte_size, datatype, dst, scale, zero_point);
+}
+
+const char*
+ConvertIsa()
+{
+  return Kernels().isa;
+}
+
+}}  // namespace triton::client
@@ -0,0 +1,125 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common.h"
+
+namespace triton { namespace client {
+
+// Conversions between the FP32 values usually held by the application and
+// the datatypes of the model tensors. The conversions use AVX-512 or AVX2
+// on x86, selected at runtime based on the CPU, and NEON on Arm. All the
+// implementations produce the same results: FP32 values are rounded to the
+// nearest representable value with ties to even, NaN stays NaN and values
+// out of range become infinity (FP16, BF16) or saturate (INT8).
+
+// Convert 'count' FP32 values to FP16.
+void Fp32ToFp16(const float* src, uint16_t* dst, size_t count);
+
+// Convert 'count' FP16 values to FP32.
+void Fp16ToFp32(const uint16_t* src, float* dst, size_t count);
+
+// Convert 'count' FP32 values to BF16.
+void Fp32ToBf16(const float* src, uint16_t* dst, size_t count);
+
+// Convert 'count' BF16 values to FP32.
+void Bf16ToFp32(const uint16_t* src, float* dst, size_t count);
+
+// Quantize 'count' FP32 values to INT8, that is
+// clamp(round(src / scale) + zero_point, -128, 127).
+// \param scale The quantization scale, must be positive.
+// \param zero_point The quantized value of 0.
+void QuantizeInt8(
+    const float* src, int8_t* dst, size_t count, float scale,
+    int32_t zero_point);
+
+// Dequantize 'count' INT8 values to FP32, that is
+// (src - zero_point) * scale.
+// \param scale The quantization scale.
+// \param zero_point The quantized value of 0.
+void DequantizeInt8(
+    const int8_t* src, float* dst, size_t count, float scale,
+    int32_t zero_point);
+
+// Transpose a batch of NHWC images to NCHW. 'src' and 'dst' must not
+// overlap.
+// \param element_byte_size The size in bytes of a tensor element.
+void NhwcToNchw(
+    const void* src, void* dst, size_t n, size_t h, size_t w, size_t c,
+    size_t element_byte_size);
+
+// Transpose a batch of NCHW images to NHWC. 'src' and 'dst' must not
+// overlap.
+// \param element_byte_size The size in bytes of a tensor element.
+void NchwToNhwc(
+    const void* src, void* dst, size_t n, size_t c, size_t h, size_t w,
+    size_t element_byte_size);
+
+// Convert FP32 values to the given datatype, writing them into 'dst' which
+// is resized to the converted byte size. The capacity of 'dst' is reused so
+// the same vector can be used for every request.
+// \param datatype The datatype to convert to, one of FP32, FP16, BF16 or
+// INT8.
+// \param scale The quantization scale, only used for INT8.
+// \param zero_point The quantized value of 0, only used for INT8.
+// \return error Returns an error if the datatype is not supported.
+Error ConvertFromFp32(
+    const float* src, size_t count, const std::string& datatype,
+    std::vector<uint8_t>* dst, float scale = 1.0f, int32_t zero_point = 0);
+
+// Convert the raw values of the given datatype to FP32, writing them into
+// 'dst' which is resized to the number of values.
+// \param datatype The datatype to convert from, one of FP32, FP16, BF16 or
+// INT8.
+// \param scale The quantization scale, only used for INT8.
+// \param zero_point The quantized value of 0, only used for INT8.
+// \return error Returns an error if the datatype is not supported or
+// 'byte_size' is not a multiple of its size.
+Error ConvertToFp32(
+    const uint8_t* src, size_t byte_size, const std::string& datatype,
+    std::vector<float>* dst, float scale = 1.0f, int32_t zero_point = 0);
+
+// Convert the values of an output of an inference result to FP32.
+// \param result The inference result.
+// \param output_name The name of the output.
+// \param dst Returns the FP32 values.
+// \param scale The quantization scale, only used for INT8 outputs.
+// \param zero_point The quantized value of 0, only used for INT8 outputs.
+// \return error Returns an error if the output can't be found or its
+// datatype is not supported.
+Error OutputToFp32(
+    const InferResult& result, const std::string& output_name,
+    std::vector<float>* dst, float scale = 1.0f, int32_t zero_point = 0);
+
+// The instruction set used by the conversions, one of "avx512", "avx2",
+// "neon" or "scalar".
+const char* ConvertIsa();
+
+}}  // namespace triton::client
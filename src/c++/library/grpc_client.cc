@@ -28,6 +28,10 @@
 #define TRITON_INFERENCE_SERVER_CLIENT_CLASS InferenceServerGrpcClient
 #include "grpc_client.h"
 
+#include <google/protobuf/io/coded_stream.h>
+#include <grpc/grpc_security.h>
+#include <grpcpp/alarm.h>
+
 #include <chrono>
 #include <cstdint>
 #include <fstream>
@@ -77,11 +81,27 @@ ReadFile(const std::string& filename, std::string& data)
   }
 }
 
+// The TLS session cache shared by all the channels, so that a new channel
+// resumes a session established by another one instead of performing a
+// full handshake.
+grpc_ssl_session_cache*
+SslSessionCache()
+{
+  static grpc_ssl_session_cache* cache =
+      grpc_ssl_session_cache_create_lru(64 /* capacity */);
+  return cache;
+}
+
+// The full name of the ModelInfer method, used to issue the inference
+// requests serialized by reference through the generic stub.
+constexpr char kModelInferMethod[] =
+    "/inference.GRPCInferenceService/ModelInfer";
+
 std::shared_ptr<inference::GRPCInferenceService::Stub>
 GetStub(
     const std::string& url, bool use_ssl, const SslOptions& ssl_options,
     const grpc::ChannelArguments& channel_args, const bool use_cached_channel,
-    bool verbose)
+    bool verbose, std::shared_ptr<grpc::Channel>* stub_channel)
 {
   std::lock_guard<std::mutex> lock(grpc_channel_stub_map_mtx_);
 
@@ -100,6 +120,7 @@ GetStub(
     const auto& shared_count = std::get<0>(channel_itr->second);
     if (shared_count % max_share_count != 0) {
       std::get<0>(channel_itr->second)++;
+      *stub_channel = std::get<1>(channel_itr->second);
       return std::get<2>(channel_itr->second);
     }
   }
@@ -128,6 +149,11 @@ GetStub(
     ReadFile(ssl_options.certificate_chain, cert);
     grpc::SslCredentialsOptions opts = {root, key, cert};
     credentials = grpc::SslCredentials(opts);
+    grpc_arg session_cache_arg =
+        grpc_ssl_session_cache_create_channel_arg(SslSessionCache());
+    arguments.SetPointerWithVtable(
+        session_cache_arg.key, session_cache_arg.value.pointer.p,
+        session_cache_arg.value.pointer.vtable);
   } else {
     credentials = grpc::InsecureChannelCredentials();
   }
@@ -143,6 +169,7 @@ GetStub(
         std::make_pair(url, std::make_tuple(1, channel, stub)));
   }
 
+  *stub_channel = channel;
   return stub;
 }
 
@@ -159,6 +186,29 @@ SetTimeout(const uint64_t& client_timeout_ms, grpc::ClientContext* context)
     context->set_deadline(deadline);
   }
 }
+
+/// Append to 'slices' the tag and the length of one element of the
+/// 'raw_input_contents' field of ModelInferRequest. Appending the element
+/// bytes afterwards yields the same wire format as if the element was set in
+/// the message, as serialized repeated fields can be concatenated.
+///
+/// \param byte_size The size of the element in bytes
+/// \param slices The slices to append to
+void
+AppendRawInputContentsPrefix(
+    const size_t byte_size, std::vector<grpc::Slice>* slices)
+{
+  // Length-delimited wire type
+  constexpr uint32_t kTag =
+      (inference::ModelInferRequest::kRawInputContentsFieldNumber << 3) | 2;
+  // Enough for a 32-bit tag and a 64-bit length as varints
+  uint8_t prefix[16];
+  uint8_t* end =
+      google::protobuf::io::CodedOutputStream::WriteTagToArray(kTag, prefix);
+  end = google::protobuf::io::CodedOutputStream::WriteVarint64ToArray(
+      byte_size, end);
+  slices->emplace_back(prefix, end - prefix);
+}
 }  // namespace
 
 //==============================================================================
@@ -168,7 +218,8 @@ class GrpcInferRequest : public InferRequest {
  public:
   GrpcInferRequest(InferenceServerClient::OnCompleteFn callback = nullptr)
       : InferRequest(callback), grpc_status_(),
-        grpc_response_(std::make_shared<inference::ModelInferResponse>())
+        grpc_response_(std::make_shared<inference::ModelInferResponse>()),
+        cancellation_id_(0)
   {
   }
 
@@ -179,6 +230,20 @@ class GrpcInferRequest : public InferRequest {
   grpc::ClientContext grpc_context_;
   grpc::Status grpc_status_;
   std::shared_ptr<inference::ModelInferResponse> grpc_response_;
+  // The serialized request if sent by reference, holds the slices that
+  // reference the input buffers until the request is completed.
+  grpc::ByteBuffer grpc_request_buffer_;
+  // The key to add the response to the response cache with, empty if the
+  // response is not to be cached.
+  std::string response_cache_key_;
+  // The result of a request served from the response cache and the alarm
+  // that delivers it through the completion queue.
+  std::unique_ptr<InferResult> cached_result_;
+  grpc::Alarm cached_result_alarm_;
+  // The cancellation the request is attached to, if any, and the id to
+  // detach from it with.
+  std::shared_ptr<InferCancellation> cancellation_;
+  uint64_t cancellation_id_;
 };
 
 //==============================================================================
@@ -201,6 +266,7 @@ class InferResultGrpc : public InferResult {
       const override;
   Error Datatype(
       const std::string& output_name, std::string* datatype) const override;
+  Error OutputNames(std::vector<std::string>* names) const override;
   Error RawData(
       const std::string& output_name, const uint8_t** buf,
       size_t* byte_size) const override;
@@ -310,6 +376,15 @@ InferResultGrpc::Datatype(
   return Error::Success;
 }
 
+Error
+InferResultGrpc::OutputNames(std::vector<std::string>* names) const
+{
+  names->clear();
+  for (const auto& output : response_->outputs()) {
+    names->push_back(output.name());
+  }
+  return Error::Success;
+}
 
 Error
 InferResultGrpc::RawData(
@@ -492,6 +567,41 @@ InferenceServerGrpcClient::Create(
   return Error::Success;
 }
 
+Error
+InferenceServerGrpcClient::Warmup(
+    const size_t connection_count, const uint64_t timeout_ms)
+{
+  if (connection_count == 0) {
+    return Error::Success;
+  }
+  if (channel_->GetState(true /* try_to_connect */) == GRPC_CHANNEL_READY) {
+    return Error::Success;
+  }
+
+  const gpr_timespec deadline =
+      (timeout_ms == 0)
+          ? gpr_inf_future(GPR_CLOCK_MONOTONIC)
+          : gpr_time_add(
+                gpr_now(GPR_CLOCK_MONOTONIC),
+                gpr_time_from_millis(timeout_ms, GPR_TIMESPAN));
+  if (!channel_->WaitForConnected(deadline)) {
+    return Error(
+        "failed to connect to the server within " +
+        std::to_string(timeout_ms) + " ms");
+  }
+  UpdateConnectionStat(1, use_ssl_ ? 1 : 0);
+  return Error::Success;
+}
+
+void
+InferenceServerGrpcClient::CountConnection()
+{
+  // A request sent on an idle channel makes the channel connect.
+  if (channel_->GetState(false /* try_to_connect */) == GRPC_CHANNEL_IDLE) {
+    UpdateConnectionStat(1, use_ssl_ ? 1 : 0);
+  }
+}
+
 Error
 InferenceServerGrpcClient::IsServerLive(
     bool* live, const Headers& headers, const uint64_t timeout_ms)
@@ -1094,9 +1204,15 @@ InferenceServerGrpcClient::Infer(
 {
   Error err;
 
+  std::string cache_key;
+  if (LookupResponseCache(options, inputs, outputs, &cache_key, result)) {
+    return Error::Success;
+  }
+
   grpc::ClientContext context;
 
   std::shared_ptr<GrpcInferRequest> sync_request(new GrpcInferRequest());
+  CountConnection();
 
   sync_request->Timer().Reset();
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
@@ -1111,14 +1227,39 @@ InferenceServerGrpcClient::Infer(
   }
   context.set_compression_algorithm(compression_algorithm);
 
-  err = PreRunProcessing(options, inputs, outputs);
+  err = PreRunProcessing(options, inputs, outputs, options.zero_copy_input_);
+  if (err.IsOk() && options.zero_copy_input_) {
+    err = SerializeRequestByReference(
+        inputs, &sync_request->grpc_request_buffer_);
+  }
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
   if (!err.IsOk()) {
     return err;
   }
   sync_request->grpc_response_->Clear();
-  sync_request->grpc_status_ = stub_->ModelInfer(
-      &context, infer_request_, sync_request->grpc_response_.get());
+  if (options.zero_copy_input_) {
+    // The generic stub only offers the asynchronous unary call, complete it
+    // on a dedicated completion queue.
+    grpc::CompletionQueue sync_queue;
+    std::unique_ptr<
+        grpc::ClientAsyncResponseReader<inference::ModelInferResponse>>
+        rpc(generic_stub_->PrepareUnaryCall(
+            &context, kModelInferMethod, sync_request->grpc_request_buffer_,
+            &sync_queue));
+    rpc->StartCall();
+    rpc->Finish(
+        sync_request->grpc_response_.get(), &sync_request->grpc_status_,
+        (void*)sync_request.get());
+    void* tag;
+    bool ok;
+    sync_queue.Next(&tag, &ok);
+    sync_queue.Shutdown();
+    while (sync_queue.Next(&tag, &ok)) {
+    }
+  } else {
+    sync_request->grpc_status_ = stub_->ModelInfer(
+        &context, infer_request_, sync_request->grpc_response_.get());
+  }
 
   if (!sync_request->grpc_status_.ok()) {
     err = Error(sync_request->grpc_status_.error_message());
@@ -1141,6 +1282,8 @@ InferenceServerGrpcClient::Infer(
     }
   }
 
+  CacheResponse(cache_key, *result);
+
   return (*result)->RequestStatus();
 }
 
@@ -1162,6 +1305,25 @@ InferenceServerGrpcClient::AsyncInfer(
   GrpcInferRequest* async_request;
   async_request = new GrpcInferRequest(std::move(callback));
 
+  InferResult* cached_result;
+  if (LookupResponseCache(
+          options, inputs, outputs, &async_request->response_cache_key_,
+          &cached_result)) {
+    // Complete the request on the worker thread, as if it was sent to
+    // the server.
+    async_request->cached_result_.reset(cached_result);
+    async_request->cached_result_alarm_.Set(
+        &async_request_completion_queue_, gpr_now(GPR_CLOCK_MONOTONIC),
+        (void*)async_request);
+    return Error::Success;
+  }
+
+  Error err = AcquireAdmission();
+  if (!err.IsOk()) {
+    delete async_request;
+    return err;
+  }
+
   async_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
   async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
   for (const auto& it : headers) {
@@ -1173,9 +1335,14 @@ InferenceServerGrpcClient::AsyncInfer(
   }
   async_request->grpc_context_.set_compression_algorithm(compression_algorithm);
 
-  Error err = PreRunProcessing(options, inputs, outputs);
+  err = PreRunProcessing(options, inputs, outputs, options.zero_copy_input_);
+  if (err.IsOk() && options.zero_copy_input_) {
+    err = SerializeRequestByReference(
+        inputs, &async_request->grpc_request_buffer_);
+  }
   if (!err.IsOk()) {
     delete async_request;
+    ReleaseAdmission(0);
     return err;
   }
 
@@ -1183,9 +1350,28 @@ InferenceServerGrpcClient::AsyncInfer(
 
   std::unique_ptr<
       grpc::ClientAsyncResponseReader<inference::ModelInferResponse>>
-      rpc(stub_->PrepareAsyncModelInfer(
-          &async_request->grpc_context_, infer_request_,
-          &async_request_completion_queue_));
+      rpc;
+  if (options.zero_copy_input_) {
+    rpc = generic_stub_->PrepareUnaryCall(
+        &async_request->grpc_context_, kModelInferMethod,
+        async_request->grpc_request_buffer_, &async_request_completion_queue_);
+  } else {
+    rpc = stub_->PrepareAsyncModelInfer(
+        &async_request->grpc_context_, infer_request_,
+        &async_request_completion_queue_);
+  }
+
+  CountConnection();
+  if (options.cancellation_ != nullptr) {
+    grpc::ClientContext* context = &async_request->grpc_context_;
+    if (options.cancellation_->Attach(
+            [context] { context->TryCancel(); },
+            &async_request->cancellation_id_)) {
+      async_request->cancellation_ = options.cancellation_;
+    } else {
+      context->TryCancel();
+    }
+  }
 
   rpc->StartCall();
 
@@ -1361,6 +1547,8 @@ InferenceServerGrpcClient::StopStream()
     grpc_stream_->WritesDone();
     // The reader thread will drain the stream properly
     stream_worker_.join();
+    // Drop the requests whose final response was not received
+    ongoing_stream_request_timers_.clear();
     if (verbose_) {
       std::cout << "Stopped stream..." << std::endl;
     }
@@ -1374,11 +1562,10 @@ InferenceServerGrpcClient::AsyncStreamInfer(
     const InferOptions& options, const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs)
 {
-  std::unique_ptr<RequestTimers> timer;
+  StreamRequestTimers request_timers;
   if (enable_stream_stats_) {
-    timer.reset(new RequestTimers());
-    timer->CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
-    timer->CaptureTimestamp(RequestTimers::Kind::SEND_START);
+    request_timers.timer.CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
+    request_timers.timer.CaptureTimestamp(RequestTimers::Kind::SEND_START);
   }
 
   Error err = PreRunProcessing(options, inputs, outputs);
@@ -1387,12 +1574,13 @@ InferenceServerGrpcClient::AsyncStreamInfer(
   }
 
   if (enable_stream_stats_) {
-    timer->CaptureTimestamp(RequestTimers::Kind::SEND_END);
+    request_timers.timer.CaptureTimestamp(RequestTimers::Kind::SEND_END);
   }
 
   if (enable_stream_stats_) {
     std::lock_guard<std::mutex> lock(stream_mutex_);
-    ongoing_stream_request_timers_.push(std::move(timer));
+    ongoing_stream_request_timers_[options.request_id_].push_back(
+        std::move(request_timers));
   }
   bool ok = grpc_stream_->Write(infer_request_);
 
@@ -1413,7 +1601,8 @@ InferenceServerGrpcClient::AsyncStreamInfer(
 Error
 InferenceServerGrpcClient::PreRunProcessing(
     const InferOptions& options, const std::vector<InferInput*>& inputs,
-    const std::vector<const InferRequestedOutput*>& outputs)
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const bool skip_input_contents)
 {
   // Populate the request protobuf
   infer_request_.set_model_name(options.model_name_);
@@ -1500,7 +1689,7 @@ InferenceServerGrpcClient::PreRunProcessing(
         (*grpc_input->mutable_parameters())["shared_memory_offset"]
             .set_int64_param(offset);
       }
-    } else {
+    } else if (!skip_input_contents) {
       bool end_of_input = false;
       std::string* raw_contents = infer_request_.add_raw_input_contents();
       size_t content_size;
@@ -1574,6 +1763,48 @@ InferenceServerGrpcClient::PreRunProcessing(
   return Error::Success;
 }
 
+Error
+InferenceServerGrpcClient::SerializeRequestByReference(
+    const std::vector<InferInput*>& inputs, grpc::ByteBuffer* request_buffer)
+{
+  std::vector<grpc::Slice> slices;
+  // The header is small compared to the input contents, copy it.
+  const std::string header = infer_request_.SerializeAsString();
+  slices.emplace_back(header.data(), header.size());
+  size_t request_size = header.size();
+
+  for (const auto input : inputs) {
+    if (input->IsSharedMemory()) {
+      continue;
+    }
+    size_t content_size;
+    input->ByteSize(&content_size);
+    AppendRawInputContentsPrefix(content_size, &slices);
+    request_size += slices.back().size() + content_size;
+
+    input->PrepareForRequest();
+    bool end_of_input = false;
+    while (!end_of_input) {
+      const uint8_t* buf;
+      size_t buf_size;
+      input->GetNext(&buf, &buf_size, &end_of_input);
+      if ((buf != nullptr) && (buf_size != 0)) {
+        slices.emplace_back(buf, buf_size, grpc::Slice::STATIC_SLICE);
+      }
+    }
+  }
+
+  if (request_size > INT_MAX) {
+    return Error(
+        "Request has byte size " + std::to_string(request_size) +
+        " which exceed gRPC's byte size limit " + std::to_string(INT_MAX) +
+        ".");
+  }
+
+  *request_buffer = grpc::ByteBuffer(slices.data(), slices.size());
+  return Error::Success;
+}
+
 void
 InferenceServerGrpcClient::AsyncTransfer()
 {
@@ -1593,8 +1824,14 @@ InferenceServerGrpcClient::AsyncTransfer()
       }
     } else if (raw_async_request == nullptr) {
       fprintf(stderr, "Unexpected null tag received at client.\n");
+    } else if (raw_async_request->cached_result_ != nullptr) {
+      async_request.reset(raw_async_request);
+      async_request->callback_(async_request->cached_result_.release());
     } else {
       async_request.reset(raw_async_request);
+      if (async_request->cancellation_ != nullptr) {
+        async_request->cancellation_->Detach(async_request->cancellation_id_);
+      }
       InferResult* async_result;
       Error err;
       if (!async_request->grpc_status_.ok()) {
@@ -1615,6 +1852,14 @@ InferenceServerGrpcClient::AsyncTransfer()
                     << std::endl;
         }
       }
+      // Release the admission before the callback, see ReleaseAdmission()
+      ReleaseAdmission(
+          async_request->grpc_status_.ok()
+              ? async_request->Timer().Duration(
+                    RequestTimers::Kind::REQUEST_START,
+                    RequestTimers::Kind::REQUEST_END)
+              : 0);
+      CacheResponse(async_request->response_cache_key_, async_result);
       async_request->callback_(async_result);
     }
   }
@@ -1632,30 +1877,62 @@ InferenceServerGrpcClient::AsyncStreamTransfer()
       continue;
     }
 
-    std::unique_ptr<RequestTimers> timer;
+    // Match the response with the oldest request in flight that has the
+    // same id. Only this thread removes requests, and the elements of the
+    // map and of the deques are not moved by insertions, so the timers can
+    // be used without holding the lock.
+    const std::string& request_id = response->infer_response().id();
+    StreamRequestTimers* request_timers = nullptr;
     if (enable_stream_stats_) {
       std::lock_guard<std::mutex> lock(stream_mutex_);
-      if (!ongoing_stream_request_timers_.empty()) {
-        timer = std::move(ongoing_stream_request_timers_.front());
-        ongoing_stream_request_timers_.pop();
+      auto itr = ongoing_stream_request_timers_.find(request_id);
+      if ((itr != ongoing_stream_request_timers_.end()) &&
+          !itr->second.empty()) {
+        request_timers = &itr->second.front();
       }
     }
 
     InferResult* stream_result;
-    // FIXME, DLIS-1263 there is no 1:1 mapping between
-    // requests and response for decoupled streaming case
-    // hence, this method will record incorrect statistics
-    // for decoupled case.
-    if (timer.get() != nullptr) {
-      timer->CaptureTimestamp(RequestTimers::Kind::RECV_START);
+    if (request_timers != nullptr) {
+      request_timers->timer.CaptureTimestamp(RequestTimers::Kind::RECV_START);
     }
     InferResultGrpc::Create(&stream_result, response);
-    if (timer.get() != nullptr) {
-      timer->CaptureTimestamp(RequestTimers::Kind::RECV_END);
-      timer->CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
-      Error err = UpdateInferStat(*timer);
-      if (!err.IsOk()) {
-        std::cerr << "Failed to update context stat: " << err << std::endl;
+    if (request_timers != nullptr) {
+      RequestTimers& timer = request_timers->timer;
+      const uint64_t received_ns =
+          timer.CaptureTimestamp(RequestTimers::Kind::RECV_END);
+      bool is_final_response = true;
+      stream_result->IsFinalResponse(&is_final_response);
+      bool is_null_response = false;
+      stream_result->IsNullResponse(&is_null_response);
+
+      if (!is_null_response) {
+        if (request_timers->last_response_ns == 0) {
+          infer_stat_.first_response_latency.Add(
+              received_ns -
+              timer.Timestamp(RequestTimers::Kind::REQUEST_START));
+        } else {
+          infer_stat_.inter_response_latency.Add(
+              received_ns - request_timers->last_response_ns);
+        }
+        request_timers->last_response_ns = received_ns;
+      }
+
+      if (is_final_response) {
+        timer.CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
+        infer_stat_.final_response_latency.Add(timer.Duration(
+            RequestTimers::Kind::REQUEST_START,
+            RequestTimers::Kind::REQUEST_END));
+        Error err = UpdateInferStat(timer);
+        if (!err.IsOk()) {
+          std::cerr << "Failed to update context stat: " << err << std::endl;
+        }
+        std::lock_guard<std::mutex> lock(stream_mutex_);
+        auto itr = ongoing_stream_request_timers_.find(request_id);
+        itr->second.pop_front();
+        if (itr->second.empty()) {
+          ongoing_stream_request_timers_.erase(itr);
+        }
       }
     }
     if (verbose_) {
@@ -1671,10 +1948,14 @@ InferenceServerGrpcClient::InferenceServerGrpcClient(
     const std::string& url, bool verbose, bool use_ssl,
     const SslOptions& ssl_options, const grpc::ChannelArguments& channel_args,
     const bool use_cached_channel)
-    : InferenceServerClient(verbose)
+    : InferenceServerClient(verbose), use_ssl_(use_ssl)
 {
   stub_ = GetStub(
-      url, use_ssl, ssl_options, channel_args, use_cached_channel, verbose);
+      url, use_ssl, ssl_options, channel_args, use_cached_channel, verbose,
+      &channel_);
+  generic_stub_.reset(new grpc::TemplatedGenericStub<
+                      grpc::ByteBuffer, inference::ModelInferResponse>(
+      channel_));
 }
 
 InferenceServerGrpcClient::~InferenceServerGrpcClient()
@@ -27,9 +27,10 @@
 
 /// \file
 
+#include <grpcpp/generic/generic_stub.h>
 #include <grpcpp/grpcpp.h>
 
-#include <queue>
+#include <deque>
 
 #include "common.h"
 #include "grpc_service.grpc.pb.h"
@@ -107,7 +108,10 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// This is the expected method for most users to create a GRPC client with
   /// the options directly exposed Triton.
   /// \param client Returns a new InferenceServerGrpcClient object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port. A server
+  /// co-located with the client may instead be reached through a Unix
+  /// domain socket by passing the socket path in the format: unix:<path>,
+  /// for example "unix:/tmp/triton.sock".
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
   /// \param use_ssl If true use encrypted channel to the server.
@@ -135,7 +139,10 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// to this method are correct and complete, and are set at the user's
   /// own risk. For example, GRPC KeepAlive options may be specified directly
   /// in this argument rather than passing a KeepAliveOptions object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port. A server
+  /// co-located with the client may instead be reached through a Unix
+  /// domain socket by passing the socket path in the format: unix:<path>,
+  /// for example "unix:/tmp/triton.sock".
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
   /// \param use_ssl If true use encrypted channel to the server.
@@ -152,6 +159,18 @@ class InferenceServerGrpcClient : public InferenceServerClient {
       const SslOptions& ssl_options = SslOptions(),
       const bool use_cached_channel = true);
 
+  /// Connect the channel of the client ahead of the first requests so
+  /// that they don't pay for the TCP, TLS and HTTP/2 setup. The TLS
+  /// sessions are shared by all the channels, so the later channels
+  /// resume a session instead of performing a full handshake.
+  /// \param connection_count The number of connections to establish. The
+  /// client multiplexes all its requests on the single connection of its
+  /// channel, so any value greater than 0 connects the channel.
+  /// \param timeout_ms Optional timeout for establishing the connection,
+  /// in milliseconds. The default value is 0 which means no timeout.
+  /// \return Error object indicating success or failure.
+  Error Warmup(const size_t connection_count, const uint64_t timeout_ms = 0);
+
   /// Contact the inference server and get its liveness.
   /// \param live Returns whether the server is live or not.
   /// \param headers Optional map specifying additional HTTP headers to include
@@ -457,7 +476,10 @@ class InferenceServerGrpcClient : public InferenceServerClient {
       const std::string& name = "", const Headers& headers = Headers(),
       const uint64_t timeout_ms = 0);
 
-  /// Run synchronous inference on server.
+  /// Run synchronous inference on server. If the response cache is
+  /// enabled with SetResponseCache() and holds the response of an
+  /// identical request, the result is returned without contacting the
+  /// server.
   /// \param result Returns the result of inference.
   /// \param options The options for inference request.
   /// \param inputs The vector of InferInput describing the model inputs.
@@ -486,6 +508,11 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// results inside the callback function or deferring it to a different thread
   /// so that the client is unblocked. In order to prevent memory leak, user
   /// must ensure this object gets deleted.
+  /// Requests served from the response cache, see SetResponseCache(), are
+  /// also completed by invoking 'callback' from the client's worker thread.
+  /// If the admission control is enabled, see SetAdmissionControl(), the
+  /// call may wait for a request in flight to complete or return an error
+  /// when the limit of requests in flight is reached.
   /// \param callback The callback function to be invoked on request completion.
   /// \param options The options for inference request.
   /// \param inputs The vector of InferInput describing the model inputs.
@@ -566,9 +593,11 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// response at the stream.
   /// \param enable_stats Indicates whether client library should record the
   /// the client-side statistics for inference requests on stream or not.
-  /// The library does not support client side statistics for decoupled
-  /// streaming. Set this option false when there is no 1:1 mapping between
-  /// request and response on the stream.
+  /// The responses are matched with their requests by request id, so the
+  /// requests of decoupled models must have distinct ids and enable the
+  /// empty final response for the statistics to be recorded correctly.
+  /// The time to the first response, between responses and to the final
+  /// response of each request are recorded in the histograms of InferStat.
   /// \param stream_timeout Specifies the end-to-end timeout for the streaming
   /// connection in microseconds. The default value is 0 which means that
   /// there is no limitation on deadline. The stream will be closed once
@@ -603,16 +632,33 @@ class InferenceServerGrpcClient : public InferenceServerClient {
           std::vector<const InferRequestedOutput*>());
 
  private:
+#ifdef TRITON_CLIENT_BENCHMARK_CLASS
+  // Lets the microbenchmarks time the request preparation directly.
+  friend class TRITON_CLIENT_BENCHMARK_CLASS;
+#endif
+
   InferenceServerGrpcClient(
       const std::string& url, bool verbose, bool use_ssl,
       const SslOptions& ssl_options, const grpc::ChannelArguments& channel_args,
       const bool use_cached_channel);
 
+  // Populate 'infer_request_'. The contents of the inputs are not added
+  // if 'skip_input_contents' is true.
   Error PreRunProcessing(
       const InferOptions& options, const std::vector<InferInput*>& inputs,
-      const std::vector<const InferRequestedOutput*>& outputs);
+      const std::vector<const InferRequestedOutput*>& outputs,
+      const bool skip_input_contents = false);
+  // Serialize 'infer_request_' into 'request_buffer' followed by the contents
+  // of the non-shared-memory 'inputs' as slices referencing the input
+  // buffers. Must be called after PreRunProcessing() with
+  // 'skip_input_contents' set.
+  Error SerializeRequestByReference(
+      const std::vector<InferInput*>& inputs,
+      grpc::ByteBuffer* request_buffer);
   void AsyncTransfer();
   void AsyncStreamTransfer();
+  // Update the connection stat if the channel connects for a request.
+  void CountConnection();
 
   // The producer-consumer queue used to communicate asynchronously with
   // the GRPC runtime.
@@ -627,11 +673,30 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   grpc::ClientContext grpc_context_;
 
   bool enable_stream_stats_;
-  std::queue<std::unique_ptr<RequestTimers>> ongoing_stream_request_timers_;
+  // The timers of a request in flight on the stream.
+  struct StreamRequestTimers {
+    RequestTimers timer;
+    // The time the last response with outputs was received, 0 if none
+    uint64_t last_response_ns{0};
+  };
+  // The requests in flight on the stream, keyed by request id. Requests
+  // sharing an id, including the requests without one, are matched with
+  // their responses in the order they were sent.
+  std::unordered_map<std::string, std::deque<StreamRequestTimers>>
+      ongoing_stream_request_timers_;
   std::mutex stream_mutex_;
 
+  // Whether the channel is encrypted
+  const bool use_ssl_;
+  // The channel of 'stub_' and 'generic_stub_'.
+  std::shared_ptr<grpc::Channel> channel_;
   // GRPC end point.
   std::shared_ptr<inference::GRPCInferenceService::Stub> stub_;
+  // GRPC end point for sending inference requests that are serialized by
+  // SerializeRequestByReference(), shares the channel with 'stub_'.
+  std::unique_ptr<grpc::TemplatedGenericStub<
+      grpc::ByteBuffer, inference::ModelInferResponse>>
+      generic_stub_;
   // request for GRPC call, one request object can be used for multiple calls
   // since it can be overwritten as soon as the GRPC send finishes.
   inference::ModelInferRequest infer_request_;
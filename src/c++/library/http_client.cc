@@ -35,7 +35,9 @@
 #include <cstdint>
 #include <deque>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 #include "common.h"
@@ -44,6 +46,14 @@
 #include <zlib.h>
 #endif
 
+#ifdef TRITON_ENABLE_ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef TRITON_ENABLE_LZ4
+#include <lz4frame.h>
+#endif
+
 extern "C" {
 #include "cencode.h"
 }
@@ -140,14 +150,51 @@ Base64Encode(
   *encoded_size += padding_size;
 }
 
+// Interface of the codecs that compress request bodies. libcurl provides
+// automatic decompression, so only compression is implemented.
+class RequestCodec {
+ public:
+  virtual ~RequestCodec() = default;
+
+  // The value of the 'Content-Encoding' header of a body compressed by
+  // this codec.
+  virtual const char* ContentEncoding() const = 0;
+
+  // Compress the concatenation of the 'source' buffers into
+  // 'compressed_data'. 'level' 0 selects the default level of the codec.
+  virtual Error Compress(
+      const std::deque<std::pair<uint8_t*, size_t>>& source,
+      const size_t source_byte_size, const int level,
+      std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+      const = 0;
+};
+
 #ifdef TRITON_ENABLE_ZLIB
-// libcurl provides automatic decompression, so only implement compression
+class ZlibCodec : public RequestCodec {
+ public:
+  explicit ZlibCodec(const bool gzip) : gzip_(gzip) {}
+
+  const char* ContentEncoding() const override
+  {
+    return gzip_ ? "gzip" : "deflate";
+  }
+
+  Error Compress(
+      const std::deque<std::pair<uint8_t*, size_t>>& source,
+      const size_t source_byte_size, const int level,
+      std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+      const override;
+
+ private:
+  const bool gzip_;
+};
+
 Error
-CompressData(
-    const InferenceServerHttpClient::CompressionType type,
+ZlibCodec::Compress(
     const std::deque<std::pair<uint8_t*, size_t>>& source,
-    const size_t source_byte_size,
+    const size_t source_byte_size, const int level,
     std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+    const
 {
   // nothing to be compressed
   if (source_byte_size == 0) {
@@ -158,24 +205,18 @@ CompressData(
   stream.zalloc = Z_NULL;
   stream.zfree = Z_NULL;
   stream.opaque = Z_NULL;
-  switch (type) {
-    case InferenceServerHttpClient::CompressionType::GZIP:
-      if (deflateInit2(
-              &stream, Z_DEFAULT_COMPRESSION /* level */,
-              Z_DEFLATED /* method */, 15 | 16 /* windowBits */,
-              8 /* memLevel */, Z_DEFAULT_STRATEGY /* strategy */) != Z_OK) {
-        return Error("failed to initialize state for gzip data compression");
-      }
-      break;
-    case InferenceServerHttpClient::CompressionType::DEFLATE: {
-      if (deflateInit(&stream, Z_DEFAULT_COMPRESSION /* level */) != Z_OK) {
-        return Error("failed to initialize state for deflate data compression");
-      }
-      break;
+  const int zlib_level = (level == 0) ? Z_DEFAULT_COMPRESSION : level;
+  if (gzip_) {
+    if (deflateInit2(
+            &stream, zlib_level, Z_DEFLATED /* method */,
+            15 | 16 /* windowBits */, 8 /* memLevel */,
+            Z_DEFAULT_STRATEGY /* strategy */) != Z_OK) {
+      return Error("failed to initialize state for gzip data compression");
+    }
+  } else {
+    if (deflateInit(&stream, zlib_level) != Z_OK) {
+      return Error("failed to initialize state for deflate data compression");
     }
-    case InferenceServerHttpClient::CompressionType::NONE:
-      return Error("can't compress data with NONE type");
-      break;
   }
   // ensure the internal state are cleaned up on function return
   std::unique_ptr<z_stream, decltype(&deflateEnd)> managed_stream(
@@ -219,17 +260,228 @@ CompressData(
   }
   return Error::Success;
 }
-#else
+#endif  // TRITON_ENABLE_ZLIB
+
+#ifdef TRITON_ENABLE_ZSTD
+class ZstdCodec : public RequestCodec {
+ public:
+  const char* ContentEncoding() const override { return "zstd"; }
+
+  Error Compress(
+      const std::deque<std::pair<uint8_t*, size_t>>& source,
+      const size_t source_byte_size, const int level,
+      std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+      const override;
+};
+
 Error
-CompressData(
-    const InferenceServerHttpClient::CompressionType type,
+ZstdCodec::Compress(
     const std::deque<std::pair<uint8_t*, size_t>>& source,
-    const size_t source_byte_size,
+    const size_t source_byte_size, const int level,
     std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+    const
 {
-  return Error("Cannot compress data as ZLIB is not included in this build");
+  // nothing to be compressed
+  if (source_byte_size == 0) {
+    return Error("nothing to be compressed");
+  }
+
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(
+      ZSTD_createCCtx(), ZSTD_freeCCtx);
+  if (context == nullptr) {
+    return Error("failed to initialize state for zstd data compression");
+  }
+  const int zstd_level = (level == 0) ? ZSTD_CLEVEL_DEFAULT : level;
+  if (ZSTD_isError(ZSTD_CCtx_setParameter(
+          context.get(), ZSTD_c_compressionLevel, zstd_level)) ||
+      ZSTD_isError(
+          ZSTD_CCtx_setPledgedSrcSize(context.get(), source_byte_size))) {
+    return Error("failed to initialize state for zstd data compression");
+  }
+
+  // The bound covers the whole frame, so the output never has to grow.
+  const size_t capacity = ZSTD_compressBound(source_byte_size);
+  std::unique_ptr<char[]> reserved_space(new char[capacity]);
+  ZSTD_outBuffer output{reserved_space.get(), capacity, 0};
+  for (auto it = source.begin(); it != source.end(); ++it) {
+    ZSTD_inBuffer input{it->first, it->second, 0};
+    const bool last = (std::next(it) == source.end());
+    size_t remaining;
+    do {
+      remaining = ZSTD_compressStream2(
+          context.get(), &output, &input, last ? ZSTD_e_end : ZSTD_e_continue);
+      if (ZSTD_isError(remaining)) {
+        return Error(
+            std::string("failed to compress data with zstd: ") +
+            ZSTD_getErrorName(remaining));
+      }
+    } while (last ? (remaining != 0) : (input.pos != input.size));
+  }
+  compressed_data->emplace_back(std::move(reserved_space), output.pos);
+  return Error::Success;
+}
+#endif  // TRITON_ENABLE_ZSTD
+
+#ifdef TRITON_ENABLE_LZ4
+class Lz4Codec : public RequestCodec {
+ public:
+  const char* ContentEncoding() const override { return "lz4"; }
+
+  Error Compress(
+      const std::deque<std::pair<uint8_t*, size_t>>& source,
+      const size_t source_byte_size, const int level,
+      std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+      const override;
+};
+
+Error
+Lz4Codec::Compress(
+    const std::deque<std::pair<uint8_t*, size_t>>& source,
+    const size_t source_byte_size, const int level,
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+    const
+{
+  // nothing to be compressed
+  if (source_byte_size == 0) {
+    return Error("nothing to be compressed");
+  }
+
+  LZ4F_cctx* raw_context = nullptr;
+  if (LZ4F_isError(
+          LZ4F_createCompressionContext(&raw_context, LZ4F_VERSION))) {
+    return Error("failed to initialize state for lz4 data compression");
+  }
+  std::unique_ptr<LZ4F_cctx, decltype(&LZ4F_freeCompressionContext)> context(
+      raw_context, LZ4F_freeCompressionContext);
+
+  LZ4F_preferences_t preferences{};
+  preferences.compressionLevel = level;
+  preferences.frameInfo.contentSize = source_byte_size;
+
+  // Reserve the worst case of every update so the output never has to grow.
+  size_t capacity = LZ4F_HEADER_SIZE_MAX;
+  for (const auto& buffer : source) {
+    capacity += LZ4F_compressBound(buffer.second, &preferences);
+  }
+  std::unique_ptr<char[]> reserved_space(new char[capacity]);
+  size_t size = LZ4F_compressBegin(
+      context.get(), reserved_space.get(), capacity, &preferences);
+  if (LZ4F_isError(size)) {
+    return Error(
+        std::string("failed to compress data with lz4: ") +
+        LZ4F_getErrorName(size));
+  }
+  for (const auto& buffer : source) {
+    const size_t written = LZ4F_compressUpdate(
+        context.get(), reserved_space.get() + size, capacity - size,
+        buffer.first, buffer.second, nullptr);
+    if (LZ4F_isError(written)) {
+      return Error(
+          std::string("failed to compress data with lz4: ") +
+          LZ4F_getErrorName(written));
+    }
+    size += written;
+  }
+  const size_t written = LZ4F_compressEnd(
+      context.get(), reserved_space.get() + size, capacity - size, nullptr);
+  if (LZ4F_isError(written)) {
+    return Error(
+        std::string("failed to compress data with lz4: ") +
+        LZ4F_getErrorName(written));
+  }
+  compressed_data->emplace_back(std::move(reserved_space), size + written);
+  return Error::Success;
 }
+#endif  // TRITON_ENABLE_LZ4
+
+// Return the codec of 'type', or an error if the codec is not included in
+// the client build.
+Error
+GetRequestCodec(
+    const InferenceServerHttpClient::CompressionType type,
+    const RequestCodec** codec)
+{
+  switch (type) {
+    case InferenceServerHttpClient::CompressionType::DEFLATE: {
+#ifdef TRITON_ENABLE_ZLIB
+      static const ZlibCodec deflate_codec(false /* gzip */);
+      *codec = &deflate_codec;
+      return Error::Success;
+#else
+      return Error(
+          "Compression type needs to be CompressionType::NONE since ZLIB is "
+          "not included in client build");
+#endif
+    }
+    case InferenceServerHttpClient::CompressionType::GZIP: {
+#ifdef TRITON_ENABLE_ZLIB
+      static const ZlibCodec gzip_codec(true /* gzip */);
+      *codec = &gzip_codec;
+      return Error::Success;
+#else
+      return Error(
+          "Compression type needs to be CompressionType::NONE since ZLIB is "
+          "not included in client build");
+#endif
+    }
+    case InferenceServerHttpClient::CompressionType::ZSTD: {
+#ifdef TRITON_ENABLE_ZSTD
+      static const ZstdCodec zstd_codec;
+      *codec = &zstd_codec;
+      return Error::Success;
+#else
+      return Error(
+          "Compression type can't be CompressionType::ZSTD since ZSTD is not "
+          "included in client build");
+#endif
+    }
+    case InferenceServerHttpClient::CompressionType::LZ4: {
+#ifdef TRITON_ENABLE_LZ4
+      static const Lz4Codec lz4_codec;
+      *codec = &lz4_codec;
+      return Error::Success;
+#else
+      return Error(
+          "Compression type can't be CompressionType::LZ4 since LZ4 is not "
+          "included in client build");
 #endif
+    }
+    case InferenceServerHttpClient::CompressionType::NONE:
+      break;
+  }
+  return Error("can't compress data with NONE type");
+}
+
+// Prefix of a server URL that names a Unix domain socket, for example
+// "unix:/tmp/triton.sock" or "unix:///tmp/triton.sock".
+constexpr char kUnixSocketScheme[] = "unix:";
+constexpr size_t kUnixSocketSchemeLength = sizeof(kUnixSocketScheme) - 1;
+
+bool
+IsUnixSocketUrl(const std::string& url)
+{
+  return url.compare(0, kUnixSocketSchemeLength, kUnixSocketScheme) == 0;
+}
+
+// Return the filesystem path of a Unix domain socket URL.
+std::string
+UnixSocketPath(const std::string& url)
+{
+  std::string path = url.substr(kUnixSocketSchemeLength);
+  if (path.compare(0, 2, "//") == 0) {
+    path.erase(0, 2);
+  }
+  return path;
+}
+
+// The URL that requests are made against. The host of a Unix domain
+// socket URL is only used for the 'Host' header, the connection itself
+// is made to the socket.
+std::string
+RequestBaseUrl(const std::string& url)
+{
+  return IsUnixSocketUrl(url) ? "http://localhost" : url;
+}
 
 Error
 ParseSslCertType(
@@ -300,6 +552,379 @@ SetSSLCurlOptions(CURL** curl, const HttpSslOptions& ssl_options)
 
 }  // namespace
 
+//==============================================================================
+// The data shared by all the curl handles of a client. Sharing the TLS
+// sessions lets a new connection resume a session established by another
+// handle, which saves a full handshake, and sharing the DNS cache saves the
+// name resolution. The connection cache is not shared as libcurl doesn't
+// support using it from concurrent threads.
+class CurlShare {
+ public:
+  CurlShare() : share_(curl_share_init())
+  {
+    if (share_ != nullptr) {
+      curl_share_setopt(share_, CURLSHOPT_LOCKFUNC, Lock);
+      curl_share_setopt(share_, CURLSHOPT_UNLOCKFUNC, Unlock);
+      curl_share_setopt(share_, CURLSHOPT_USERDATA, this);
+      curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+      curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    }
+  }
+  ~CurlShare()
+  {
+    if (share_ != nullptr) {
+      curl_share_cleanup(share_);
+    }
+  }
+
+  // Make 'curl' use the shared data.
+  void Attach(CURL* curl) const
+  {
+    if (share_ != nullptr) {
+      curl_easy_setopt(curl, CURLOPT_SHARE, share_);
+    }
+  }
+
+ private:
+  static void Lock(
+      CURL* curl, curl_lock_data data, curl_lock_access access, void* userp)
+  {
+    reinterpret_cast<CurlShare*>(userp)->mutexes_[data].lock();
+  }
+  static void Unlock(CURL* curl, curl_lock_data data, void* userp)
+  {
+    reinterpret_cast<CurlShare*>(userp)->mutexes_[data].unlock();
+  }
+
+  CURLSH* share_;
+  std::mutex mutexes_[CURL_LOCK_DATA_LAST];
+};
+
+//==============================================================================
+// Cache of serialized inference request headers. Requests that share the
+// same parameters and input/output descriptors produce JSON headers that
+// only differ in the request id and the sequence fields, which always lead
+// the serialized header. The cache keeps the remaining part of the header
+// so that it can be replayed without building the JSON DOM again.
+class HttpRequestTemplateCache {
+ public:
+  // Write into 'key' the fingerprint of the structure of the request.
+  // Returns false if the request can't be served from a template, that is
+  // when the header embeds the tensor data of non-binary inputs.
+  static bool Fingerprint(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      std::string* key);
+
+  // Append to 'header' the leading, per-request fields of the header.
+  static void SerializeVariableFields(
+      const InferOptions& options, std::string* header);
+
+  // Write into 'header' the complete header for 'options' if a template is
+  // recorded for 'key'. Returns false if there is no such template.
+  bool Lookup(
+      const std::string& key, const InferOptions& options,
+      std::string* header);
+
+  // Record the template of 'header', which was generated for 'options'.
+  void Insert(
+      const std::string& key, const InferOptions& options,
+      const std::string& header);
+
+ private:
+  // Upper bound on the number of templates kept, the cache is reset once
+  // exceeded as steady-state workloads only use a handful of request shapes.
+  static constexpr size_t kMaxTemplateCount = 64;
+
+  static void AppendKeyField(const std::string& field, std::string* key);
+  static void AppendKeyField(const uint64_t field, std::string* key);
+  static void AppendJsonString(const std::string& str, std::string* json);
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::string> templates_;
+};
+
+bool
+HttpRequestTemplateCache::Fingerprint(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs, std::string* key)
+{
+  key->clear();
+
+  // Only the kind of the sequence id matters, the values are patched in
+  uint64_t sequence_kind = 0;
+  if (options.sequence_id_ != 0) {
+    sequence_kind = 1;
+  } else if (options.sequence_id_str_ != "") {
+    sequence_kind = 2;
+  }
+  AppendKeyField(sequence_kind, key);
+  AppendKeyField(options.priority_, key);
+  AppendKeyField(options.server_timeout_, key);
+  AppendKeyField(options.request_parameters.size(), key);
+  for (const auto& param : options.request_parameters) {
+    AppendKeyField(param.first, key);
+    AppendKeyField(param.second.type, key);
+    AppendKeyField(param.second.value, key);
+  }
+
+  AppendKeyField(inputs.size(), key);
+  for (const auto io : inputs) {
+    AppendKeyField(io->Name(), key);
+    AppendKeyField(io->Datatype(), key);
+    AppendKeyField(io->Shape().size(), key);
+    for (const auto dim : io->Shape()) {
+      AppendKeyField(static_cast<uint64_t>(dim), key);
+    }
+    if (io->IsSharedMemory()) {
+      std::string region_name;
+      size_t offset;
+      size_t byte_size;
+      if (!io->SharedMemoryInfo(&region_name, &byte_size, &offset).IsOk()) {
+        return false;
+      }
+      AppendKeyField(1, key);
+      AppendKeyField(region_name, key);
+      AppendKeyField(byte_size, key);
+      AppendKeyField(offset, key);
+    } else if (io->BinaryData()) {
+      size_t byte_size;
+      if (!io->ByteSize(&byte_size).IsOk()) {
+        return false;
+      }
+      AppendKeyField(2, key);
+      AppendKeyField(byte_size, key);
+    } else {
+      return false;
+    }
+  }
+
+  AppendKeyField(outputs.size(), key);
+  for (const auto io : outputs) {
+    AppendKeyField(io->Name(), key);
+    AppendKeyField(io->ClassificationCount(), key);
+    if (io->IsSharedMemory()) {
+      std::string region_name;
+      size_t offset;
+      size_t byte_size;
+      if (!io->SharedMemoryInfo(&region_name, &byte_size, &offset).IsOk()) {
+        return false;
+      }
+      AppendKeyField(1, key);
+      AppendKeyField(region_name, key);
+      AppendKeyField(byte_size, key);
+      AppendKeyField(offset, key);
+    } else {
+      AppendKeyField(io->BinaryData() ? 2 : 3, key);
+    }
+  }
+
+  return true;
+}
+
+void
+HttpRequestTemplateCache::SerializeVariableFields(
+    const InferOptions& options, std::string* header)
+{
+  // Must match the order in which HttpInferRequest::PrepareRequestJson()
+  // adds these fields.
+  header->append("{\"id\":");
+  AppendJsonString(options.request_id_, header);
+  if ((options.sequence_id_ != 0) || (options.sequence_id_str_ != "")) {
+    header->append(",\"parameters\":{\"sequence_id\":");
+    if (options.sequence_id_ != 0) {
+      header->append(std::to_string(options.sequence_id_));
+    } else {
+      AppendJsonString(options.sequence_id_str_, header);
+    }
+    header->append(",\"sequence_start\":");
+    header->append(options.sequence_start_ ? "true" : "false");
+    header->append(",\"sequence_end\":");
+    header->append(options.sequence_end_ ? "true" : "false");
+  }
+}
+
+bool
+HttpRequestTemplateCache::Lookup(
+    const std::string& key, const InferOptions& options, std::string* header)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = templates_.find(key);
+  if (it == templates_.end()) {
+    return false;
+  }
+
+  header->clear();
+  SerializeVariableFields(options, header);
+  header->append(it->second);
+  return true;
+}
+
+void
+HttpRequestTemplateCache::Insert(
+    const std::string& key, const InferOptions& options,
+    const std::string& header)
+{
+  std::string variable_fields;
+  SerializeVariableFields(options, &variable_fields);
+  // Only record the template if the leading fields are serialized exactly
+  // as expected, otherwise replaying it would produce a different header.
+  if (header.compare(0, variable_fields.size(), variable_fields) != 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (templates_.size() >= kMaxTemplateCount) {
+    templates_.clear();
+  }
+  templates_[key] = header.substr(variable_fields.size());
+}
+
+void
+HttpRequestTemplateCache::AppendKeyField(
+    const std::string& field, std::string* key)
+{
+  // Length-prefix the field so that different descriptors can't collide
+  AppendKeyField(field.size(), key);
+  key->append(field);
+}
+
+void
+HttpRequestTemplateCache::AppendKeyField(const uint64_t field, std::string* key)
+{
+  key->append(reinterpret_cast<const char*>(&field), sizeof(field));
+}
+
+void
+HttpRequestTemplateCache::AppendJsonString(
+    const std::string& str, std::string* json)
+{
+  static const char kHexDigits[] = "0123456789ABCDEF";
+  json->push_back('"');
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        json->append("\\\"");
+        break;
+      case '\\':
+        json->append("\\\\");
+        break;
+      case '\b':
+        json->append("\\b");
+        break;
+      case '\f':
+        json->append("\\f");
+        break;
+      case '\n':
+        json->append("\\n");
+        break;
+      case '\r':
+        json->append("\\r");
+        break;
+      case '\t':
+        json->append("\\t");
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          json->append("\\u00");
+          json->push_back(kHexDigits[(c >> 4) & 0xF]);
+          json->push_back(kHexDigits[c & 0xF]);
+        } else {
+          json->push_back(c);
+        }
+        break;
+    }
+  }
+  json->push_back('"');
+}
+
+//==============================================================================
+// Decides whether a request body is worth compressing according to the
+// client's HttpCompressionOptions, and compresses it if so. The ratio
+// achieved by each compression type is sampled periodically so that
+// bodies which don't compress well are sent as they are.
+class RequestCompressor {
+ public:
+  explicit RequestCompressor(const HttpCompressionOptions& options)
+      : options_(options)
+  {
+  }
+
+  // Compress the concatenation of the 'source' buffers with 'type' into
+  // 'compressed_data' and set 'content_encoding' to the matching header
+  // value. 'content_encoding' is set to nullptr and 'compressed_data' is
+  // left untouched if the body is to be sent uncompressed.
+  Error Compress(
+      const InferenceServerHttpClient::CompressionType type,
+      const std::deque<std::pair<uint8_t*, size_t>>& source,
+      const size_t source_byte_size,
+      std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data,
+      const char** content_encoding);
+
+ private:
+  struct RatioSample {
+    // Number of requests seen since the first one.
+    uint64_t request_count_{0};
+    // Whether the last sampled ratio was below the minimum ratio.
+    bool below_min_ratio_{false};
+  };
+
+  const HttpCompressionOptions options_;
+  std::mutex mutex_;
+  std::map<InferenceServerHttpClient::CompressionType, RatioSample> samples_;
+};
+
+Error
+RequestCompressor::Compress(
+    const InferenceServerHttpClient::CompressionType type,
+    const std::deque<std::pair<uint8_t*, size_t>>& source,
+    const size_t source_byte_size,
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data,
+    const char** content_encoding)
+{
+  *content_encoding = nullptr;
+
+  const RequestCodec* codec;
+  Error err = GetRequestCodec(type, &codec);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  if ((source_byte_size == 0) || (source_byte_size < options_.min_byte_size)) {
+    return Error::Success;
+  }
+
+  bool sample = false;
+  if (options_.min_ratio > 0) {
+    const uint64_t interval = std::max(options_.sample_interval, 1u);
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto& state = samples_[type];
+    sample = ((state.request_count_++ % interval) == 0);
+    if (!sample && state.below_min_ratio_) {
+      return Error::Success;
+    }
+  }
+
+  err = codec->Compress(
+      source, source_byte_size, options_.level, compressed_data);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  if (sample) {
+    size_t compressed_byte_size = 0;
+    for (const auto& data : *compressed_data) {
+      compressed_byte_size += data.second;
+    }
+    std::lock_guard<std::mutex> lk(mutex_);
+    samples_[type].below_min_ratio_ =
+        (source_byte_size < options_.min_ratio * compressed_byte_size);
+  }
+
+  *content_encoding = codec->ContentEncoding();
+  return Error::Success;
+}
+
 //==============================================================================
 
 class HttpInferRequest : public InferRequest {
@@ -309,10 +934,12 @@ class HttpInferRequest : public InferRequest {
       const bool verbose = false);
   ~HttpInferRequest();
 
-  // Initialize the request for HTTP transfer. */
+  // Initialize the request for HTTP transfer. If 'template_cache' is
+  // provided, the request header is replayed from it when possible.
   Error InitializeRequest(
       const InferOptions& options, const std::vector<InferInput*>& inputs,
-      const std::vector<const InferRequestedOutput*>& outputs);
+      const std::vector<const InferRequestedOutput*>& outputs,
+      HttpRequestTemplateCache* template_cache = nullptr);
 
   // Adds the input data to be delivered to the server
   Error AddInput(uint8_t* buf, size_t byte_size);
@@ -321,7 +948,12 @@ class HttpInferRequest : public InferRequest {
   // actual amount copied in 'input_bytes'.
   Error GetNextInput(uint8_t* buf, size_t size, size_t* input_bytes);
 
-  Error CompressInput(const InferenceServerHttpClient::CompressionType type);
+  // Compress the input data with 'type' if 'compressor' decides it is
+  // worth it, 'content_encoding' is set to nullptr otherwise.
+  Error CompressInput(
+      RequestCompressor* compressor,
+      const InferenceServerHttpClient::CompressionType type,
+      const char** content_encoding);
 
  private:
   friend class InferenceServerHttpClient;
@@ -332,6 +964,18 @@ class HttpInferRequest : public InferRequest {
       const std::vector<const InferRequestedOutput*>& outputs,
       triton::common::TritonJson::Value* request_json);
 
+  // The serialized request header.
+  const char* RequestJsonBase() const
+  {
+    return from_template_ ? templated_request_json_.c_str()
+                          : request_json_.Base();
+  }
+  size_t RequestJsonSize() const
+  {
+    return from_template_ ? templated_request_json_.size()
+                          : request_json_.Size();
+  }
+
  protected:
   virtual Error ConvertBinaryInputsToJSON(
       InferInput& input, triton::common::TritonJson::Value& data_json) const;
@@ -352,6 +996,11 @@ class HttpInferRequest : public InferRequest {
 
   triton::common::TritonJson::WriteBuffer request_json_;
 
+  // The request header when it is replayed from a template, in which case
+  // 'request_json_' is not used.
+  std::string templated_request_json_;
+  bool from_template_;
+
   // Buffer that accumulates the response body.
   std::unique_ptr<std::string> infer_response_buffer_;
 
@@ -362,13 +1011,23 @@ class HttpInferRequest : public InferRequest {
   std::vector<std::pair<std::unique_ptr<char[]>, size_t>> compressed_data_;
 
   size_t response_json_size_;
+
+  // The key to add the response to the response cache with, empty if the
+  // response is not to be cached.
+  std::string response_cache_key_;
+
+  // The cancellation the request is attached to, if any, and the id to
+  // detach from it with.
+  std::shared_ptr<InferCancellation> cancellation_;
+  uint64_t cancellation_id_;
 };
 
 
 HttpInferRequest::HttpInferRequest(
     InferenceServerClient::OnCompleteFn callback, const bool verbose)
     : InferRequest(callback, verbose), header_list_(nullptr),
-      total_input_byte_size_(0), response_json_size_(0)
+      total_input_byte_size_(0), from_template_(false), response_json_size_(0),
+      cancellation_id_(0)
 {
 }
 
@@ -383,24 +1042,40 @@ HttpInferRequest::~HttpInferRequest()
 Error
 HttpInferRequest::InitializeRequest(
     const InferOptions& options, const std::vector<InferInput*>& inputs,
-    const std::vector<const InferRequestedOutput*>& outputs)
+    const std::vector<const InferRequestedOutput*>& outputs,
+    HttpRequestTemplateCache* template_cache)
 {
   data_buffers_ = {};
   total_input_byte_size_ = 0;
   http_code_ = 400;
 
-  triton::common::TritonJson::Value request_json(
-      triton::common::TritonJson::ValueType::OBJECT);
-  Error err = PrepareRequestJson(options, inputs, outputs, &request_json);
-  if (!err.IsOk()) {
-    return err;
-  }
+  std::string template_key;
+  const bool use_template =
+      (template_cache != nullptr) &&
+      HttpRequestTemplateCache::Fingerprint(
+          options, inputs, outputs, &template_key);
+  from_template_ =
+      use_template &&
+      template_cache->Lookup(template_key, options, &templated_request_json_);
+
+  if (!from_template_) {
+    triton::common::TritonJson::Value request_json(
+        triton::common::TritonJson::ValueType::OBJECT);
+    Error err = PrepareRequestJson(options, inputs, outputs, &request_json);
+    if (!err.IsOk()) {
+      return err;
+    }
+
+    request_json_.Clear();
+    request_json.Write(&request_json_);
 
-  request_json_.Clear();
-  request_json.Write(&request_json_);
+    if (use_template) {
+      template_cache->Insert(template_key, options, request_json_.Contents());
+    }
+  }
 
   // Add the buffer holding the json to be delivered first
-  AddInput((uint8_t*)request_json_.Base(), request_json_.Size());
+  AddInput((uint8_t*)RequestJsonBase(), RequestJsonSize());
 
   // Prepare buffer to record the response
   infer_response_buffer_.reset(new std::string());
@@ -718,11 +1393,14 @@ HttpInferRequest::GetNextInput(uint8_t* buf, size_t size, size_t* input_bytes)
 
 Error
 HttpInferRequest::CompressInput(
-    const InferenceServerHttpClient::CompressionType type)
+    RequestCompressor* compressor,
+    const InferenceServerHttpClient::CompressionType type,
+    const char** content_encoding)
 {
-  auto err = CompressData(
-      type, data_buffers_, total_input_byte_size_, &compressed_data_);
-  if (!err.IsOk()) {
+  auto err = compressor->Compress(
+      type, data_buffers_, total_input_byte_size_, &compressed_data_,
+      content_encoding);
+  if (!err.IsOk() || (*content_encoding == nullptr)) {
     return err;
   }
   data_buffers_.clear();
@@ -753,6 +1431,7 @@ class InferResultHttp : public InferResult {
       const override;
   Error Datatype(
       const std::string& output_name, std::string* datatype) const override;
+  Error OutputNames(std::vector<std::string>* names) const override;
   Error RawData(
       const std::string& output_name, const uint8_t** buf,
       size_t* byte_size) const override;
@@ -940,6 +1619,21 @@ InferResultHttp::Datatype(
   return Error::Success;
 }
 
+Error
+InferResultHttp::OutputNames(std::vector<std::string>* names) const
+{
+  if (!status_.IsOk()) {
+    return status_;
+  }
+
+  names->clear();
+  for (const auto& output : output_name_to_result_map_) {
+    names->push_back(output.first);
+  }
+
+  return Error::Success;
+}
+
 Error
 InferResultHttp::RawData(
     const std::string& output_name, const uint8_t** buf,
@@ -1312,7 +2006,7 @@ InferenceServerHttpClient::GenerateRequestBody(
     }
   }
 
-  *header_length = infer_request->request_json_.Size();
+  *header_length = infer_request->RequestJsonSize();
   *request_body = std::vector<char>(infer_request->total_input_byte_size_);
   size_t remaining_bytes = infer_request->total_input_byte_size_;
   size_t actual_copied_bytes = 0;
@@ -1354,18 +2048,25 @@ Error
 InferenceServerHttpClient::Create(
     std::unique_ptr<InferenceServerHttpClient>* client,
     const std::string& server_url, bool verbose,
-    const HttpSslOptions& ssl_options)
+    const HttpSslOptions& ssl_options,
+    const HttpCompressionOptions& compression_options)
 {
-  client->reset(
-      new InferenceServerHttpClient(server_url, verbose, ssl_options));
+  client->reset(new InferenceServerHttpClient(
+      server_url, verbose, ssl_options, compression_options));
   return Error::Success;
 }
 
 InferenceServerHttpClient::InferenceServerHttpClient(
-    const std::string& url, bool verbose, const HttpSslOptions& ssl_options)
-    : InferenceServerClient(verbose), url_(url), ssl_options_(ssl_options),
+    const std::string& url, bool verbose, const HttpSslOptions& ssl_options,
+    const HttpCompressionOptions& compression_options)
+    : InferenceServerClient(verbose), url_(RequestBaseUrl(url)),
+      unix_socket_path_(IsUnixSocketUrl(url) ? UnixSocketPath(url) : ""),
+      ssl_options_(ssl_options),
       easy_handle_(reinterpret_cast<void*>(curl_easy_init())),
-      multi_handle_(curl_multi_init())
+      multi_handle_(curl_multi_init()),
+      request_template_cache_(new HttpRequestTemplateCache()),
+      request_compressor_(new RequestCompressor(compression_options)),
+      curl_share_(new CurlShare())
 {
 }
 
@@ -1376,16 +2077,25 @@ InferenceServerHttpClient::~InferenceServerHttpClient()
   // thread not joinable if AsyncInfer() is not called
   // (it is default constructed thread before the first AsyncInfer() call)
   if (worker_.joinable()) {
+    curl_multi_wakeup(multi_handle_);
     cv_.notify_all();
     worker_.join();
   }
 
+  for (auto& cached_request : cached_async_requests_) {
+    delete cached_request.second;
+  }
+
   if (easy_handle_ != nullptr) {
     curl_easy_cleanup(reinterpret_cast<CURL*>(easy_handle_));
   }
 
   if (multi_handle_ != nullptr) {
     for (auto& request : ongoing_async_requests_) {
+      if (request.second->cancellation_ != nullptr) {
+        request.second->cancellation_->Detach(
+            request.second->cancellation_id_);
+      }
       CURL* easy_handle = reinterpret_cast<CURL*>(request.first);
       curl_multi_remove_handle(multi_handle_, easy_handle);
       curl_easy_cleanup(easy_handle);
@@ -1394,6 +2104,123 @@ InferenceServerHttpClient::~InferenceServerHttpClient()
   }
 }
 
+Error
+InferenceServerHttpClient::Warmup(
+    const size_t connection_count, const uint64_t timeout_ms)
+{
+  if (!CurlGlobal::Get().Status().IsOk()) {
+    return CurlGlobal::Get().Status();
+  }
+  if (!multi_handle_) {
+    return Error("failed to start HTTP asynchronous client");
+  }
+
+  // The connections are established by concurrent transfers on the multi
+  // handle of the asynchronous requests so that they stay in its
+  // connection cache. The worker holds 'mutex_' while waiting for
+  // transfers so wake it up before acquiring it.
+  curl_multi_wakeup(multi_handle_);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!ongoing_async_requests_.empty()) {
+    return Error(
+        "failed to warm up connections while asynchronous requests are in "
+        "flight");
+  }
+
+  const std::string request_uri(url_ + "/v2/health/live");
+  std::vector<std::string> responses(connection_count);
+  std::vector<CURL*> easy_handles;
+  // Remove the transfers that are not completed when returning, the multi
+  // handle must only hold the asynchronous requests.
+  auto cleanup = [this, &easy_handles] {
+    for (CURL* curl : easy_handles) {
+      curl_multi_remove_handle(multi_handle_, curl);
+      curl_easy_cleanup(curl);
+    }
+  };
+  for (size_t i = 0; i < connection_count; ++i) {
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+      cleanup();
+      return Error("failed to initialize HTTP client");
+    }
+    curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
+    if (!unix_socket_path_.empty()) {
+      curl_easy_setopt(
+          curl, CURLOPT_UNIX_SOCKET_PATH, unix_socket_path_.c_str());
+    }
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
+    curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+    if (timeout_ms != 0) {
+      curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeout_ms);
+    }
+    if (verbose_) {
+      curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
+    }
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, ResponseHandler);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responses[i]);
+    Error err = SetSSLCurlOptions(&curl, ssl_options_);
+    if (!err.IsOk()) {
+      curl_easy_cleanup(curl);
+      cleanup();
+      return err;
+    }
+    curl_share_->Attach(curl);
+    curl_multi_add_handle(multi_handle_, curl);
+    easy_handles.push_back(curl);
+  }
+
+  Error err;
+  int running_count = 0;
+  do {
+    CURLMcode mc = curl_multi_perform(multi_handle_, &running_count);
+    if ((mc == CURLM_OK) && (running_count != 0)) {
+      int numfds;
+      mc = curl_multi_poll(multi_handle_, NULL, 0, INT_MAX, &numfds);
+    }
+    if (mc != CURLM_OK) {
+      err = Error(
+          "HTTP client failed: " + std::string(curl_multi_strerror(mc)));
+    }
+
+    int place_holder = 0;
+    CURLMsg* msg = nullptr;
+    while ((msg = curl_multi_info_read(multi_handle_, &place_holder))) {
+      if (msg->data.result != CURLE_OK) {
+        err = Error(
+            "HTTP client failed: " +
+            std::string(curl_easy_strerror(msg->data.result)));
+      } else {
+        CountConnections(msg->easy_handle);
+      }
+      easy_handles.erase(std::remove(
+          easy_handles.begin(), easy_handles.end(), msg->easy_handle));
+      curl_multi_remove_handle(multi_handle_, msg->easy_handle);
+      curl_easy_cleanup(msg->easy_handle);
+    }
+  } while ((running_count != 0) && err.IsOk());
+
+  cleanup();
+  return err;
+}
+
+void
+InferenceServerHttpClient::CountConnections(void* curl)
+{
+  long connection_count = 0;
+  curl_easy_getinfo(
+      reinterpret_cast<CURL*>(curl), CURLINFO_NUM_CONNECTS, &connection_count);
+  // The time of the TLS handshake is only set when a handshake was
+  // performed on a new connection, it is 0 for plain HTTP.
+  curl_off_t appconnect_time_us = 0;
+  if (connection_count > 0) {
+    curl_easy_getinfo(
+        reinterpret_cast<CURL*>(curl), CURLINFO_APPCONNECT_TIME_T,
+        &appconnect_time_us);
+  }
+  UpdateConnectionStat(connection_count, (appconnect_time_us > 0) ? 1 : 0);
+}
+
 Error
 InferenceServerHttpClient::IsServerLive(
     bool* live, const Headers& headers, const Parameters& query_params)
@@ -1778,6 +2605,11 @@ InferenceServerHttpClient::Infer(
 {
   Error err;
 
+  std::string cache_key;
+  if (LookupResponseCache(options, inputs, outputs, &cache_key, result)) {
+    return Error::Success;
+  }
+
   std::string request_uri(url_ + "/v2/models/" + options.model_name_);
   if (!options.model_version_.empty()) {
     request_uri = request_uri + "/versions/" + options.model_version_;
@@ -1825,6 +2657,7 @@ InferenceServerHttpClient::Infer(
   } else {  // Success
     curl_easy_getinfo(
         easy_handle_, CURLINFO_RESPONSE_CODE, &sync_request->http_code_);
+    CountConnections(easy_handle_);
   }
 
   InferResultHttp::Create(result, sync_request);
@@ -1836,6 +2669,8 @@ InferenceServerHttpClient::Infer(
     std::cerr << "Failed to update context stat: " << err << std::endl;
   }
 
+  CacheResponse(cache_key, *result);
+
   err = (*result)->RequestStatus();
 
   return err;
@@ -1862,6 +2697,30 @@ InferenceServerHttpClient::AsyncInfer(
     worker_ = std::thread(&InferenceServerHttpClient::AsyncTransfer, this);
   }
 
+  std::string cache_key;
+  InferResult* cached_result;
+  if (LookupResponseCache(
+          options, inputs, outputs, &cache_key, &cached_result)) {
+    // Complete the request on the worker thread, as if it was sent to
+    // the server. The worker holds 'mutex_' while waiting for transfers
+    // so wake it up before acquiring it.
+    {
+      std::lock_guard<std::mutex> lock(cached_async_requests_mutex_);
+      cached_async_requests_.emplace_back(std::move(callback), cached_result);
+    }
+    curl_multi_wakeup(multi_handle_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+    }
+    cv_.notify_all();
+    return Error::Success;
+  }
+
+  Error err = AcquireAdmission();
+  if (!err.IsOk()) {
+    return err;
+  }
+
   std::string request_uri(url_ + "/v2/models/" + options.model_name_);
   if (!options.model_version_.empty()) {
     request_uri = request_uri + "/versions/" + options.model_version_;
@@ -1871,19 +2730,24 @@ InferenceServerHttpClient::AsyncInfer(
   HttpInferRequest* raw_async_request =
       new HttpInferRequest(std::move(callback), verbose_);
   async_request.reset(raw_async_request);
+  async_request->response_cache_key_ = std::move(cache_key);
 
   async_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
 
   CURL* multi_easy_handle = curl_easy_init();
-  Error err = PreRunProcessing(
+  err = PreRunProcessing(
       reinterpret_cast<void*>(multi_easy_handle), request_uri, options, inputs,
       outputs, headers, query_params, request_compression_algorithm,
       response_compression_algorithm, async_request);
   if (!err.IsOk()) {
     curl_easy_cleanup(multi_easy_handle);
+    ReleaseAdmission(0);
     return err;
   }
 
+  // The worker holds 'mutex_' while waiting for transfers so wake it up
+  // before acquiring it.
+  curl_multi_wakeup(multi_handle_);
   {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -1891,6 +2755,7 @@ InferenceServerHttpClient::AsyncInfer(
         reinterpret_cast<uintptr_t>(multi_easy_handle), async_request));
     if (!insert_result.second) {
       curl_easy_cleanup(multi_easy_handle);
+      ReleaseAdmission(0);
       return Error("Failed to insert new asynchronous request context.");
     }
 
@@ -1903,6 +2768,27 @@ InferenceServerHttpClient::AsyncInfer(
     }
 
     curl_multi_add_handle(multi_handle_, multi_easy_handle);
+
+    if (options.cancellation_ != nullptr) {
+      // The transfer can only be aborted by the worker thread, queue the
+      // request for it and interrupt its wait.
+      const uintptr_t identifier =
+          reinterpret_cast<uintptr_t>(multi_easy_handle);
+      std::weak_ptr<HttpInferRequest> weak_request(async_request);
+      auto cancel_fn = [this, identifier, weak_request] {
+        {
+          std::lock_guard<std::mutex> lock(cached_async_requests_mutex_);
+          cancelled_async_requests_.emplace_back(identifier, weak_request);
+        }
+        curl_multi_wakeup(multi_handle_);
+      };
+      if (options.cancellation_->Attach(
+              cancel_fn, &async_request->cancellation_id_)) {
+        async_request->cancellation_ = options.cancellation_;
+      } else {
+        cancel_fn();
+      }
+    }
   }
 
   cv_.notify_all();
@@ -2109,7 +2995,8 @@ InferenceServerHttpClient::PreRunProcessing(
   CURL* curl = reinterpret_cast<CURL*>(vcurl);
 
   // Prepare the request object to provide the data for inference.
-  Error err = http_request->InitializeRequest(options, inputs, outputs);
+  Error err = http_request->InitializeRequest(
+      options, inputs, outputs, request_template_cache_.get());
   if (!err.IsOk()) {
     return err;
   }
@@ -2136,19 +3023,19 @@ InferenceServerHttpClient::PreRunProcessing(
   }
 
   // Compress data if requested
-  switch (request_compression_algorithm) {
-    case CompressionType::NONE:
-      break;
-    case CompressionType::DEFLATE:
-    case CompressionType::GZIP:
-#ifdef TRITON_ENABLE_ZLIB
-      http_request->CompressInput(request_compression_algorithm);
-      break;
-#else
-      return Error(
-          "Compression type needs to be CompressionType::NONE since ZLIB is "
-          "not included in client build");
-#endif
+  const char* content_encoding = nullptr;
+  if (request_compression_algorithm != CompressionType::NONE) {
+    err = http_request->CompressInput(
+        request_compressor_.get(), request_compression_algorithm,
+        &content_encoding);
+    if (!err.IsOk()) {
+      return err;
+    }
+  }
+  if (response_compression_algorithm == CompressionType::LZ4) {
+    return Error(
+        "Compression type CompressionType::LZ4 is not supported for the "
+        "response body");
   }
 
   // Prepare curl
@@ -2157,6 +3044,9 @@ InferenceServerHttpClient::PreRunProcessing(
   }
 
   curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
+  if (!unix_socket_path_.empty()) {
+    curl_easy_setopt(curl, CURLOPT_UNIX_SOCKET_PATH, unix_socket_path_.c_str());
+  }
   curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
   curl_easy_setopt(curl, CURLOPT_POST, 1L);
   curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
@@ -2193,12 +3083,13 @@ InferenceServerHttpClient::PreRunProcessing(
   if (!err.IsOk()) {
     return err;
   }
+  curl_share_->Attach(curl);
 
   struct curl_slist* list = nullptr;
 
   std::string infer_hdr{
       std::string(kInferHeaderContentLengthHTTPHeader) + ": " +
-      std::to_string(http_request->request_json_.Size())};
+      std::to_string(http_request->RequestJsonSize())};
   list = curl_slist_append(list, infer_hdr.c_str());
   list = curl_slist_append(list, "Expect:");
   if (all_inputs_are_json) {
@@ -2213,18 +3104,13 @@ InferenceServerHttpClient::PreRunProcessing(
   }
 
   // Compress data if requested
-  switch (request_compression_algorithm) {
-    case CompressionType::NONE:
-      break;
-    case CompressionType::DEFLATE:
-      list = curl_slist_append(list, "Content-Encoding: deflate");
-      break;
-    case CompressionType::GZIP:
-      list = curl_slist_append(list, "Content-Encoding: gzip");
-      break;
+  if (content_encoding != nullptr) {
+    list = curl_slist_append(
+        list, (std::string("Content-Encoding: ") + content_encoding).c_str());
   }
   switch (response_compression_algorithm) {
     case CompressionType::NONE:
+    case CompressionType::LZ4:
       break;
     case CompressionType::DEFLATE:
       curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "deflate");
@@ -2232,6 +3118,9 @@ InferenceServerHttpClient::PreRunProcessing(
     case CompressionType::GZIP:
       curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "gzip");
       break;
+    case CompressionType::ZSTD:
+      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "zstd");
+      break;
   }
   curl_easy_setopt(curl, CURLOPT_HTTPHEADER, list);
 
@@ -2239,7 +3128,10 @@ InferenceServerHttpClient::PreRunProcessing(
   http_request->header_list_ = list;
 
   if (verbose_) {
-    std::cout << "inference request: " << http_request->request_json_.Contents()
+    std::cout << "inference request: "
+              << std::string(
+                     http_request->RequestJsonBase(),
+                     http_request->RequestJsonSize())
               << std::endl;
   }
 
@@ -2250,9 +3142,12 @@ void
 InferenceServerHttpClient::AsyncTransfer()
 {
   int place_holder = 0;
+  int running_count = 0;
   CURLMsg* msg = nullptr;
   do {
     std::vector<std::shared_ptr<HttpInferRequest>> request_list;
+    std::vector<std::shared_ptr<HttpInferRequest>> cancelled_request_list;
+    CachedAsyncRequests cached_request_list;
 
     // sleep if no work is available
     std::unique_lock<std::mutex> lock(mutex_);
@@ -2260,16 +3155,24 @@ InferenceServerHttpClient::AsyncTransfer()
       if (this->exiting_) {
         return true;
       }
-      // wake up if an async request has been generated
-      return !this->ongoing_async_requests_.empty();
+      // wake up if an async request has been generated or served from
+      // the response cache
+      std::lock_guard<std::mutex> cached_lock(
+          this->cached_async_requests_mutex_);
+      return !this->ongoing_async_requests_.empty() ||
+             !this->cached_async_requests_.empty();
     });
 
-    CURLMcode mc = curl_multi_perform(multi_handle_, &place_holder);
-    int numfds;
+    // Wait for activity on the transfers still running after the previous
+    // pass. The wait is interrupted by curl_multi_wakeup() when a request is
+    // added, cancelled or served from the response cache.
+    CURLMcode mc = CURLM_OK;
+    if (running_count > 0) {
+      int numfds;
+      mc = curl_multi_poll(multi_handle_, NULL, 0, INT_MAX, &numfds);
+    }
     if (mc == CURLM_OK) {
-      // Wait for activity. If there are no descriptors in the multi_handle_
-      // then curl_multi_wait will return immediately
-      mc = curl_multi_wait(multi_handle_, NULL, 0, INT_MAX, &numfds);
+      mc = curl_multi_perform(multi_handle_, &running_count);
       if (mc == CURLM_OK) {
         while ((msg = curl_multi_info_read(multi_handle_, &place_holder))) {
           uintptr_t identifier = reinterpret_cast<uintptr_t>(msg->easy_handle);
@@ -2295,6 +3198,7 @@ InferenceServerHttpClient::AsyncTransfer()
 
           request_list.emplace_back(itr->second);
           ongoing_async_requests_.erase(itr);
+          CountConnections(msg->easy_handle);
           curl_multi_remove_handle(multi_handle_, msg->easy_handle);
           curl_easy_cleanup(msg->easy_handle);
 
@@ -2323,13 +3227,55 @@ InferenceServerHttpClient::AsyncTransfer()
       std::cerr << "Unexpected error: curl_multi failed. Code:" << mc
                 << std::endl;
     }
+    CancelledAsyncRequests cancel_list;
+    {
+      std::lock_guard<std::mutex> cached_lock(cached_async_requests_mutex_);
+      cached_request_list.swap(cached_async_requests_);
+      cancel_list.swap(cancelled_async_requests_);
+    }
+    for (auto& cancelled : cancel_list) {
+      // Skip the requests that completed before being cancelled.
+      std::shared_ptr<HttpInferRequest> async_request = cancelled.second.lock();
+      auto itr = ongoing_async_requests_.find(cancelled.first);
+      if ((async_request == nullptr) ||
+          (itr == ongoing_async_requests_.end()) ||
+          (itr->second != async_request)) {
+        continue;
+      }
+      CURL* easy_handle = reinterpret_cast<CURL*>(cancelled.first);
+      curl_multi_remove_handle(multi_handle_, easy_handle);
+      curl_easy_cleanup(easy_handle);
+      ongoing_async_requests_.erase(itr);
+      cancelled_request_list.emplace_back(std::move(async_request));
+    }
     lock.unlock();
 
+    for (auto& this_request : cancelled_request_list) {
+      ReleaseAdmission(0);
+      this_request->cancellation_->Detach(this_request->cancellation_id_);
+      InferResult* result;
+      InferResultHttp::Create(&result, Error("Cancelled"));
+      this_request->callback_(result);
+    }
     for (auto& this_request : request_list) {
+      if (this_request->cancellation_ != nullptr) {
+        this_request->cancellation_->Detach(this_request->cancellation_id_);
+      }
+      // Release the admission before the callback, see ReleaseAdmission()
+      const uint64_t request_time_ns = this_request->Timer().Duration(
+          RequestTimers::Kind::REQUEST_START, RequestTimers::Kind::REQUEST_END);
+      ReleaseAdmission(
+          (request_time_ns == std::numeric_limits<uint64_t>::max())
+              ? 0
+              : request_time_ns);
       InferResult* result;
       InferResultHttp::Create(&result, this_request);
+      CacheResponse(this_request->response_cache_key_, result);
       this_request->callback_(result);
     }
+    for (auto& cached_request : cached_request_list) {
+      cached_request.first(cached_request.second);
+    }
   } while (!exiting_);
 }
 
@@ -2385,6 +3331,9 @@ InferenceServerHttpClient::Get(
   }
 
   curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
+  if (!unix_socket_path_.empty()) {
+    curl_easy_setopt(curl, CURLOPT_UNIX_SOCKET_PATH, unix_socket_path_.c_str());
+  }
   curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
   curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
   if (verbose_) {
@@ -2401,6 +3350,7 @@ InferenceServerHttpClient::Get(
   if (!err.IsOk()) {
     return err;
   }
+  curl_share_->Attach(curl);
 
   // Add user provided headers...
   struct curl_slist* header_list = nullptr;
@@ -2422,6 +3372,7 @@ InferenceServerHttpClient::Get(
 
   long lhttp_code;
   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &lhttp_code);
+  CountConnections(curl);
 
   curl_slist_free_all(header_list);
   curl_easy_cleanup(curl);
@@ -2461,6 +3412,9 @@ InferenceServerHttpClient::Post(
   }
 
   curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
+  if (!unix_socket_path_.empty()) {
+    curl_easy_setopt(curl, CURLOPT_UNIX_SOCKET_PATH, unix_socket_path_.c_str());
+  }
   curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
   curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
   curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.size());
@@ -2479,6 +3433,7 @@ InferenceServerHttpClient::Post(
   if (!err.IsOk()) {
     return err;
   }
+  curl_share_->Attach(curl);
 
   // Add user provided headers...
   struct curl_slist* header_list = nullptr;
@@ -2500,6 +3455,7 @@ InferenceServerHttpClient::Post(
 
   long http_code;
   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+  CountConnections(curl);
 
   curl_slist_free_all(header_list);
   curl_easy_cleanup(curl);
@@ -36,6 +36,9 @@
 namespace triton { namespace client {
 
 class HttpInferRequest;
+class HttpRequestTemplateCache;
+class RequestCompressor;
+class CurlShare;
 
 /// The key-value map type to be included in the request
 /// as custom headers.
@@ -87,6 +90,28 @@ struct HttpSslOptions {
   std::string key;
 };
 
+// The options for deciding how request bodies are compressed.
+struct HttpCompressionOptions {
+  explicit HttpCompressionOptions()
+      : level(0), min_byte_size(0), min_ratio(0.0), sample_interval(64)
+  {
+  }
+  // The compression level passed to the codec. The range of valid levels
+  // depends on the codec, 0 selects the codec's default level.
+  int level;
+  // Request bodies smaller than this number of bytes are sent uncompressed,
+  // the default value is 0 which compresses every request body.
+  size_t min_byte_size;
+  // Stop compressing request bodies with an algorithm while its sampled
+  // compression ratio (uncompressed size / compressed size) is below this
+  // value. The default value is 0 which disables sampling.
+  double min_ratio;
+  // The number of requests between two samples of the compression ratio
+  // when 'min_ratio' is set. The request bodies are still compressed in
+  // between if the last sample met 'min_ratio'.
+  uint32_t sample_interval;
+};
+
 //==============================================================================
 /// An InferenceServerHttpClient object is used to perform any kind of
 /// communication with the InferenceServer using HTTP protocol. None
@@ -106,7 +131,7 @@ struct HttpSslOptions {
 ///
 class InferenceServerHttpClient : public InferenceServerClient {
  public:
-  enum class CompressionType { NONE, DEFLATE, GZIP };
+  enum class CompressionType { NONE, DEFLATE, GZIP, ZSTD, LZ4 };
   ~InferenceServerHttpClient();
 
   /// Generate a request body for inference using the supplied 'inputs' and
@@ -142,7 +167,10 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// \param client Returns a new InferenceServerHttpClient object.
   /// \param server_url The inference server name, port, optional
   /// scheme and optional base path in the following format:
-  /// <scheme://>host:port/<base-path>.
+  /// <scheme://>host:port/<base-path>. A server co-located with the
+  /// client may instead be reached through a Unix domain socket by
+  /// passing the socket path in the format: unix:<path>, for example
+  /// "unix:/tmp/triton.sock".
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
   /// \param ssl_options Specifies the settings for configuring
@@ -151,11 +179,28 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// The use of SSL/TLS depends entirely on the server endpoint.
   /// These options will be ignored if the server_url does not
   /// expose `https://` scheme.
+  /// \param compression_options Specifies when the request bodies are
+  /// compressed and with which level, see HttpCompressionOptions.
   /// \return Error object indicating success or failure.
   static Error Create(
       std::unique_ptr<InferenceServerHttpClient>* client,
       const std::string& server_url, bool verbose = false,
-      const HttpSslOptions& ssl_options = HttpSslOptions());
+      const HttpSslOptions& ssl_options = HttpSslOptions(),
+      const HttpCompressionOptions& compression_options =
+          HttpCompressionOptions());
+
+  /// Establish connections to the server ahead of the first requests so
+  /// that they don't pay for the TCP and TLS setup. The connections are
+  /// kept by the client and reused by AsyncInfer(). The TLS sessions are
+  /// shared by all the connections of the client, so the later
+  /// connections, including the one of the synchronous requests, resume
+  /// a session instead of performing a full handshake. Must not be
+  /// called while asynchronous requests are in flight.
+  /// \param connection_count The number of connections to establish.
+  /// \param timeout_ms Optional timeout for establishing the connections,
+  /// in milliseconds. The default value is 0 which means no timeout.
+  /// \return Error object indicating success or failure.
+  Error Warmup(const size_t connection_count, const uint64_t timeout_ms = 0);
 
   /// Contact the inference server and get its liveness.
   /// \param live Returns whether the server is live or not.
@@ -442,7 +487,10 @@ class InferenceServerHttpClient : public InferenceServerClient {
       const std::string& name = "", const Headers& headers = Headers(),
       const Parameters& query_params = Parameters());
 
-  /// Run synchronous inference on server.
+  /// Run synchronous inference on server. If the response cache is
+  /// enabled with SetResponseCache() and holds the response of an
+  /// identical request, the result is returned without contacting the
+  /// server.
   /// \param result Returns the result of inference.
   /// \param options The options for inference request.
   /// \param inputs The vector of InferInput describing the model inputs.
@@ -455,12 +503,15 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// included with URL query.
   /// \param request_compression_algorithm Optional HTTP compression algorithm
   /// to use for the request body on client side. Currently supports DEFLATE,
-  /// GZIP and NONE. By default, no compression is used.
+  /// GZIP, ZSTD, LZ4 and NONE, ZSTD and LZ4 are only available if the client
+  /// is built with them and must also be supported by the server. The body
+  /// may be sent uncompressed based on the client's HttpCompressionOptions.
+  /// By default, no compression is used.
   /// \param response_compression_algorithm Optional HTTP compression algorithm
   /// to request for the response body. Note that the response may not be
   /// compressed if the server does not support the specified algorithm.
-  /// Currently supports DEFLATE, GZIP and NONE. By default, no compression
-  /// is used.
+  /// Currently supports DEFLATE, GZIP, ZSTD and NONE. By default, no
+  /// compression is used.
   /// \return Error object indicating success or failure of the
   /// request.
   Error Infer(
@@ -483,6 +534,11 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// results inside the callback function or deferring it to a different thread
   /// so that the client is unblocked. In order to prevent memory leak, user
   /// must ensure this object gets deleted.
+  /// Requests served from the response cache, see SetResponseCache(), are
+  /// also completed by invoking 'callback' from the client's worker thread.
+  /// If the admission control is enabled, see SetAdmissionControl(), the
+  /// call may wait for a request in flight to complete or return an error
+  /// when the limit of requests in flight is reached.
   /// Note: InferInput::AppendRaw() or InferInput::SetSharedMemory() calls do
   /// not copy the data buffers but hold the pointers to the data directly.
   /// It is advisable to not to disturb the buffer contents until the respective
@@ -499,12 +555,15 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// included with URL query.
   /// \param request_compression_algorithm Optional HTTP compression algorithm
   /// to use for the request body on client side. Currently supports DEFLATE,
-  /// GZIP and NONE. By default, no compression is used.
+  /// GZIP, ZSTD, LZ4 and NONE, ZSTD and LZ4 are only available if the client
+  /// is built with them and must also be supported by the server. The body
+  /// may be sent uncompressed based on the client's HttpCompressionOptions.
+  /// By default, no compression is used.
   /// \param response_compression_algorithm Optional HTTP compression algorithm
   /// to request for the response body. Note that the response may not be
   /// compressed if the server does not support the specified algorithm.
-  /// Currently supports DEFLATE, GZIP and NONE. By default, no compression
-  /// is used.
+  /// Currently supports DEFLATE, GZIP, ZSTD and NONE. By default, no
+  /// compression is used.
   /// \return Error object indicating success
   /// or failure of the request.
   Error AsyncInfer(
@@ -535,12 +594,15 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// included with URL query.
   /// \param request_compression_algorithm Optional HTTP compression algorithm
   /// to use for the request body on client side. Currently supports DEFLATE,
-  /// GZIP and NONE. By default, no compression is used.
+  /// GZIP, ZSTD, LZ4 and NONE, ZSTD and LZ4 are only available if the client
+  /// is built with them and must also be supported by the server. The body
+  /// may be sent uncompressed based on the client's HttpCompressionOptions.
+  /// By default, no compression is used.
   /// \param response_compression_algorithm Optional HTTP compression algorithm
   /// to request for the response body. Note that the response may not be
   /// compressed if the server does not support the specified algorithm.
-  /// Currently supports DEFLATE, GZIP and NONE. By default, no compression
-  /// is used.
+  /// Currently supports DEFLATE, GZIP, ZSTD and NONE. By default, no
+  /// compression is used.
   /// \return Error object indicating success or failure of the
   /// request.
   Error InferMulti(
@@ -584,12 +646,15 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// included with URL query.
   /// \param request_compression_algorithm Optional HTTP compression algorithm
   /// to use for the request body on client side. Currently supports DEFLATE,
-  /// GZIP and NONE. By default, no compression is used.
+  /// GZIP, ZSTD, LZ4 and NONE, ZSTD and LZ4 are only available if the client
+  /// is built with them and must also be supported by the server. The body
+  /// may be sent uncompressed based on the client's HttpCompressionOptions.
+  /// By default, no compression is used.
   /// \param response_compression_algorithm Optional HTTP compression algorithm
   /// to request for the response body. Note that the response may not be
   /// compressed if the server does not support the specified algorithm.
-  /// Currently supports DEFLATE, GZIP and NONE. By default, no compression
-  /// is used.
+  /// Currently supports DEFLATE, GZIP, ZSTD and NONE. By default, no
+  /// compression is used.
   /// \return Error object indicating success
   /// or failure of the request.
   Error AsyncInferMulti(
@@ -606,7 +671,8 @@ class InferenceServerHttpClient : public InferenceServerClient {
 
  private:
   InferenceServerHttpClient(
-      const std::string& url, bool verbose, const HttpSslOptions& ssl_options);
+      const std::string& url, bool verbose, const HttpSslOptions& ssl_options,
+      const HttpCompressionOptions& compression_options);
 
   Error PreRunProcessing(
       void* curl, std::string& request_uri, const InferOptions& options,
@@ -625,6 +691,9 @@ class InferenceServerHttpClient : public InferenceServerClient {
       std::string& request_uri, const std::string& request,
       const Headers& headers, const Parameters& query_params,
       std::string* response);
+  // Update the connection stat with the connections established by the
+  // transfer of 'curl'.
+  void CountConnections(void* curl);
 
   static size_t ResponseHandler(
       void* contents, size_t size, size_t nmemb, void* userp);
@@ -637,6 +706,9 @@ class InferenceServerHttpClient : public InferenceServerClient {
 
   // The server url
   const std::string url_;
+  // The path of the Unix domain socket to connect through, empty if the
+  // server is reached over TCP
+  const std::string unix_socket_path_;
   // The options for authorizing and authenticating SSL/TLS connections
   HttpSslOptions ssl_options_;
 
@@ -648,6 +720,24 @@ class InferenceServerHttpClient : public InferenceServerClient {
   // map to record ongoing asynchronous requests with pointer to easy handle
   // or tag id as key
   AsyncReqMap ongoing_async_requests_;
+  using CachedAsyncRequests =
+      std::vector<std::pair<OnCompleteFn, InferResult*>>;
+  // asynchronous requests served from the response cache that are waiting
+  // for the worker thread to invoke their callbacks
+  CachedAsyncRequests cached_async_requests_;
+  using CancelledAsyncRequests =
+      std::vector<std::pair<uintptr_t, std::weak_ptr<HttpInferRequest>>>;
+  // asynchronous requests cancelled with InferOptions::cancellation_ that
+  // are waiting for the worker thread to abort their transfers
+  CancelledAsyncRequests cancelled_async_requests_;
+  // protects 'cached_async_requests_' and 'cancelled_async_requests_'
+  std::mutex cached_async_requests_mutex_;
+  // cache of the serialized headers of previous inference requests
+  std::unique_ptr<HttpRequestTemplateCache> request_template_cache_;
+  // decides whether and how the request bodies are compressed
+  std::unique_ptr<RequestCompressor> request_compressor_;
+  // the TLS sessions and DNS entries shared by all the curl handles
+  std::unique_ptr<CurlShare> curl_share_;
 };
 
 }}  // namespace triton::client
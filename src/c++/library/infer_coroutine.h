@@ -0,0 +1,192 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+/// \file
+/// Awaitable inference requests for C++20 coroutines, built on the
+/// AsyncInfer() API of InferenceServerHttpClient and
+/// InferenceServerGrpcClient. The client libraries are built as C++11,
+/// only the code including this header needs to be compiled as C++20.
+///
+/// \code
+///   Task Pipeline(tc::InferenceServerGrpcClient& client, ...)
+///   {
+///     auto first = co_await tc::InferAsync(client, options, inputs);
+///     ...
+///     auto second = co_await tc::InferAsync(client, options, next_inputs);
+///   }
+/// \endcode
+
+#if __cplusplus < 202002L
+#error "infer_coroutine.h requires C++20"
+#endif
+
+#include <coroutine>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <vector>
+
+#include "common.h"
+
+namespace triton { namespace client {
+
+//==============================================================================
+/// A function that runs the given function on an executor, for example a
+/// thread pool or an event loop. Used to resume the coroutines awaiting
+/// an inference request.
+///
+using InferExecutor = std::function<void(std::function<void()>)>;
+
+//==============================================================================
+/// The outcome of an awaited inference request.
+///
+struct InferAsyncResult {
+  /// The status of the request, the error returned by AsyncInfer() if the
+  /// request could not be sent, otherwise the status of 'result'.
+  Error status;
+  /// The result of the request, nullptr if the request could not be sent.
+  std::unique_ptr<InferResult> result;
+};
+
+//==============================================================================
+/// An InferAwaitable sends an inference request when awaited and resumes
+/// the awaiting coroutine with the InferAsyncResult once the request
+/// completes. Use InferAsync() to create one.
+///
+template <typename Client>
+class InferAwaitable {
+ public:
+  InferAwaitable(
+      Client* client, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      InferExecutor executor, std::stop_token stop_token)
+      : client_(client), options_(options), inputs_(inputs),
+        outputs_(outputs), executor_(std::move(executor)),
+        stop_token_(std::move(stop_token))
+  {
+  }
+
+  bool await_ready() const noexcept { return false; }
+
+  bool await_suspend(std::coroutine_handle<> handle)
+  {
+    if (stop_token_.stop_requested()) {
+      status_ = Error("Cancelled");
+      return false;
+    }
+    if (stop_token_.stop_possible()) {
+      // Requesting the stop cancels the request, through the RPC for the
+      // gRPC client and by aborting the transfer for the HTTP client.
+      if (options_.cancellation_ == nullptr) {
+        options_.cancellation_ = std::make_shared<InferCancellation>();
+      }
+      stop_callback_.emplace(
+          stop_token_, [cancellation = options_.cancellation_] {
+            cancellation->Cancel();
+          });
+    }
+
+    handle_ = handle;
+    Error err = client_->AsyncInfer(
+        [this](InferResult* result) {
+          result_.reset(result);
+          status_ = result->RequestStatus();
+          stop_callback_.reset();
+          // The awaiter may be destroyed as soon as the coroutine resumes,
+          // don't access it after this point.
+          std::coroutine_handle<> handle = handle_;
+          if (executor_) {
+            executor_([handle] { handle.resume(); });
+          } else {
+            handle.resume();
+          }
+        },
+        options_, inputs_, outputs_);
+    if (!err.IsOk()) {
+      status_ = err;
+      stop_callback_.reset();
+      return false;
+    }
+    // The request may already have completed and resumed the coroutine,
+    // the awaiter must not be accessed anymore.
+    return true;
+  }
+
+  InferAsyncResult await_resume()
+  {
+    return InferAsyncResult{std::move(status_), std::move(result_)};
+  }
+
+ private:
+  Client* client_;
+  InferOptions options_;
+  std::vector<InferInput*> inputs_;
+  std::vector<const InferRequestedOutput*> outputs_;
+  InferExecutor executor_;
+  std::stop_token stop_token_;
+  std::optional<std::stop_callback<std::function<void()>>> stop_callback_;
+
+  std::coroutine_handle<> handle_;
+  Error status_;
+  std::unique_ptr<InferResult> result_;
+};
+
+/// Create an awaitable inference request. The request is sent when the
+/// returned object is awaited, and the awaiting coroutine is resumed once
+/// the request completes. The inputs and outputs must stay valid until
+/// then, as with AsyncInfer().
+/// \param client The InferenceServerHttpClient or InferenceServerGrpcClient
+/// to send the request with.
+/// \param options The options for inference request.
+/// \param inputs The vector of InferInput describing the model inputs.
+/// \param outputs Optional vector of InferRequestedOutput describing how the
+/// output must be returned. If not provided then all the outputs in the model
+/// config will be returned as default settings.
+/// \param executor Optional executor to resume the coroutine on. If not
+/// provided, the coroutine is resumed on the worker thread of the client
+/// and must not block it, as that would delay the completion of all the
+/// other requests of the client.
+/// \param stop_token Optional stop token, requesting the stop cancels the
+/// request which then completes with an error status.
+/// \return The awaitable request.
+template <typename Client>
+InferAwaitable<Client>
+InferAsync(
+    Client& client, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs =
+        std::vector<const InferRequestedOutput*>(),
+    InferExecutor executor = nullptr, std::stop_token stop_token = {})
+{
+  return InferAwaitable<Client>(
+      &client, options, inputs, outputs, std::move(executor),
+      std::move(stop_token));
+}
+
+}}  // namespace triton::client
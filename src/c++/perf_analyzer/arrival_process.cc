@@ -0,0 +1,371 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "arrival_process.h"
+
+#include <rapidjson/filereadstream.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+#include "constants.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+std::chrono::nanoseconds
+SecondsToNanos(const double seconds)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(seconds));
+}
+
+// Set the option 'key' of the arrival processes
+cb::Error
+SetArrivalProcessOption(
+    const std::string& key, const double value, ArrivalProcessOptions* options)
+{
+  if (key == "cv") {
+    if (value <= 0.0) {
+      return cb::Error("cv must be > 0", pa::GENERIC_ERROR);
+    }
+    options->gamma_cv_ = value;
+  } else if (key == "burst_ratio") {
+    if (value < 1.0) {
+      return cb::Error("burst_ratio must be >= 1", pa::GENERIC_ERROR);
+    }
+    options->mmpp_burst_ratio_ = value;
+  } else if (key == "burst_ms" || key == "idle_ms" || key == "on_ms" ||
+             key == "off_ms") {
+    if (value <= 0.0) {
+      return cb::Error(key + " must be > 0", pa::GENERIC_ERROR);
+    }
+    if (key == "burst_ms") {
+      options->mmpp_burst_ms_ = value;
+    } else if (key == "idle_ms") {
+      options->mmpp_idle_ms_ = value;
+    } else if (key == "on_ms") {
+      options->pareto_on_ms_ = value;
+    } else {
+      options->pareto_off_ms_ = value;
+    }
+  } else if (key == "alpha") {
+    // The periods have no mean at or under 1
+    if (value <= 1.0) {
+      return cb::Error("alpha must be > 1", pa::GENERIC_ERROR);
+    }
+    options->pareto_alpha_ = value;
+  } else {
+    return cb::Error(
+        "unknown arrival process parameter '" + key + "'", pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+}  // namespace
+
+GammaArrivalProcess::GammaArrivalProcess(
+    const double request_rate, const double cv)
+    : dist_(1.0 / (cv * cv), cv * cv / request_rate)
+{
+}
+
+std::chrono::nanoseconds
+GammaArrivalProcess::NextInterval(std::mt19937& gen)
+{
+  return SecondsToNanos(dist_(gen));
+}
+
+ModulatedArrivalProcess::ModulatedArrivalProcess(
+    const double idle_rate, const double burst_rate,
+    const double burst_fraction)
+    : idle_rate_(idle_rate), burst_rate_(burst_rate),
+      burst_fraction_(burst_fraction)
+{
+}
+
+std::chrono::nanoseconds
+ModulatedArrivalProcess::NextInterval(std::mt19937& gen)
+{
+  if (remaining_s_ < 0.0) {
+    // Start in a state with the probability of being in it
+    burst_ = std::uniform_real_distribution<>(0.0, 1.0)(gen) < burst_fraction_;
+    remaining_s_ = StateDuration(burst_, gen);
+  }
+
+  // The arrivals within a state are memoryless, so a gap that runs past the
+  // end of the state is drawn again from the start of the next one
+  double interval_s{0.0};
+  while (true) {
+    const double rate{burst_ ? burst_rate_ : idle_rate_};
+    if (rate > 0.0) {
+      const double gap_s{gap_(gen) / rate};
+      if (gap_s <= remaining_s_) {
+        remaining_s_ -= gap_s;
+        return SecondsToNanos(interval_s + gap_s);
+      }
+    }
+    interval_s += remaining_s_;
+    burst_ = !burst_;
+    remaining_s_ = StateDuration(burst_, gen);
+  }
+}
+
+MarkovModulatedArrivalProcess::MarkovModulatedArrivalProcess(
+    const double request_rate, const double burst_ratio,
+    const double burst_ms, const double idle_ms)
+    : ModulatedArrivalProcess(
+          // The idle rate such that the mean rate is 'request_rate'
+          request_rate * (burst_ms + idle_ms) /
+              (idle_ms + burst_ratio * burst_ms),
+          burst_ratio * request_rate * (burst_ms + idle_ms) /
+              (idle_ms + burst_ratio * burst_ms),
+          burst_ms / (burst_ms + idle_ms)),
+      burst_duration_(1000.0 / burst_ms), idle_duration_(1000.0 / idle_ms)
+{
+}
+
+double
+MarkovModulatedArrivalProcess::StateDuration(
+    const bool burst, std::mt19937& gen)
+{
+  return burst ? burst_duration_(gen) : idle_duration_(gen);
+}
+
+ParetoOnOffArrivalProcess::ParetoOnOffArrivalProcess(
+    const double request_rate, const double alpha, const double on_ms,
+    const double off_ms)
+    : ModulatedArrivalProcess(
+          0.0, request_rate * (on_ms + off_ms) / on_ms,
+          on_ms / (on_ms + off_ms)),
+      alpha_(alpha), on_scale_s_(on_ms * (alpha - 1.0) / alpha / 1000.0),
+      off_scale_s_(off_ms * (alpha - 1.0) / alpha / 1000.0)
+{
+}
+
+double
+ParetoOnOffArrivalProcess::StateDuration(const bool burst, std::mt19937& gen)
+{
+  // Inverse transform sampling, with 1 - u in (0, 1]
+  const double u{1.0 - uniform_(gen)};
+  return (burst ? on_scale_s_ : off_scale_s_) / std::pow(u, 1.0 / alpha_);
+}
+
+cb::Error
+CreateArrivalProcess(
+    const Distribution distribution, const double request_rate,
+    const ArrivalProcessOptions& options,
+    std::shared_ptr<ArrivalProcess>* process)
+{
+  if (request_rate <= 0.0) {
+    return cb::Error(
+        "The request rate of an arrival process must be > 0",
+        pa::GENERIC_ERROR);
+  }
+
+  switch (distribution) {
+    case Distribution::GAMMA:
+      *process = std::make_shared<GammaArrivalProcess>(
+          request_rate, options.gamma_cv_);
+      break;
+    case Distribution::MMPP:
+      *process = std::make_shared<MarkovModulatedArrivalProcess>(
+          request_rate, options.mmpp_burst_ratio_, options.mmpp_burst_ms_,
+          options.mmpp_idle_ms_);
+      break;
+    case Distribution::PARETO_ON_OFF:
+      *process = std::make_shared<ParetoOnOffArrivalProcess>(
+          request_rate, options.pareto_alpha_, options.pareto_on_ms_,
+          options.pareto_off_ms_);
+      break;
+    default:
+      return cb::Error(
+          "The request distribution has no arrival process",
+          pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+std::function<std::chrono::nanoseconds(std::mt19937&)>
+ArrivalProcessDistribution(std::shared_ptr<ArrivalProcess> process)
+{
+  return [process](std::mt19937& gen) { return process->NextInterval(gen); };
+}
+
+cb::Error
+ParseArrivalProcessOptions(
+    const std::string& params, ArrivalProcessOptions* options)
+{
+  std::stringstream params_stream(params);
+  std::string param;
+  while (std::getline(params_stream, param, ',')) {
+    const size_t pos{param.find('=')};
+    if (pos == std::string::npos) {
+      return cb::Error(
+          "arrival process parameter '" + param + "' is not key=value",
+          pa::GENERIC_ERROR);
+    }
+    const std::string key{param.substr(0, pos)};
+    const std::string value_str{param.substr(pos + 1)};
+    double value;
+    size_t value_end{0};
+    try {
+      value = std::stod(value_str, &value_end);
+    }
+    catch (const std::exception&) {
+      value_end = 0;
+    }
+    if (value_str.empty() || value_end != value_str.size()) {
+      return cb::Error(
+          "the value of arrival process parameter '" + key +
+              "' is not a number",
+          pa::GENERIC_ERROR);
+    }
+    RETURN_IF_ERROR(SetArrivalProcessOption(key, value, options));
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+ReadArrivalProcessFile(
+    const std::string& path, ArrivalProcessOptions* options)
+{
+  FILE* params_file = fopen(path.c_str(), "r");
+  if (params_file == nullptr) {
+    return cb::Error(
+        "failed to open arrival process file '" + path + "'",
+        pa::GENERIC_ERROR);
+  }
+
+  char readBuffer[65536];
+  rapidjson::FileReadStream fs(params_file, readBuffer, sizeof(readBuffer));
+
+  rapidjson::Document d{};
+  d.ParseStream(fs);
+
+  fclose(params_file);
+
+  return ParseArrivalProcessJson(d, options);
+}
+
+cb::Error
+ParseArrivalProcessJson(
+    const rapidjson::Document& json, ArrivalProcessOptions* options)
+{
+  if (json.HasParseError() || !json.IsObject()) {
+    return cb::Error(
+        "The arrival process file must contain a JSON object",
+        pa::GENERIC_ERROR);
+  }
+
+  for (rapidjson::Value::ConstMemberIterator member = json.MemberBegin();
+       member != json.MemberEnd(); ++member) {
+    const std::string key{member->name.GetString()};
+    if (!member->value.IsNumber()) {
+      return cb::Error(
+          "the value of arrival process parameter '" + key +
+              "' is not a number",
+          pa::GENERIC_ERROR);
+    }
+    RETURN_IF_ERROR(
+        SetArrivalProcessOption(key, member->value.GetDouble(), options));
+  }
+  return cb::Error::Success;
+}
+
+ScheduleStatsCollector::ScheduleStatsCollector(
+    const std::chrono::nanoseconds window,
+    const std::chrono::nanoseconds burst_gap)
+    : window_ns_(std::max<uint64_t>(window.count(), 1)),
+      burst_gap_ns_(burst_gap.count())
+{
+}
+
+void
+ScheduleStatsCollector::Add(const std::chrono::nanoseconds interval)
+{
+  const double interval_ns{static_cast<double>(interval.count())};
+  requests_++;
+  interval_sum_ += interval_ns;
+  interval_sum_squares_ += interval_ns * interval_ns;
+
+  timestamp_ns_ += interval.count();
+  const uint64_t window{timestamp_ns_ / window_ns_};
+  if (window != window_) {
+    // Close the current window and the empty ones up to the new window
+    AddWindowCount(window_count_);
+    windows_ += window - window_ - 1;
+    window_ = window;
+    window_count_ = 0;
+  }
+  window_count_++;
+
+  burst_length_ =
+      (static_cast<uint64_t>(interval.count()) < burst_gap_ns_)
+          ? burst_length_ + 1
+          : 1;
+  longest_burst_ = std::max(longest_burst_, burst_length_);
+}
+
+void
+ScheduleStatsCollector::AddWindowCount(const uint64_t count)
+{
+  windows_++;
+  count_sum_ += count;
+  count_sum_squares_ += static_cast<double>(count) * count;
+  max_count_ = std::max(max_count_, count);
+}
+
+ScheduleStats
+ScheduleStatsCollector::Stats() const
+{
+  ScheduleStats stats{};
+  stats.requests_ = requests_;
+  stats.window_ms_ = window_ns_ / NANOS_PER_MILLIS;
+  stats.longest_burst_ = longest_burst_;
+
+  if (requests_ != 0 && interval_sum_ > 0.0) {
+    const double mean{interval_sum_ / requests_};
+    const double variance{
+        std::max(interval_sum_squares_ / requests_ - mean * mean, 0.0)};
+    stats.interval_cv_ = std::sqrt(variance) / mean;
+  }
+
+  if (windows_ != 0 && count_sum_ > 0.0) {
+    const double mean{count_sum_ / windows_};
+    const double variance{
+        std::max(count_sum_squares_ / windows_ - mean * mean, 0.0)};
+    stats.count_dispersion_ = variance / mean;
+    stats.peak_to_mean_ = max_count_ / mean;
+  }
+
+  return stats;
+}
+
+}}  // namespace triton::perfanalyzer
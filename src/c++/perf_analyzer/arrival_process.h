@@ -0,0 +1,237 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <rapidjson/document.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "client_backend/client_backend.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// The shape of the bursty arrival processes. Each process keeps the mean
+/// request rate it is created with and uses these to shape the arrivals
+/// around it.
+struct ArrivalProcessOptions {
+  // The coefficient of variation of the gamma intervals
+  double gamma_cv_{4.0};
+  // The ratio of the rate in the burst state to the rate in the idle state of
+  // the Markov-modulated process and the mean time spent in each state
+  double mmpp_burst_ratio_{10.0};
+  double mmpp_burst_ms_{100.0};
+  double mmpp_idle_ms_{900.0};
+  // The tail index of the Pareto distributed on and off periods and their
+  // mean lengths
+  double pareto_alpha_{1.5};
+  double pareto_on_ms_{100.0};
+  double pareto_off_ms_{900.0};
+};
+
+/// A process generating the time between successive requests.
+class ArrivalProcess {
+ public:
+  virtual ~ArrivalProcess() = default;
+
+  /// \param gen The random generator to draw from.
+  /// \return The time from the previous request to the next one.
+  virtual std::chrono::nanoseconds NextInterval(std::mt19937& gen) = 0;
+};
+
+/// Gamma distributed intervals, burstier than Poisson when the coefficient of
+/// variation is over 1.
+class GammaArrivalProcess : public ArrivalProcess {
+ public:
+  GammaArrivalProcess(const double request_rate, const double cv);
+
+  std::chrono::nanoseconds NextInterval(std::mt19937& gen) override;
+
+ private:
+  std::gamma_distribution<> dist_;
+};
+
+/// Poisson arrivals whose rate switches between two states, the time spent
+/// in a state before switching being drawn by the subclass.
+class ModulatedArrivalProcess : public ArrivalProcess {
+ public:
+  std::chrono::nanoseconds NextInterval(std::mt19937& gen) override;
+
+ protected:
+  /// \param idle_rate The request rate in the idle state.
+  /// \param burst_rate The request rate in the burst state.
+  /// \param burst_fraction The fraction of the time spent in the burst state.
+  ModulatedArrivalProcess(
+      const double idle_rate, const double burst_rate,
+      const double burst_fraction);
+
+  /// \param burst Whether to draw the time of the burst state or of the idle
+  /// state.
+  /// \return The time to spend in the state, in seconds.
+  virtual double StateDuration(const bool burst, std::mt19937& gen) = 0;
+
+ private:
+  const double idle_rate_;
+  const double burst_rate_;
+  const double burst_fraction_;
+  bool burst_{false};
+  // The time left in the current state, negative before the first request
+  double remaining_s_{-1.0};
+  std::exponential_distribution<> gap_{1.0};
+};
+
+/// A two-state Markov-modulated Poisson process, staying an exponentially
+/// distributed time in each state.
+class MarkovModulatedArrivalProcess : public ModulatedArrivalProcess {
+ public:
+  MarkovModulatedArrivalProcess(
+      const double request_rate, const double burst_ratio,
+      const double burst_ms, const double idle_ms);
+
+ private:
+  double StateDuration(const bool burst, std::mt19937& gen) override;
+
+  std::exponential_distribution<> burst_duration_;
+  std::exponential_distribution<> idle_duration_;
+};
+
+/// Poisson arrivals during on periods and none during off periods, with
+/// heavy-tailed Pareto distributed on and off periods.
+class ParetoOnOffArrivalProcess : public ModulatedArrivalProcess {
+ public:
+  ParetoOnOffArrivalProcess(
+      const double request_rate, const double alpha, const double on_ms,
+      const double off_ms);
+
+ private:
+  double StateDuration(const bool burst, std::mt19937& gen) override;
+
+  const double alpha_;
+  // The smallest on and off periods, in seconds
+  const double on_scale_s_;
+  const double off_scale_s_;
+  std::uniform_real_distribution<> uniform_{0.0, 1.0};
+};
+
+/// Create the arrival process of a bursty request distribution.
+/// \param distribution One of GAMMA, MMPP and PARETO_ON_OFF.
+/// \param request_rate The mean request rate of the process.
+/// \param options The shape of the process.
+/// \param process Returns the arrival process.
+/// \return cb::Error object indicating success or failure.
+cb::Error CreateArrivalProcess(
+    const Distribution distribution, const double request_rate,
+    const ArrivalProcessOptions& options,
+    std::shared_ptr<ArrivalProcess>* process);
+
+/// \return The request schedule distribution generator drawing from
+/// 'process'.
+std::function<std::chrono::nanoseconds(std::mt19937&)>
+ArrivalProcessDistribution(std::shared_ptr<ArrivalProcess> process);
+
+/// Parse the shape of the arrival processes from a list such as
+/// "cv=8,burst_ratio=20". The keys are cv, burst_ratio, burst_ms, idle_ms,
+/// alpha, on_ms and off_ms, the options not in the list are left unchanged.
+/// \param params The comma separated list of key=value pairs.
+/// \param options Returns the updated options.
+/// \return cb::Error object indicating success or failure.
+cb::Error ParseArrivalProcessOptions(
+    const std::string& params, ArrivalProcessOptions* options);
+
+/// Read the shape of the arrival processes from a JSON file, an object with
+/// the keys of ParseArrivalProcessOptions.
+/// \param path The path of the file.
+/// \param options Returns the updated options.
+/// \return cb::Error object indicating success or failure.
+cb::Error ReadArrivalProcessFile(
+    const std::string& path, ArrivalProcessOptions* options);
+
+/// Parse the JSON form of ReadArrivalProcessFile.
+cb::Error ParseArrivalProcessJson(
+    const rapidjson::Document& json, ArrivalProcessOptions* options);
+
+/// The burstiness of a request schedule.
+struct ScheduleStats {
+  size_t requests_{0};
+  // The coefficient of variation of the time between requests, 1 for Poisson
+  double interval_cv_{0.0};
+  // The windows the requests are counted in, the index of dispersion
+  // (variance over mean) of the counts, 1 for Poisson, and the ratio of the
+  // highest count to the mean count
+  uint64_t window_ms_{0};
+  double count_dispersion_{0.0};
+  double peak_to_mean_{0.0};
+  // The most requests in a row that are closer than the burst gap
+  size_t longest_burst_{0};
+};
+
+/// Collects the ScheduleStats of a schedule as it is generated, in constant
+/// memory.
+class ScheduleStatsCollector {
+ public:
+  /// \param window The windows to count requests in.
+  /// \param burst_gap The time between requests under which they are part
+  /// of a burst.
+  ScheduleStatsCollector(
+      const std::chrono::nanoseconds window,
+      const std::chrono::nanoseconds burst_gap);
+
+  /// Add the next request, 'interval' after the previous one.
+  void Add(const std::chrono::nanoseconds interval);
+
+  /// \return The stats of the requests added so far. Only the windows that
+  /// are over are counted.
+  ScheduleStats Stats() const;
+
+ private:
+  void AddWindowCount(const uint64_t count);
+
+  const uint64_t window_ns_;
+  const uint64_t burst_gap_ns_;
+
+  size_t requests_{0};
+  double interval_sum_{0.0};
+  double interval_sum_squares_{0.0};
+
+  uint64_t timestamp_ns_{0};
+  uint64_t window_{0};
+  uint64_t window_count_{0};
+  uint64_t windows_{0};
+  double count_sum_{0.0};
+  double count_sum_squares_{0.0};
+  uint64_t max_count_{0};
+
+  size_t burst_length_{0};
+  size_t longest_burst_{0};
+};
+
+}}  // namespace triton::perfanalyzer
@@ -26,6 +26,8 @@
 
 #include "client_backend.h"
 
+#include "null/null_client_backend.h"
+#include "shared_client_backend.h"
 #include "triton/triton_client_backend.h"
 
 #ifdef TRITON_ENABLE_PERF_ANALYZER_C_API
@@ -86,6 +88,9 @@ BackendKindToString(const BackendKind kind)
     case TRITON_C_API:
       return std::string("TRITON_C_API");
       break;
+    case NULL_SERVICE:
+      return std::string("NULL_SERVICE");
+      break;
     default:
       return std::string("UNKNOWN");
       break;
@@ -116,7 +121,10 @@ ClientBackendFactory::Create(
     const SslOptionsBase& ssl_options,
     const std::map<std::string, std::vector<std::string>> trace_options,
     const GrpcCompressionAlgorithm compression_algorithm,
-    std::shared_ptr<Headers> http_headers,
+    const CompressionOptions& compression_options,
+    const ResponseCacheOptions& response_cache_options,
+    const NullServiceOptions& null_service_options,
+    const size_t shared_backend_count, std::shared_ptr<Headers> http_headers,
     const std::string& triton_server_path,
     const std::string& model_repository_path, const bool verbose,
     const std::string& metrics_url, const cb::TensorFormat input_tensor_format,
@@ -125,8 +133,10 @@ ClientBackendFactory::Create(
 {
   factory->reset(new ClientBackendFactory(
       kind, url, protocol, ssl_options, trace_options, compression_algorithm,
-      http_headers, triton_server_path, model_repository_path, verbose,
-      metrics_url, input_tensor_format, output_tensor_format));
+      compression_options, response_cache_options, null_service_options,
+      shared_backend_count, http_headers, triton_server_path,
+      model_repository_path, verbose, metrics_url, input_tensor_format,
+      output_tensor_format));
   return Error::Success;
 }
 
@@ -136,12 +146,37 @@ ClientBackendFactory::CreateClientBackend(
 {
   RETURN_IF_CB_ERROR(ClientBackend::Create(
       kind_, url_, protocol_, ssl_options_, trace_options_,
-      compression_algorithm_, http_headers_, verbose_, triton_server_path,
+      compression_algorithm_, compression_options_, response_cache_options_,
+      null_service_options_, http_headers_, verbose_, triton_server_path,
       model_repository_path_, metrics_url_, input_tensor_format_,
       output_tensor_format_, client_backend));
   return Error::Success;
 }
 
+Error
+ClientBackendFactory::CreateContextClientBackend(
+    std::unique_ptr<ClientBackend>* client_backend)
+{
+  if (shared_backend_count_ == 0) {
+    return CreateClientBackend(client_backend);
+  }
+
+  std::shared_ptr<MultiplexedBackend> shared_backend;
+  {
+    std::lock_guard<std::mutex> lk(shared_backends_mutex_);
+    if (shared_backends_.size() < shared_backend_count_) {
+      std::unique_ptr<ClientBackend> local_backend;
+      RETURN_IF_CB_ERROR(CreateClientBackend(&local_backend));
+      shared_backends_.emplace_back(
+          std::make_shared<MultiplexedBackend>(std::move(local_backend)));
+    }
+    shared_backend = shared_backends_[next_shared_backend_];
+    next_shared_backend_ = (next_shared_backend_ + 1) % shared_backend_count_;
+  }
+  client_backend->reset(new SharedClientBackend(shared_backend));
+  return Error::Success;
+}
+
 const BackendKind&
 ClientBackendFactory::Kind()
 {
@@ -157,6 +192,9 @@ ClientBackend::Create(
     const SslOptionsBase& ssl_options,
     const std::map<std::string, std::vector<std::string>> trace_options,
     const GrpcCompressionAlgorithm compression_algorithm,
+    const CompressionOptions& compression_options,
+    const ResponseCacheOptions& response_cache_options,
+    const NullServiceOptions& null_service_options,
     std::shared_ptr<Headers> http_headers, const bool verbose,
     const std::string& triton_server_path,
     const std::string& model_repository_path, const std::string& metrics_url,
@@ -168,9 +206,12 @@ ClientBackend::Create(
   if (kind == TRITON) {
     RETURN_IF_CB_ERROR(tritonremote::TritonClientBackend::Create(
         url, protocol, ssl_options, trace_options,
-        BackendToGrpcType(compression_algorithm), http_headers, verbose,
-        metrics_url, input_tensor_format, output_tensor_format,
-        &local_backend));
+        BackendToGrpcType(compression_algorithm), compression_options,
+        response_cache_options, http_headers, verbose, metrics_url,
+        input_tensor_format, output_tensor_format, &local_backend));
+  } else if (kind == NULL_SERVICE) {
+    RETURN_IF_CB_ERROR(nullservice::NullClientBackend::Create(
+        null_service_options, &local_backend));
   }
 #ifdef TRITON_ENABLE_PERF_ANALYZER_TFS
   else if (kind == TENSORFLOW_SERVING) {
@@ -420,6 +461,9 @@ InferInput::Create(
   if (kind == TRITON) {
     RETURN_IF_CB_ERROR(tritonremote::TritonInferInput::Create(
         infer_input, name, dims, datatype));
+  } else if (kind == NULL_SERVICE) {
+    RETURN_IF_CB_ERROR(nullservice::NullInferInput::Create(
+        infer_input, name, dims, datatype));
   }
 #ifdef TRITON_ENABLE_PERF_ANALYZER_TFS
   else if (kind == TENSORFLOW_SERVING) {
@@ -504,6 +548,9 @@ InferRequestedOutput::Create(
   if (kind == TRITON) {
     RETURN_IF_CB_ERROR(tritonremote::TritonInferRequestedOutput::Create(
         infer_output, name, class_count));
+  } else if (kind == NULL_SERVICE) {
+    RETURN_IF_CB_ERROR(
+        nullservice::NullInferRequestedOutput::Create(infer_output, name));
   }
 #ifdef TRITON_ENABLE_PERF_ANALYZER_TFS
   else if (kind == TENSORFLOW_SERVING) {
@@ -32,6 +32,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -130,12 +131,14 @@ class ClientBackend;
 class InferInput;
 class InferRequestedOutput;
 class InferResult;
+class MultiplexedBackend;
 
 enum BackendKind {
   TRITON = 0,
   TENSORFLOW_SERVING = 1,
   TORCHSERVE = 2,
-  TRITON_C_API = 3
+  TRITON_C_API = 3,
+  NULL_SERVICE = 4
 };
 enum ProtocolType { HTTP = 0, GRPC = 1, UNKNOWN = 2 };
 enum GrpcCompressionAlgorithm {
@@ -143,9 +146,61 @@ enum GrpcCompressionAlgorithm {
   COMPRESS_DEFLATE = 1,
   COMPRESS_GZIP = 2
 };
+enum HttpCompressionAlgorithm {
+  HTTP_COMPRESS_NONE = 0,
+  HTTP_COMPRESS_DEFLATE = 1,
+  HTTP_COMPRESS_GZIP = 2,
+  HTTP_COMPRESS_ZSTD = 3,
+  HTTP_COMPRESS_LZ4 = 4
+};
 enum class TensorFormat { BINARY, JSON, UNKNOWN };
 typedef std::map<std::string, std::string> Headers;
 
+/// The options for compressing the inference requests, on top of the
+/// gRPC compression algorithm.
+struct CompressionOptions {
+  /// The compression algorithm of the HTTP request bodies.
+  HttpCompressionAlgorithm http_compression_algorithm{HTTP_COMPRESS_NONE};
+  /// The codec specific compression level of the HTTP request bodies, 0
+  /// selects the default level of the codec.
+  int level{0};
+  /// Requests whose input data is smaller than this number of bytes are
+  /// sent uncompressed.
+  size_t min_byte_size{0};
+  /// HTTP request bodies are sent uncompressed while the sampled
+  /// compression ratio is below this value, 0 disables sampling.
+  double min_ratio{0.0};
+};
+
+/// The options of the client-side response cache of the client library.
+struct ResponseCacheOptions {
+  /// The maximum total size, in bytes, of the cached responses, 0
+  /// disables the cache.
+  size_t max_byte_size{0};
+  /// The time, in milliseconds, after which a cached response expires, 0
+  /// means the responses don't expire.
+  uint64_t ttl_ms{0};
+};
+
+/// The options of the null service, which completes the requests without
+/// sending them anywhere to measure the load perf_analyzer itself can
+/// generate.
+struct NullServiceOptions {
+  enum class LatencyDistribution { CONSTANT, UNIFORM, NORMAL, EXPONENTIAL };
+  /// The distribution of the synthetic latency of each response.
+  LatencyDistribution latency_distribution{LatencyDistribution::CONSTANT};
+  /// The mean synthetic latency in microseconds, 0 completes the requests
+  /// immediately.
+  uint64_t latency_us{0};
+  /// The standard deviation of the NORMAL distribution, and the half width
+  /// of the range of the UNIFORM distribution, in microseconds.
+  uint64_t latency_spread_us{0};
+  /// Whether the service behaves as a decoupled model, which returns
+  /// 'response_count' responses to each streaming request.
+  bool decoupled{false};
+  size_t response_count{1};
+};
+
 using OnCompleteFn = std::function<void(InferResult*)>;
 using ModelIdentifier = std::pair<std::string, std::string>;
 
@@ -164,10 +219,18 @@ struct InferStat {
   /// response is completely received.
   uint64_t cumulative_receive_time_ns;
 
+  /// Number of requests served from the client-side response cache.
+  size_t cache_hit_count;
+
+  /// Number of cacheable requests not found in the client-side response
+  /// cache.
+  size_t cache_miss_count;
+
   /// Create a new InferStat object with zero-ed statistics.
   InferStat()
       : completed_request_count(0), cumulative_total_request_time_ns(0),
-        cumulative_send_time_ns(0), cumulative_receive_time_ns(0)
+        cumulative_send_time_ns(0), cumulative_receive_time_ns(0),
+        cache_hit_count(0), cache_miss_count(0)
   {
   }
 };
@@ -271,6 +334,14 @@ class ClientBackendFactory {
   /// \param ssl_options The SSL options used with client backend.
   /// \param compression_algorithm The compression algorithm to be used
   /// on the grpc requests.
+  /// \param compression_options The HTTP compression algorithm and the
+  /// options deciding when requests are compressed.
+  /// \param response_cache_options The options of the client-side
+  /// response cache.
+  /// \param null_service_options Only for the null backend. The synthetic
+  /// latency and responses of the requests.
+  /// \param shared_backend_count The number of backends shared by all the
+  /// inference contexts, 0 to give each context its own backend.
   /// \param http_headers Map of HTTP headers. The map key/value
   /// indicates the header name/value. The headers will be included
   /// with all the requests made to server using this client.
@@ -292,7 +363,10 @@ class ClientBackendFactory {
       const ProtocolType protocol, const SslOptionsBase& ssl_options,
       const std::map<std::string, std::vector<std::string>> trace_options,
       const GrpcCompressionAlgorithm compression_algorithm,
-      std::shared_ptr<Headers> http_headers,
+      const CompressionOptions& compression_options,
+      const ResponseCacheOptions& response_cache_options,
+      const NullServiceOptions& null_service_options,
+      const size_t shared_backend_count, std::shared_ptr<Headers> http_headers,
       const std::string& triton_server_path,
       const std::string& model_repository_path, const bool verbose,
       const std::string& metrics_url, const TensorFormat input_tensor_format,
@@ -305,12 +379,22 @@ class ClientBackendFactory {
   /// \param backend Returns a new Client backend object.
   virtual Error CreateClientBackend(std::unique_ptr<ClientBackend>* backend);
 
+  /// Create the ClientBackend of an inference context. When backends are
+  /// shared, the requests of the context are multiplexed over one of the
+  /// shared backends, otherwise the context gets a backend of its own.
+  /// \param backend Returns a new Client backend object.
+  Error CreateContextClientBackend(std::unique_ptr<ClientBackend>* backend);
+
  private:
   ClientBackendFactory(
       const BackendKind kind, const std::string& url,
       const ProtocolType protocol, const SslOptionsBase& ssl_options,
       const std::map<std::string, std::vector<std::string>> trace_options,
       const GrpcCompressionAlgorithm compression_algorithm,
+      const CompressionOptions& compression_options,
+      const ResponseCacheOptions& response_cache_options,
+      const NullServiceOptions& null_service_options,
+      const size_t shared_backend_count,
       const std::shared_ptr<Headers> http_headers,
       const std::string& triton_server_path,
       const std::string& model_repository_path, const bool verbose,
@@ -319,6 +403,10 @@ class ClientBackendFactory {
       : kind_(kind), url_(url), protocol_(protocol), ssl_options_(ssl_options),
         trace_options_(trace_options),
         compression_algorithm_(compression_algorithm),
+        compression_options_(compression_options),
+        response_cache_options_(response_cache_options),
+        null_service_options_(null_service_options),
+        shared_backend_count_(shared_backend_count),
         http_headers_(http_headers), triton_server_path(triton_server_path),
         model_repository_path_(model_repository_path), verbose_(verbose),
         metrics_url_(metrics_url), input_tensor_format_(input_tensor_format),
@@ -332,6 +420,10 @@ class ClientBackendFactory {
   const SslOptionsBase& ssl_options_;
   const std::map<std::string, std::vector<std::string>> trace_options_;
   const GrpcCompressionAlgorithm compression_algorithm_;
+  const CompressionOptions compression_options_;
+  const ResponseCacheOptions response_cache_options_;
+  const NullServiceOptions null_service_options_;
+  const size_t shared_backend_count_{0};
   std::shared_ptr<Headers> http_headers_;
   std::string triton_server_path;
   std::string model_repository_path_;
@@ -340,6 +432,11 @@ class ClientBackendFactory {
   const TensorFormat input_tensor_format_{TensorFormat::UNKNOWN};
   const TensorFormat output_tensor_format_{TensorFormat::UNKNOWN};
 
+  // The backends shared by the inference contexts, created on demand and
+  // handed out in turn
+  std::mutex shared_backends_mutex_;
+  std::vector<std::shared_ptr<MultiplexedBackend>> shared_backends_;
+  size_t next_shared_backend_{0};
 
 #ifndef DOCTEST_CONFIG_DISABLE
  protected:
@@ -363,6 +460,9 @@ class ClientBackend {
       const ProtocolType protocol, const SslOptionsBase& ssl_options,
       const std::map<std::string, std::vector<std::string>> trace_options,
       const GrpcCompressionAlgorithm compression_algorithm,
+      const CompressionOptions& compression_options,
+      const ResponseCacheOptions& response_cache_options,
+      const NullServiceOptions& null_service_options,
       std::shared_ptr<Headers> http_headers, const bool verbose,
       const std::string& library_directory, const std::string& model_repository,
       const std::string& metrics_url, const TensorFormat input_tensor_format,
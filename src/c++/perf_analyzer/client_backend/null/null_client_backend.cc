@@ -0,0 +1,382 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "null_client_backend.h"
+
+#include <algorithm>
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace nullservice {
+
+//==============================================================================
+
+Error
+NullClientBackend::Create(
+    const NullServiceOptions& options,
+    std::unique_ptr<ClientBackend>* client_backend)
+{
+  if (options.response_count == 0) {
+    return Error(
+        "the null service must return at least one response per request",
+        pa::GENERIC_ERROR);
+  }
+  client_backend->reset(new NullClientBackend(options));
+  return Error::Success;
+}
+
+NullClientBackend::NullClientBackend(const NullServiceOptions& options)
+    : ClientBackend(BackendKind::NULL_SERVICE), options_(options),
+      rng_(std::random_device{}())
+{
+}
+
+NullClientBackend::~NullClientBackend()
+{
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    exiting_ = true;
+  }
+  cv_.notify_all();
+  if (timer_thread_.joinable()) {
+    timer_thread_.join();
+  }
+
+  // The responses not delivered yet are dropped, as the callbacks may refer
+  // to objects that are being destroyed
+  while (!pending_.empty()) {
+    delete pending_.top().result;
+    pending_.pop();
+  }
+}
+
+Error
+NullClientBackend::Infer(
+    InferResult** result, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  const auto start = Clock::now();
+  const uint64_t latency_ns = SampleLatencyNs();
+  if (latency_ns != 0) {
+    std::this_thread::sleep_until(start + std::chrono::nanoseconds(latency_ns));
+  }
+  *result = new NullInferResult(
+      options.request_id_, true /* is_final_response */,
+      false /* is_null_response */);
+  RecordCompletion(start);
+  return Error::Success;
+}
+
+Error
+NullClientBackend::AsyncInfer(
+    OnCompleteFn callback, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  if (options_.decoupled) {
+    return Error(
+        "the decoupled null service only supports streaming requests",
+        pa::GENERIC_ERROR);
+  }
+  ScheduleResponses(
+      options, std::move(callback), false /* decoupled */,
+      true /* record_stat */);
+  return Error::Success;
+}
+
+Error
+NullClientBackend::StartStream(OnCompleteFn callback, bool enable_stats)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  stream_callback_ = std::move(callback);
+  enable_stream_stats_ = enable_stats;
+  return Error::Success;
+}
+
+Error
+NullClientBackend::AsyncStreamInfer(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  if (stream_callback_ == nullptr) {
+    return Error(
+        "stream not available, use StartStream() to make one available.",
+        pa::GENERIC_ERROR);
+  }
+  ScheduleResponses(
+      options, nullptr, options_.decoupled, enable_stream_stats_);
+  return Error::Success;
+}
+
+Error
+NullClientBackend::ClientInferStat(InferStat* infer_stat)
+{
+  std::lock_guard<std::mutex> lk(stat_mutex_);
+  *infer_stat = infer_stat_;
+  return Error::Success;
+}
+
+uint64_t
+NullClientBackend::SampleLatencyNs()
+{
+  const double mean_ns = options_.latency_us * 1000.0;
+  const double spread_ns = options_.latency_spread_us * 1000.0;
+  double latency_ns = mean_ns;
+  switch (options_.latency_distribution) {
+    case NullServiceOptions::LatencyDistribution::CONSTANT:
+      return static_cast<uint64_t>(mean_ns);
+    case NullServiceOptions::LatencyDistribution::UNIFORM: {
+      std::uniform_real_distribution<double> distribution(
+          std::max(mean_ns - spread_ns, 0.0), mean_ns + spread_ns);
+      std::lock_guard<std::mutex> lk(rng_mutex_);
+      latency_ns = distribution(rng_);
+      break;
+    }
+    case NullServiceOptions::LatencyDistribution::NORMAL: {
+      std::normal_distribution<double> distribution(mean_ns, spread_ns);
+      std::lock_guard<std::mutex> lk(rng_mutex_);
+      latency_ns = distribution(rng_);
+      break;
+    }
+    case NullServiceOptions::LatencyDistribution::EXPONENTIAL: {
+      if (mean_ns <= 0) {
+        return 0;
+      }
+      std::exponential_distribution<double> distribution(1.0 / mean_ns);
+      std::lock_guard<std::mutex> lk(rng_mutex_);
+      latency_ns = distribution(rng_);
+      break;
+    }
+  }
+  return static_cast<uint64_t>(std::max(latency_ns, 0.0));
+}
+
+void
+NullClientBackend::ScheduleResponses(
+    const InferOptions& options, OnCompleteFn callback, const bool decoupled,
+    const bool record_stat)
+{
+  const auto start = Clock::now();
+
+  // A decoupled request returns each of its responses a sampled latency
+  // after the previous one, followed by an empty final response if
+  // requested, as Triton does.
+  const size_t response_count = decoupled ? options_.response_count : 1;
+  const bool empty_final_response =
+      decoupled && options.triton_enable_empty_final_response_;
+  std::vector<PendingResponse> responses;
+  auto deadline = start;
+  for (size_t i = 0; i < response_count; ++i) {
+    deadline += std::chrono::nanoseconds(SampleLatencyNs());
+    const bool is_final = ((i + 1) == response_count) && !empty_final_response;
+    responses.push_back(PendingResponse{
+        deadline, 0, callback,
+        new NullInferResult(
+            options.request_id_, is_final, false /* is_null_response */),
+        start, record_stat && is_final});
+  }
+  if (empty_final_response) {
+    responses.push_back(PendingResponse{
+        deadline, 0, callback,
+        new NullInferResult(
+            options.request_id_, true /* is_final_response */,
+            true /* is_null_response */),
+        start, record_stat});
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (!timer_thread_.joinable()) {
+      timer_thread_ = std::thread(&NullClientBackend::TimerLoop, this);
+    }
+    for (auto& response : responses) {
+      response.sequence = next_sequence_++;
+      pending_.push(std::move(response));
+    }
+  }
+  cv_.notify_one();
+}
+
+void
+NullClientBackend::TimerLoop()
+{
+  std::vector<PendingResponse> due;
+  std::unique_lock<std::mutex> lk(mutex_);
+  while (!exiting_) {
+    if (pending_.empty()) {
+      cv_.wait(lk);
+      continue;
+    }
+    const auto deadline = pending_.top().deadline;
+    if (Clock::now() < deadline) {
+      cv_.wait_until(lk, deadline);
+      continue;
+    }
+
+    const auto now = Clock::now();
+    while (!pending_.empty() && (pending_.top().deadline <= now)) {
+      due.push_back(pending_.top());
+      pending_.pop();
+    }
+    OnCompleteFn stream_callback = stream_callback_;
+    lk.unlock();
+
+    for (auto& response : due) {
+      if (response.record_stat) {
+        RecordCompletion(response.start);
+      }
+      if (response.callback != nullptr) {
+        response.callback(response.result);
+      } else {
+        stream_callback(response.result);
+      }
+    }
+    due.clear();
+
+    lk.lock();
+  }
+}
+
+void
+NullClientBackend::RecordCompletion(const Clock::time_point start)
+{
+  const uint64_t request_time_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          Clock::now() - start)
+          .count();
+  std::lock_guard<std::mutex> lk(stat_mutex_);
+  infer_stat_.completed_request_count++;
+  infer_stat_.cumulative_total_request_time_ns += request_time_ns;
+}
+
+//==============================================================================
+
+Error
+NullInferInput::Create(
+    InferInput** infer_input, const std::string& name,
+    const std::vector<int64_t>& dims, const std::string& datatype)
+{
+  *infer_input = new NullInferInput(name, dims, datatype);
+  return Error::Success;
+}
+
+Error
+NullInferInput::SetShape(const std::vector<int64_t>& shape)
+{
+  shape_ = shape;
+  return Error::Success;
+}
+
+Error
+NullInferInput::Reset()
+{
+  byte_size_ = 0;
+  return Error::Success;
+}
+
+Error
+NullInferInput::AppendRaw(const uint8_t* input, size_t input_byte_size)
+{
+  byte_size_ += input_byte_size;
+  return Error::Success;
+}
+
+NullInferInput::NullInferInput(
+    const std::string& name, const std::vector<int64_t>& dims,
+    const std::string& datatype)
+    : InferInput(BackendKind::NULL_SERVICE, name, datatype), shape_(dims)
+{
+}
+
+//==============================================================================
+
+Error
+NullInferRequestedOutput::Create(
+    InferRequestedOutput** infer_output, const std::string& name)
+{
+  *infer_output = new NullInferRequestedOutput(name);
+  return Error::Success;
+}
+
+NullInferRequestedOutput::NullInferRequestedOutput(const std::string& name)
+    : InferRequestedOutput(BackendKind::NULL_SERVICE, name)
+{
+}
+
+//==============================================================================
+
+NullInferResult::NullInferResult(
+    const std::string& request_id, const bool is_final_response,
+    const bool is_null_response)
+    : request_id_(request_id), is_final_response_(is_final_response),
+      is_null_response_(is_null_response)
+{
+}
+
+Error
+NullInferResult::Id(std::string* id) const
+{
+  *id = request_id_;
+  return Error::Success;
+}
+
+Error
+NullInferResult::RequestStatus() const
+{
+  return Error::Success;
+}
+
+Error
+NullInferResult::RawData(
+    const std::string& output_name, const uint8_t** buf,
+    size_t* byte_size) const
+{
+  *buf = nullptr;
+  *byte_size = 0;
+  return Error::Success;
+}
+
+Error
+NullInferResult::IsFinalResponse(bool* is_final_response) const
+{
+  if (is_final_response == nullptr) {
+    return Error("is_final_response cannot be nullptr");
+  }
+  *is_final_response = is_final_response_;
+  return Error::Success;
+}
+
+Error
+NullInferResult::IsNullResponse(bool* is_null_response) const
+{
+  if (is_null_response == nullptr) {
+    return Error("is_null_response cannot be nullptr");
+  }
+  *is_null_response = is_null_response_;
+  return Error::Success;
+}
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::nullservice
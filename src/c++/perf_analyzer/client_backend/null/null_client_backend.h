@@ -0,0 +1,212 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../client_backend.h"
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace nullservice {
+
+//==============================================================================
+/// NullClientBackend completes the requests without sending them anywhere,
+/// immediately or after a synthetic latency, so that the rate perf_analyzer
+/// can generate requests at is measured without a server being the
+/// bottleneck. The asynchronous and streaming responses are delivered from a
+/// timer thread, as the responses of a real service are delivered from the
+/// thread of the client library.
+///
+class NullClientBackend : public ClientBackend {
+ public:
+  /// Create a null client backend.
+  /// \param options The synthetic latency and responses of the requests.
+  /// \param client_backend Returns a new NullClientBackend object.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      const NullServiceOptions& options,
+      std::unique_ptr<ClientBackend>* client_backend);
+
+  ~NullClientBackend();
+
+  /// See ClientBackend::Infer()
+  Error Infer(
+      InferResult** result, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override;
+
+  /// See ClientBackend::AsyncInfer()
+  Error AsyncInfer(
+      OnCompleteFn callback, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override;
+
+  /// See ClientBackend::StartStream()
+  Error StartStream(OnCompleteFn callback, bool enable_stats) override;
+
+  /// See ClientBackend::AsyncStreamInfer()
+  Error AsyncStreamInfer(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override;
+
+  /// See ClientBackend::ClientInferStat()
+  Error ClientInferStat(InferStat* infer_stat) override;
+
+ protected:
+  NullClientBackend(const NullServiceOptions& options);
+
+  /// \return The synthetic latency of the next response in nanoseconds.
+  uint64_t SampleLatencyNs();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  // A response to deliver once 'deadline' is reached.
+  struct PendingResponse {
+    Clock::time_point deadline;
+    // Orders the responses due at the same time by scheduling order
+    uint64_t sequence;
+    // The callback of the asynchronous request, unset for the stream
+    OnCompleteFn callback;
+    InferResult* result;
+    // The start of the request if its completion is recorded in the stats
+    Clock::time_point start;
+    bool record_stat;
+
+    bool operator>(const PendingResponse& rhs) const
+    {
+      return (deadline != rhs.deadline) ? (deadline > rhs.deadline)
+                                        : (sequence > rhs.sequence);
+    }
+  };
+
+  // Schedule the responses of the request described by 'options'.
+  void ScheduleResponses(
+      const InferOptions& options, OnCompleteFn callback,
+      const bool decoupled, const bool record_stat);
+  void TimerLoop();
+  void RecordCompletion(const Clock::time_point start);
+
+  const NullServiceOptions options_;
+
+  std::mutex rng_mutex_;
+  std::mt19937_64 rng_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::priority_queue<
+      PendingResponse, std::vector<PendingResponse>,
+      std::greater<PendingResponse>>
+      pending_;
+  uint64_t next_sequence_{0};
+  bool exiting_{false};
+  // Started on the first asynchronous request
+  std::thread timer_thread_;
+
+  OnCompleteFn stream_callback_;
+  bool enable_stream_stats_{false};
+
+  std::mutex stat_mutex_;
+  InferStat infer_stat_;
+};
+
+//==============================================================
+/// NullInferInput only keeps track of the shape and the size of the data
+/// of an input, the data itself is never read.
+///
+class NullInferInput : public InferInput {
+ public:
+  static Error Create(
+      InferInput** infer_input, const std::string& name,
+      const std::vector<int64_t>& dims, const std::string& datatype);
+  /// See InferInput::Shape()
+  const std::vector<int64_t>& Shape() const override { return shape_; }
+  /// See InferInput::SetShape()
+  Error SetShape(const std::vector<int64_t>& shape) override;
+  /// See InferInput::Reset()
+  Error Reset() override;
+  /// See InferInput::AppendRaw()
+  Error AppendRaw(const uint8_t* input, size_t input_byte_size) override;
+  /// \return The size of the data appended since the last Reset().
+  size_t ByteSize() const { return byte_size_; }
+
+ private:
+  explicit NullInferInput(
+      const std::string& name, const std::vector<int64_t>& dims,
+      const std::string& datatype);
+
+  std::vector<int64_t> shape_;
+  size_t byte_size_{0};
+};
+
+//==============================================================
+/// NullInferRequestedOutput describes an output of the null service.
+///
+class NullInferRequestedOutput : public InferRequestedOutput {
+ public:
+  static Error Create(
+      InferRequestedOutput** infer_output, const std::string& name);
+
+ private:
+  explicit NullInferRequestedOutput(const std::string& name);
+};
+
+//==============================================================
+/// NullInferResult is a response of the null service, it holds no
+/// output data.
+///
+class NullInferResult : public InferResult {
+ public:
+  NullInferResult(
+      const std::string& request_id, const bool is_final_response,
+      const bool is_null_response);
+  /// See InferResult::Id()
+  Error Id(std::string* id) const override;
+  /// See InferResult::RequestStatus()
+  Error RequestStatus() const override;
+  /// See InferResult::RawData()
+  Error RawData(
+      const std::string& output_name, const uint8_t** buf,
+      size_t* byte_size) const override;
+  /// See InferResult::IsFinalResponse()
+  Error IsFinalResponse(bool* is_final_response) const override;
+  /// See InferResult::IsNullResponse()
+  Error IsNullResponse(bool* is_null_response) const override;
+
+ private:
+  const std::string request_id_;
+  const bool is_final_response_;
+  const bool is_null_response_;
+};
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::nullservice
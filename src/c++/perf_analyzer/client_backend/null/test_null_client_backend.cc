@@ -0,0 +1,210 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../../doctest.h"
+#include "null_client_backend.h"
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace nullservice {
+
+class TestNullClientBackend : public NullClientBackend {
+ public:
+  TestNullClientBackend(const NullServiceOptions& options)
+      : NullClientBackend(options)
+  {
+  }
+
+  using NullClientBackend::SampleLatencyNs;
+};
+
+// Collects the responses delivered to a callback.
+struct ResponseCollector {
+  void Add(InferResult* result)
+  {
+    std::lock_guard<std::mutex> lk(mutex);
+    bool is_final = false;
+    bool is_null = false;
+    result->IsFinalResponse(&is_final);
+    result->IsNullResponse(&is_null);
+    final_flags.push_back(is_final);
+    null_flags.push_back(is_null);
+    thread_ids.push_back(std::this_thread::get_id());
+    delete result;
+    cv.notify_all();
+  }
+
+  bool WaitFor(const size_t count)
+  {
+    std::unique_lock<std::mutex> lk(mutex);
+    return cv.wait_for(lk, std::chrono::seconds(5), [&] {
+      return final_flags.size() >= count;
+    });
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<bool> final_flags;
+  std::vector<bool> null_flags;
+  std::vector<std::thread::id> thread_ids;
+};
+
+TEST_CASE("null_client_backend: latency distributions")
+{
+  NullServiceOptions options;
+  options.latency_us = 100;
+  options.latency_spread_us = 50;
+
+  SUBCASE("constant")
+  {
+    TestNullClientBackend backend(options);
+    CHECK(backend.SampleLatencyNs() == 100000);
+  }
+  SUBCASE("uniform")
+  {
+    options.latency_distribution =
+        NullServiceOptions::LatencyDistribution::UNIFORM;
+    TestNullClientBackend backend(options);
+    for (size_t i = 0; i < 1000; ++i) {
+      const uint64_t latency_ns = backend.SampleLatencyNs();
+      CHECK(latency_ns >= 50000);
+      CHECK(latency_ns <= 150000);
+    }
+  }
+  SUBCASE("exponential")
+  {
+    options.latency_distribution =
+        NullServiceOptions::LatencyDistribution::EXPONENTIAL;
+    TestNullClientBackend backend(options);
+    double total_ns = 0;
+    const size_t count = 100000;
+    for (size_t i = 0; i < count; ++i) {
+      total_ns += backend.SampleLatencyNs();
+    }
+    CHECK(total_ns / count == doctest::Approx(100000).epsilon(0.05));
+  }
+}
+
+TEST_CASE("null_client_backend: requests")
+{
+  NullServiceOptions options;
+  InferOptions infer_options("null_model");
+  infer_options.request_id_ = "42";
+  std::vector<InferInput*> inputs;
+  std::vector<const InferRequestedOutput*> outputs;
+  ResponseCollector collector;
+
+  SUBCASE("sync")
+  {
+    options.latency_us = 1000;
+    TestNullClientBackend backend(options);
+    const auto start = std::chrono::steady_clock::now();
+    InferResult* result;
+    REQUIRE(backend.Infer(&result, infer_options, inputs, outputs).IsOk());
+    CHECK(
+        std::chrono::steady_clock::now() - start >=
+        std::chrono::microseconds(1000));
+    std::string id;
+    CHECK(result->Id(&id).IsOk());
+    CHECK(id == "42");
+    delete result;
+
+    InferStat stat;
+    CHECK(backend.ClientInferStat(&stat).IsOk());
+    CHECK(stat.completed_request_count == 1);
+    CHECK(stat.cumulative_total_request_time_ns >= 1000000);
+  }
+
+  SUBCASE("async")
+  {
+    TestNullClientBackend backend(options);
+    REQUIRE(backend
+                .AsyncInfer(
+                    [&](InferResult* result) { collector.Add(result); },
+                    infer_options, inputs, outputs)
+                .IsOk());
+    REQUIRE(collector.WaitFor(1));
+    CHECK(collector.final_flags == std::vector<bool>{true});
+    // Delivered from the timer thread, as a real client library would
+    CHECK(collector.thread_ids[0] != std::this_thread::get_id());
+
+    InferStat stat;
+    CHECK(backend.ClientInferStat(&stat).IsOk());
+    CHECK(stat.completed_request_count == 1);
+  }
+
+  SUBCASE("decoupled stream")
+  {
+    options.decoupled = true;
+    options.response_count = 3;
+    TestNullClientBackend backend(options);
+    REQUIRE(backend
+                .StartStream(
+                    [&](InferResult* result) { collector.Add(result); },
+                    false /* enable_stats */)
+                .IsOk());
+
+    SUBCASE("empty final response")
+    {
+      REQUIRE(
+          backend.AsyncStreamInfer(infer_options, inputs, outputs).IsOk());
+      REQUIRE(collector.WaitFor(4));
+      CHECK(
+          collector.final_flags ==
+          std::vector<bool>{false, false, false, true});
+      CHECK(
+          collector.null_flags ==
+          std::vector<bool>{false, false, false, true});
+    }
+    SUBCASE("no empty final response")
+    {
+      infer_options.triton_enable_empty_final_response_ = false;
+      REQUIRE(
+          backend.AsyncStreamInfer(infer_options, inputs, outputs).IsOk());
+      REQUIRE(collector.WaitFor(3));
+      CHECK(collector.final_flags == std::vector<bool>{false, false, true});
+      CHECK(collector.null_flags == std::vector<bool>{false, false, false});
+    }
+
+    // The stats of decoupled requests are not collected
+    InferStat stat;
+    CHECK(backend.ClientInferStat(&stat).IsOk());
+    CHECK(stat.completed_request_count == 0);
+
+    CHECK(!backend
+               .AsyncInfer(
+                   [&](InferResult* result) { collector.Add(result); },
+                   infer_options, inputs, outputs)
+               .IsOk());
+  }
+}
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::nullservice
@@ -0,0 +1,291 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "shared_client_backend.h"
+
+#include <cstdlib>
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+
+//==============================================================================
+
+void
+ContextCallbacks::Invoke(const OnCompleteFn& callback, InferResult* result)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (detached_) {
+    delete result;
+    return;
+  }
+  callback(result);
+}
+
+void
+ContextCallbacks::Detach()
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  detached_ = true;
+}
+
+//==============================================================================
+
+MultiplexedBackend::MultiplexedBackend(std::unique_ptr<ClientBackend> backend)
+    : backend_(std::move(backend))
+{
+}
+
+MultiplexedBackend::~MultiplexedBackend()
+{
+  // Stop the client first, its stream delivers the responses through this
+  // object
+  backend_.reset();
+}
+
+uint64_t
+MultiplexedBackend::NextClientId()
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  return next_client_id_++;
+}
+
+Error
+MultiplexedBackend::RegisterStreamClient(
+    const uint64_t client_id, std::shared_ptr<ContextCallbacks> callbacks,
+    const bool enable_stats)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (!stream_started_) {
+    auto send_lock = SendLock();
+    RETURN_IF_CB_ERROR(backend_->StartStream(
+        [this](InferResult* result) { StreamCallback(result); },
+        enable_stats));
+    stream_started_ = true;
+  }
+  stream_clients_[client_id] = std::move(callbacks);
+  return Error::Success;
+}
+
+void
+MultiplexedBackend::UnregisterStreamClient(const uint64_t client_id)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  stream_clients_.erase(client_id);
+}
+
+Error
+MultiplexedBackend::AccumulateInferStat(InferStat* infer_stat)
+{
+  // The statistics are read under the lock so that the differences handed
+  // out are never negative
+  std::lock_guard<std::mutex> lk(mutex_);
+  InferStat stat;
+  RETURN_IF_CB_ERROR(backend_->ClientInferStat(&stat));
+  infer_stat->completed_request_count +=
+      stat.completed_request_count - reported_stat_.completed_request_count;
+  infer_stat->cumulative_total_request_time_ns +=
+      stat.cumulative_total_request_time_ns -
+      reported_stat_.cumulative_total_request_time_ns;
+  infer_stat->cumulative_send_time_ns +=
+      stat.cumulative_send_time_ns - reported_stat_.cumulative_send_time_ns;
+  infer_stat->cumulative_receive_time_ns +=
+      stat.cumulative_receive_time_ns -
+      reported_stat_.cumulative_receive_time_ns;
+  infer_stat->cache_hit_count +=
+      stat.cache_hit_count - reported_stat_.cache_hit_count;
+  infer_stat->cache_miss_count +=
+      stat.cache_miss_count - reported_stat_.cache_miss_count;
+  reported_stat_ = stat;
+  return Error::Success;
+}
+
+std::string
+MultiplexedBackend::StreamRequestId(
+    const uint64_t client_id, const std::string& request_id)
+{
+  return std::to_string(client_id) + ":" + request_id;
+}
+
+void
+MultiplexedBackend::StreamCallback(InferResult* result)
+{
+  std::string id;
+  result->Id(&id);
+  const size_t pos = id.find(':');
+
+  std::shared_ptr<ContextCallbacks> callbacks;
+  std::string request_id;
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (pos != std::string::npos) {
+      const auto it =
+          stream_clients_.find(std::strtoull(id.c_str(), nullptr, 10));
+      if (it == stream_clients_.end()) {
+        // The context that sent the request is gone
+        delete result;
+        return;
+      }
+      callbacks = it->second;
+      request_id = id.substr(pos + 1);
+    } else if (!stream_clients_.empty()) {
+      // A response that can't be routed, such as an error of the stream
+      // itself, is handed to one of the contexts so that it gets reported
+      callbacks = stream_clients_.begin()->second;
+      request_id = id;
+    }
+  }
+
+  if (callbacks == nullptr) {
+    delete result;
+    return;
+  }
+  callbacks->Invoke(
+      callbacks->stream_callback_, new StreamInferResult(result, request_id));
+}
+
+//==============================================================================
+
+SharedClientBackend::SharedClientBackend(
+    std::shared_ptr<MultiplexedBackend> shared_backend)
+    : ClientBackend(shared_backend->Backend()->Kind()),
+      shared_backend_(shared_backend),
+      client_id_(shared_backend->NextClientId()),
+      callbacks_(std::make_shared<ContextCallbacks>())
+{
+}
+
+SharedClientBackend::~SharedClientBackend()
+{
+  if (stream_registered_) {
+    shared_backend_->UnregisterStreamClient(client_id_);
+  }
+  // The shared backend outlives this context, make sure none of its
+  // responses reach the context once it is destroyed
+  callbacks_->Detach();
+}
+
+Error
+SharedClientBackend::Infer(
+    InferResult** result, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  auto send_lock = shared_backend_->SendLock();
+  return shared_backend_->Backend()->Infer(result, options, inputs, outputs);
+}
+
+Error
+SharedClientBackend::AsyncInfer(
+    OnCompleteFn callback, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  std::shared_ptr<ContextCallbacks> callbacks = callbacks_;
+  auto send_lock = shared_backend_->SendLock();
+  return shared_backend_->Backend()->AsyncInfer(
+      [callbacks, callback](InferResult* result) {
+        callbacks->Invoke(callback, result);
+      },
+      options, inputs, outputs);
+}
+
+Error
+SharedClientBackend::StartStream(OnCompleteFn callback, bool enable_stats)
+{
+  callbacks_->stream_callback_ = std::move(callback);
+  RETURN_IF_CB_ERROR(shared_backend_->RegisterStreamClient(
+      client_id_, callbacks_, enable_stats));
+  stream_registered_ = true;
+  return Error::Success;
+}
+
+Error
+SharedClientBackend::AsyncStreamInfer(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  stream_options_ = options;
+  stream_options_.request_id_ =
+      MultiplexedBackend::StreamRequestId(client_id_, options.request_id_);
+  auto send_lock = shared_backend_->SendLock();
+  return shared_backend_->Backend()->AsyncStreamInfer(
+      stream_options_, inputs, outputs);
+}
+
+Error
+SharedClientBackend::ClientInferStat(InferStat* infer_stat)
+{
+  RETURN_IF_CB_ERROR(shared_backend_->AccumulateInferStat(&infer_stat_));
+  *infer_stat = infer_stat_;
+  return Error::Success;
+}
+
+//==============================================================================
+
+StreamInferResult::StreamInferResult(
+    InferResult* result, const std::string& request_id)
+    : result_(result), request_id_(request_id)
+{
+}
+
+StreamInferResult::~StreamInferResult()
+{
+  delete result_;
+}
+
+Error
+StreamInferResult::Id(std::string* id) const
+{
+  *id = request_id_;
+  return Error::Success;
+}
+
+Error
+StreamInferResult::RequestStatus() const
+{
+  return result_->RequestStatus();
+}
+
+Error
+StreamInferResult::RawData(
+    const std::string& output_name, const uint8_t** buf,
+    size_t* byte_size) const
+{
+  return result_->RawData(output_name, buf, byte_size);
+}
+
+Error
+StreamInferResult::IsFinalResponse(bool* is_final_response) const
+{
+  return result_->IsFinalResponse(is_final_response);
+}
+
+Error
+StreamInferResult::IsNullResponse(bool* is_null_response) const
+{
+  return result_->IsNullResponse(is_null_response);
+}
+
+}}}  // namespace triton::perfanalyzer::clientbackend
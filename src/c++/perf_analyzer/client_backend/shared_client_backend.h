@@ -0,0 +1,191 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "client_backend.h"
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+
+//==============================================================================
+/// ContextCallbacks delivers the responses of a context using a shared
+/// backend. The responses of a shared backend may outlive the context, once
+/// the context is detached the responses still to come are dropped.
+///
+class ContextCallbacks {
+ public:
+  /// Call 'callback' with 'result' unless the context is detached.
+  void Invoke(const OnCompleteFn& callback, InferResult* result);
+
+  /// Drop the responses to come, waiting for the one being delivered.
+  void Detach();
+
+  /// The callback of the stream responses of the context.
+  OnCompleteFn stream_callback_;
+
+ private:
+  std::mutex mutex_;
+  bool detached_{false};
+};
+
+//==============================================================================
+/// MultiplexedBackend is a client backend shared by several inference
+/// contexts. The asynchronous requests of all the contexts go through its
+/// client, which already delivers each response to the callback given with
+/// the request. The streaming requests share a single stream, the responses
+/// are routed back to the context that sent the request using a prefix that
+/// is added to the request id. The clients don't support concurrent sends,
+/// the contexts may run on different threads so their sends are serialized
+/// with SendLock().
+///
+class MultiplexedBackend {
+ public:
+  MultiplexedBackend(std::unique_ptr<ClientBackend> backend);
+
+  ~MultiplexedBackend();
+
+  ClientBackend* Backend() { return backend_.get(); }
+
+  /// \return A lock to hold while sending a request through Backend(). The
+  /// responses are delivered on the threads of the client, so the lock is
+  /// never held by a callback sending the next request.
+  std::unique_lock<std::mutex> SendLock()
+  {
+    return std::unique_lock<std::mutex>(send_mutex_);
+  }
+
+  /// \return A new id for a context using this backend.
+  uint64_t NextClientId();
+
+  /// Route the stream responses of the requests sent by 'client_id' to
+  /// 'callbacks', starting the shared stream on first use.
+  Error RegisterStreamClient(
+      const uint64_t client_id, std::shared_ptr<ContextCallbacks> callbacks,
+      const bool enable_stats);
+
+  /// Stop routing the stream responses to 'client_id'.
+  void UnregisterStreamClient(const uint64_t client_id);
+
+  /// Add to 'infer_stat' the client statistics of the backend accumulated
+  /// since the last call by any of the contexts, so that the statistics of
+  /// all the contexts sum up to the statistics of the backend.
+  Error AccumulateInferStat(InferStat* infer_stat);
+
+  /// \return The request id sent on the shared stream for 'request_id' of
+  /// the context 'client_id'.
+  static std::string StreamRequestId(
+      const uint64_t client_id, const std::string& request_id);
+
+ private:
+  void StreamCallback(InferResult* result);
+
+  std::unique_ptr<ClientBackend> backend_;
+  std::mutex send_mutex_;
+
+  std::mutex mutex_;
+  uint64_t next_client_id_{0};
+  bool stream_started_{false};
+  std::unordered_map<uint64_t, std::shared_ptr<ContextCallbacks>>
+      stream_clients_;
+  // The statistics of the backend already handed out to the contexts
+  InferStat reported_stat_;
+};
+
+//==============================================================================
+/// SharedClientBackend is the client backend of a single inference context
+/// whose requests are multiplexed over a MultiplexedBackend.
+///
+class SharedClientBackend : public ClientBackend {
+ public:
+  SharedClientBackend(std::shared_ptr<MultiplexedBackend> shared_backend);
+
+  ~SharedClientBackend();
+
+  /// See ClientBackend::Infer()
+  Error Infer(
+      InferResult** result, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override;
+
+  /// See ClientBackend::AsyncInfer()
+  Error AsyncInfer(
+      OnCompleteFn callback, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override;
+
+  /// See ClientBackend::StartStream()
+  Error StartStream(OnCompleteFn callback, bool enable_stats) override;
+
+  /// See ClientBackend::AsyncStreamInfer()
+  Error AsyncStreamInfer(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override;
+
+  /// See ClientBackend::ClientInferStat()
+  Error ClientInferStat(InferStat* infer_stat) override;
+
+ private:
+  std::shared_ptr<MultiplexedBackend> shared_backend_;
+  const uint64_t client_id_;
+  std::shared_ptr<ContextCallbacks> callbacks_;
+  bool stream_registered_{false};
+  // Reused for the requests sent on the shared stream
+  InferOptions stream_options_{""};
+  InferStat infer_stat_;
+};
+
+//==============================================================================
+/// StreamInferResult hands a response of the shared stream to the context
+/// that sent the request, with the request id the context used.
+///
+class StreamInferResult : public InferResult {
+ public:
+  StreamInferResult(InferResult* result, const std::string& request_id);
+  ~StreamInferResult();
+  /// See InferResult::Id()
+  Error Id(std::string* id) const override;
+  /// See InferResult::RequestStatus()
+  Error RequestStatus() const override;
+  /// See InferResult::RawData()
+  Error RawData(
+      const std::string& output_name, const uint8_t** buf,
+      size_t* byte_size) const override;
+  /// See InferResult::IsFinalResponse()
+  Error IsFinalResponse(bool* is_final_response) const override;
+  /// See InferResult::IsNullResponse()
+  Error IsNullResponse(bool* is_null_response) const override;
+
+ private:
+  InferResult* result_;
+  const std::string request_id_;
+};
+
+}}}  // namespace triton::perfanalyzer::clientbackend
@@ -0,0 +1,251 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../doctest.h"
+#include "null/null_client_backend.h"
+#include "shared_client_backend.h"
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+
+// Records the responses received by a context.
+struct ContextResponses {
+  OnCompleteFn Callback()
+  {
+    return [this](InferResult* result) {
+      std::string id;
+      bool is_final = false;
+      result->Id(&id);
+      result->IsFinalResponse(&is_final);
+      delete result;
+      std::lock_guard<std::mutex> lk(mutex);
+      ids.push_back(id);
+      final_count += is_final ? 1 : 0;
+      cv.notify_all();
+    };
+  }
+
+  bool WaitForFinal(const size_t count)
+  {
+    std::unique_lock<std::mutex> lk(mutex);
+    return cv.wait_for(lk, std::chrono::seconds(5), [&] {
+      return final_count >= count;
+    });
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::string> ids;
+  size_t final_count{0};
+};
+
+std::shared_ptr<MultiplexedBackend>
+CreateSharedNullBackend(const NullServiceOptions& options)
+{
+  std::unique_ptr<ClientBackend> backend;
+  REQUIRE(nullservice::NullClientBackend::Create(options, &backend).IsOk());
+  return std::make_shared<MultiplexedBackend>(std::move(backend));
+}
+
+TEST_CASE("shared_client_backend: async requests")
+{
+  auto shared_backend = CreateSharedNullBackend(NullServiceOptions());
+  ContextResponses responses_a;
+  ContextResponses responses_b;
+  SharedClientBackend backend_a(shared_backend);
+  SharedClientBackend backend_b(shared_backend);
+
+  InferOptions options("null_model");
+  std::vector<InferInput*> inputs;
+  std::vector<const InferRequestedOutput*> outputs;
+  for (size_t i = 0; i < 3; ++i) {
+    options.request_id_ = std::to_string(i);
+    REQUIRE(
+        backend_a.AsyncInfer(responses_a.Callback(), options, inputs, outputs)
+            .IsOk());
+  }
+  options.request_id_ = "0";
+  REQUIRE(backend_b.AsyncInfer(responses_b.Callback(), options, inputs, outputs)
+              .IsOk());
+
+  REQUIRE(responses_a.WaitForFinal(3));
+  REQUIRE(responses_b.WaitForFinal(1));
+  CHECK(responses_a.ids == std::vector<std::string>{"0", "1", "2"});
+  CHECK(responses_b.ids == std::vector<std::string>{"0"});
+
+  // The statistics of the contexts sum up to the ones of the shared backend
+  InferStat stat_a;
+  InferStat stat_b;
+  CHECK(backend_a.ClientInferStat(&stat_a).IsOk());
+  CHECK(backend_b.ClientInferStat(&stat_b).IsOk());
+  CHECK(stat_a.completed_request_count + stat_b.completed_request_count == 4);
+  CHECK(backend_a.ClientInferStat(&stat_a).IsOk());
+  CHECK(stat_a.completed_request_count + stat_b.completed_request_count == 4);
+}
+
+TEST_CASE("shared_client_backend: stream requests")
+{
+  NullServiceOptions null_options;
+  null_options.decoupled = true;
+  null_options.response_count = 2;
+  auto shared_backend = CreateSharedNullBackend(null_options);
+  ContextResponses responses_a;
+  ContextResponses responses_b;
+  SharedClientBackend backend_a(shared_backend);
+  SharedClientBackend backend_b(shared_backend);
+  REQUIRE(backend_a.StartStream(responses_a.Callback(), false).IsOk());
+  REQUIRE(backend_b.StartStream(responses_b.Callback(), false).IsOk());
+
+  // Both contexts use the same request ids, the responses still reach the
+  // context that sent the request with the id it used
+  InferOptions options("null_model");
+  options.request_id_ = "7";
+  options.triton_enable_empty_final_response_ = false;
+  std::vector<InferInput*> inputs;
+  std::vector<const InferRequestedOutput*> outputs;
+  REQUIRE(backend_a.AsyncStreamInfer(options, inputs, outputs).IsOk());
+  REQUIRE(backend_b.AsyncStreamInfer(options, inputs, outputs).IsOk());
+  REQUIRE(backend_b.AsyncStreamInfer(options, inputs, outputs).IsOk());
+
+  REQUIRE(responses_a.WaitForFinal(1));
+  REQUIRE(responses_b.WaitForFinal(2));
+  CHECK(responses_a.ids == std::vector<std::string>{"7", "7"});
+  CHECK(responses_b.ids == std::vector<std::string>{"7", "7", "7", "7"});
+}
+
+TEST_CASE("shared_client_backend: destroyed context")
+{
+  NullServiceOptions null_options;
+  null_options.latency_us = 50000;
+  auto shared_backend = CreateSharedNullBackend(null_options);
+  std::atomic<size_t> callback_count{0};
+
+  {
+    SharedClientBackend backend(shared_backend);
+    InferOptions options("null_model");
+    std::vector<InferInput*> inputs;
+    std::vector<const InferRequestedOutput*> outputs;
+    REQUIRE(backend
+                .AsyncInfer(
+                    [&callback_count](InferResult* result) {
+                      callback_count++;
+                      delete result;
+                    },
+                    options, inputs, outputs)
+                .IsOk());
+  }
+
+  // The response of the destroyed context is dropped
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  CHECK(callback_count == 0);
+}
+
+// Counts the sends that overlap, which the clients don't support.
+class OverlapCountingBackend : public ClientBackend {
+ public:
+  OverlapCountingBackend() : ClientBackend(BackendKind::TRITON) {}
+
+  Error AsyncInfer(
+      OnCompleteFn callback, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override
+  {
+    return Send();
+  }
+
+  Error StartStream(OnCompleteFn callback, bool enable_stats) override
+  {
+    return Error::Success;
+  }
+
+  Error AsyncStreamInfer(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override
+  {
+    return Send();
+  }
+
+  std::atomic<size_t> send_count_{0};
+  std::atomic<size_t> overlap_count_{0};
+
+ private:
+  Error Send()
+  {
+    if (sending_.exchange(true)) {
+      overlap_count_++;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    sending_ = false;
+    send_count_++;
+    return Error::Success;
+  }
+
+  std::atomic<bool> sending_{false};
+};
+
+TEST_CASE("shared_client_backend: sends from several threads")
+{
+  auto backend = new OverlapCountingBackend();
+  auto shared_backend = std::make_shared<MultiplexedBackend>(
+      std::unique_ptr<ClientBackend>(backend));
+
+  const size_t thread_count = 4;
+  const size_t request_count = 50;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back([shared_backend, request_count, i]() {
+      SharedClientBackend context(shared_backend);
+      ContextResponses responses;
+      REQUIRE(context.StartStream(responses.Callback(), false).IsOk());
+      InferOptions options("null_model");
+      std::vector<InferInput*> inputs;
+      std::vector<const InferRequestedOutput*> outputs;
+      for (size_t j = 0; j < request_count; ++j) {
+        if ((i + j) % 2 == 0) {
+          REQUIRE(
+              context.AsyncInfer(responses.Callback(), options, inputs, outputs)
+                  .IsOk());
+        } else {
+          REQUIRE(context.AsyncStreamInfer(options, inputs, outputs).IsOk());
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  CHECK(backend->send_count_ == thread_count * request_count);
+  CHECK(backend->overlap_count_ == 0);
+}
+
+}}}  // namespace triton::perfanalyzer::clientbackend
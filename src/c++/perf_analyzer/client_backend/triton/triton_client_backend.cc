@@ -82,6 +82,39 @@ ParseGrpcSslOptions(
   return std::pair<bool, triton::client::SslOptions>{use_ssl, grpc_ssl_options};
 }
 
+triton::client::HttpCompressionOptions
+ParseHttpCompressionOptions(
+    const triton::perfanalyzer::clientbackend::CompressionOptions&
+        compression_options)
+{
+  triton::client::HttpCompressionOptions http_compression_options;
+  http_compression_options.level = compression_options.level;
+  http_compression_options.min_byte_size = compression_options.min_byte_size;
+  http_compression_options.min_ratio = compression_options.min_ratio;
+  return http_compression_options;
+}
+
+triton::client::InferenceServerHttpClient::CompressionType
+ParseHttpCompressionType(
+    const triton::perfanalyzer::clientbackend::HttpCompressionAlgorithm
+        compression_algorithm)
+{
+  using CompressionType =
+      triton::client::InferenceServerHttpClient::CompressionType;
+  switch (compression_algorithm) {
+    case triton::perfanalyzer::clientbackend::HTTP_COMPRESS_DEFLATE:
+      return CompressionType::DEFLATE;
+    case triton::perfanalyzer::clientbackend::HTTP_COMPRESS_GZIP:
+      return CompressionType::GZIP;
+    case triton::perfanalyzer::clientbackend::HTTP_COMPRESS_ZSTD:
+      return CompressionType::ZSTD;
+    case triton::perfanalyzer::clientbackend::HTTP_COMPRESS_LZ4:
+      return CompressionType::LZ4;
+    default:
+      return CompressionType::NONE;
+  }
+}
+
 }  // namespace
 
 namespace triton { namespace perfanalyzer { namespace clientbackend {
@@ -94,6 +127,8 @@ TritonClientBackend::Create(
     const SslOptionsBase& ssl_options,
     const std::map<std::string, std::vector<std::string>> trace_options,
     const grpc_compression_algorithm compression_algorithm,
+    const CompressionOptions& compression_options,
+    const ResponseCacheOptions& response_cache_options,
     std::shared_ptr<Headers> http_headers, const bool verbose,
     const std::string& metrics_url, const TensorFormat input_tensor_format,
     const TensorFormat output_tensor_format,
@@ -101,14 +136,21 @@ TritonClientBackend::Create(
 {
   std::unique_ptr<TritonClientBackend> triton_client_backend(
       new TritonClientBackend(
-          protocol, compression_algorithm, http_headers, metrics_url,
-          input_tensor_format, output_tensor_format));
+          protocol, compression_algorithm, compression_options, http_headers,
+          metrics_url, input_tensor_format, output_tensor_format));
+  tc::ResponseCacheOptions triton_response_cache_options;
+  triton_response_cache_options.max_byte_size =
+      response_cache_options.max_byte_size;
+  triton_response_cache_options.ttl_ms = response_cache_options.ttl_ms;
   if (protocol == ProtocolType::HTTP) {
     triton::client::HttpSslOptions http_ssl_options =
         ParseHttpSslOptions(ssl_options);
     RETURN_IF_TRITON_ERROR(tc::InferenceServerHttpClient::Create(
         &(triton_client_backend->client_.http_client_), url, verbose,
-        http_ssl_options));
+        http_ssl_options, ParseHttpCompressionOptions(compression_options)));
+    RETURN_IF_TRITON_ERROR(
+        triton_client_backend->client_.http_client_->SetResponseCache(
+            triton_response_cache_options));
     if (!trace_options.empty()) {
       std::string response;
       RETURN_IF_TRITON_ERROR(
@@ -123,6 +165,9 @@ TritonClientBackend::Create(
     RETURN_IF_TRITON_ERROR(tc::InferenceServerGrpcClient::Create(
         &(triton_client_backend->client_.grpc_client_), url, verbose, use_ssl,
         grpc_ssl_options));
+    RETURN_IF_TRITON_ERROR(
+        triton_client_backend->client_.grpc_client_->SetResponseCache(
+            triton_response_cache_options));
     if (!trace_options.empty()) {
       inference::TraceSettingResponse response;
       RETURN_IF_TRITON_ERROR(
@@ -245,11 +290,13 @@ TritonClientBackend::Infer(
   if (protocol_ == ProtocolType::GRPC) {
     RETURN_IF_TRITON_ERROR(client_.grpc_client_->Infer(
         &triton_result, triton_options, triton_inputs, triton_outputs,
-        *http_headers_, compression_algorithm_));
+        *http_headers_, GrpcCompressionForRequest(triton_inputs)));
   } else {
     RETURN_IF_TRITON_ERROR(client_.http_client_->Infer(
         &triton_result, triton_options, triton_inputs, triton_outputs,
-        *http_headers_));
+        *http_headers_, tc::Parameters(),
+        ParseHttpCompressionType(
+            compression_options_.http_compression_algorithm)));
   }
 
   *result = new TritonInferResult(triton_result);
@@ -280,11 +327,13 @@ TritonClientBackend::AsyncInfer(
   if (protocol_ == ProtocolType::GRPC) {
     RETURN_IF_TRITON_ERROR(client_.grpc_client_->AsyncInfer(
         wrapped_callback, triton_options, triton_inputs, triton_outputs,
-        *http_headers_, compression_algorithm_));
+        *http_headers_, GrpcCompressionForRequest(triton_inputs)));
   } else {
     RETURN_IF_TRITON_ERROR(client_.http_client_->AsyncInfer(
         wrapped_callback, triton_options, triton_inputs, triton_outputs,
-        *http_headers_));
+        *http_headers_, tc::Parameters(),
+        ParseHttpCompressionType(
+            compression_options_.http_compression_algorithm)));
   }
 
   return Error::Success;
@@ -560,6 +609,26 @@ TritonClientBackend::ParseInferInputToTriton(
   }
 }
 
+grpc_compression_algorithm
+TritonClientBackend::GrpcCompressionForRequest(
+    const std::vector<tc::InferInput*>& inputs)
+{
+  // Small requests are not worth the CPU time spent compressing them
+  if ((compression_algorithm_ == GRPC_COMPRESS_NONE) ||
+      (compression_options_.min_byte_size == 0)) {
+    return compression_algorithm_;
+  }
+  size_t request_byte_size = 0;
+  for (const auto input : inputs) {
+    size_t byte_size = 0;
+    input->ByteSize(&byte_size);
+    request_byte_size += byte_size;
+  }
+  return (request_byte_size < compression_options_.min_byte_size)
+             ? GRPC_COMPRESS_NONE
+             : compression_algorithm_;
+}
+
 void
 TritonClientBackend::ParseInferRequestedOutputToTriton(
     const std::vector<const InferRequestedOutput*>& outputs,
@@ -590,6 +659,9 @@ TritonClientBackend::ParseInferOptionsToTriton(
   }
   triton_options->triton_enable_empty_final_response_ =
       options.triton_enable_empty_final_response_;
+  // The input buffers are owned by the data loader and outlive the requests,
+  // so they can be sent without copying them into the gRPC message.
+  triton_options->zero_copy_input_ = true;
 
   for (auto& map_entry : options.request_parameters_) {
     auto rp = tc::RequestParameter();
@@ -701,6 +773,8 @@ TritonClientBackend::ParseInferStat(
       triton_infer_stat.cumulative_send_time_ns;
   infer_stat->cumulative_receive_time_ns =
       triton_infer_stat.cumulative_receive_time_ns;
+  infer_stat->cache_hit_count = triton_infer_stat.cache_hit_count;
+  infer_stat->cache_miss_count = triton_infer_stat.cache_miss_count;
 }
 
 //==============================================================================
@@ -76,6 +76,12 @@ class TritonClientBackend : public ClientBackend {
   /// \param url The inference server url and port.
   /// \param protocol The protocol type used.
   /// \param ssl_options The SSL options used with client backend.
+  /// \param compression_algorithm The compression algorithm to be used
+  /// on the grpc requests.
+  /// \param compression_options The HTTP compression algorithm and the
+  /// options deciding when requests are compressed.
+  /// \param response_cache_options The options of the client-side
+  /// response cache.
   /// \param http_headers Map of HTTP headers. The map key/value indicates
   /// the header name/value.
   /// \param verbose Enables the verbose mode.
@@ -91,6 +97,8 @@ class TritonClientBackend : public ClientBackend {
       const SslOptionsBase& ssl_options,
       const std::map<std::string, std::vector<std::string>> trace_options,
       const grpc_compression_algorithm compression_algorithm,
+      const CompressionOptions& compression_options,
+      const ResponseCacheOptions& response_cache_options,
       std::shared_ptr<tc::Headers> http_headers, const bool verbose,
       const std::string& metrics_url,
       const cb::TensorFormat input_tensor_format,
@@ -176,11 +184,13 @@ class TritonClientBackend : public ClientBackend {
   TritonClientBackend(
       const ProtocolType protocol,
       const grpc_compression_algorithm compression_algorithm,
+      const CompressionOptions& compression_options,
       std::shared_ptr<tc::Headers> http_headers, const std::string& metrics_url,
       const cb::TensorFormat input_tensor_format,
       const cb::TensorFormat output_tensor_format)
       : ClientBackend(BackendKind::TRITON), protocol_(protocol),
         compression_algorithm_(compression_algorithm),
+        compression_options_(compression_options),
         http_headers_(http_headers), metrics_url_(metrics_url),
         input_tensor_format_(input_tensor_format),
         output_tensor_format_(output_tensor_format)
@@ -195,6 +205,8 @@ class TritonClientBackend : public ClientBackend {
       std::vector<const tc::InferRequestedOutput*>* triton_outputs);
   void ParseInferOptionsToTriton(
       const InferOptions& options, tc::InferOptions* triton_options);
+  grpc_compression_algorithm GrpcCompressionForRequest(
+      const std::vector<tc::InferInput*>& inputs);
   void ParseStatistics(
       const inference::ModelStatisticsResponse& infer_stat,
       std::map<ModelIdentifier, ModelStatistics>* model_stats);
@@ -248,6 +260,7 @@ class TritonClientBackend : public ClientBackend {
 
   const ProtocolType protocol_{UNKNOWN};
   const grpc_compression_algorithm compression_algorithm_{GRPC_COMPRESS_NONE};
+  const CompressionOptions compression_options_;
   std::shared_ptr<tc::Headers> http_headers_;
   const std::string metrics_url_{""};
   const cb::TensorFormat input_tensor_format_{cb::TensorFormat::UNKNOWN};
@@ -34,6 +34,7 @@
 #include <iostream>
 #include <string>
 
+#include "cpu_affinity.h"
 #include "perf_analyzer_exception.h"
 
 namespace triton { namespace perfanalyzer {
@@ -99,12 +100,14 @@ CLParser::Usage(const std::string& msg)
   std::cerr << "==== SYNOPSIS ====\n \n";
   std::cerr << "\t--version " << std::endl;
   std::cerr << "\t--service-kind "
-               "<\"triton\"|\"tfserving\"|\"torchserve\"|\"triton_c_api\">"
+               "<\"triton\"|\"tfserving\"|\"torchserve\"|\"triton_c_api\"|"
+               "\"null\">"
             << std::endl;
   std::cerr << "\t-m <model name>" << std::endl;
   std::cerr << "\t-x <model version>" << std::endl;
   std::cerr << "\t--bls-composing-models=<string>" << std::endl;
   std::cerr << "\t--model-signature-name <model signature name>" << std::endl;
+  std::cerr << "\t--workload-file <path>" << std::endl;
   std::cerr << "\t-v" << std::endl;
   std::cerr << std::endl;
   std::cerr << "I. MEASUREMENT PARAMETERS: " << std::endl;
@@ -116,11 +119,20 @@ CLParser::Usage(const std::string& msg)
   std::cerr << "\t--periodic-concurrency-range <start:end:step>" << std::endl;
   std::cerr << "\t--request-period <number of responses>" << std::endl;
   std::cerr << "\t--request-rate-range <start:end:step>" << std::endl;
-  std::cerr << "\t--request-distribution <\"poisson\"|\"constant\">"
+  std::cerr << "\t--request-distribution <\"poisson\"|\"constant\"|"
+               "\"gamma\"|\"mmpp\"|\"pareto-on-off\">"
+            << std::endl;
+  std::cerr << "\t--request-distribution-params <key=value,...|path>"
             << std::endl;
   std::cerr << "\t--request-intervals <path to file containing time intervals "
                "in microseconds>"
             << std::endl;
+  std::cerr << "\t--request-rate-profile <path to load profile file>"
+            << std::endl;
+  std::cerr << "\t--max-inflight <number of requests>" << std::endl;
+  std::cerr << "\t--inflight-limit-policy <\"queue\"|\"drop\">" << std::endl;
+  std::cerr << "\t--inflight-queue-timeout <queue timeout (in msec)>"
+            << std::endl;
   std::cerr << "\t--serial-sequences" << std::endl;
   std::cerr << "\t--binary-search" << std::endl;
   std::cerr << "\t--num-of-sequences <number of concurrent sequences>"
@@ -135,6 +147,9 @@ CLParser::Usage(const std::string& msg)
                "profiling>"
             << std::endl;
   std::cerr << "\t--percentile <percentile>" << std::endl;
+  std::cerr << "\t--warmup-duration <warm-up duration (in msec)>" << std::endl;
+  std::cerr << "\t--warmup-request-count <number of warm-up requests>"
+            << std::endl;
   std::cerr << "\tDEPRECATED OPTIONS" << std::endl;
   std::cerr << "\t-t <number of concurrent requests>" << std::endl;
   std::cerr << "\t-c <maximum concurrency>" << std::endl;
@@ -176,10 +191,26 @@ CLParser::Usage(const std::string& msg)
   std::cerr << "IV. OTHER OPTIONS: " << std::endl;
   std::cerr << "\t-f <filename for storing report in csv format>" << std::endl;
   std::cerr << "\t--profile-export-file <path>" << std::endl;
+  std::cerr << "\t--timeline-file <path>" << std::endl;
+  std::cerr << "\t--timeline-interval <milliseconds>" << std::endl;
+  std::cerr << "\t--live-metrics-port <port>" << std::endl;
+  std::cerr << "\t--cpu-affinity <list of CPU cores>" << std::endl;
+  std::cerr << "\t--numa-node <NUMA node>" << std::endl;
   std::cerr << "\t-H <HTTP header>" << std::endl;
   std::cerr << "\t--streaming" << std::endl;
   std::cerr << "\t--grpc-compression-algorithm <compression_algorithm>"
             << std::endl;
+  std::cerr << "\t--http-compression-algorithm <compression_algorithm>"
+            << std::endl;
+  std::cerr << "\t--compression-level <level>" << std::endl;
+  std::cerr << "\t--compression-threshold <bytes>" << std::endl;
+  std::cerr << "\t--compression-min-ratio <ratio>" << std::endl;
+  std::cerr << "\t--response-cache-size <bytes>" << std::endl;
+  std::cerr << "\t--response-cache-ttl <milliseconds>" << std::endl;
+  std::cerr << "\t--null-latency <distribution:mean_us[:spread_us]>"
+            << std::endl;
+  std::cerr << "\t--null-response-count <n>" << std::endl;
+  std::cerr << "\t--shared-client-backends <n>" << std::endl;
   std::cerr << "\t--trace-file" << std::endl;
   std::cerr << "\t--trace-level" << std::endl;
   std::cerr << "\t--trace-rate" << std::endl;
@@ -207,7 +238,10 @@ CLParser::Usage(const std::string& msg)
              "content file>\"]}, {...}...]}. The type of file here will depend "
              "on the model. In order to use \"triton_c_api\" you must specify "
              "the Triton server install path and the model repository path via "
-             "the --triton-server-directory and --model-repository flags",
+             "the --triton-server-directory and --model-repository flags. "
+             "\"null\" sends the requests nowhere and completes them "
+             "immediately or after a synthetic latency, see --null-latency, "
+             "to measure the highest load perf_analyzer can generate.",
              18)
       << std::endl;
 
@@ -232,6 +266,17 @@ CLParser::Usage(const std::string& msg)
                    "\"tfserving\".",
                    18)
             << std::endl;
+  std::cerr << FormatMessage(
+                   " --workload-file: The path to a json file listing the "
+                   "models to send requests to, used instead of -m and -x. "
+                   "Each model has a \"name\" and optionally a \"version\", "
+                   "a \"weight\" setting its share of the requests, its "
+                   "\"input_data\" and a \"slo_latency_ms\" latency "
+                   "objective. The requests of all the models are sent by the "
+                   "same load manager and the report has the statistics of "
+                   "each model along with the ones of all the requests.",
+                   18)
+            << std::endl;
   std::cerr << std::setw(9) << std::left
             << " -v: " << FormatMessage("Enables verbose mode.", 9)
             << std::endl;
@@ -286,6 +331,21 @@ CLParser::Usage(const std::string& msg)
              "be enabled using the --measurement-mode flag.",
              18)
       << std::endl;
+  std::cerr << FormatMessage(
+                   " --warmup-duration: The minimum time in msec to generate "
+                   "the load of each concurrency level or request rate before "
+                   "measuring it. The requests and the client and server "
+                   "statistics of the warm-up are not collected. Default is 0, "
+                   "no warm-up.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --warmup-request-count: The minimum number of requests to "
+                   "complete at each concurrency level or request rate before "
+                   "measuring it. When specified with --warmup-duration, the "
+                   "warm-up lasts until both are reached. Default is 0.",
+                   18)
+            << std::endl;
   std::cerr
       << FormatMessage(
              " --concurrency-range <start:end:step>: Determines the range of "
@@ -359,12 +419,25 @@ CLParser::Usage(const std::string& msg)
       << std::endl;
   std::cerr
       << FormatMessage(
-             " --request-distribution <\"poisson\"|\"constant\">: Specifies "
+             " --request-distribution <\"poisson\"|\"constant\"|"
+             "\"gamma\"|\"mmpp\"|\"pareto-on-off\">: Specifies "
              "the time interval distribution between dispatching inference "
              "requests to the server. Poisson distribution closely mimics the "
-             "real-world work load on a server. This option is ignored if not "
-             "using --request-rate-range. By default, this option is set to be "
-             "constant.",
+             "real-world work load on a server. Gamma distributed intervals, "
+             "a Markov-modulated Poisson process and Pareto distributed on "
+             "and off periods send bursts of requests around the same mean "
+             "rate. This option is ignored if not using --request-rate-range. "
+             "By default, this option is set to be constant.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --request-distribution-params: Specifies the shape of the "
+             "bursty request distributions, as a list such as "
+             "\"cv=8,burst_ratio=20\" or a path to a JSON file with the same "
+             "keys. The keys are 'cv' for gamma, 'burst_ratio', 'burst_ms' "
+             "and 'idle_ms' for mmpp, and 'alpha', 'on_ms' and 'off_ms' for "
+             "pareto-on-off.",
              18)
       << std::endl;
   std::cerr
@@ -380,6 +453,44 @@ CLParser::Usage(const std::string& msg)
              "--request-rate-range or --concurrency-range.",
              18)
       << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --request-rate-profile: Specifies a path to a json file "
+             "describing the request rate over time as a series of segments: "
+             "constant rates, linear ramps, steps, sine waves and spikes. The "
+             "requests are sent following the profile as a non-homogeneous "
+             "Poisson process in one continuous run, and each segment is "
+             "measured and reported separately. This option can not be used "
+             "with --request-rate-range, --concurrency-range or "
+             "--request-intervals.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --max-inflight: Limits the number of requests in flight of "
+             "all the threads in request rate mode, like a gateway in front "
+             "of the server. The requests still arrive at the requested "
+             "rate, and those arriving at the limit are queued or dropped "
+             "according to --inflight-limit-policy. The shed requests and the "
+             "client queueing delay are reported. By default there is no "
+             "limit.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --inflight-limit-policy: What to do with the requests arriving "
+             "at the --max-inflight limit. 'queue' waits for a request to "
+             "complete, up to --inflight-queue-timeout, and 'drop' does not "
+             "send them. Default is 'queue'.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --inflight-queue-timeout: The longest time in msec a request "
+             "waits for a slot after its arrival with the 'queue' policy, "
+             "after which it is shed. Default is 0, waiting without a limit.",
+             18)
+      << std::endl;
   std::cerr
       << FormatMessage(
              "--binary-search: Enables the binary search on the specified "
@@ -584,7 +695,9 @@ CLParser::Usage(const std::string& msg)
                    "Specify URL to the server. When using triton default is "
                    "\"localhost:8000\" if using HTTP and \"localhost:8001\" "
                    "if using gRPC. When using tfserving default is "
-                   "\"localhost:8500\". ",
+                   "\"localhost:8500\". A Triton server running on the same "
+                   "host may be reached through a Unix domain socket by "
+                   "specifying \"unix:<path to socket>\". ",
                    38)
             << std::endl;
   std::cerr << std::setw(38) << std::left << " -i: "
@@ -682,6 +795,49 @@ CLParser::Usage(const std::string& msg)
                    "generated.",
                    9)
             << std::endl;
+  std::cerr << std::setw(9) << std::left << " --timeline-file: "
+            << FormatMessage(
+                   "The timeline of the run will be stored in the csv file "
+                   "named by this option. Each row holds the throughput, the "
+                   "average number of requests in flight, the latency "
+                   "percentiles and, with --collect-metrics, the server-side "
+                   "metrics of one interval of the run, to show changes "
+                   "within a measurement window. By default, no timeline is "
+                   "recorded.",
+                   9)
+            << std::endl;
+  std::cerr << std::setw(9) << std::left << " --timeline-interval: "
+            << FormatMessage(
+                   "The length of the intervals of the timeline in msec. "
+                   "Default is 1000 msec.",
+                   9)
+            << std::endl;
+  std::cerr << std::setw(9) << std::left << " --live-metrics-port: "
+            << FormatMessage(
+                   "The port to serve the live metrics of perf_analyzer on, "
+                   "in the Prometheus format at /metrics. They include the "
+                   "requests sent, completed, delayed and in flight, a "
+                   "latency histogram and the results of the last "
+                   "measurement window. By default, they are not served.",
+                   9)
+            << std::endl;
+  std::cerr << std::setw(9) << std::left << " --cpu-affinity: "
+            << FormatMessage(
+                   "The CPU cores to pin perf_analyzer to, as a comma "
+                   "separated list of cores and ranges of cores such as "
+                   "'0-3,8'. The load generating threads, the client I/O "
+                   "threads and the profiler thread are all pinned to these "
+                   "cores. When only --numa-node is specified, the cores of "
+                   "that node are used. By default, no pinning is done.",
+                   9)
+            << std::endl;
+  std::cerr << std::setw(9) << std::left << " --numa-node: "
+            << FormatMessage(
+                   "The NUMA node to allocate the memory of perf_analyzer, "
+                   "including the input data, on. By default, the memory "
+                   "policy of the system is used.",
+                   9)
+            << std::endl;
   std::cerr
       << std::setw(9) << std::left << " -H: "
       << FormatMessage(
@@ -704,6 +860,83 @@ CLParser::Usage(const std::string& msg)
                    "none, gzip, and deflate. Default value is none.",
                    18)
             << std::endl;
+  std::cerr << FormatMessage(
+                   " --http-compression-algorithm: The compression algorithm "
+                   "to be used for the HTTP request bodies. Only supported "
+                   "when http protocol is being used. The supported values are "
+                   "none, gzip, deflate, zstd and lz4, zstd and lz4 must be "
+                   "included in the client build and supported by the server. "
+                   "Default value is none.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --compression-level: The compression level used for the "
+                   "HTTP request bodies. The valid range depends on the "
+                   "algorithm. Default value is 0, which selects the default "
+                   "level of the algorithm.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --compression-threshold: Requests whose input data is "
+                   "smaller than this number of bytes are sent uncompressed. "
+                   "Applies to both gRPC and HTTP compression. Default value "
+                   "is 0, which compresses every request.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --compression-min-ratio: The compression ratio of the "
+                   "HTTP request bodies is sampled periodically, and the "
+                   "bodies are sent uncompressed while the sampled ratio "
+                   "(uncompressed size / compressed size) is below this "
+                   "value. Default value is 0, which disables sampling.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --response-cache-size: The size in bytes of the "
+                   "client-side response cache. Responses of requests with "
+                   "identical inputs are served from the cache without "
+                   "contacting the server, which models the effect of "
+                   "caching the responses of a deterministic model in the "
+                   "client. Only supported with the triton service kind. "
+                   "Default value is 0, which disables the cache.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --response-cache-ttl: The time in milliseconds after "
+                   "which a response in the client-side response cache "
+                   "expires. Default value is 0, which means the responses "
+                   "don't expire.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --null-latency: The synthetic latency of the responses "
+                   "of the null service kind, as <distribution>:<mean_us> "
+                   "with the distribution being \"constant\", \"uniform\", "
+                   "\"normal\" or \"exponential\". \"uniform\" and "
+                   "\"normal\" take a third field, the half width of the "
+                   "range and the standard deviation respectively. For "
+                   "example \"normal:500:100\". Default value is "
+                   "\"constant:0\", which completes the requests "
+                   "immediately.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --null-response-count: Makes the null service kind "
+                   "behave as a decoupled model returning this number of "
+                   "responses to each request, each a synthetic latency "
+                   "after the previous one. Requires --streaming.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --shared-client-backends: The number of client backends "
+                   "shared by all the inference contexts. The asynchronous "
+                   "and streaming requests of the contexts are multiplexed "
+                   "over the shared backends instead of each context having "
+                   "a client, with its own threads and connections, of its "
+                   "own. Not supported with the synchronous API. Default "
+                   "value is 0, which gives each context its own backend.",
+                   18)
+            << std::endl;
 
   std::cerr
       << FormatMessage(
@@ -875,6 +1108,30 @@ CLParser::ParseCommandLine(int argc, char** argv)
       {"periodic-concurrency-range", required_argument, 0, 59},
       {"request-period", required_argument, 0, 60},
       {"request-parameter", required_argument, 0, 61},
+      {"http-compression-algorithm", required_argument, 0, 62},
+      // 63 is '?', which getopt_long() returns for an unrecognized option
+      {"compression-level", required_argument, 0, 64},
+      {"compression-threshold", required_argument, 0, 65},
+      {"compression-min-ratio", required_argument, 0, 66},
+      {"response-cache-size", required_argument, 0, 67},
+      {"response-cache-ttl", required_argument, 0, 68},
+      {"null-latency", required_argument, 0, 69},
+      {"null-response-count", required_argument, 0, 70},
+      {"shared-client-backends", required_argument, 0, 71},
+      // 72 is 'H'
+      {"workload-file", required_argument, 0, 73},
+      {"timeline-file", required_argument, 0, 74},
+      {"timeline-interval", required_argument, 0, 75},
+      {"live-metrics-port", required_argument, 0, 76},
+      {"warmup-duration", required_argument, 0, 77},
+      {"warmup-request-count", required_argument, 0, 78},
+      {"cpu-affinity", required_argument, 0, 79},
+      {"numa-node", required_argument, 0, 80},
+      {"request-rate-profile", required_argument, 0, 81},
+      {"request-distribution-params", required_argument, 0, 82},
+      {"max-inflight", required_argument, 0, 83},
+      {"inflight-limit-policy", required_argument, 0, 84},
+      {"inflight-queue-timeout", required_argument, 0, 85},
       {0, 0, 0, 0}};
 
   // Parse commandline...
@@ -1104,11 +1361,19 @@ CLParser::ParseCommandLine(int argc, char** argv)
             params_->request_distribution = Distribution::POISSON;
           } else if (arg.compare("constant") == 0) {
             params_->request_distribution = Distribution::CONSTANT;
+          } else if (arg.compare("gamma") == 0) {
+            params_->request_distribution = Distribution::GAMMA;
+          } else if (arg.compare("mmpp") == 0) {
+            params_->request_distribution = Distribution::MMPP;
+          } else if (arg.compare("pareto-on-off") == 0) {
+            params_->request_distribution = Distribution::PARETO_ON_OFF;
           } else {
             Usage(
                 "Failed to parse --request-distribution. Unsupported type "
                 "provided: '" +
-                std::string(optarg) + "'. Choices are 'posson' or 'constant'.");
+                std::string(optarg) +
+                "'. Choices are 'poisson', 'constant', 'gamma', 'mmpp' or "
+                "'pareto-on-off'.");
           }
           break;
         }
@@ -1169,12 +1434,14 @@ CLParser::ParseCommandLine(int argc, char** argv)
             params_->kind = cb::TORCHSERVE;
           } else if (arg.compare("triton_c_api") == 0) {
             params_->kind = cb::TRITON_C_API;
+          } else if (arg.compare("null") == 0) {
+            params_->kind = cb::NULL_SERVICE;
           } else {
             Usage(
                 "Failed to parse --service-kind. Unsupported type provided: '" +
                 std::string{optarg} +
                 "'. The available options are 'triton', 'tfserving', "
-                "'torchserve', or 'triton_c_api'.");
+                "'torchserve', 'triton_c_api', or 'null'.");
           }
           break;
         }
@@ -1608,6 +1875,287 @@ CLParser::ParseCommandLine(int argc, char** argv)
           params_->request_parameters[name] = param;
           break;
         }
+        case 62: {
+          std::string arg = optarg;
+          if (arg.compare("none") == 0) {
+            params_->compression_options.http_compression_algorithm =
+                cb::HTTP_COMPRESS_NONE;
+          } else if (arg.compare("deflate") == 0) {
+            params_->compression_options.http_compression_algorithm =
+                cb::HTTP_COMPRESS_DEFLATE;
+          } else if (arg.compare("gzip") == 0) {
+            params_->compression_options.http_compression_algorithm =
+                cb::HTTP_COMPRESS_GZIP;
+          } else if (arg.compare("zstd") == 0) {
+            params_->compression_options.http_compression_algorithm =
+                cb::HTTP_COMPRESS_ZSTD;
+          } else if (arg.compare("lz4") == 0) {
+            params_->compression_options.http_compression_algorithm =
+                cb::HTTP_COMPRESS_LZ4;
+          } else {
+            Usage(
+                "Failed to parse --http-compression-algorithm. Unsupported "
+                "type provided: '" +
+                arg +
+                "'. The available options are 'gzip', 'deflate', 'zstd', "
+                "'lz4', or 'none'.");
+          }
+          params_->using_http_compression = true;
+          break;
+        }
+        case 64: {
+          params_->compression_options.level = std::stoi(optarg);
+          break;
+        }
+        case 65: {
+          std::string compression_threshold{optarg};
+          if (std::stoll(compression_threshold) >= 0) {
+            params_->compression_options.min_byte_size =
+                std::stoull(compression_threshold);
+          } else {
+            Usage(
+                "Failed to parse --compression-threshold. The value must be "
+                ">= 0.");
+          }
+          break;
+        }
+        case 66: {
+          double compression_min_ratio{std::stod(optarg)};
+          if (compression_min_ratio >= 0.0) {
+            params_->compression_options.min_ratio = compression_min_ratio;
+          } else {
+            Usage(
+                "Failed to parse --compression-min-ratio. The value must be "
+                ">= 0.");
+          }
+          break;
+        }
+        case 67: {
+          std::string response_cache_size{optarg};
+          if (std::stoll(response_cache_size) >= 0) {
+            params_->response_cache_options.max_byte_size =
+                std::stoull(response_cache_size);
+          } else {
+            Usage(
+                "Failed to parse --response-cache-size. The value must be "
+                ">= 0.");
+          }
+          break;
+        }
+        case 68: {
+          std::string response_cache_ttl{optarg};
+          if (std::stoll(response_cache_ttl) >= 0) {
+            params_->response_cache_options.ttl_ms =
+                std::stoull(response_cache_ttl);
+          } else {
+            Usage(
+                "Failed to parse --response-cache-ttl. The value must be "
+                ">= 0.");
+          }
+          break;
+        }
+        case 69: {
+          std::string arg = optarg;
+          std::vector<std::string> values{SplitString(arg)};
+          if (values.size() < 2 || values.size() > 3) {
+            Usage(
+                "Failed to parse --null-latency. The value does not match "
+                "<distribution:mean_us[:spread_us]>.");
+          }
+
+          using LatencyDistribution =
+              cb::NullServiceOptions::LatencyDistribution;
+          auto& options = params_->null_service_options;
+          ToLowerCase(values[0]);
+          if (values[0].compare("constant") == 0) {
+            options.latency_distribution = LatencyDistribution::CONSTANT;
+          } else if (values[0].compare("uniform") == 0) {
+            options.latency_distribution = LatencyDistribution::UNIFORM;
+          } else if (values[0].compare("normal") == 0) {
+            options.latency_distribution = LatencyDistribution::NORMAL;
+          } else if (values[0].compare("exponential") == 0) {
+            options.latency_distribution = LatencyDistribution::EXPONENTIAL;
+          } else {
+            Usage(
+                "Failed to parse --null-latency. Unsupported distribution "
+                "provided: '" +
+                values[0] +
+                "'. The available options are 'constant', 'uniform', "
+                "'normal' or 'exponential'.");
+          }
+          if ((values.size() == 3) &&
+              (options.latency_distribution !=
+               LatencyDistribution::UNIFORM) &&
+              (options.latency_distribution != LatencyDistribution::NORMAL)) {
+            Usage(
+                "Failed to parse --null-latency. Only the uniform and normal "
+                "distributions take a <spread_us> value.");
+          }
+          if ((std::stoll(values[1]) < 0) ||
+              ((values.size() == 3) && (std::stoll(values[2]) < 0))) {
+            Usage(
+                "Failed to parse --null-latency. The values must be >= 0.");
+          }
+          options.latency_us = std::stoull(values[1]);
+          if (values.size() == 3) {
+            options.latency_spread_us = std::stoull(values[2]);
+          }
+          break;
+        }
+        case 70: {
+          std::string response_count{optarg};
+          if (std::stoll(response_count) > 0) {
+            params_->null_service_options.decoupled = true;
+            params_->null_service_options.response_count =
+                std::stoull(response_count);
+          } else {
+            Usage(
+                "Failed to parse --null-response-count. The value must be "
+                "> 0.");
+          }
+          break;
+        }
+        case 71: {
+          std::string shared_client_backends{optarg};
+          if (std::stoll(shared_client_backends) >= 0) {
+            params_->shared_client_backends =
+                std::stoull(shared_client_backends);
+          } else {
+            Usage(
+                "Failed to parse --shared-client-backends. The value must be "
+                ">= 0.");
+          }
+          break;
+        }
+        case 73: {
+          params_->workload_file = optarg;
+          break;
+        }
+        case 74: {
+          params_->timeline_file = optarg;
+          break;
+        }
+        case 75: {
+          std::string timeline_interval{optarg};
+          if (std::stoll(timeline_interval) > 0) {
+            params_->timeline_interval_ms = std::stoull(timeline_interval);
+          } else {
+            Usage(
+                "Failed to parse --timeline-interval. The value must be > "
+                "0.");
+          }
+          break;
+        }
+        case 76: {
+          std::string live_metrics_port{optarg};
+          int64_t port{std::stoll(live_metrics_port)};
+          if (port > 0 && port <= UINT16_MAX) {
+            params_->live_metrics_port = port;
+          } else {
+            Usage(
+                "Failed to parse --live-metrics-port. The value must be "
+                "between 1 and 65535.");
+          }
+          break;
+        }
+        case 77: {
+          std::string warmup_duration{optarg};
+          if (std::stoll(warmup_duration) >= 0) {
+            params_->warmup_duration_ms = std::stoull(warmup_duration);
+          } else {
+            Usage(
+                "Failed to parse --warmup-duration. The value must be >= 0.");
+          }
+          break;
+        }
+        case 78: {
+          std::string warmup_request_count{optarg};
+          if (std::stoll(warmup_request_count) >= 0) {
+            params_->warmup_request_count = std::stoull(warmup_request_count);
+          } else {
+            Usage(
+                "Failed to parse --warmup-request-count. The value must be >= "
+                "0.");
+          }
+          break;
+        }
+        case 79: {
+          cb::Error err{ParseCpuList(optarg, &params_->cpu_affinity)};
+          if (!err.IsOk()) {
+            Usage("Failed to parse --cpu-affinity. " + err.Message() + ".");
+          }
+          break;
+        }
+        case 80: {
+          std::string numa_node{optarg};
+          if (std::stoll(numa_node) >= 0) {
+            params_->numa_node = std::stoi(numa_node);
+          } else {
+            Usage("Failed to parse --numa-node. The value must be >= 0.");
+          }
+          break;
+        }
+        case 81: {
+          std::string request_rate_profile_file{optarg};
+          if (IsFile(request_rate_profile_file)) {
+            params_->request_rate_profile_file = request_rate_profile_file;
+            params_->using_request_rate_range = true;
+          } else {
+            Usage(
+                "Failed to parse --request-rate-profile. The value must be a "
+                "valid file path");
+          }
+          break;
+        }
+        case 82: {
+          std::string arg{optarg};
+          cb::Error err{
+              IsFile(arg) ? ReadArrivalProcessFile(
+                                arg, &params_->arrival_process_options)
+                          : ParseArrivalProcessOptions(
+                                arg, &params_->arrival_process_options)};
+          if (!err.IsOk()) {
+            Usage(
+                "Failed to parse --request-distribution-params. " +
+                err.Message() + ".");
+          }
+          break;
+        }
+        case 83: {
+          std::string max_inflight{optarg};
+          if (std::stoll(max_inflight) > 0) {
+            params_->max_inflight = std::stoull(max_inflight);
+          } else {
+            Usage("Failed to parse --max-inflight. The value must be > 0.");
+          }
+          break;
+        }
+        case 84: {
+          std::string arg{optarg};
+          if (arg == "queue") {
+            params_->inflight_limit_policy = InflightLimitPolicy::QUEUE;
+          } else if (arg == "drop") {
+            params_->inflight_limit_policy = InflightLimitPolicy::DROP;
+          } else {
+            Usage(
+                "Failed to parse --inflight-limit-policy. Unsupported type "
+                "provided: '" +
+                arg + "'. Choices are 'queue' or 'drop'.");
+          }
+          break;
+        }
+        case 85: {
+          std::string inflight_queue_timeout{optarg};
+          if (std::stoll(inflight_queue_timeout) >= 0) {
+            params_->inflight_queue_timeout_ms =
+                std::stoull(inflight_queue_timeout);
+          } else {
+            Usage(
+                "Failed to parse --inflight-queue-timeout. The value must be "
+                ">= 0.");
+          }
+          break;
+        }
         case 'v':
           params_->extra_verbose = params_->verbose;
           params_->verbose = true;
@@ -1704,7 +2252,19 @@ CLParser::ParseCommandLine(int argc, char** argv)
 void
 CLParser::VerifyOptions()
 {
-  if (params_->model_name.empty()) {
+  if (!params_->workload_file.empty()) {
+    if (!params_->model_name.empty()) {
+      Usage("Cannot specify -m and --workload-file simultaneously.");
+    }
+    if (!params_->user_data.empty()) {
+      Usage(
+          "Cannot specify --input-data and --workload-file simultaneously. "
+          "Specify the input data of each model in the workload file.");
+    }
+    if (params_->shared_memory_type != SharedMemoryType::NO_SHARED_MEMORY) {
+      Usage("Shared memory is not supported with --workload-file.");
+    }
+  } else if (params_->model_name.empty()) {
     Usage("Failed to parse -m (model name). The value must be specified.");
   }
   if (params_->concurrency_range.start <= 0 ||
@@ -1721,13 +2281,61 @@ CLParser::VerifyOptions()
         "Failed to parse -i (protocol). The value should be either HTTP or "
         "gRPC.");
   }
-  if (params_->streaming && (params_->protocol != cb::ProtocolType::GRPC)) {
+  if (params_->streaming && (params_->protocol != cb::ProtocolType::GRPC) &&
+      (params_->kind != cb::BackendKind::NULL_SERVICE)) {
     Usage("Streaming is only allowed with gRPC protocol.");
   }
   if (params_->using_grpc_compression &&
       (params_->protocol != cb::ProtocolType::GRPC)) {
     Usage("Using compression algorithm is only allowed with gRPC protocol.");
   }
+  if (params_->using_http_compression &&
+      (params_->protocol != cb::ProtocolType::HTTP)) {
+    Usage(
+        "Using HTTP compression algorithm is only allowed with HTTP "
+        "protocol.");
+  }
+  if (((params_->compression_options.level != 0) ||
+       (params_->compression_options.min_ratio != 0.0)) &&
+      !params_->using_http_compression) {
+    Usage(
+        "Must specify --http-compression-algorithm when using the "
+        "--compression-level or --compression-min-ratio option.");
+  }
+  if ((params_->compression_options.min_byte_size != 0) &&
+      !params_->using_grpc_compression && !params_->using_http_compression) {
+    Usage(
+        "Must specify --grpc-compression-algorithm or "
+        "--http-compression-algorithm when using the --compression-threshold "
+        "option.");
+  }
+  if ((params_->response_cache_options.max_byte_size != 0) &&
+      (params_->kind != cb::BackendKind::TRITON)) {
+    Usage(
+        "The response cache is only supported with the triton service "
+        "kind.");
+  }
+  if (params_->kind == cb::NULL_SERVICE) {
+    if (params_->shared_memory_type != SharedMemoryType::NO_SHARED_MEMORY) {
+      Usage("Shared memory is not supported by the null service kind.");
+    }
+    if (params_->null_service_options.decoupled && !params_->streaming) {
+      Usage(
+          "Must specify --streaming when using the --null-response-count "
+          "option.");
+    }
+    params_->protocol = cb::ProtocolType::UNKNOWN;
+  } else if (params_->null_service_options.decoupled) {
+    Usage(
+        "The --null-response-count option is only supported with the null "
+        "service kind.");
+  }
+  if ((params_->response_cache_options.ttl_ms != 0) &&
+      (params_->response_cache_options.max_byte_size == 0)) {
+    Usage(
+        "Must specify --response-cache-size when using the "
+        "--response-cache-ttl option.");
+  }
   if (params_->sequence_length_variation < 0.0) {
     Usage(
         "Failed to parse --sequence-length-variation. The value must be >= "
@@ -1751,6 +2359,9 @@ CLParser::VerifyOptions()
   if (params_->async && params_->forced_sync) {
     Usage("Cannot specify --async and --sync simultaneously.");
   }
+  if ((params_->shared_client_backends != 0) && params_->forced_sync) {
+    Usage("Cannot specify --shared-client-backends and --sync simultaneously.");
+  }
 
   if (params_->using_concurrency_range && params_->using_old_options) {
     Usage("Cannot use deprecated options with --concurrency-range.");
@@ -1821,6 +2432,26 @@ CLParser::VerifyOptions()
     Usage("Cannot specify --request-rate-range when in multi-model mode.");
   }
 
+  if (!params_->request_rate_profile_file.empty()) {
+    if ((params_->request_rate_range[SEARCH_RANGE::kSTART] != 1.0) ||
+        (params_->request_rate_range[SEARCH_RANGE::kEND] != 1.0) ||
+        (params_->request_rate_range[SEARCH_RANGE::kSTEP] != 1.0)) {
+      Usage(
+          "Cannot use --request-rate-range along with "
+          "--request-rate-profile.");
+    }
+    if (params_->search_mode == SearchMode::BINARY) {
+      Usage("Cannot use --binary-search along with --request-rate-profile.");
+    }
+  }
+
+  if (params_->max_inflight != 0 && !params_->using_request_rate_range &&
+      !params_->using_custom_intervals) {
+    Usage(
+        "--max-inflight can only be used in request rate mode, with "
+        "--request-rate-range, --request-intervals or --request-rate-profile.");
+  }
+
   if (params_->using_custom_intervals && params_->using_old_options) {
     Usage("Cannot use deprecated options with --request-intervals.");
   }
@@ -1931,10 +2562,12 @@ CLParser::VerifyOptions()
 
   if (params_->should_collect_metrics && !params_->metrics_url_specified) {
     // Update the default metrics URL to be associated with the input URL
-    // instead of localhost
+    // instead of localhost. A Unix domain socket URL names no host, so
+    // the default is kept for it.
     //
     size_t colon_pos = params_->url.find(':');
-    if (colon_pos != std::string::npos) {
+    if (colon_pos != std::string::npos &&
+        params_->url.compare(0, colon_pos, "unix") != 0) {
       params_->metrics_url =
           params_->url.substr(0, colon_pos) + ":8002/metrics";
     }
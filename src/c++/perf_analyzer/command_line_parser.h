@@ -31,7 +31,9 @@
 #include <unordered_map>
 #include <vector>
 
+#include "arrival_process.h"
 #include "constants.h"
+#include "inflight_limiter.h"
 #include "mpi_utils.h"
 #include "perf_utils.h"
 
@@ -73,8 +75,18 @@ struct PerfAnalyzerParameters {
   bool serial_sequences = false;
   SearchMode search_mode = SearchMode::LINEAR;
   Distribution request_distribution = Distribution::CONSTANT;
+  // The shape of the gamma, mmpp and pareto-on-off request distributions
+  ArrivalProcessOptions arrival_process_options{};
   bool using_custom_intervals = false;
   std::string request_intervals_file{""};
+  // The load profile file of the request rate over time, empty if the rates
+  // of --request-rate-range are used
+  std::string request_rate_profile_file{""};
+  // The limit of requests in flight in request rate mode, 0 if there is no
+  // limit, and what to do with the requests over the limit
+  size_t max_inflight{0};
+  InflightLimitPolicy inflight_limit_policy{InflightLimitPolicy::QUEUE};
+  uint64_t inflight_queue_timeout_ms{0};
   SharedMemoryType shared_memory_type = NO_SHARED_MEMORY;
   size_t output_shm_size = 100 * 1024;
   clientbackend::BackendKind kind = clientbackend::BackendKind::TRITON;
@@ -82,8 +94,17 @@ struct PerfAnalyzerParameters {
   bool using_grpc_compression = false;
   clientbackend::GrpcCompressionAlgorithm compression_algorithm =
       clientbackend::GrpcCompressionAlgorithm::COMPRESS_NONE;
+  bool using_http_compression = false;
+  clientbackend::CompressionOptions compression_options;
+  clientbackend::ResponseCacheOptions response_cache_options;
+  clientbackend::NullServiceOptions null_service_options;
+  size_t shared_client_backends{0};
   MeasurementMode measurement_mode = MeasurementMode::TIME_WINDOWS;
   uint64_t measurement_request_count = 50;
+  // The minimum duration and completed request count of the warm-up of each
+  // load level
+  uint64_t warmup_duration_ms{0};
+  uint64_t warmup_request_count{0};
   std::string triton_server_path = "/opt/tritonserver";
   std::string model_repository_path;
   uint64_t start_sequence_id = 1;
@@ -102,6 +123,8 @@ struct PerfAnalyzerParameters {
   std::string url{"localhost:8000"};
   std::string model_name;
   std::string model_version;
+  // The path to the file listing the models of a multi-model workload
+  std::string workload_file;
   uint64_t batch_size = 1;
   bool using_batch_size = false;
   int32_t concurrent_request_count = 1;
@@ -151,6 +174,18 @@ struct PerfAnalyzerParameters {
   // The profile export file path.
   std::string profile_export_file{""};
 
+  // The timeline file path and the length of its intervals
+  std::string timeline_file{""};
+  uint64_t timeline_interval_ms{1000};
+
+  // The port to serve the live metrics on, 0 if they are not served
+  uint16_t live_metrics_port{0};
+
+  // The CPU cores to pin perf_analyzer to, empty if it is not pinned, and the
+  // NUMA node to allocate its memory on, -1 for the default memory policy
+  std::vector<int> cpu_affinity{};
+  int32_t numa_node{-1};
+
   bool is_using_periodic_concurrency_mode{false};
   Range<uint64_t> periodic_concurrency_range{1, 1, 1};
   uint64_t request_period{10};
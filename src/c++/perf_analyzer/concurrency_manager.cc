@@ -120,7 +120,7 @@ ConcurrencyManager::ReconfigThreads(const size_t concurrent_request_count)
   while ((concurrent_request_count > threads_.size()) &&
          (threads_.size() < max_threads_)) {
     // Launch new thread for inferencing
-    threads_stat_.emplace_back(new ThreadStat());
+    AddThreadStat();
     threads_config_.emplace_back(
         new ConcurrencyWorker::ThreadConfig(threads_config_.size()));
 
@@ -175,11 +175,13 @@ ConcurrencyManager::MakeWorker(
 {
   uint32_t id = workers_.size();
 
-  return std::make_shared<ConcurrencyWorker>(
+  auto worker = std::make_shared<ConcurrencyWorker>(
       id, thread_stat, thread_config, parser_, data_loader_, factory_,
       on_sequence_model_, async_, max_concurrency_, using_json_data_,
       streaming_, batch_size_, wake_signal_, wake_mutex_, active_threads_,
       execute_, infer_data_manager_, sequence_manager_);
+  worker->SetWorkload(workload_);
+  return worker;
 }
 
 }}  // namespace triton::perfanalyzer
@@ -0,0 +1,191 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "cpu_affinity.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "constants.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// The memory policy of set_mempolicy(2) that allocates on the given node
+// while it has free memory
+constexpr int kMemPolicyPreferred{1};
+
+bool
+ParseCpu(const std::string& value, int* cpu)
+{
+  if (value.empty() ||
+      value.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  try {
+    *cpu = std::stoi(value);
+  }
+  catch (const std::exception&) {
+    return false;
+  }
+  return *cpu < CPU_SETSIZE;
+}
+
+cb::Error
+SetMemoryNode(const int32_t numa_node)
+{
+  constexpr size_t kBitsPerMask{8 * sizeof(unsigned long)};
+  std::vector<unsigned long> node_mask(numa_node / kBitsPerMask + 1, 0);
+  node_mask[numa_node / kBitsPerMask] |= 1UL << (numa_node % kBitsPerMask);
+  if (syscall(
+          SYS_set_mempolicy, kMemPolicyPreferred, node_mask.data(),
+          node_mask.size() * kBitsPerMask + 1) != 0) {
+    return cb::Error(
+        "failed to allocate memory on NUMA node " + std::to_string(numa_node) +
+            ": " + std::strerror(errno),
+        GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+}  // namespace
+
+cb::Error
+ParseCpuList(const std::string& cpu_list, std::vector<int>* cpus)
+{
+  cpus->clear();
+  std::stringstream ss(cpu_list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    const size_t dash{item.find('-')};
+    int first{0};
+    int last{0};
+    bool valid{false};
+    if (dash == std::string::npos) {
+      valid = ParseCpu(item, &first);
+      last = first;
+    } else {
+      valid = ParseCpu(item.substr(0, dash), &first) &&
+              ParseCpu(item.substr(dash + 1), &last) && first <= last;
+    }
+    if (!valid) {
+      return cb::Error(
+          "invalid CPU core or range '" + item + "' in '" + cpu_list + "'",
+          GENERIC_ERROR);
+    }
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus->push_back(cpu);
+    }
+  }
+  if (cpus->empty()) {
+    return cb::Error("no CPU cores in '" + cpu_list + "'", GENERIC_ERROR);
+  }
+  std::sort(cpus->begin(), cpus->end());
+  cpus->erase(std::unique(cpus->begin(), cpus->end()), cpus->end());
+  return cb::Error::Success;
+}
+
+std::string
+FormatCpuList(const std::vector<int>& cpus)
+{
+  std::stringstream ss;
+  for (size_t i = 0; i < cpus.size();) {
+    size_t last{i};
+    while (last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1) {
+      ++last;
+    }
+    if (i != 0) {
+      ss << ",";
+    }
+    ss << cpus[i];
+    if (last != i) {
+      ss << "-" << cpus[last];
+    }
+    i = last + 1;
+  }
+  return ss.str();
+}
+
+cb::Error
+GetNumaNodeCpus(
+    const int32_t numa_node, std::vector<int>* cpus,
+    const std::string& sysfs_node_dir)
+{
+  const std::string path{
+      sysfs_node_dir + "/node" + std::to_string(numa_node) + "/cpulist"};
+  std::ifstream cpulist_file(path);
+  std::string cpu_list;
+  if (!cpulist_file || !std::getline(cpulist_file, cpu_list)) {
+    return cb::Error(
+        "failed to read the CPU cores of NUMA node " +
+            std::to_string(numa_node) + " from " + path,
+        GENERIC_ERROR);
+  }
+  return ParseCpuList(cpu_list, cpus);
+}
+
+cb::Error
+SetCpuPlacement(
+    const std::vector<int>& cpus, const int32_t numa_node,
+    std::vector<int>* placed_cpus)
+{
+  *placed_cpus = cpus;
+  if (placed_cpus->empty() && numa_node >= 0) {
+    RETURN_IF_ERROR(GetNumaNodeCpus(numa_node, placed_cpus));
+  }
+
+  if (!placed_cpus->empty()) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const int cpu : *placed_cpus) {
+      CPU_SET(cpu, &cpu_set);
+    }
+    const int err{
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set)};
+    if (err != 0) {
+      return cb::Error(
+          "failed to pin to CPU cores " + FormatCpuList(*placed_cpus) + ": " +
+              std::strerror(err),
+          GENERIC_ERROR);
+    }
+  }
+
+  if (numa_node >= 0) {
+    RETURN_IF_ERROR(SetMemoryNode(numa_node));
+  }
+  return cb::Error::Success;
+}
+
+}}  // namespace triton::perfanalyzer
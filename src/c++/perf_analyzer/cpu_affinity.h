@@ -0,0 +1,70 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "client_backend/client_backend.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// Parse a list of CPU cores such as "0-3,8,10-11".
+/// \param cpu_list The comma separated list of cores and ranges of cores.
+/// \param cpus Returns the sorted cores without duplicates.
+/// \return cb::Error object indicating success or failure.
+cb::Error ParseCpuList(const std::string& cpu_list, std::vector<int>* cpus);
+
+/// \return The cores in 'cpus' in the format of ParseCpuList.
+std::string FormatCpuList(const std::vector<int>& cpus);
+
+/// Get the CPU cores of a NUMA node.
+/// \param numa_node The NUMA node.
+/// \param cpus Returns the cores of the node.
+/// \param sysfs_node_dir The directory describing the NUMA nodes.
+/// \return cb::Error object indicating success or failure.
+cb::Error GetNumaNodeCpus(
+    const int32_t numa_node, std::vector<int>* cpus,
+    const std::string& sysfs_node_dir = "/sys/devices/system/node");
+
+/// Pin the calling thread to CPU cores and prefer allocating its memory on a
+/// NUMA node. The threads it creates afterwards inherit the placement, so
+/// calling this before creating the client backend, the load manager and the
+/// input data places the worker threads, the client I/O threads and the
+/// input buffers as well.
+/// \param cpus The cores to pin to. When empty, the cores of 'numa_node' are
+/// used, and no pinning is done when 'numa_node' is negative too.
+/// \param numa_node The NUMA node to allocate memory on, or negative to keep
+/// the default memory policy.
+/// \param placed_cpus Returns the cores the thread was pinned to.
+/// \return cb::Error object indicating success or failure.
+cb::Error SetCpuPlacement(
+    const std::vector<int>& cpus, const int32_t numa_node,
+    std::vector<int>* placed_cpus);
+
+}}  // namespace triton::perfanalyzer
@@ -31,6 +31,8 @@
 
 #include <fstream>
 
+#include "convert_utils.h"
+
 namespace triton { namespace perfanalyzer {
 
 DataLoader::DataLoader(const size_t batch_size)
@@ -272,6 +274,27 @@ DataLoader::GenerateData(
                 "the request",
             pa::GENERIC_ERROR);
       }
+      if (!zero_input && ((input.second.datatype_.compare("FP16") == 0) ||
+                          (input.second.datatype_.compare("BF16") == 0))) {
+        // Random bytes would contain NaN and infinity values, generate
+        // random values in [0, 1] and convert them instead.
+        std::vector<float> values(byte_size / sizeof(uint16_t));
+        for (auto& value : values) {
+          value = static_cast<float>(rand()) / RAND_MAX;
+        }
+        std::string key_name(
+            input.second.name_ + "_" + std::to_string(0) + "_" +
+            std::to_string(0));
+        auto it = input_data_.emplace(key_name, std::vector<char>()).first;
+        it->second.resize(byte_size);
+        uint16_t* converted = reinterpret_cast<uint16_t*>(it->second.data());
+        if (input.second.datatype_.compare("FP16") == 0) {
+          triton::client::Fp32ToFp16(values.data(), converted, values.size());
+        } else {
+          triton::client::Fp32ToBf16(values.data(), converted, values.size());
+        }
+        continue;
+      }
       max_input_byte_size = std::max(max_input_byte_size, (size_t)byte_size);
     } else {
       // Generate string input and store it into map
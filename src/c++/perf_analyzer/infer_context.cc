@@ -28,6 +28,34 @@
 
 namespace triton { namespace perfanalyzer {
 
+void
+InferContext::SetWorkload(std::shared_ptr<const Workload> workload)
+{
+  workload_ = workload;
+  workload_infer_data_.clear();
+  std::vector<double> weights;
+  for (size_t i = 0; i < workload_->size(); ++i) {
+    const auto& model_load = (*workload_)[i];
+    weights.push_back(model_load.weight_);
+    if (i == 0) {
+      continue;
+    }
+    std::unique_ptr<InferData> infer_data(new InferData());
+    infer_data->options_.reset(
+        new cb::InferOptions(model_load.parser_->ModelName()));
+    infer_data->options_->model_version_ = model_load.parser_->ModelVersion();
+    infer_data->options_->model_signature_name_ =
+        model_load.parser_->ModelSignatureName();
+    workload_infer_data_.push_back(std::move(infer_data));
+  }
+
+  model_selector_ = ModelSelector(weights);
+  // Offset the contexts so that they don't all start with the same model
+  for (size_t i = 0; i < (thread_id_ + id_) % weights.size(); ++i) {
+    model_selector_.Next();
+  }
+}
+
 void
 InferContext::Init()
 {
@@ -36,6 +64,15 @@ InferContext::Init()
     return;
   }
 
+  for (size_t i = 0; i < workload_infer_data_.size(); ++i) {
+    thread_stat_->status_ =
+        (*workload_)[i + 1].infer_data_manager_->InitInferData(
+            *workload_infer_data_[i]);
+    if (!thread_stat_->status_.IsOk()) {
+      return;
+    }
+  }
+
   if (streaming_) {
     // Decoupled models should not collect client side statistics
     thread_stat_->status_ = infer_backend_->StartStream(
@@ -46,19 +83,40 @@ InferContext::Init()
   }
 }
 
-void
-InferContext::SendInferRequest(bool delayed)
+bool
+InferContext::SendInferRequest(
+    bool delayed,
+    std::chrono::time_point<std::chrono::system_clock> scheduled_time)
 {
+  scheduled_time_ = scheduled_time;
+  if (!AdmitRequest()) {
+    return false;
+  }
+  bool using_json_data{using_json_data_};
+  if (workload_ != nullptr) {
+    model_index_ = model_selector_.Next();
+    using_json_data = (*workload_)[model_index_].using_json_data_;
+  }
+
   // Update the inputs if required
-  if (using_json_data_) {
+  if (using_json_data) {
     UpdateJsonData();
   }
   SendRequest(request_id_++, delayed);
+  return true;
 }
 
-void
-InferContext::SendSequenceInferRequest(uint32_t seq_stat_index, bool delayed)
+bool
+InferContext::SendSequenceInferRequest(
+    uint32_t seq_stat_index, bool delayed,
+    std::chrono::time_point<std::chrono::system_clock> scheduled_time)
 {
+  scheduled_time_ = scheduled_time;
+  // Admitted before the sequence moves on so that a shed request does not
+  // skip a step of the sequence
+  if (!AdmitRequest()) {
+    return false;
+  }
   // Need lock to protect the order of dispatch across worker threads.
   // This also helps in reporting the realistic latencies.
   std::lock_guard<std::mutex> guard(
@@ -77,7 +135,10 @@ InferContext::SendSequenceInferRequest(uint32_t seq_stat_index, bool delayed)
     SendRequest(
         request_id_++, delayed,
         sequence_manager_->GetSequenceID(seq_stat_index));
+    return true;
   }
+  ReleaseRequest();
+  return false;
 }
 
 void
@@ -97,6 +158,11 @@ InferContext::CompleteOngoingSequence(uint32_t seq_stat_index)
     sequence_manager_->DecrementRemainingQueries(seq_stat_index);
 
     bool is_delayed = false;
+    scheduled_time_ = {};
+    // The end of a sequence is sent regardless of the limit
+    if (thread_stat_->inflight_limiter_ != nullptr) {
+      thread_stat_->inflight_limiter_->ForceAcquire();
+    }
     SendRequest(
         request_id_++, is_delayed,
         sequence_manager_->GetSequenceID(seq_stat_index));
@@ -111,29 +177,37 @@ InferContext::SendRequest(
     return;
   }
 
+  InferData& infer_data{ModelInferData(model_index_)};
   thread_stat_->num_sent_requests_++;
+  thread_stat_->total_sent_requests_++;
+  if (delayed) {
+    thread_stat_->total_delayed_requests_++;
+  }
+  thread_stat_->in_flight_requests_++;
   if (async_) {
-    infer_data_.options_->request_id_ = std::to_string(request_id);
+    infer_data.options_->request_id_ = std::to_string(request_id);
     {
       std::lock_guard<std::mutex> lock(thread_stat_->mu_);
       auto it = async_req_map_
-                    .emplace(infer_data_.options_->request_id_, RequestRecord())
+                    .emplace(infer_data.options_->request_id_, RequestRecord())
                     .first;
       it->second.start_time_ = std::chrono::system_clock::now();
-      it->second.sequence_end_ = infer_data_.options_->sequence_end_;
+      it->second.sequence_end_ = infer_data.options_->sequence_end_;
       it->second.delayed_ = delayed;
       it->second.sequence_id_ = sequence_id;
+      it->second.model_index_ = model_index_;
+      it->second.scheduled_time_ = scheduled_time_;
     }
 
     thread_stat_->idle_timer.Start();
     if (streaming_) {
       thread_stat_->status_ = infer_backend_->AsyncStreamInfer(
-          *(infer_data_.options_), infer_data_.valid_inputs_,
-          infer_data_.outputs_);
+          *(infer_data.options_), infer_data.valid_inputs_,
+          infer_data.outputs_);
     } else {
       thread_stat_->status_ = infer_backend_->AsyncInfer(
-          async_callback_func_, *(infer_data_.options_),
-          infer_data_.valid_inputs_, infer_data_.outputs_);
+          async_callback_func_, *(infer_data.options_),
+          infer_data.valid_inputs_, infer_data.outputs_);
     }
     thread_stat_->idle_timer.Stop();
 
@@ -145,12 +219,14 @@ InferContext::SendRequest(
     start_time_sync = std::chrono::system_clock::now();
     cb::InferResult* results = nullptr;
     thread_stat_->status_ = infer_backend_->Infer(
-        &results, *(infer_data_.options_), infer_data_.valid_inputs_,
-        infer_data_.outputs_);
+        &results, *(infer_data.options_), infer_data.valid_inputs_,
+        infer_data.outputs_);
     thread_stat_->idle_timer.Stop();
+    thread_stat_->in_flight_requests_--;
+    ReleaseRequest();
     if (results != nullptr) {
       if (thread_stat_->status_.IsOk()) {
-        thread_stat_->status_ = ValidateOutputs(results);
+        thread_stat_->status_ = ValidateOutputs(results, model_index_);
       }
       delete results;
     }
@@ -158,6 +234,10 @@ InferContext::SendRequest(
       return;
     }
     end_time_sync = std::chrono::system_clock::now();
+    thread_stat_->latency_histogram_.Add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            end_time_sync - start_time_sync)
+            .count());
     std::vector<std::chrono::time_point<std::chrono::system_clock>>
         end_time_syncs{end_time_sync};
     {
@@ -167,7 +247,12 @@ InferContext::SendRequest(
       auto total = end_time_sync - start_time_sync;
       thread_stat_->request_records_.emplace_back(RequestRecord(
           start_time_sync, std::move(end_time_syncs),
-          infer_data_.options_->sequence_end_, delayed, sequence_id, false));
+          infer_data.options_->sequence_end_, delayed, sequence_id, false,
+          model_index_, scheduled_time_));
+      // Counted once the record is there for the window to collect
+      if (thread_stat_->window_controller_ != nullptr) {
+        thread_stat_->window_controller_->RequestCompleted();
+      }
       thread_stat_->status_ =
           infer_backend_->ClientInferStat(&(thread_stat_->contexts_stat_[id_]));
       if (!thread_stat_->status_.IsOk()) {
@@ -178,13 +263,36 @@ InferContext::SendRequest(
 }
 
 
+bool
+InferContext::AdmitRequest()
+{
+  if (thread_stat_->inflight_limiter_ == nullptr) {
+    return true;
+  }
+  return thread_stat_->inflight_limiter_->Acquire(scheduled_time_);
+}
+
+void
+InferContext::ReleaseRequest()
+{
+  if (thread_stat_->inflight_limiter_ != nullptr) {
+    thread_stat_->inflight_limiter_->Release();
+  }
+}
+
 void
 InferContext::UpdateJsonData()
 {
-  int step_id = (data_step_id_ * batch_size_) % data_loader_->GetTotalSteps(0);
+  const bool use_workload{workload_ != nullptr};
+  const auto& data_loader{
+      use_workload ? (*workload_)[model_index_].data_loader_ : data_loader_};
+  const auto& infer_data_manager{
+      use_workload ? (*workload_)[model_index_].infer_data_manager_
+                   : infer_data_manager_};
+  int step_id = (data_step_id_ * batch_size_) % data_loader->GetTotalSteps(0);
   data_step_id_ += GetNumActiveThreads();
-  thread_stat_->status_ =
-      infer_data_manager_->UpdateInferData(thread_id_, 0, step_id, infer_data_);
+  thread_stat_->status_ = infer_data_manager->UpdateInferData(
+      thread_id_, 0, step_id, ModelInferData(model_index_));
 }
 
 void
@@ -203,15 +311,17 @@ InferContext::UpdateSeqJsonData(size_t seq_stat_index)
 }
 
 cb::Error
-InferContext::ValidateOutputs(const cb::InferResult* result_ptr)
+InferContext::ValidateOutputs(
+    const cb::InferResult* result_ptr, const size_t model_index)
 {
+  const InferData& infer_data{ModelInferData(model_index)};
   // Validate output if set
-  if (!infer_data_.expected_outputs_.empty()) {
-    for (size_t i = 0; i < infer_data_.outputs_.size(); ++i) {
+  if (!infer_data.expected_outputs_.empty()) {
+    for (size_t i = 0; i < infer_data.outputs_.size(); ++i) {
       const uint8_t* buf = nullptr;
       size_t byte_size = 0;
-      result_ptr->RawData(infer_data_.outputs_[i]->Name(), &buf, &byte_size);
-      for (const auto& expected : infer_data_.expected_outputs_[i]) {
+      result_ptr->RawData(infer_data.outputs_[i]->Name(), &buf, &byte_size);
+      for (const auto& expected : infer_data.expected_outputs_[i]) {
         if (!expected.is_valid) {
           return cb::Error(
               "Expected output can't be invalid", pa::GENERIC_ERROR);
@@ -236,6 +346,15 @@ InferContext::ValidateOutputs(const cb::InferResult* result_ptr)
   return cb::Error::Success;
 }
 
+InferData&
+InferContext::ModelInferData(const size_t model_index)
+{
+  if (model_index == 0) {
+    return infer_data_;
+  }
+  return *workload_infer_data_[model_index - 1];
+}
+
 void
 InferContext::AsyncCallbackFuncImpl(cb::InferResult* result)
 {
@@ -269,12 +388,21 @@ InferContext::AsyncCallbackFuncImpl(cb::InferResult* result)
         }
         if (is_final_response) {
           has_received_final_response_ = is_final_response;
+          thread_stat_->latency_histogram_.Add(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  it->second.response_times_.back() - it->second.start_time_)
+                  .count());
           thread_stat_->request_records_.emplace_back(
               it->second.start_time_, it->second.response_times_,
               it->second.sequence_end_, it->second.delayed_,
-              it->second.sequence_id_, it->second.has_null_last_response_);
+              it->second.sequence_id_, it->second.has_null_last_response_,
+              it->second.model_index_, it->second.scheduled_time_);
+          if (thread_stat_->window_controller_ != nullptr) {
+            thread_stat_->window_controller_->RequestCompleted();
+          }
           infer_backend_->ClientInferStat(&(thread_stat_->contexts_stat_[id_]));
-          thread_stat_->cb_status_ = ValidateOutputs(result);
+          thread_stat_->cb_status_ =
+              ValidateOutputs(result, it->second.model_index_);
           async_req_map_.erase(request_id);
         }
       }
@@ -287,6 +415,8 @@ InferContext::AsyncCallbackFuncImpl(cb::InferResult* result)
 
   if (is_final_response) {
     total_ongoing_requests_--;
+    thread_stat_->in_flight_requests_--;
+    ReleaseRequest();
     num_responses_ = 0;
 
     if (async_callback_finalize_func_ != nullptr) {
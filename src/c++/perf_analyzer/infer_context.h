@@ -35,9 +35,13 @@
 #include "idle_timer.h"
 #include "iinfer_data_manager.h"
 #include "infer_data.h"
+#include "inflight_limiter.h"
+#include "live_metrics.h"
 #include "perf_utils.h"
 #include "request_record.h"
 #include "sequence_manager.h"
+#include "window_controller.h"
+#include "workload.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -62,6 +66,20 @@ struct ThreadStat {
   std::mutex mu_;
   // The number of sent requests by this thread.
   std::atomic<size_t> num_sent_requests_{0};
+
+  // The live metrics of this thread, updated without taking 'mu_'. Unlike
+  // the members above they are never reset during the run.
+  std::atomic<size_t> total_sent_requests_{0};
+  std::atomic<size_t> total_delayed_requests_{0};
+  std::atomic<size_t> in_flight_requests_{0};
+  LiveLatencyHistogram latency_histogram_;
+
+  // Counts the completed requests of all the threads for the measurement
+  // windows, null if they are not counted
+  std::shared_ptr<WindowController> window_controller_;
+  // Bounds the requests in flight of all the threads, null if they are not
+  // bounded
+  std::shared_ptr<InflightLimiter> inflight_limiter_;
 };
 
 #ifndef DOCTEST_CONFIG_DISABLE
@@ -89,7 +107,8 @@ class InferContext {
         infer_data_manager_(infer_data_manager),
         sequence_manager_(sequence_manager)
   {
-    thread_stat_->status_ = factory_->CreateClientBackend(&infer_backend_);
+    thread_stat_->status_ =
+        factory_->CreateContextClientBackend(&infer_backend_);
     infer_data_.options_.reset(new cb::InferOptions(parser_->ModelName()));
     infer_data_.options_->model_version_ = parser_->ModelVersion();
     infer_data_.options_->model_signature_name_ = parser_->ModelSignatureName();
@@ -100,14 +119,25 @@ class InferContext {
   InferContext(InferContext&&) = delete;
   InferContext(const InferContext&) = delete;
 
+  // Spread the requests over the models of 'workload' instead of sending
+  // them all to the model of the context. Must be done before Init()
+  void SetWorkload(std::shared_ptr<const Workload> workload);
+
   // Initialize the context. Must be done before any inferences are sent
   void Init();
 
-  // Send a single inference request to the server
-  void SendInferRequest(bool delayed = false);
+  // Send a single inference request to the server. 'scheduled_time' is the
+  // time the request was intended to be sent at, if it follows a schedule.
+  // Returns false if the request was not sent, such as when it is shed
+  bool SendInferRequest(
+      bool delayed = false,
+      std::chrono::time_point<std::chrono::system_clock> scheduled_time = {});
 
-  // Send a single sequence inference request to the server
-  void SendSequenceInferRequest(uint32_t seq_index, bool delayed = false);
+  // Send a single sequence inference request to the server. Returns false if
+  // the request was not sent, such as when it is shed
+  bool SendSequenceInferRequest(
+      uint32_t seq_index, bool delayed = false,
+      std::chrono::time_point<std::chrono::system_clock> scheduled_time = {});
 
   // Finish the active sequence at the given seq_stat_index
   void CompleteOngoingSequence(uint32_t seq_stat_index);
@@ -148,13 +178,26 @@ class InferContext {
       const uint64_t request_id, const bool delayed,
       const uint64_t sequence_id = 0);
 
+  // Admit a scheduled request under the limit of requests in flight, if
+  // there is one. Returns false if the request is shed
+  bool AdmitRequest();
+
+  // Release the slot of a completed request under the limit of requests in
+  // flight, if there is one
+  void ReleaseRequest();
+
   /// Update inputs based on custom json data
   void UpdateJsonData();
 
   /// Update inputs based on custom json data for the given sequence
   void UpdateSeqJsonData(size_t seq_stat_index);
 
-  cb::Error ValidateOutputs(const cb::InferResult* result_ptr);
+  cb::Error ValidateOutputs(
+      const cb::InferResult* result_ptr, const size_t model_index = 0);
+
+  /// \return The InferData object of the model at 'model_index' of the
+  /// workload, the one of the context for the first model.
+  InferData& ModelInferData(const size_t model_index);
 
   // Callback function for handling asynchronous requests
   void AsyncCallbackFuncImpl(cb::InferResult* result);
@@ -205,6 +248,17 @@ class InferContext {
   std::function<void(uint32_t)> worker_callback_{nullptr};
   bool has_received_final_response_{false};
 
+  // The models of a multi-model workload, null if the requests all go to the
+  // model of 'parser_'
+  std::shared_ptr<const Workload> workload_{nullptr};
+  // The InferData objects of the models of the workload but the first one
+  std::vector<std::unique_ptr<InferData>> workload_infer_data_;
+  ModelSelector model_selector_;
+  // The model the request being sent goes to
+  size_t model_index_{0};
+  // The time the request being sent was scheduled at, zero if unscheduled
+  std::chrono::time_point<std::chrono::system_clock> scheduled_time_;
+
 #ifndef DOCTEST_CONFIG_DISABLE
   friend NaggyMockInferContext;
 
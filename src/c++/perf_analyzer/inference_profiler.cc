@@ -94,6 +94,36 @@ ReportPrometheusMetrics(const Metrics& metrics)
 
 namespace {
 
+// Get the time the request ended at. A final null response doesn't count as
+// the end of the request, returns false if it is the only response.
+bool
+GetRequestEndNs(const RequestRecord& request_record, uint64_t& request_end_ns)
+{
+  if (request_record.has_null_last_response_ == false) {
+    request_end_ns = CHRONO_TO_NANOS(request_record.response_times_.back());
+  } else if (request_record.response_times_.size() > 1) {
+    size_t last_response_idx{request_record.response_times_.size() - 2};
+    request_end_ns =
+        CHRONO_TO_NANOS(request_record.response_times_[last_response_idx]);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// The bucket of the schedule lag histogram for 'lag_ns': decades from 10
+// usec to 1 sec and UINT64_MAX above.
+uint64_t
+ScheduleLagBucket(const uint64_t lag_ns)
+{
+  for (uint64_t bound_us = 10; bound_us <= 1000000; bound_us *= 10) {
+    if (lag_ns < bound_us * 1000) {
+      return bound_us;
+    }
+  }
+  return UINT64_MAX;
+}
+
 inline uint64_t
 AverageDurationInUs(const uint64_t total_time_in_ns, const uint64_t cnt)
 {
@@ -419,12 +449,124 @@ ReportClientSideStats(
               << " latency: " << (percentile.second / 1000) << " usec"
               << std::endl;
   }
+  if (!stats.corrected_latencies.empty()) {
+    if (percentile == -1) {
+      std::cout << "    Avg corrected latency: "
+                << (stats.avg_corrected_latency_ns / 1000) << " usec"
+                << std::endl;
+    }
+    for (const auto& percentile : stats.corrected_percentile_latency_ns) {
+      std::cout << "    p" << percentile.first << " corrected latency: "
+                << (percentile.second / 1000) << " usec" << std::endl;
+    }
+    std::cout << "    Schedule lag:";
+    std::string separator{" "};
+    for (const auto& bucket : stats.schedule_lag_histogram) {
+      std::cout << separator;
+      if (bucket.first == UINT64_MAX) {
+        std::cout << ">=1000000 usec: ";
+      } else {
+        std::cout << "<" << bucket.first << " usec: ";
+      }
+      std::cout << bucket.second;
+      separator = ", ";
+    }
+    std::cout << std::endl;
+  }
 
   std::cout << client_library_detail << std::endl;
 
+  if (include_lib_stats &&
+      ((stats.cache_hit_count != 0) || (stats.cache_miss_count != 0))) {
+    std::cout << "    Response cache: " << stats.cache_hit_count << " hits, "
+              << stats.cache_miss_count << " misses" << std::endl;
+  }
+
   return cb::Error::Success;
 }
 
+void
+ReportWorkloadModelStats(
+    const WorkloadModelStats& stats, const int64_t percentile)
+{
+  std::cout << "  Model " << stats.model_name << ": " << std::endl;
+  std::cout << "    Request count: " << stats.request_count << std::endl;
+  std::cout << "    Throughput: " << stats.infer_per_sec << " infer/sec"
+            << std::endl;
+  if (stats.request_count == 0) {
+    return;
+  }
+  if (percentile == -1) {
+    std::cout << "    Avg latency: " << (stats.avg_latency_ns / 1000)
+              << " usec" << std::endl;
+  }
+  for (const auto& percentile : stats.percentile_latency_ns) {
+    std::cout << "    p" << percentile.first
+              << " latency: " << (percentile.second / 1000) << " usec"
+              << std::endl;
+  }
+  if (stats.slo_latency_ms != 0) {
+    std::stringstream slo_violations{""};
+    slo_violations << "    Requests over the " << stats.slo_latency_ms
+                   << " msec latency objective: " << stats.slo_violation_count
+                   << " (" << std::fixed << std::setprecision(2)
+                   << ((double)stats.slo_violation_count /
+                       stats.request_count) *
+                          100
+                   << "%)";
+    std::cout << slo_violations.str() << std::endl;
+  }
+}
+
+void
+ReportResourceUsage(const ResourceUsageStats& stats)
+{
+  std::cout << "  Load generator: " << std::endl;
+  std::cout << "    CPU: " << std::fixed << std::setprecision(2)
+            << stats.cpu_utilization << " cores (user "
+            << (stats.user_cpu_ns / NANOS_PER_MILLIS) << " msec, system "
+            << (stats.system_cpu_ns / NANOS_PER_MILLIS)
+            << " msec), busiest thread "
+            << stats.max_thread_cpu_utilization * 100 << "% of a core"
+            << std::endl;
+  std::cout << "    Context switches: " << stats.voluntary_context_switches
+            << " voluntary, " << stats.involuntary_context_switches
+            << " involuntary" << std::endl;
+  std::cout << "    Page faults: " << stats.minor_page_faults << " minor, "
+            << stats.major_page_faults << " major" << std::endl;
+  std::cout << "    Resident memory: " << (stats.rss_bytes >> 20) << " MB ("
+            << std::showpos << (stats.rss_growth_bytes / 1024) << " KB"
+            << std::noshowpos << ")" << std::endl;
+  if (stats.has_heap_stats) {
+    std::cout << "    Heap growth: " << std::showpos
+              << (stats.heap_growth_bytes / 1024) << " KB" << std::noshowpos
+              << std::endl;
+  }
+}
+
+void
+ReportInflightLimitStats(
+    const InflightLimitStats& stats, const uint64_t duration_ns)
+{
+  const uint64_t arrivals{stats.admitted_requests + stats.shed_requests};
+  std::cout << "  In-flight limit of " << stats.max_inflight << ": "
+            << std::endl;
+  std::cout << "    Shed requests: " << stats.shed_requests << " ("
+            << std::fixed << std::setprecision(2)
+            << (duration_ns == 0 ? 0.0
+                                 : stats.shed_requests * 1e9 / duration_ns)
+            << " per sec, "
+            << (arrivals == 0 ? 0.0 : stats.shed_requests * 100.0 / arrivals)
+            << "% of arrivals)" << std::endl;
+  std::cout << "    Client queueing delay: avg "
+            << (stats.admitted_requests == 0
+                    ? 0
+                    : stats.queue_delay_sum_ns / stats.admitted_requests /
+                          1000)
+            << " usec, max " << (stats.max_queue_delay_ns / 1000) << " usec ("
+            << stats.queued_requests << " requests queued)" << std::endl;
+}
+
 cb::Error
 Report(
     const PerfStatus& summary, const int64_t percentile,
@@ -439,6 +581,10 @@ Report(
       summary.on_sequence_model, include_lib_stats, summary.overhead_pct,
       summary.send_request_rate, parser->IsDecoupled());
 
+  for (const auto& model_stats : summary.workload_model_stats) {
+    ReportWorkloadModelStats(model_stats, percentile);
+  }
+
   if (include_server_stats) {
     std::cout << "  Server: " << std::endl;
     ReportServerSideStats(summary.server_stats, 1, parser);
@@ -449,11 +595,32 @@ Report(
     ReportPrometheusMetrics(summary.metrics.front());
   }
 
+  if (summary.inflight_limit.max_inflight != 0) {
+    ReportInflightLimitStats(
+        summary.inflight_limit, summary.client_stats.duration_ns);
+  }
+
+  if (verbose && summary.resource_usage.duration_ns != 0) {
+    ReportResourceUsage(summary.resource_usage);
+  }
+
   if (summary.overhead_pct > overhead_pct_threshold) {
     std::cout << "[WARNING] Perf Analyzer is not able to keep up with the "
                  "desired load. The results may not be accurate."
               << std::endl;
   }
+  const size_t cpu_count{AvailableCpuCount()};
+  if (IsCpuSaturated(summary.resource_usage, cpu_count)) {
+    std::cout << "[WARNING] Perf Analyzer used " << std::fixed
+              << std::setprecision(2)
+              << summary.resource_usage.cpu_utilization
+              << " CPU cores on average out of the " << cpu_count
+              << " cores it can run on, and its busiest thread used "
+              << summary.resource_usage.max_thread_cpu_utilization * 100
+              << "% of a core. The results may be limited by the load "
+                 "generator."
+              << std::endl;
+  }
   return cb::Error::Success;
 }
 
@@ -601,10 +768,22 @@ InferenceProfiler::Profile(
   is_stable = false;
   meets_threshold = true;
 
-  RETURN_IF_ERROR(dynamic_cast<RequestRateManager*>(manager_.get())
-                      ->ChangeRequestRate(request_rate));
+  auto request_rate_manager{
+      dynamic_cast<RequestRateManager*>(manager_.get())};
+  RETURN_IF_ERROR(request_rate_manager->ChangeRequestRate(request_rate));
   std::cout << "Request Rate: " << request_rate
             << " inference requests per seconds" << std::endl;
+  const ScheduleStats& schedule_stats{
+      request_rate_manager->GetScheduleStats()};
+  if (schedule_stats.requests_ != 0) {
+    std::cout << "  Schedule burstiness: interval CV "
+              << schedule_stats.interval_cv_ << ", count dispersion "
+              << schedule_stats.count_dispersion_ << " and peak to mean "
+              << schedule_stats.peak_to_mean_ << " over "
+              << schedule_stats.window_ms_
+              << " msec windows, longest burst "
+              << schedule_stats.longest_burst_ << " requests" << std::endl;
+  }
 
   err = ProfileHelper(perf_status, &is_stable);
   if (err.IsOk()) {
@@ -636,6 +815,45 @@ InferenceProfiler::Profile(
   return cb::Error::Success;
 }
 
+cb::Error
+InferenceProfiler::ProfileLoadProfile(
+    const LoadProfile& profile, std::vector<PerfStatus>& perf_statuses)
+{
+  RETURN_IF_ERROR(dynamic_cast<RequestRateManager*>(manager_.get())
+                      ->StartLoadProfile(profile));
+
+  // The windows of the segments follow each other from the start of the
+  // profile, without warm-up or stabilization
+  all_request_records_.clear();
+  previous_window_end_ns_ = 0;
+  std::vector<RequestRecord> empty_request_records;
+  RETURN_IF_ERROR(manager_->SwapRequestRecords(empty_request_records));
+
+  const auto& segments{profile.Segments()};
+  for (size_t i = 0; i < segments.size() && !early_exit; ++i) {
+    const LoadSegment& segment{segments[i]};
+    std::cout << "Load profile segment " << (i + 1) << "/" << segments.size()
+              << ": " << segment.Description() << std::endl;
+
+    PerfStatus perf_status{};
+    perf_status.request_rate = segment.MeanRate();
+    perf_status.load_segment = segment.Description();
+    RETURN_IF_ERROR(manager_->CheckHealth());
+    RETURN_IF_ERROR(Measure(perf_status, segment.duration_ms_, false));
+
+    perf_statuses.push_back(perf_status);
+    cb::Error err{Report(
+        perf_status, percentile_, protocol_, verbose_, include_lib_stats_,
+        include_server_stats_, parser_, should_collect_metrics_,
+        overhead_pct_threshold_)};
+    if (!err.IsOk()) {
+      std::cerr << err;
+    }
+  }
+
+  return cb::Error::Success;
+}
+
 cb::Error
 InferenceProfiler::Profile(
     std::vector<PerfStatus>& perf_statuses, bool& meets_threshold,
@@ -694,6 +912,8 @@ InferenceProfiler::ProfileHelper(
   all_request_records_.clear();
   previous_window_end_ns_ = 0;
 
+  RETURN_IF_ERROR(WarmUp());
+
   // Start with a fresh empty request records vector in the manager
   //
   std::vector<RequestRecord> empty_request_records;
@@ -786,6 +1006,14 @@ InferenceProfiler::ProfileHelper(
   if (*is_stable) {
     RETURN_IF_ERROR(MergePerfStatusReports(
         measurement_perf_statuses, experiment_perf_status));
+    if (should_collect_profile_data_) {
+      InferenceLoadMode id{
+          experiment_perf_status.concurrency,
+          experiment_perf_status.request_rate};
+      collector_->SetMeasurementWindow(
+          id, experiment_perf_status.window_start_ns,
+          experiment_perf_status.window_end_ns);
+    }
   }
 
   if (early_exit) {
@@ -995,6 +1223,10 @@ InferenceProfiler::MergePerfStatusReports(
 
   experiment_perf_status.batch_size = perf_status.batch_size;
   experiment_perf_status.on_sequence_model = perf_status.on_sequence_model;
+  // The reports are in the order of their windows
+  experiment_perf_status.window_start_ns = perf_status.window_start_ns;
+  experiment_perf_status.window_end_ns =
+      perf_status_reports.back().window_end_ns;
 
   // Initialize the client stats for the merged report.
   experiment_perf_status.client_stats.request_count = 0;
@@ -1011,9 +1243,15 @@ InferenceProfiler::MergePerfStatusReports(
   experiment_perf_status.client_stats.infer_per_sec = 0;
   experiment_perf_status.client_stats.sequence_per_sec = 0;
   experiment_perf_status.client_stats.completed_count = 0;
+  experiment_perf_status.client_stats.cache_hit_count = 0;
+  experiment_perf_status.client_stats.cache_miss_count = 0;
+  experiment_perf_status.client_stats.corrected_latencies.clear();
+  experiment_perf_status.client_stats.schedule_lag_histogram.clear();
   experiment_perf_status.stabilizing_latency_ns = 0;
   experiment_perf_status.overhead_pct = 0;
   experiment_perf_status.send_request_rate = 0.0;
+  experiment_perf_status.resource_usage = ResourceUsageStats{};
+  experiment_perf_status.inflight_limit = InflightLimitStats{};
 
   std::vector<ServerSideStats> server_side_stats;
   for (auto& perf_status : perf_status_reports) {
@@ -1035,10 +1273,22 @@ InferenceProfiler::MergePerfStatusReports(
         experiment_perf_status.client_stats.latencies.end(),
         perf_status.client_stats.latencies.begin(),
         perf_status.client_stats.latencies.end());
+    experiment_perf_status.client_stats.corrected_latencies.insert(
+        experiment_perf_status.client_stats.corrected_latencies.end(),
+        perf_status.client_stats.corrected_latencies.begin(),
+        perf_status.client_stats.corrected_latencies.end());
+    for (const auto& bucket : perf_status.client_stats.schedule_lag_histogram) {
+      experiment_perf_status.client_stats
+          .schedule_lag_histogram[bucket.first] += bucket.second;
+    }
     // Accumulate the overhead percentage and send rate here to remove extra
     // traversals over the perf_status_reports
     experiment_perf_status.overhead_pct += perf_status.overhead_pct;
     experiment_perf_status.send_request_rate += perf_status.send_request_rate;
+    AccumulateResourceUsage(
+        perf_status.resource_usage, &experiment_perf_status.resource_usage);
+    AccumulateInflightLimitStats(
+        perf_status.inflight_limit, &experiment_perf_status.inflight_limit);
   }
 
   // Calculate the average overhead_pct for the experiment.
@@ -1049,6 +1299,10 @@ InferenceProfiler::MergePerfStatusReports(
     for (auto& perf_status : perf_status_reports) {
       experiment_perf_status.client_stats.completed_count +=
           perf_status.client_stats.completed_count;
+      experiment_perf_status.client_stats.cache_hit_count +=
+          perf_status.client_stats.cache_hit_count;
+      experiment_perf_status.client_stats.cache_miss_count +=
+          perf_status.client_stats.cache_miss_count;
 
       experiment_perf_status.client_stats.avg_request_time_ns +=
           perf_status.client_stats.avg_request_time_ns *
@@ -1098,6 +1352,34 @@ InferenceProfiler::MergePerfStatusReports(
   RETURN_IF_ERROR(SummarizeLatency(
       experiment_perf_status.client_stats.latencies, experiment_perf_status));
 
+  std::sort(
+      experiment_perf_status.client_stats.corrected_latencies.begin(),
+      experiment_perf_status.client_stats.corrected_latencies.end());
+  SummarizeCorrectedLatency(experiment_perf_status);
+
+  experiment_perf_status.workload_model_stats.clear();
+  for (size_t i = 0; i < workload_models_.size(); ++i) {
+    WorkloadModelStats stats{};
+    stats.model_name = workload_models_[i].name_;
+    stats.slo_latency_ms = workload_models_[i].slo_latency_ms_;
+    std::vector<uint64_t> latencies;
+    uint64_t duration_ns{0};
+    for (auto& perf_status : perf_status_reports) {
+      if (i < perf_status.workload_model_stats.size()) {
+        const auto& model_stats = perf_status.workload_model_stats[i];
+        latencies.insert(
+            latencies.end(), model_stats.latencies.begin(),
+            model_stats.latencies.end());
+        duration_ns += model_stats.duration_ns;
+      }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    SummarizeWorkloadModel(
+        std::move(latencies), duration_ns, experiment_perf_status.batch_size,
+        stats);
+    experiment_perf_status.workload_model_stats.push_back(std::move(stats));
+  }
+
   if (should_collect_metrics_) {
     // Put all Metric objects in a flat vector so they're easier to merge
     std::vector<std::reference_wrapper<const Metrics>> all_metrics{};
@@ -1131,6 +1413,51 @@ InferenceProfiler::GetServerSideStatus(
   return cb::Error::Success;
 }
 
+cb::Error
+InferenceProfiler::WarmUp()
+{
+  if (warmup_duration_ms_ == 0 && warmup_request_count_ == 0) {
+    return cb::Error::Success;
+  }
+
+  if (verbose_) {
+    std::cout << "  Warming up for " << warmup_duration_ms_ << " msec and "
+              << warmup_request_count_ << " requests" << std::endl;
+  }
+
+  WindowController& window_controller{manager_->GetWindowController()};
+  const uint64_t target{
+      window_controller.CompletedRequests() + warmup_request_count_};
+
+  // Check the health of the worker threads at least every second, both
+  // during the warm-up duration and while waiting for the warm-up requests
+  const auto warmup_end{
+      std::chrono::steady_clock::now() +
+      std::chrono::milliseconds(warmup_duration_ms_)};
+  while (!early_exit) {
+    const auto now{std::chrono::steady_clock::now()};
+    if (now >= warmup_end) {
+      break;
+    }
+    std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(
+        warmup_end - now, std::chrono::seconds(1)));
+    RETURN_IF_ERROR(manager_->CheckHealth());
+  }
+  // Wake up as soon as the workers complete the warm-up requests instead of
+  // polling for them
+  while (!early_exit && !window_controller.WaitForCompletedRequests(
+                            target, std::chrono::seconds(1))) {
+    RETURN_IF_ERROR(manager_->CheckHealth());
+  }
+  RETURN_IF_ERROR(manager_->CheckHealth());
+
+  // The requests sent during the warm-up don't count towards the send rate
+  // of the first measurement window
+  manager_->GetAndResetNumSentRequests();
+
+  return cb::Error::Success;
+}
+
 // Used for measurement
 cb::Error
 InferenceProfiler::Measure(
@@ -1160,6 +1487,10 @@ InferenceProfiler::Measure(
       RETURN_IF_ERROR(GetServerSideStatus(&start_status));
     }
     RETURN_IF_ERROR(manager_->GetAccumulatedClientStat(&start_stat));
+    RETURN_IF_ERROR(SampleResourceUsage(&prev_resource_usage_));
+    if (manager_->GetInflightLimiter() != nullptr) {
+      manager_->GetInflightLimiter()->SwapStats();
+    }
   }
 
   if (should_collect_metrics_) {
@@ -1171,28 +1502,51 @@ InferenceProfiler::Measure(
     }
   }
 
+  uint64_t window_end_ns;
   if (!is_count_based) {
-    // Wait for specified time interval in msec
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds((uint64_t)(measurement_window_ms_ * 1.2)));
+    // The window ends exactly one measurement interval after it started so
+    // that consecutive windows are contiguous and of equal length. Requests
+    // that end after the boundary are kept for the next window.
+    window_end_ns = window_start_ns + measurement_window * NANOS_PER_MILLIS;
+    std::this_thread::sleep_until(
+        std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::nanoseconds(window_end_ns))));
   } else {
-    do {
-      // Check the health of the worker threads.
+    // Wake up as soon as the workers complete the requested number of
+    // requests instead of polling for them
+    WindowController& window_controller{manager_->GetWindowController()};
+    const uint64_t target{
+        window_controller.CompletedRequests() + measurement_window};
+    while (!early_exit &&
+           !window_controller.WaitForCompletedRequests(
+               target, std::chrono::seconds(1))) {
+      // Check the health of the worker threads while waiting
       RETURN_IF_ERROR(manager_->CheckHealth());
-
-      // Wait for 1s until enough samples have been collected.
-      std::this_thread::sleep_for(std::chrono::milliseconds((uint64_t)1000));
-    } while (manager_->CountCollectedRequests() < measurement_window);
+    }
+    RETURN_IF_ERROR(manager_->CheckHealth());
+    window_end_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
   }
-
-  uint64_t window_end_ns =
-      std::chrono::duration_cast<std::chrono::nanoseconds>(
-          std::chrono::system_clock::now().time_since_epoch())
-          .count();
   previous_window_end_ns_ = window_end_ns;
 
+  ResourceUsageSample end_resource_usage;
+  RETURN_IF_ERROR(SampleResourceUsage(&end_resource_usage));
+  const ResourceUsageStats resource_usage{
+      SummarizeResourceUsage(prev_resource_usage_, end_resource_usage)};
+  prev_resource_usage_ = end_resource_usage;
+
+  InflightLimitStats inflight_limit{};
+  if (manager_->GetInflightLimiter() != nullptr) {
+    inflight_limit = manager_->GetInflightLimiter()->SwapStats();
+  }
+
   if (should_collect_metrics_) {
     metrics_manager_->GetLatestMetrics(perf_status.metrics);
+    if (timeline_collector_ != nullptr) {
+      timeline_collector_->AddMetrics(perf_status.metrics);
+    }
   }
 
   // Get server status and then print report on difference between
@@ -1214,6 +1568,8 @@ InferenceProfiler::Measure(
   RETURN_IF_ERROR(Summarize(
       start_status, end_status, start_stat, end_stat, perf_status,
       window_start_ns, window_end_ns));
+  perf_status.resource_usage = resource_usage;
+  perf_status.inflight_limit = inflight_limit;
 
   return cb::Error::Success;
 }
@@ -1229,6 +1585,9 @@ InferenceProfiler::Summarize(
   size_t delayed_request_count = 0;
   size_t response_count = 0;
 
+  summary.window_start_ns = window_start_ns;
+  summary.window_end_ns = window_end_ns;
+
   // Get measurement from requests that fall within the time interval
   std::pair<uint64_t, uint64_t> valid_range{window_start_ns, window_end_ns};
   uint64_t window_duration_ns = valid_range.second - valid_range.first;
@@ -1238,6 +1597,15 @@ InferenceProfiler::Summarize(
       valid_range, valid_sequence_count, delayed_request_count, &latencies,
       response_count, valid_requests);
 
+  if (!workload_models_.empty()) {
+    SummarizeWorkloadModels(valid_requests, window_duration_ns, summary);
+  }
+  SummarizeScheduleLag(valid_requests, summary);
+
+  if (timeline_collector_ != nullptr) {
+    timeline_collector_->AddRequests(valid_requests);
+  }
+
   if (should_collect_profile_data_) {
     CollectData(
         summary, window_start_ns, window_end_ns, std::move(valid_requests));
@@ -1257,6 +1625,14 @@ InferenceProfiler::Summarize(
   SummarizeSendRequestRate(
       window_duration_s, manager_->GetAndResetNumSentRequests(), summary);
 
+  {
+    std::lock_guard<std::mutex> lock(live_stats_mutex_);
+    live_window_stats_.infer_per_sec = summary.client_stats.infer_per_sec;
+    live_window_stats_.send_request_rate = summary.send_request_rate;
+    live_window_stats_.overhead_pct = summary.overhead_pct;
+    live_window_stats_.avg_latency_ns = summary.client_stats.avg_latency_ns;
+  }
+
   if (include_server_stats_) {
     RETURN_IF_ERROR(SummarizeServerStats(
         start_status, end_status, &(summary.server_stats)));
@@ -1265,6 +1641,17 @@ InferenceProfiler::Summarize(
   return cb::Error::Success;
 }
 
+void
+InferenceProfiler::GetLiveStats(LiveStats* stats)
+{
+  manager_->GetLiveStats(stats);
+  std::lock_guard<std::mutex> lock(live_stats_mutex_);
+  stats->infer_per_sec = live_window_stats_.infer_per_sec;
+  stats->send_request_rate = live_window_stats_.send_request_rate;
+  stats->overhead_pct = live_window_stats_.overhead_pct;
+  stats->avg_latency_ns = live_window_stats_.avg_latency_ns;
+}
+
 void
 InferenceProfiler::ValidLatencyMeasurement(
     const std::pair<uint64_t, uint64_t>& valid_range,
@@ -1281,13 +1668,7 @@ InferenceProfiler::ValidLatencyMeasurement(
     uint64_t request_start_ns = CHRONO_TO_NANOS(request_record.start_time_);
     uint64_t request_end_ns;
 
-    if (request_record.has_null_last_response_ == false) {
-      request_end_ns = CHRONO_TO_NANOS(request_record.response_times_.back());
-    } else if (request_record.response_times_.size() > 1) {
-      size_t last_response_idx{request_record.response_times_.size() - 2};
-      request_end_ns =
-          CHRONO_TO_NANOS(request_record.response_times_[last_response_idx]);
-    } else {
+    if (!GetRequestEndNs(request_record, request_end_ns)) {
       erase_indices.push_back(i);
       continue;
     }
@@ -1354,7 +1735,22 @@ InferenceProfiler::SummarizeLatency(
       GetMeanAndStdDev(latencies);
 
   // retrieve other interesting percentile
-  summary.client_stats.percentile_latency_ns.clear();
+  summary.client_stats.percentile_latency_ns = GetLatencyPercentiles(latencies);
+
+  if (extra_percentile_) {
+    summary.stabilizing_latency_ns =
+        summary.client_stats.percentile_latency_ns.find(percentile_)->second;
+  } else {
+    summary.stabilizing_latency_ns = summary.client_stats.avg_latency_ns;
+  }
+
+  return cb::Error::Success;
+}
+
+std::map<size_t, uint64_t>
+InferenceProfiler::GetLatencyPercentiles(const std::vector<uint64_t>& latencies)
+{
+  std::map<size_t, uint64_t> percentile_latency_ns;
   std::set<size_t> percentiles{50, 90, 95, 99};
   if (extra_percentile_) {
     percentiles.emplace(percentile_);
@@ -1362,18 +1758,122 @@ InferenceProfiler::SummarizeLatency(
 
   for (const auto percentile : percentiles) {
     size_t index = (percentile / 100.0) * (latencies.size() - 1) + 0.5;
-    summary.client_stats.percentile_latency_ns.emplace(
-        percentile, latencies[index]);
+    percentile_latency_ns.emplace(percentile, latencies[index]);
   }
+  return percentile_latency_ns;
+}
 
-  if (extra_percentile_) {
-    summary.stabilizing_latency_ns =
-        summary.client_stats.percentile_latency_ns.find(percentile_)->second;
-  } else {
-    summary.stabilizing_latency_ns = summary.client_stats.avg_latency_ns;
+void
+InferenceProfiler::SummarizeScheduleLag(
+    const std::vector<RequestRecord>& valid_requests, PerfStatus& summary)
+{
+  auto& client_stats{summary.client_stats};
+  client_stats.corrected_latencies.clear();
+  client_stats.schedule_lag_histogram.clear();
+  for (const auto& request_record : valid_requests) {
+    // Requests that are not sent on a schedule have nothing to correct
+    if (request_record.scheduled_time_.time_since_epoch().count() == 0) {
+      continue;
+    }
+    uint64_t request_end_ns;
+    if (!GetRequestEndNs(request_record, request_end_ns)) {
+      continue;
+    }
+    const uint64_t request_start_ns =
+        CHRONO_TO_NANOS(request_record.start_time_);
+    // A request sent ahead of its schedule is not corrected
+    const uint64_t scheduled_ns{std::min<uint64_t>(
+        CHRONO_TO_NANOS(request_record.scheduled_time_), request_start_ns)};
+    client_stats.corrected_latencies.push_back(request_end_ns - scheduled_ns);
+    client_stats
+        .schedule_lag_histogram[ScheduleLagBucket(
+            request_start_ns - scheduled_ns)]++;
+  }
+  std::sort(
+      client_stats.corrected_latencies.begin(),
+      client_stats.corrected_latencies.end());
+  SummarizeCorrectedLatency(summary);
+}
+
+void
+InferenceProfiler::SummarizeCorrectedLatency(PerfStatus& summary)
+{
+  auto& client_stats{summary.client_stats};
+  client_stats.avg_corrected_latency_ns = 0;
+  client_stats.corrected_percentile_latency_ns.clear();
+  if (client_stats.corrected_latencies.empty()) {
+    return;
+  }
+  client_stats.avg_corrected_latency_ns =
+      std::accumulate(
+          client_stats.corrected_latencies.begin(),
+          client_stats.corrected_latencies.end(), 0ULL) /
+      client_stats.corrected_latencies.size();
+  client_stats.corrected_percentile_latency_ns =
+      GetLatencyPercentiles(client_stats.corrected_latencies);
+}
+
+void
+InferenceProfiler::SummarizeWorkloadModels(
+    const std::vector<RequestRecord>& valid_requests,
+    const uint64_t duration_ns, PerfStatus& summary)
+{
+  std::vector<std::vector<uint64_t>> latencies(workload_models_.size());
+  for (const auto& request_record : valid_requests) {
+    if (request_record.model_index_ >= latencies.size()) {
+      continue;
+    }
+    uint64_t request_end_ns;
+    if (!GetRequestEndNs(request_record, request_end_ns)) {
+      continue;
+    }
+    latencies[request_record.model_index_].push_back(
+        request_end_ns - CHRONO_TO_NANOS(request_record.start_time_));
   }
 
-  return cb::Error::Success;
+  summary.workload_model_stats.clear();
+  for (size_t i = 0; i < workload_models_.size(); ++i) {
+    WorkloadModelStats stats{};
+    stats.model_name = workload_models_[i].name_;
+    stats.slo_latency_ms = workload_models_[i].slo_latency_ms_;
+    std::sort(latencies[i].begin(), latencies[i].end());
+    SummarizeWorkloadModel(
+        std::move(latencies[i]), duration_ns,
+        std::max(manager_->BatchSize(), (size_t)1), stats);
+    summary.workload_model_stats.push_back(std::move(stats));
+  }
+}
+
+void
+InferenceProfiler::SummarizeWorkloadModel(
+    std::vector<uint64_t>&& latencies, const uint64_t duration_ns,
+    const size_t batch_size, WorkloadModelStats& stats)
+{
+  stats.latencies = std::move(latencies);
+  stats.request_count = stats.latencies.size();
+  stats.duration_ns = duration_ns;
+  stats.infer_per_sec = (stats.request_count * batch_size) /
+                        ((float)duration_ns / NANOS_PER_SECOND);
+  stats.avg_latency_ns = 0;
+  stats.percentile_latency_ns.clear();
+  stats.slo_violation_count = 0;
+  if (stats.latencies.empty()) {
+    return;
+  }
+
+  stats.avg_latency_ns =
+      std::accumulate(stats.latencies.begin(), stats.latencies.end(), 0ULL) /
+      stats.latencies.size();
+
+  stats.percentile_latency_ns = GetLatencyPercentiles(stats.latencies);
+
+  if (stats.slo_latency_ms != 0) {
+    stats.slo_violation_count = std::distance(
+        std::upper_bound(
+            stats.latencies.begin(), stats.latencies.end(),
+            stats.slo_latency_ms * NANOS_PER_MILLIS),
+        stats.latencies.end());
+  }
 }
 
 std::tuple<uint64_t, uint64_t>
@@ -1439,6 +1939,10 @@ InferenceProfiler::SummarizeClientStat(
     uint64_t request_time_ns = end_stat.cumulative_total_request_time_ns -
                                start_stat.cumulative_total_request_time_ns;
     summary.client_stats.completed_count = completed_count;
+    summary.client_stats.cache_hit_count =
+        end_stat.cache_hit_count - start_stat.cache_hit_count;
+    summary.client_stats.cache_miss_count =
+        end_stat.cache_miss_count - start_stat.cache_miss_count;
     uint64_t send_time_ns =
         end_stat.cumulative_send_time_ns - start_stat.cumulative_send_time_ns;
     uint64_t receive_time_ns = end_stat.cumulative_receive_time_ns -
@@ -39,6 +39,8 @@
 #include "concurrency_manager.h"
 #include "constants.h"
 #include "custom_load_manager.h"
+#include "inflight_limiter.h"
+#include "live_metrics.h"
 #include "metrics.h"
 #include "metrics_manager.h"
 #include "model_parser.h"
@@ -46,6 +48,9 @@
 #include "periodic_concurrency_manager.h"
 #include "profile_data_collector.h"
 #include "request_rate_manager.h"
+#include "resource_usage.h"
+#include "timeline_collector.h"
+#include "workload.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -149,6 +154,39 @@ struct ClientSideStats {
 
   // Completed request count reported by the client library
   uint64_t completed_count;
+  // Requests served from and missing the client-side response cache
+  uint64_t cache_hit_count;
+  uint64_t cache_miss_count;
+
+  // The latencies of the requests measured from the time the schedule of the
+  // load intended them to be sent at rather than from the time they were
+  // sent at. They include the time a request waited for the load generator
+  // or the server to catch up, which the latencies above leave out
+  // (coordinated omission). Only set for scheduled loads, such as the
+  // request rate mode.
+  uint64_t avg_corrected_latency_ns{0};
+  std::map<size_t, uint64_t> corrected_percentile_latency_ns;
+  std::vector<uint64_t> corrected_latencies;
+  // The number of requests sent late by a lag below each bound (in usec,
+  // UINT64_MAX for the last bucket)
+  std::map<uint64_t, uint64_t> schedule_lag_histogram;
+};
+
+/// The client side statistics of a model of a multi-model workload.
+struct WorkloadModelStats {
+  std::string model_name;
+  uint64_t request_count;
+  uint64_t duration_ns;
+  double infer_per_sec;
+  uint64_t avg_latency_ns;
+  // a ordered map of percentiles to be reported (<percentile, value> pair)
+  std::map<size_t, uint64_t> percentile_latency_ns;
+  // The latency objective of the model, 0 if none
+  uint64_t slo_latency_ms;
+  // The number of requests over the latency objective
+  uint64_t slo_violation_count;
+  // List of all the valid latencies.
+  std::vector<uint64_t> latencies;
 };
 
 /// The entire statistics record.
@@ -166,6 +204,19 @@ struct PerfStatus {
   uint64_t stabilizing_latency_ns;
   // Metric for requests sent per second
   double send_request_rate{0.0};
+  // The statistics of each model of a multi-model workload
+  std::vector<WorkloadModelStats> workload_model_stats{};
+  // The resources used by perf_analyzer itself
+  ResourceUsageStats resource_usage{};
+  // The load profile segment that was measured, empty if there is no load
+  // profile
+  std::string load_segment{};
+  // The requests shed and queued under the limit of requests in flight
+  InflightLimitStats inflight_limit{};
+  // The start and the end of the measurement, in nanoseconds since the
+  // epoch. They span all the windows merged into the status.
+  uint64_t window_start_ns{0};
+  uint64_t window_end_ns{0};
 };
 
 cb::Error ReportPrometheusMetrics(const Metrics& metrics);
@@ -311,6 +362,9 @@ class InferenceProfiler {
   {
     auto& manager{dynamic_cast<PeriodicConcurrencyManager&>(*manager_)};
     std::vector<RequestRecord> request_records{manager.RunExperiment()};
+    if (timeline_collector_ != nullptr) {
+      timeline_collector_->AddRequests(request_records);
+    }
     // FIXME - Refactor collector class to not need ID or window in the case of
     // periodic concurrency mode
     InferenceLoadMode id{1, 0.0};
@@ -319,8 +373,51 @@ class InferenceProfiler {
     return cb::Error::Success;
   }
 
+  /// Follow a load profile in one continuous run and measure each of its
+  /// segments in a measurement window of the length of the segment.
+  /// \param profile The load profile to follow.
+  /// \param perf_statuses Appends the measurements summary of each segment.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error ProfileLoadProfile(
+      const LoadProfile& profile, std::vector<PerfStatus>& perf_statuses);
+
   bool IncludeServerStats() { return include_server_stats_; }
 
+  /// Report the statistics of each model of a multi-model workload along with
+  /// the ones of all the requests.
+  /// \param models The models of the workload, in the order of the model
+  /// indices of the request records.
+  void SetWorkload(const std::vector<WorkloadModel>& models)
+  {
+    workload_models_ = models;
+  }
+
+  /// Take a snapshot of the live metrics of the load generator and the
+  /// results of the last measurement window. Safe to call from any thread.
+  /// \param stats Returns the live stats.
+  void GetLiveStats(LiveStats* stats);
+
+  /// Add the requests and server-side metrics of every measurement window to
+  /// a timeline.
+  /// \param timeline_collector The collector of the timeline.
+  void SetTimelineCollector(
+      std::shared_ptr<TimelineCollector> timeline_collector)
+  {
+    timeline_collector_ = timeline_collector;
+  }
+
+  /// Generate load for a while at each load level before measuring it, to
+  /// leave the warm-up effects of the server out of the measurement. The
+  /// warm-up lasts until both minimums are reached.
+  /// \param duration_ms The minimum duration of the warm-up.
+  /// \param request_count The minimum number of requests to complete during
+  /// the warm-up.
+  void SetWarmup(const uint64_t duration_ms, const uint64_t request_count)
+  {
+    warmup_duration_ms_ = duration_ms;
+    warmup_request_count_ = request_count;
+  }
+
  private:
   InferenceProfiler(
       const bool verbose, const double stability_threshold,
@@ -384,6 +481,12 @@ class InferenceProfiler {
   /// \return cb::Error object indicating success or failure.
   cb::Error ProfileHelper(PerfStatus& status_summary, bool* is_stable);
 
+  /// Generate the load of the current load level without measuring it for
+  /// the warm-up duration and request count. The requests of the warm-up
+  /// are left to be discarded and the send count is reset.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error WarmUp();
+
   /// A helper function to determine if profiling is stable
   /// \param load_status Stores the observations of infer_per_sec and latencies
   /// \return Returns if the threshold and latencies are stable.
@@ -488,6 +591,43 @@ class InferenceProfiler {
   virtual cb::Error SummarizeLatency(
       const std::vector<uint64_t>& latencies, PerfStatus& summary);
 
+  /// Set the latencies corrected for the lag of the requests behind their
+  /// schedule in the summary.
+  /// \param valid_requests The request records of the measurement.
+  /// \param summary Returns the summary that the corrected latency fields
+  /// are set.
+  void SummarizeScheduleLag(
+      const std::vector<RequestRecord>& valid_requests, PerfStatus& summary);
+
+  /// Set the average and percentiles of the corrected latencies of the
+  /// summary from its sorted corrected_latencies.
+  /// \param summary Returns the summary that the corrected latency fields
+  /// are set.
+  void SummarizeCorrectedLatency(PerfStatus& summary);
+
+  /// \param latencies The sorted latencies to take the percentiles of.
+  /// \return The reported percentiles of 'latencies'.
+  std::map<size_t, uint64_t> GetLatencyPercentiles(
+      const std::vector<uint64_t>& latencies);
+
+  /// Set the statistics of each model of the workload in the summary.
+  /// \param valid_requests The request records of the measurement.
+  /// \param duration_ns The duration of the measurement in nsec.
+  /// \param summary Returns the summary that the workload model statistics
+  /// are set.
+  void SummarizeWorkloadModels(
+      const std::vector<RequestRecord>& valid_requests,
+      const uint64_t duration_ns, PerfStatus& summary);
+
+  /// \param latencies The sorted latencies of the requests to the model.
+  /// \param duration_ns The duration of the measurement in nsec.
+  /// \param batch_size The batch size of the requests.
+  /// \param stats Returns the statistics of the model, the model name and
+  /// latency objective being already set.
+  void SummarizeWorkloadModel(
+      std::vector<uint64_t>&& latencies, const uint64_t duration_ns,
+      const size_t batch_size, WorkloadModelStats& stats);
+
   /// \param latencies The vector of request latencies collected.
   /// \return std::tuple object containing:
   ///   * mean of latencies in nanoseconds
@@ -722,6 +862,10 @@ class InferenceProfiler {
   /// Client side statistics from the previous measurement window
   cb::InferStat prev_client_side_stats_;
 
+  /// The resources used by perf_analyzer at the end of the previous
+  /// measurement window
+  ResourceUsageSample prev_resource_usage_;
+
   /// Metrics manager that collects server-side metrics periodically
   std::shared_ptr<MetricsManager> metrics_manager_{nullptr};
 
@@ -735,6 +879,21 @@ class InferenceProfiler {
   // Whether to collect profile data.
   bool should_collect_profile_data_{false};
 
+  // The models of a multi-model workload, empty if there is a single model
+  std::vector<WorkloadModel> workload_models_;
+
+  // The collector of the timeline of the run, null if there is no timeline
+  std::shared_ptr<TimelineCollector> timeline_collector_{nullptr};
+
+  // The minimum duration and completed request count of the warm-up at each
+  // load level, no warm-up if both are 0
+  uint64_t warmup_duration_ms_{0};
+  uint64_t warmup_request_count_{0};
+
+  // The results of the last measurement window for the live metrics
+  LiveStats live_window_stats_{};
+  std::mutex live_stats_mutex_;
+
 #ifndef DOCTEST_CONFIG_DISABLE
   friend NaggyMockInferenceProfiler;
   friend TestInferenceProfiler;
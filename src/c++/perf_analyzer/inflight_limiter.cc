@@ -0,0 +1,140 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "inflight_limiter.h"
+
+#include <algorithm>
+
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+InflightLimiter::InflightLimiter(
+    const size_t max_inflight, const InflightLimitPolicy policy,
+    const std::chrono::nanoseconds queue_timeout)
+    : max_inflight_(max_inflight), policy_(policy),
+      queue_timeout_(queue_timeout)
+{
+  stats_.max_inflight = max_inflight_;
+}
+
+bool
+InflightLimiter::Acquire(
+    const std::chrono::system_clock::time_point arrival_time)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  bool queued{false};
+  if (inflight_ >= max_inflight_ && policy_ == InflightLimitPolicy::QUEUE) {
+    queued = true;
+    // Wake up regularly to stop waiting on an early exit
+    const auto check_interval{std::chrono::milliseconds(100)};
+    while (inflight_ >= max_inflight_ && !early_exit) {
+      auto wake_time{std::chrono::system_clock::now() + check_interval};
+      if (queue_timeout_.count() != 0) {
+        const auto deadline{arrival_time + queue_timeout_};
+        if (std::chrono::system_clock::now() >= deadline) {
+          break;
+        }
+        wake_time = std::min(wake_time, deadline);
+      }
+      cv_.wait_until(lock, wake_time);
+    }
+  }
+
+  if (inflight_ >= max_inflight_) {
+    if (!early_exit) {
+      stats_.shed_requests++;
+    }
+    return false;
+  }
+
+  inflight_++;
+  stats_.admitted_requests++;
+  if (queued) {
+    stats_.queued_requests++;
+  }
+  const auto now{std::chrono::system_clock::now()};
+  const uint64_t queue_delay_ns{
+      now > arrival_time
+          ? static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    now - arrival_time)
+                    .count())
+          : 0};
+  stats_.queue_delay_sum_ns += queue_delay_ns;
+  stats_.max_queue_delay_ns =
+      std::max(stats_.max_queue_delay_ns, queue_delay_ns);
+  return true;
+}
+
+void
+InflightLimiter::ForceAcquire()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  inflight_++;
+}
+
+void
+InflightLimiter::Release()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    inflight_--;
+  }
+  cv_.notify_one();
+}
+
+size_t
+InflightLimiter::InflightRequests()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return inflight_;
+}
+
+InflightLimitStats
+InflightLimiter::SwapStats()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  InflightLimitStats stats{stats_};
+  stats_ = InflightLimitStats{};
+  stats_.max_inflight = max_inflight_;
+  return stats;
+}
+
+void
+AccumulateInflightLimitStats(
+    const InflightLimitStats& stats, InflightLimitStats* total)
+{
+  total->max_inflight = stats.max_inflight;
+  total->admitted_requests += stats.admitted_requests;
+  total->shed_requests += stats.shed_requests;
+  total->queued_requests += stats.queued_requests;
+  total->queue_delay_sum_ns += stats.queue_delay_sum_ns;
+  total->max_queue_delay_ns =
+      std::max(total->max_queue_delay_ns, stats.max_queue_delay_ns);
+}
+
+}}  // namespace triton::perfanalyzer
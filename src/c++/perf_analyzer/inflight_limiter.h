@@ -0,0 +1,109 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace triton { namespace perfanalyzer {
+
+/// What to do with a request that arrives when the limit of requests in
+/// flight is reached.
+enum class InflightLimitPolicy {
+  // Wait for a request to complete, up to a timeout
+  QUEUE,
+  // Do not send the request
+  DROP
+};
+
+/// The requests admitted and shed by an InflightLimiter.
+struct InflightLimitStats {
+  // The limit of requests in flight, 0 if there is no limit
+  uint64_t max_inflight{0};
+  uint64_t admitted_requests{0};
+  // The requests dropped or that timed out in the queue
+  uint64_t shed_requests{0};
+  // The admitted requests that waited for a slot
+  uint64_t queued_requests{0};
+  // The time from the arrival of the admitted requests to their admission
+  uint64_t queue_delay_sum_ns{0};
+  uint64_t max_queue_delay_ns{0};
+};
+
+/// Bounds the number of requests in flight of all the worker threads of an
+/// open-loop load, like a gateway in front of the server. Requests arrive on
+/// schedule and are admitted while there are fewer than the limit in flight.
+/// The others are queued until a request completes or their timeout expires,
+/// or dropped, depending on the policy.
+class InflightLimiter {
+ public:
+  /// \param max_inflight The limit of requests in flight.
+  /// \param policy What to do with the requests over the limit.
+  /// \param queue_timeout The longest time a request waits in the queue
+  /// after its arrival, 0 to wait without a limit.
+  InflightLimiter(
+      const size_t max_inflight, const InflightLimitPolicy policy,
+      const std::chrono::nanoseconds queue_timeout);
+
+  /// Admit a request. Called by the worker threads before sending it.
+  /// \param arrival_time The time the request arrived at, its time in the
+  /// schedule.
+  /// \return Whether the request was admitted. Release() must be called when
+  /// an admitted request completes.
+  bool Acquire(const std::chrono::system_clock::time_point arrival_time);
+
+  /// Count a request in flight without checking the limit, for the requests
+  /// that must be sent such as the ends of the ongoing sequences.
+  void ForceAcquire();
+
+  /// Release the slot of a completed request.
+  void Release();
+
+  /// \return The number of requests in flight.
+  size_t InflightRequests();
+
+  /// \return The stats since the previous call, resetting them.
+  InflightLimitStats SwapStats();
+
+ private:
+  const size_t max_inflight_;
+  const InflightLimitPolicy policy_;
+  const std::chrono::nanoseconds queue_timeout_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t inflight_{0};
+  InflightLimitStats stats_{};
+};
+
+/// Add the stats of a measurement window to those of an experiment.
+void AccumulateInflightLimitStats(
+    const InflightLimitStats& stats, InflightLimitStats* total);
+
+}}  // namespace triton::perfanalyzer
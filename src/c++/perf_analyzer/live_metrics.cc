@@ -0,0 +1,294 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "live_metrics.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#include "constants.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// How often the server thread checks whether it should exit
+constexpr int kPollTimeoutMs{100};
+
+// The largest request the server reads
+constexpr size_t kMaxRequestSize{8192};
+
+void
+WriteMetricHeader(
+    std::ostream& os, const std::string& name, const std::string& help,
+    const std::string& type)
+{
+  os << "# HELP " << name << " " << help << "\n";
+  os << "# TYPE " << name << " " << type << "\n";
+}
+
+void
+SendAll(const int fd, const std::string& data)
+{
+  size_t sent{0};
+  while (sent < data.size()) {
+    ssize_t n{send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL)};
+    if (n <= 0) {
+      return;
+    }
+    sent += n;
+  }
+}
+
+}  // namespace
+
+constexpr std::array<uint64_t, 16> LiveLatencyHistogram::kBucketBoundsUs;
+
+void
+LiveLatencyHistogram::Add(const uint64_t latency_ns)
+{
+  size_t index{0};
+  while (index < kBucketBoundsUs.size() &&
+         latency_ns > kBucketBoundsUs[index] * 1000) {
+    index++;
+  }
+  buckets_[index].fetch_add(1, std::memory_order_relaxed);
+  sum_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+}
+
+void
+LiveLatencyHistogram::AccumulateTo(
+    std::vector<uint64_t>& bucket_counts, uint64_t& sum_ns) const
+{
+  bucket_counts.resize(buckets_.size(), 0);
+  for (size_t i = 0; i < buckets_.size(); ++i) {
+    bucket_counts[i] += buckets_[i].load(std::memory_order_relaxed);
+  }
+  sum_ns += sum_ns_.load(std::memory_order_relaxed);
+}
+
+std::string
+FormatLiveMetrics(const LiveStats& stats)
+{
+  std::stringstream ss;
+
+  uint64_t completed_request_count{0};
+  for (const auto count : stats.latency_bucket_counts) {
+    completed_request_count += count;
+  }
+  uint64_t in_flight_request_count{0};
+  for (const auto count : stats.worker_in_flight_requests) {
+    in_flight_request_count += count;
+  }
+
+  WriteMetricHeader(
+      ss, "perf_analyzer_requests_sent_total",
+      "Requests sent by perf_analyzer.", "counter");
+  ss << "perf_analyzer_requests_sent_total " << stats.sent_request_count
+     << "\n";
+  WriteMetricHeader(
+      ss, "perf_analyzer_requests_completed_total",
+      "Requests completed by perf_analyzer.", "counter");
+  ss << "perf_analyzer_requests_completed_total " << completed_request_count
+     << "\n";
+  WriteMetricHeader(
+      ss, "perf_analyzer_requests_delayed_total",
+      "Requests sent later than their schedule.", "counter");
+  ss << "perf_analyzer_requests_delayed_total " << stats.delayed_request_count
+     << "\n";
+
+  WriteMetricHeader(
+      ss, "perf_analyzer_requests_in_flight",
+      "Requests sent and not completed yet.", "gauge");
+  ss << "perf_analyzer_requests_in_flight " << in_flight_request_count << "\n";
+  WriteMetricHeader(
+      ss, "perf_analyzer_worker_requests_in_flight",
+      "Requests sent and not completed yet by each worker thread.", "gauge");
+  for (size_t i = 0; i < stats.worker_in_flight_requests.size(); ++i) {
+    ss << "perf_analyzer_worker_requests_in_flight{worker=\"" << i << "\"} "
+       << stats.worker_in_flight_requests[i] << "\n";
+  }
+
+  WriteMetricHeader(
+      ss, "perf_analyzer_request_latency_seconds",
+      "Latency of the requests completed by perf_analyzer.", "histogram");
+  uint64_t cumulative_count{0};
+  for (size_t i = 0; i < stats.latency_bucket_counts.size(); ++i) {
+    cumulative_count += stats.latency_bucket_counts[i];
+    ss << "perf_analyzer_request_latency_seconds_bucket{le=\"";
+    if (i < LiveLatencyHistogram::kBucketBoundsUs.size()) {
+      ss << LiveLatencyHistogram::kBucketBoundsUs[i] / 1e6;
+    } else {
+      ss << "+Inf";
+    }
+    ss << "\"} " << cumulative_count << "\n";
+  }
+  ss << "perf_analyzer_request_latency_seconds_sum "
+     << stats.latency_sum_ns / static_cast<double>(NANOS_PER_SECOND) << "\n";
+  ss << "perf_analyzer_request_latency_seconds_count "
+     << completed_request_count << "\n";
+
+  WriteMetricHeader(
+      ss, "perf_analyzer_window_throughput_infer_per_second",
+      "Throughput of the last measurement window.", "gauge");
+  ss << "perf_analyzer_window_throughput_infer_per_second "
+     << stats.infer_per_sec << "\n";
+  WriteMetricHeader(
+      ss, "perf_analyzer_window_send_request_rate",
+      "Rate requests were sent at in the last measurement window.", "gauge");
+  ss << "perf_analyzer_window_send_request_rate " << stats.send_request_rate
+     << "\n";
+  WriteMetricHeader(
+      ss, "perf_analyzer_window_latency_seconds",
+      "Average latency of the last measurement window.", "gauge");
+  ss << "perf_analyzer_window_latency_seconds "
+     << stats.avg_latency_ns / static_cast<double>(NANOS_PER_SECOND) << "\n";
+  WriteMetricHeader(
+      ss, "perf_analyzer_window_overhead_ratio",
+      "Fraction of the last measurement window the load generator was busy "
+      "rather than waiting on requests.",
+      "gauge");
+  ss << "perf_analyzer_window_overhead_ratio " << stats.overhead_pct / 100
+     << "\n";
+
+  return ss.str();
+}
+
+cb::Error
+LiveMetricsServer::Create(
+    const uint16_t port, CollectFunc collect,
+    std::unique_ptr<LiveMetricsServer>* server)
+{
+  int socket_fd{socket(AF_INET, SOCK_STREAM, 0)};
+  if (socket_fd < 0) {
+    return cb::Error(
+        "failed to create the live metrics socket: " +
+            std::string(strerror(errno)),
+        GENERIC_ERROR);
+  }
+  int reuse{1};
+  setsockopt(socket_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(port);
+  socklen_t address_len{sizeof(address)};
+  if (bind(socket_fd, reinterpret_cast<sockaddr*>(&address), address_len) !=
+          0 ||
+      listen(socket_fd, SOMAXCONN) != 0 ||
+      getsockname(
+          socket_fd, reinterpret_cast<sockaddr*>(&address), &address_len) !=
+          0) {
+    const std::string message{strerror(errno)};
+    close(socket_fd);
+    return cb::Error(
+        "failed to listen for live metrics on port " + std::to_string(port) +
+            ": " + message,
+        GENERIC_ERROR);
+  }
+
+  std::unique_ptr<LiveMetricsServer> local_server{new LiveMetricsServer(
+      socket_fd, ntohs(address.sin_port), std::move(collect))};
+  local_server->thread_ =
+      std::thread(&LiveMetricsServer::Serve, local_server.get());
+  *server = std::move(local_server);
+  return cb::Error::Success;
+}
+
+LiveMetricsServer::~LiveMetricsServer()
+{
+  exiting_ = true;
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  close(socket_fd_);
+}
+
+void
+LiveMetricsServer::Serve()
+{
+  pollfd poll_fd{socket_fd_, POLLIN, 0};
+  while (!exiting_) {
+    if (poll(&poll_fd, 1, kPollTimeoutMs) <= 0) {
+      continue;
+    }
+    int connection_fd{accept(socket_fd_, nullptr, nullptr)};
+    if (connection_fd < 0) {
+      continue;
+    }
+    HandleConnection(connection_fd);
+    close(connection_fd);
+  }
+}
+
+void
+LiveMetricsServer::HandleConnection(const int connection_fd)
+{
+  // Read the request line and headers, the request has no body
+  std::string request;
+  char buffer[1024];
+  pollfd poll_fd{connection_fd, POLLIN, 0};
+  while (request.find("\r\n\r\n") == std::string::npos &&
+         request.size() < kMaxRequestSize) {
+    if (poll(&poll_fd, 1, kPollTimeoutMs * 10) <= 0) {
+      return;
+    }
+    ssize_t n{recv(connection_fd, buffer, sizeof(buffer), 0)};
+    if (n <= 0) {
+      return;
+    }
+    request.append(buffer, n);
+  }
+
+  std::string status;
+  std::string body;
+  if (request.rfind("GET /metrics ", 0) == 0) {
+    LiveStats stats{};
+    collect_(&stats);
+    status = "200 OK";
+    body = FormatLiveMetrics(stats);
+  } else {
+    status = "404 Not Found";
+    body = "Not Found\n";
+  }
+  SendAll(
+      connection_fd,
+      "HTTP/1.1 " + status +
+          "\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+          std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,132 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "client_backend/client_backend.h"
+
+namespace triton { namespace perfanalyzer {
+
+#ifndef DOCTEST_CONFIG_DISABLE
+class TestLiveMetrics;
+#endif
+
+/// A histogram of request latencies that the worker threads update without
+/// locking, for the live metrics to read while the requests are running.
+class LiveLatencyHistogram {
+ public:
+  /// The upper bounds of the buckets in usec, the last bucket has no bound.
+  static constexpr std::array<uint64_t, 16> kBucketBoundsUs{
+      100,    250,    500,     1000,    2500,    5000,    10000,   25000,
+      50000,  100000, 250000,  500000,  1000000, 2500000, 5000000, 10000000};
+
+  void Add(const uint64_t latency_ns);
+
+  /// Add the count of each bucket, including the last one, to
+  /// 'bucket_counts' and the sum of the latencies to 'sum_ns'.
+  void AccumulateTo(
+      std::vector<uint64_t>& bucket_counts, uint64_t& sum_ns) const;
+
+ private:
+  std::array<std::atomic<uint64_t>, kBucketBoundsUs.size() + 1> buckets_{};
+  std::atomic<uint64_t> sum_ns_{0};
+};
+
+/// A snapshot of the state of the load generator for the live metrics.
+struct LiveStats {
+  // Counters since the start of the run
+  uint64_t sent_request_count{0};
+  uint64_t delayed_request_count{0};
+  // The non-cumulative counts of the buckets of LiveLatencyHistogram and the
+  // sum of the latencies of all the completed requests
+  std::vector<uint64_t> latency_bucket_counts{};
+  uint64_t latency_sum_ns{0};
+  // The number of requests in flight of each worker thread
+  std::vector<uint64_t> worker_in_flight_requests{};
+
+  // The results of the last measurement window, zero before the first one
+  double infer_per_sec{0.0};
+  double send_request_rate{0.0};
+  double overhead_pct{0.0};
+  uint64_t avg_latency_ns{0};
+};
+
+/// \return The live stats in the Prometheus text exposition format.
+std::string FormatLiveMetrics(const LiveStats& stats);
+
+/// An HTTP endpoint serving the live metrics of the load generator on
+/// /metrics, in a background thread.
+class LiveMetricsServer {
+ public:
+  using CollectFunc = std::function<void(LiveStats*)>;
+
+  /// Create a live metrics server and start serving.
+  /// \param port The port to listen on, 0 to pick any free port.
+  /// \param collect The function that takes a snapshot of the live stats on
+  /// each scrape.
+  /// \param server Returns a new LiveMetricsServer object.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Create(
+      const uint16_t port, CollectFunc collect,
+      std::unique_ptr<LiveMetricsServer>* server);
+
+  /// Stops serving.
+  ~LiveMetricsServer();
+
+  /// \return The port the server listens on.
+  uint16_t Port() const { return port_; }
+
+ private:
+  LiveMetricsServer(
+      const int socket_fd, const uint16_t port, CollectFunc collect)
+      : socket_fd_(socket_fd), port_(port), collect_(std::move(collect))
+  {
+  }
+
+  void Serve();
+  void HandleConnection(const int connection_fd);
+
+  int socket_fd_;
+  uint16_t port_;
+  CollectFunc collect_;
+  std::atomic<bool> exiting_{false};
+  std::thread thread_;
+
+#ifndef DOCTEST_CONFIG_DISABLE
+  friend TestLiveMetrics;
+#endif
+};
+
+}}  // namespace triton::perfanalyzer
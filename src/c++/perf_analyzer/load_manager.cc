@@ -93,6 +93,8 @@ LoadManager::GetAccumulatedClientStat(cb::InferStat* contexts_stat)
   contexts_stat->cumulative_receive_time_ns = 0;
   contexts_stat->cumulative_send_time_ns = 0;
   contexts_stat->cumulative_total_request_time_ns = 0;
+  contexts_stat->cache_hit_count = 0;
+  contexts_stat->cache_miss_count = 0;
 
   for (auto& thread_stat : threads_stat_) {
     std::lock_guard<std::mutex> lock(thread_stat->mu_);
@@ -105,6 +107,8 @@ LoadManager::GetAccumulatedClientStat(cb::InferStat* contexts_stat)
           context_stat.cumulative_send_time_ns;
       contexts_stat->cumulative_receive_time_ns +=
           context_stat.cumulative_receive_time_ns;
+      contexts_stat->cache_hit_count += context_stat.cache_hit_count;
+      contexts_stat->cache_miss_count += context_stat.cache_miss_count;
     }
   }
   return cb::Error::Success;
@@ -143,6 +147,32 @@ LoadManager::ResetIdleTime()
   }
 }
 
+std::shared_ptr<ThreadStat>
+LoadManager::AddThreadStat()
+{
+  auto thread_stat{std::make_shared<ThreadStat>()};
+  thread_stat->window_controller_ = window_controller_;
+  thread_stat->inflight_limiter_ = inflight_limiter_;
+  std::lock_guard<std::mutex> lock(threads_stat_mutex_);
+  threads_stat_.push_back(thread_stat);
+  return thread_stat;
+}
+
+void
+LoadManager::GetLiveStats(LiveStats* stats)
+{
+  std::lock_guard<std::mutex> lock(threads_stat_mutex_);
+  stats->worker_in_flight_requests.clear();
+  for (auto& thread_stat : threads_stat_) {
+    stats->sent_request_count += thread_stat->total_sent_requests_;
+    stats->delayed_request_count += thread_stat->total_delayed_requests_;
+    stats->worker_in_flight_requests.push_back(
+        thread_stat->in_flight_requests_);
+    thread_stat->latency_histogram_.AccumulateTo(
+        stats->latency_bucket_counts, stats->latency_sum_ns);
+  }
+}
+
 const size_t
 LoadManager::GetAndResetNumSentRequests()
 {
@@ -165,7 +195,7 @@ LoadManager::LoadManager(
         request_parameters)
     : async_(async), streaming_(streaming), batch_size_(batch_size),
       max_threads_(max_threads), parser_(parser), factory_(factory),
-      using_json_data_(false)
+      using_json_data_(false), request_parameters_(request_parameters)
 {
   on_sequence_model_ =
       ((parser_->SchedulerType() == ModelParser::SEQUENCE) ||
@@ -178,6 +208,36 @@ LoadManager::LoadManager(
       request_parameters, parser, factory, data_loader_);
 }
 
+void
+LoadManager::SetWorkload(
+    const std::vector<WorkloadModel>& models,
+    const std::vector<std::shared_ptr<ModelParser>>& parsers)
+{
+  workload_ = std::make_shared<Workload>();
+  workload_user_data_.clear();
+  for (size_t i = 0; i < models.size(); ++i) {
+    ModelLoad model_load;
+    model_load.weight_ = models[i].weight_;
+    if (i == 0) {
+      model_load.parser_ = parser_;
+      model_load.data_loader_ = data_loader_;
+      model_load.infer_data_manager_ = infer_data_manager_;
+    } else {
+      // Shared memory isn't supported with workloads, the regions of the
+      // infer data managers would collide
+      model_load.parser_ = parsers[i];
+      model_load.data_loader_.reset(new DataLoader(batch_size_));
+      model_load.infer_data_manager_ =
+          InferDataManagerFactory::CreateInferDataManager(
+              max_threads_, batch_size_, SharedMemoryType::NO_SHARED_MEMORY, 0,
+              request_parameters_, model_load.parser_, factory_,
+              model_load.data_loader_);
+    }
+    workload_->push_back(std::move(model_load));
+    workload_user_data_.push_back(models[i].input_data_);
+  }
+}
+
 void
 LoadManager::InitManager(
     const size_t string_length, const std::string& string_data,
@@ -199,6 +259,14 @@ LoadManager::InitManager(
 
   THROW_IF_ERROR(
       infer_data_manager_->Init(), "Unable to init infer data manager");
+  if (workload_ != nullptr) {
+    for (size_t i = 1; i < workload_->size(); ++i) {
+      THROW_IF_ERROR(
+          (*workload_)[i].infer_data_manager_->Init(),
+          "Unable to init infer data manager of model " +
+              (*workload_)[i].parser_->ModelName());
+    }
+  }
 
   sequence_manager_ = MakeSequenceManager(
       start_sequence_id, sequence_id_range, sequence_length,
@@ -215,33 +283,59 @@ LoadManager::InitManagerInputs(
 {
   RETURN_IF_ERROR(factory_->CreateClientBackend(&backend_));
 
+  RETURN_IF_ERROR(ReadModelData(
+      parser_, data_loader_, string_length, string_data, zero_input,
+      user_data, &using_json_data_));
+
+  if (workload_ != nullptr) {
+    (*workload_)[0].using_json_data_ = using_json_data_;
+    for (size_t i = 1; i < workload_->size(); ++i) {
+      auto& model_load = (*workload_)[i];
+      RETURN_IF_ERROR(ReadModelData(
+          model_load.parser_, model_load.data_loader_, string_length,
+          string_data, zero_input, workload_user_data_[i],
+          &model_load.using_json_data_));
+    }
+  }
+
+  // Reserve the required vector space
+  threads_stat_.reserve(max_threads_);
+
+  return cb::Error::Success;
+}
+
+cb::Error
+LoadManager::ReadModelData(
+    const std::shared_ptr<ModelParser>& parser,
+    const std::shared_ptr<DataLoader>& data_loader,
+    const size_t string_length, const std::string& string_data,
+    const bool zero_input, const std::vector<std::string>& user_data,
+    bool* using_json_data)
+{
   // Read provided data
   if (!user_data.empty()) {
     if (IsDirectory(user_data[0])) {
-      RETURN_IF_ERROR(data_loader_->ReadDataFromDir(
-          parser_->Inputs(), parser_->Outputs(), user_data[0]));
+      RETURN_IF_ERROR(data_loader->ReadDataFromDir(
+          parser->Inputs(), parser->Outputs(), user_data[0]));
     } else {
-      using_json_data_ = true;
+      *using_json_data = true;
       for (const auto& json_file : user_data) {
-        RETURN_IF_ERROR(data_loader_->ReadDataFromJSON(
-            parser_->Inputs(), parser_->Outputs(), json_file));
+        RETURN_IF_ERROR(data_loader->ReadDataFromJSON(
+            parser->Inputs(), parser->Outputs(), json_file));
       }
       std::cout << " Successfully read data for "
-                << data_loader_->GetDataStreamsCount() << " stream/streams";
-      if (data_loader_->GetDataStreamsCount() == 1) {
-        std::cout << " with " << data_loader_->GetTotalSteps(0)
+                << data_loader->GetDataStreamsCount() << " stream/streams";
+      if (data_loader->GetDataStreamsCount() == 1) {
+        std::cout << " with " << data_loader->GetTotalSteps(0)
                   << " step/steps";
       }
       std::cout << "." << std::endl;
     }
   } else {
-    RETURN_IF_ERROR(data_loader_->GenerateData(
-        parser_->Inputs(), zero_input, string_length, string_data));
+    RETURN_IF_ERROR(data_loader->GenerateData(
+        parser->Inputs(), zero_input, string_length, string_data));
   }
 
-  // Reserve the required vector space
-  threads_stat_.reserve(max_threads_);
-
   return cb::Error::Success;
 }
 
@@ -34,9 +34,13 @@
 #include "client_backend/client_backend.h"
 #include "data_loader.h"
 #include "iinfer_data_manager.h"
+#include "inflight_limiter.h"
+#include "live_metrics.h"
 #include "load_worker.h"
 #include "perf_utils.h"
 #include "sequence_manager.h"
+#include "window_controller.h"
+#include "workload.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -72,6 +76,16 @@ class LoadManager {
       const size_t sequence_length, const bool sequence_length_specified,
       const double sequence_length_variation);
 
+  /// Spread the requests over the models of a workload instead of sending
+  /// them all to the model of the load manager. Must be called before
+  /// InitManager().
+  /// \param models The models of the workload, the first one being the model
+  /// of the load manager.
+  /// \param parsers The ModelParser objects of the models, in the same order.
+  void SetWorkload(
+      const std::vector<WorkloadModel>& models,
+      const std::vector<std::shared_ptr<ModelParser>>& parsers);
+
   /// Check if the load manager is working as expected.
   /// \return cb::Error object indicating success or failure.
   cb::Error CheckHealth();
@@ -107,7 +121,39 @@ class LoadManager {
   /// Count the number of requests collected until now.
   uint64_t CountCollectedRequests();
 
+  /// Take a snapshot of the live metrics of the worker threads. Unlike the
+  /// other methods it is safe to call from any thread.
+  /// \param stats Returns the counters, latency histogram and requests in
+  /// flight of the worker threads.
+  void GetLiveStats(LiveStats* stats);
+
+  /// \return The counter of the requests completed by all the worker threads
+  /// that measurement windows wait on.
+  WindowController& GetWindowController() { return *window_controller_; }
+
+  /// Bound the number of requests in flight of all the worker threads. Must
+  /// be called before the worker threads are created.
+  /// \param max_inflight The limit of requests in flight.
+  /// \param policy What to do with the requests over the limit.
+  /// \param queue_timeout The longest time a request waits for a slot, 0 to
+  /// wait without a limit.
+  void SetInflightLimit(
+      const size_t max_inflight, const InflightLimitPolicy policy,
+      const std::chrono::nanoseconds queue_timeout)
+  {
+    inflight_limiter_ =
+        std::make_shared<InflightLimiter>(max_inflight, policy, queue_timeout);
+  }
+
+  /// \return The limiter of the requests in flight, null if they are not
+  /// bounded.
+  InflightLimiter* GetInflightLimiter() { return inflight_limiter_.get(); }
+
  protected:
+  /// Add the statistics of a new worker thread to threads_stat_.
+  /// \return The statistics of the new worker thread.
+  std::shared_ptr<ThreadStat> AddThreadStat();
+
   LoadManager(
       const bool async, const bool streaming, const int32_t batch_size,
       const size_t max_threads, const SharedMemoryType shared_memory_type,
@@ -131,6 +177,24 @@ class LoadManager {
       const size_t string_length, const std::string& string_data,
       const bool zero_input, std::vector<std::string>& user_data);
 
+  /// Helper function to read or generate the input data of a model
+  /// \param parser The ModelParser object of the model.
+  /// \param data_loader The DataLoader object to hold the data.
+  /// \param string_length The length of the random strings to be generated
+  /// for string inputs.
+  /// \param string_data The string to be used as string inputs for model.
+  /// \param zero_input Whether to use zero for model inputs.
+  /// \param user_data The vector containing path/paths to user-provided data
+  /// that can be a directory or path to a json data file.
+  /// \param using_json_data Returns whether the data was read from json files.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error ReadModelData(
+      const std::shared_ptr<ModelParser>& parser,
+      const std::shared_ptr<DataLoader>& data_loader,
+      const size_t string_length, const std::string& string_data,
+      const bool zero_input, const std::vector<std::string>& user_data,
+      bool* using_json_data);
+
   /// Stops all the worker threads generating the request load.
   void StopWorkerThreads();
 
@@ -150,6 +214,14 @@ class LoadManager {
   std::unique_ptr<cb::ClientBackend> backend_;
   std::shared_ptr<IInferDataManager> infer_data_manager_;
 
+  std::unordered_map<std::string, cb::RequestParameter> request_parameters_;
+
+  // The models the workers spread the requests over, null if the requests
+  // all go to the model of the load manager
+  std::shared_ptr<Workload> workload_{nullptr};
+  // The paths to the input data of the models of the workload
+  std::vector<std::vector<std::string>> workload_user_data_;
+
   // Track the workers so they all go out of scope at the
   // same time
   std::vector<std::shared_ptr<IWorker>> workers_;
@@ -158,6 +230,14 @@ class LoadManager {
   std::vector<std::thread> threads_;
   // Contains the statistics on the current working threads
   std::vector<std::shared_ptr<ThreadStat>> threads_stat_;
+  // Guards adding to threads_stat_ against GetLiveStats()
+  std::mutex threads_stat_mutex_;
+  // Counts the requests completed by all the worker threads
+  std::shared_ptr<WindowController> window_controller_{
+      std::make_shared<WindowController>()};
+  // Bounds the requests in flight of all the worker threads, null if they
+  // are not bounded
+  std::shared_ptr<InflightLimiter> inflight_limiter_{nullptr};
 
   // Use condition variable to pause/continue worker threads
   std::condition_variable wake_signal_;
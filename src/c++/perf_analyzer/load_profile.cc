@@ -0,0 +1,429 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "load_profile.h"
+
+#include <rapidjson/filereadstream.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+
+#include "constants.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+constexpr double kPi{3.14159265358979323846};
+
+cb::Error
+GetRate(
+    const rapidjson::Value& json, const char* key, const std::string& segment,
+    double* rate)
+{
+  const auto member = json.FindMember(key);
+  if ((member == json.MemberEnd()) || !member->value.IsNumber() ||
+      (member->value.GetDouble() < 0.0)) {
+    return cb::Error(
+        "The " + std::string(key) + " of " + segment + " must be >= 0",
+        pa::GENERIC_ERROR);
+  }
+  *rate = member->value.GetDouble();
+  return cb::Error::Success;
+}
+
+cb::Error
+GetMsec(
+    const rapidjson::Value& json, const char* key, const std::string& segment,
+    uint64_t* msec)
+{
+  const auto member = json.FindMember(key);
+  if ((member == json.MemberEnd()) || !member->value.IsUint64()) {
+    return cb::Error(
+        "The " + std::string(key) + " of " + segment +
+            " must be an integer >= 0",
+        pa::GENERIC_ERROR);
+  }
+  *msec = member->value.GetUint64();
+  return cb::Error::Success;
+}
+
+// Parse a segment of the load profile file, a step segment is parsed into one
+// constant segment per step
+cb::Error
+ParseLoadSegment(
+    const rapidjson::Value& json, const size_t index,
+    std::vector<LoadSegment>* segments)
+{
+  const std::string segment_name{"segment " + std::to_string(index)};
+  if (!json.IsObject()) {
+    return cb::Error(
+        "The segments of the load profile file must be objects",
+        pa::GENERIC_ERROR);
+  }
+
+  LoadSegment segment;
+  const auto name = json.FindMember("name");
+  if (name != json.MemberEnd()) {
+    if (!name->value.IsString()) {
+      return cb::Error(
+          "The name of " + segment_name + " must be a string",
+          pa::GENERIC_ERROR);
+    }
+    segment.name_ = name->value.GetString();
+  }
+
+  RETURN_IF_ERROR(
+      GetMsec(json, "duration_ms", segment_name, &segment.duration_ms_));
+  if (segment.duration_ms_ == 0) {
+    return cb::Error(
+        "The duration_ms of " + segment_name + " must be > 0",
+        pa::GENERIC_ERROR);
+  }
+
+  const auto type = json.FindMember("type");
+  if ((type == json.MemberEnd()) || !type->value.IsString()) {
+    return cb::Error(
+        "The type of " + segment_name + " must be a string", pa::GENERIC_ERROR);
+  }
+  const std::string type_str{type->value.GetString()};
+  if (type_str == "constant") {
+    segment.shape_ = LoadShape::CONSTANT;
+    RETURN_IF_ERROR(GetRate(json, "rate", segment_name, &segment.rate_));
+  } else if (type_str == "ramp") {
+    segment.shape_ = LoadShape::RAMP;
+    RETURN_IF_ERROR(GetRate(json, "start_rate", segment_name, &segment.rate_));
+    RETURN_IF_ERROR(
+        GetRate(json, "end_rate", segment_name, &segment.end_rate_));
+  } else if (type_str == "step") {
+    const auto rates = json.FindMember("rates");
+    if ((rates == json.MemberEnd()) || !rates->value.IsArray() ||
+        rates->value.Empty()) {
+      return cb::Error(
+          "The rates of " + segment_name + " must be a non-empty array",
+          pa::GENERIC_ERROR);
+    }
+    const size_t step_count{rates->value.Size()};
+    if (segment.duration_ms_ < step_count) {
+      return cb::Error(
+          "The duration_ms of " + segment_name +
+              " must be at least 1 msec per step",
+          pa::GENERIC_ERROR);
+    }
+    // The last step takes the remainder of the duration
+    const uint64_t step_duration_ms{segment.duration_ms_ / step_count};
+    size_t i{0};
+    for (const auto& rate : rates->value.GetArray()) {
+      if (!rate.IsNumber() || (rate.GetDouble() < 0.0)) {
+        return cb::Error(
+            "The rates of " + segment_name + " must be >= 0",
+            pa::GENERIC_ERROR);
+      }
+      LoadSegment step{segment};
+      step.shape_ = LoadShape::CONSTANT;
+      step.rate_ = rate.GetDouble();
+      step.duration_ms_ =
+          (i + 1 == step_count)
+              ? segment.duration_ms_ - step_duration_ms * (step_count - 1)
+              : step_duration_ms;
+      if (!step.name_.empty()) {
+        step.name_ += " step " + std::to_string(i);
+      }
+      segments->push_back(step);
+      ++i;
+    }
+    return cb::Error::Success;
+  } else if (type_str == "sine") {
+    segment.shape_ = LoadShape::SINE;
+    RETURN_IF_ERROR(GetRate(json, "mean_rate", segment_name, &segment.rate_));
+    RETURN_IF_ERROR(
+        GetRate(json, "amplitude", segment_name, &segment.amplitude_));
+    RETURN_IF_ERROR(
+        GetMsec(json, "period_ms", segment_name, &segment.period_ms_));
+    if (segment.amplitude_ > segment.rate_) {
+      return cb::Error(
+          "The amplitude of " + segment_name + " must be <= its mean_rate",
+          pa::GENERIC_ERROR);
+    }
+    if (segment.period_ms_ == 0) {
+      return cb::Error(
+          "The period_ms of " + segment_name + " must be > 0",
+          pa::GENERIC_ERROR);
+    }
+  } else if (type_str == "spike") {
+    segment.shape_ = LoadShape::SPIKE;
+    RETURN_IF_ERROR(GetRate(json, "rate", segment_name, &segment.rate_));
+    RETURN_IF_ERROR(
+        GetRate(json, "spike_rate", segment_name, &segment.spike_rate_));
+    RETURN_IF_ERROR(GetMsec(
+        json, "spike_start_ms", segment_name, &segment.spike_start_ms_));
+    RETURN_IF_ERROR(GetMsec(
+        json, "spike_duration_ms", segment_name,
+        &segment.spike_duration_ms_));
+    if (segment.spike_start_ms_ + segment.spike_duration_ms_ >
+        segment.duration_ms_) {
+      return cb::Error(
+          "The spike of " + segment_name + " must end within the segment",
+          pa::GENERIC_ERROR);
+    }
+  } else {
+    return cb::Error(
+        "Unsupported type '" + type_str + "' of " + segment_name +
+            ". Choices are 'constant', 'ramp', 'step', 'sine' or 'spike'.",
+        pa::GENERIC_ERROR);
+  }
+
+  segments->push_back(segment);
+  return cb::Error::Success;
+}
+
+}  // namespace
+
+double
+LoadSegment::RateAt(const uint64_t offset_ns) const
+{
+  switch (shape_) {
+    case LoadShape::RAMP:
+      return rate_ + (end_rate_ - rate_) * offset_ns /
+                         (duration_ms_ * NANOS_PER_MILLIS);
+    case LoadShape::SINE:
+      return rate_ + amplitude_ * std::sin(
+                                      2 * kPi * offset_ns /
+                                      (period_ms_ * NANOS_PER_MILLIS));
+    case LoadShape::SPIKE: {
+      const uint64_t offset_ms{offset_ns / NANOS_PER_MILLIS};
+      return (offset_ms >= spike_start_ms_ &&
+              offset_ms < spike_start_ms_ + spike_duration_ms_)
+                 ? spike_rate_
+                 : rate_;
+    }
+    default:
+      return rate_;
+  }
+}
+
+double
+LoadSegment::MaxRate() const
+{
+  switch (shape_) {
+    case LoadShape::RAMP:
+      return std::max(rate_, end_rate_);
+    case LoadShape::SINE:
+      return rate_ + amplitude_;
+    case LoadShape::SPIKE:
+      return spike_duration_ms_ != 0 ? std::max(rate_, spike_rate_) : rate_;
+    default:
+      return rate_;
+  }
+}
+
+double
+LoadSegment::MeanRate() const
+{
+  switch (shape_) {
+    case LoadShape::RAMP:
+      return (rate_ + end_rate_) / 2;
+    case LoadShape::SINE: {
+      // The integral of the sine over the duration, divided by the duration
+      const double phase{2 * kPi * duration_ms_ / period_ms_};
+      return rate_ + amplitude_ * (1 - std::cos(phase)) / phase;
+    }
+    case LoadShape::SPIKE:
+      return (rate_ * (duration_ms_ - spike_duration_ms_) +
+              spike_rate_ * spike_duration_ms_) /
+             duration_ms_;
+    default:
+      return rate_;
+  }
+}
+
+std::string
+LoadSegment::Description() const
+{
+  std::stringstream ss;
+  if (!name_.empty()) {
+    ss << name_ << ": ";
+  }
+  switch (shape_) {
+    case LoadShape::RAMP:
+      ss << "ramp from " << rate_ << " to " << end_rate_ << " infer/sec";
+      break;
+    case LoadShape::SINE:
+      ss << "sine of " << rate_ << " +/- " << amplitude_
+         << " infer/sec with a period of " << period_ms_ << " msec";
+      break;
+    case LoadShape::SPIKE:
+      ss << rate_ << " infer/sec with a spike of " << spike_rate_
+         << " infer/sec at " << spike_start_ms_ << " msec for "
+         << spike_duration_ms_ << " msec";
+      break;
+    default:
+      ss << "constant " << rate_ << " infer/sec";
+      break;
+  }
+  ss << " over " << duration_ms_ << " msec";
+  return ss.str();
+}
+
+LoadProfile::LoadProfile(const std::vector<LoadSegment>& segments)
+    : segments_(segments)
+{
+  uint64_t end_ns{0};
+  for (const auto& segment : segments_) {
+    end_ns += segment.duration_ms_ * NANOS_PER_MILLIS;
+    segment_ends_ns_.push_back(end_ns);
+  }
+}
+
+size_t
+LoadProfile::SegmentAt(const uint64_t offset_ns) const
+{
+  const uint64_t profile_offset_ns{offset_ns % DurationNs()};
+  return std::upper_bound(
+             segment_ends_ns_.begin(), segment_ends_ns_.end(),
+             profile_offset_ns) -
+         segment_ends_ns_.begin();
+}
+
+double
+LoadProfile::RateAt(const uint64_t offset_ns) const
+{
+  const uint64_t profile_offset_ns{offset_ns % DurationNs()};
+  const size_t index{SegmentAt(profile_offset_ns)};
+  const uint64_t segment_start_ns{
+      index == 0 ? 0 : segment_ends_ns_[index - 1]};
+  return segments_[index].RateAt(profile_offset_ns - segment_start_ns);
+}
+
+cb::Error
+ReadLoadProfileFile(const std::string& path, LoadProfile* profile)
+{
+  FILE* profile_file = fopen(path.c_str(), "r");
+  if (profile_file == nullptr) {
+    return cb::Error(
+        "failed to open load profile file '" + path + "'", pa::GENERIC_ERROR);
+  }
+
+  char readBuffer[65536];
+  rapidjson::FileReadStream fs(profile_file, readBuffer, sizeof(readBuffer));
+
+  rapidjson::Document d{};
+  d.ParseStream(fs);
+
+  fclose(profile_file);
+
+  return ParseLoadProfile(d, profile);
+}
+
+cb::Error
+ParseLoadProfile(const rapidjson::Document& json, LoadProfile* profile)
+{
+  if (json.HasParseError()) {
+    return cb::Error(
+        "failed to parse the load profile file", pa::GENERIC_ERROR);
+  }
+
+  if (!json.IsObject() || !json.HasMember("segments") ||
+      !json["segments"].IsArray() || json["segments"].Empty()) {
+    return cb::Error(
+        "The load profile file must contain a non-empty segments array",
+        pa::GENERIC_ERROR);
+  }
+
+  std::vector<LoadSegment> segments;
+  size_t index{0};
+  for (const auto& segment_json : json["segments"].GetArray()) {
+    RETURN_IF_ERROR(ParseLoadSegment(segment_json, index++, &segments));
+  }
+
+  if (std::none_of(
+          segments.begin(), segments.end(),
+          [](const LoadSegment& segment) { return segment.MaxRate() > 0.0; })) {
+    return cb::Error(
+        "The load profile file must have a segment with a rate > 0",
+        pa::GENERIC_ERROR);
+  }
+
+  *profile = LoadProfile(segments);
+  return cb::Error::Success;
+}
+
+std::function<std::chrono::nanoseconds(std::mt19937&)>
+LoadProfileDistribution(const LoadProfile& profile)
+{
+  struct ThinningState {
+    LoadProfile profile_;
+    // The time of the last candidate and of the last request, from the
+    // start of the schedule
+    double time_ns_{0.0};
+    int64_t last_request_ns_{0};
+    std::uniform_real_distribution<double> acceptance_{0.0, 1.0};
+  };
+  auto state{std::make_shared<ThinningState>()};
+  state->profile_ = profile;
+
+  return [state](std::mt19937& rng) {
+    const LoadProfile& profile{state->profile_};
+    const uint64_t duration_ns{profile.DurationNs()};
+    while (true) {
+      const uint64_t time_ns{static_cast<uint64_t>(state->time_ns_)};
+      const uint64_t round_start_ns{time_ns - time_ns % duration_ns};
+      const size_t index{profile.SegmentAt(time_ns)};
+      const double segment_end_ns{static_cast<double>(
+          round_start_ns + profile.SegmentEndNs(index))};
+      const double max_rate{profile.Segments()[index].MaxRate()};
+
+      // A Poisson process has no memory, so the candidates restart at the
+      // rate of the next segment at its start
+      if (max_rate <= 0.0) {
+        state->time_ns_ = segment_end_ns;
+        continue;
+      }
+      std::exponential_distribution<double> gap(max_rate / NANOS_PER_SECOND);
+      state->time_ns_ += gap(rng);
+      if (state->time_ns_ >= segment_end_ns) {
+        state->time_ns_ = segment_end_ns;
+        continue;
+      }
+
+      const double rate{
+          profile.RateAt(static_cast<uint64_t>(state->time_ns_))};
+      if (state->acceptance_(rng) * max_rate < rate) {
+        const int64_t request_ns{std::llround(state->time_ns_)};
+        const std::chrono::nanoseconds interval{
+            request_ns - state->last_request_ns_};
+        state->last_request_ns_ = request_ns;
+        return interval;
+      }
+    }
+  };
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,136 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <rapidjson/document.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "client_backend/client_backend.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// How the request rate of a load profile segment changes over time.
+enum class LoadShape { CONSTANT, RAMP, SINE, SPIKE };
+
+/// A period of a load profile with its own request rate over time. A step
+/// function is a series of constant segments.
+struct LoadSegment {
+  std::string name_;
+  LoadShape shape_{LoadShape::CONSTANT};
+  uint64_t duration_ms_{0};
+  // The rate of a constant segment, the start rate of a ramp, the mean rate
+  // of a sine and the base rate of a spike, in requests per second
+  double rate_{0.0};
+  // The end rate of a ramp
+  double end_rate_{0.0};
+  // The amplitude and period of a sine
+  double amplitude_{0.0};
+  uint64_t period_ms_{0};
+  // The rate during a spike and when the spike starts and how long it lasts,
+  // relative to the start of the segment
+  double spike_rate_{0.0};
+  uint64_t spike_start_ms_{0};
+  uint64_t spike_duration_ms_{0};
+
+  /// \return The request rate 'offset_ns' after the start of the segment.
+  double RateAt(const uint64_t offset_ns) const;
+
+  /// \return The highest request rate of the segment.
+  double MaxRate() const;
+
+  /// \return The average request rate over the segment.
+  double MeanRate() const;
+
+  /// \return A description of the segment for the report.
+  std::string Description() const;
+};
+
+/// A load profile, the request rate over time of a run as a series of
+/// segments.
+class LoadProfile {
+ public:
+  LoadProfile() = default;
+
+  explicit LoadProfile(const std::vector<LoadSegment>& segments);
+
+  const std::vector<LoadSegment>& Segments() const { return segments_; }
+
+  uint64_t DurationNs() const
+  {
+    return segment_ends_ns_.empty() ? 0 : segment_ends_ns_.back();
+  }
+
+  /// \return The end of segment 'index' relative to the start of the profile.
+  uint64_t SegmentEndNs(const size_t index) const
+  {
+    return segment_ends_ns_[index];
+  }
+
+  /// \return The index of the segment 'offset_ns' after the start of the
+  /// profile, which repeats after its duration.
+  size_t SegmentAt(const uint64_t offset_ns) const;
+
+  /// \return The request rate 'offset_ns' after the start of the profile,
+  /// which repeats after its duration.
+  double RateAt(const uint64_t offset_ns) const;
+
+ private:
+  std::vector<LoadSegment> segments_;
+  // The end of each segment relative to the start of the profile
+  std::vector<uint64_t> segment_ends_ns_;
+};
+
+/// Read a load profile file.
+/// \param path The path to the load profile file.
+/// \param profile Returns the load profile.
+/// \return cb::Error object indicating success or failure.
+cb::Error ReadLoadProfileFile(const std::string& path, LoadProfile* profile);
+
+/// Parse a load profile.
+/// \param json The load profile, as a json object with a "segments" array.
+/// \param profile Returns the load profile.
+/// \return cb::Error object indicating success or failure.
+cb::Error ParseLoadProfile(
+    const rapidjson::Document& json, LoadProfile* profile);
+
+/// Generates the intervals between the requests of a load profile as a
+/// non-homogeneous Poisson process, whose rate follows the profile. The
+/// arrivals are drawn by thinning: candidates are drawn at the highest rate
+/// of the current segment and each is kept with the probability of the rate
+/// at its time over that highest rate.
+/// \param profile The load profile, which repeats after its duration.
+/// \return A function returning the interval to the next request.
+std::function<std::chrono::nanoseconds(std::mt19937&)> LoadProfileDistribution(
+    const LoadProfile& profile);
+
+}}  // namespace triton::perfanalyzer
@@ -85,6 +85,9 @@ void
 LoadWorker::CreateContext()
 {
   auto ctx = CreateInferContext();
+  if (workload_ != nullptr) {
+    ctx->SetWorkload(workload_);
+  }
   ctx->Init();
   CreateContextFinalize(ctx);
   ctxs_.push_back(ctx);
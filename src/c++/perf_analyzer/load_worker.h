@@ -42,6 +42,14 @@ namespace triton { namespace perfanalyzer {
 /// Abstract base class for worker threads
 ///
 class LoadWorker : public IWorker {
+ public:
+  /// Spread the requests of the contexts over the models of 'workload'. Must
+  /// be called before the worker starts.
+  void SetWorkload(std::shared_ptr<const Workload> workload)
+  {
+    workload_ = workload;
+  }
+
  protected:
   LoadWorker(
       uint32_t id, std::shared_ptr<ThreadStat> thread_stat,
@@ -67,22 +75,30 @@ class LoadWorker : public IWorker {
 
   virtual ~LoadWorker() = default;
 
- protected:
   // Return the total number of async requests that have started and not
   // finished
   uint GetNumOngoingRequests();
 
-  void SendInferRequest(uint32_t ctx_id, bool delayed = false)
+  void SendInferRequest(
+      uint32_t ctx_id, bool delayed = false,
+      std::chrono::time_point<std::chrono::system_clock> scheduled_time = {})
   {
     if (ShouldExit()) {
       return;
     }
 
+    bool sent;
     if (on_sequence_model_) {
       uint32_t seq_stat_index = GetSeqStatIndex(ctx_id);
-      ctxs_[ctx_id]->SendSequenceInferRequest(seq_stat_index, delayed);
+      sent = ctxs_[ctx_id]->SendSequenceInferRequest(
+          seq_stat_index, delayed, scheduled_time);
     } else {
-      ctxs_[ctx_id]->SendInferRequest(delayed);
+      sent = ctxs_[ctx_id]->SendInferRequest(delayed, scheduled_time);
+    }
+    // The callback of an async request gives the context back, which a
+    // request that wasn't sent must do here
+    if (!sent && async_) {
+      AsyncCallbackFinalize(ctx_id);
     }
   }
 
@@ -150,6 +166,10 @@ class LoadWorker : public IWorker {
   const bool using_json_data_;
 
   std::shared_ptr<SequenceManager> sequence_manager_{nullptr};
+
+  // The models of a multi-model workload, null if the requests all go to the
+  // model of 'parser_'
+  std::shared_ptr<const Workload> workload_{nullptr};
 };
 
 }}  // namespace triton::perfanalyzer
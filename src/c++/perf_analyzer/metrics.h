@@ -39,6 +39,8 @@ struct Metrics {
   std::map<std::string, double> gpu_power_usage_per_gpu{};
   std::map<std::string, uint64_t> gpu_memory_used_bytes_per_gpu{};
   std::map<std::string, uint64_t> gpu_memory_total_bytes_per_gpu{};
+  // The time the metrics were queried at, in nanoseconds since the epoch
+  uint64_t timestamp_ns{0};
 };
 
 }}  // namespace triton::perfanalyzer
@@ -32,6 +32,7 @@
 
 #include "constants.h"
 #include "perf_analyzer_exception.h"
+#include "perf_utils.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -64,6 +65,7 @@ MetricsManager::QueryMetricsEveryNMilliseconds()
     const auto& start{std::chrono::system_clock::now()};
 
     Metrics metrics{};
+    metrics.timestamp_ns = CHRONO_TO_NANOS(start);
     clientbackend::Error err{client_backend_->Metrics(metrics)};
     if (err.IsOk() == false) {
       throw PerfAnalyzerException(err.Message(), err.Err());
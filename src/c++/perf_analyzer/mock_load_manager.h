@@ -30,7 +30,10 @@
 
 namespace triton { namespace perfanalyzer {
 
-class NaggyMockLoadManager : public LoadManager {};
+class NaggyMockLoadManager : public LoadManager {
+ public:
+  using LoadManager::AddThreadStat;
+};
 
 using MockLoadManager = testing::NiceMock<NaggyMockLoadManager>;
 
@@ -26,6 +26,8 @@
 
 #include "model_parser.h"
 
+#include <map>
+
 #include "rapidjson/writer.h"
 
 namespace triton { namespace perfanalyzer {
@@ -287,6 +289,43 @@ ModelParser::InitTorchServe(
   return cb::Error::Success;
 }
 
+cb::Error
+ModelParser::InitNull(
+    const std::string& model_name, const std::string& model_version,
+    const int32_t batch_size,
+    const std::unordered_map<std::string, std::vector<int64_t>>& input_shapes,
+    const bool is_decoupled)
+{
+  model_name_ = model_name;
+  model_version_ = model_version;
+  scheduler_type_ = NONE;
+  max_batch_size_ = batch_size;
+  is_decoupled_ = is_decoupled;
+
+  // The null service accepts any input, order them by name so that the
+  // outputs are named consistently between runs
+  std::map<std::string, std::vector<int64_t>> shapes(
+      input_shapes.begin(), input_shapes.end());
+  if (shapes.empty()) {
+    shapes.emplace("INPUT0", std::vector<int64_t>{16});
+  }
+  size_t index = 0;
+  for (const auto& shape : shapes) {
+    auto it = inputs_->emplace(shape.first, ModelTensor()).first;
+    it->second.name_ = shape.first;
+    it->second.datatype_ = "FP32";
+    it->second.shape_ = shape.second;
+
+    const std::string output_name = "OUTPUT" + std::to_string(index++);
+    auto output_it = outputs_->emplace(output_name, ModelTensor()).first;
+    output_it->second.name_ = output_name;
+    output_it->second.datatype_ = "FP32";
+    output_it->second.shape_ = shape.second;
+  }
+
+  return cb::Error::Success;
+}
+
 cb::Error
 ModelParser::DetermineComposingModelMap(
     const std::vector<cb::ModelIdentifier>& bls_composing_models,
@@ -115,6 +115,22 @@ class ModelParser {
       const std::string& model_name, const std::string& model_version,
       const int32_t batch_size);
 
+  /// Initializes the ModelParser for the null service, which has no model.
+  /// The model takes FP32 inputs of the user provided shapes, or a single
+  /// input INPUT0 of shape [16] if none are provided, and returns an output
+  /// OUTPUT<i> for each of them.
+  /// \param model_name The name of target model.
+  /// \param model_version The version of target model.
+  /// \param batch_size The batch size, used as the maximum batch size.
+  /// \param input_shapes The user provided shapes of the inputs.
+  /// \param is_decoupled Whether the null service is decoupled.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error InitNull(
+      const std::string& model_name, const std::string& model_version,
+      const int32_t batch_size,
+      const std::unordered_map<std::string, std::vector<int64_t>>& input_shapes,
+      const bool is_decoupled);
+
   /// Get the name of the target model
   /// \return Model name as string
   const std::string& ModelName() const { return model_name_; }
@@ -74,11 +74,21 @@ PerfAnalyzer::CreateAnalyzerObjects()
 {
   // trap SIGINT to allow threads to exit gracefully
   signal(SIGINT, pa::SignalHandler);
+
+  // Place this thread before creating the other threads and allocating the
+  // input data so that they inherit the placement
+  FAIL_IF_ERR(
+      pa::SetCpuPlacement(
+          params_->cpu_affinity, params_->numa_node, &placed_cpus_),
+      "failed to set the CPU placement");
+
   std::shared_ptr<cb::ClientBackendFactory> factory;
   FAIL_IF_ERR(
       cb::ClientBackendFactory::Create(
           params_->kind, params_->url, params_->protocol, params_->ssl_options,
           params_->trace_options, params_->compression_algorithm,
+          params_->compression_options, params_->response_cache_options,
+          params_->null_service_options, params_->shared_client_backends,
           params_->http_headers, params_->triton_server_path,
           params_->model_repository_path, params_->extra_verbose,
           params_->metrics_url, params_->input_tensor_format,
@@ -89,45 +99,47 @@ PerfAnalyzer::CreateAnalyzerObjects()
       factory->CreateClientBackend(&backend_),
       "failed to create triton client backend");
 
-  parser_ = std::make_shared<pa::ModelParser>(params_->kind);
-  if (params_->kind == cb::BackendKind::TRITON ||
-      params_->kind == cb::BackendKind::TRITON_C_API) {
-    rapidjson::Document model_metadata;
-    FAIL_IF_ERR(
-        backend_->ModelMetadata(
-            &model_metadata, params_->model_name, params_->model_version),
-        "failed to get model metadata");
-    rapidjson::Document model_config;
+  if (!params_->workload_file.empty()) {
     FAIL_IF_ERR(
-        backend_->ModelConfig(
-            &model_config, params_->model_name, params_->model_version),
-        "failed to get model config");
+        pa::ReadWorkloadFile(params_->workload_file, &workload_models_),
+        "failed to read workload file");
+    params_->model_name = workload_models_[0].name_;
+    params_->model_version = workload_models_[0].version_;
+  }
 
+  if (!params_->request_rate_profile_file.empty()) {
     FAIL_IF_ERR(
-        parser_->InitTriton(
-            model_metadata, model_config, params_->model_version,
-            params_->bls_composing_models, params_->input_shapes, backend_),
-        "failed to create model parser");
-  } else if (params_->kind == cb::BackendKind::TENSORFLOW_SERVING) {
-    rapidjson::Document model_metadata;
-    FAIL_IF_ERR(
-        backend_->ModelMetadata(
-            &model_metadata, params_->model_name, params_->model_version),
-        "failed to get model metadata");
-    FAIL_IF_ERR(
-        parser_->InitTFServe(
-            model_metadata, params_->model_name, params_->model_version,
-            params_->model_signature_name, params_->batch_size,
-            params_->input_shapes, backend_),
-        "failed to create model parser");
-  } else if (params_->kind == cb::BackendKind::TORCHSERVE) {
-    FAIL_IF_ERR(
-        parser_->InitTorchServe(
-            params_->model_name, params_->model_version, params_->batch_size),
-        "failed to create model parser");
-  } else {
-    std::cerr << "unsupported client backend kind" << std::endl;
-    throw pa::PerfAnalyzerException(pa::GENERIC_ERROR);
+        pa::ReadLoadProfileFile(
+            params_->request_rate_profile_file, &load_profile_),
+        "failed to read load profile file");
+  }
+
+  parser_ = CreateModelParser(params_->model_name, params_->model_version);
+  std::vector<std::shared_ptr<pa::ModelParser>> workload_parsers{parser_};
+  for (size_t i = 1; i < workload_models_.size(); ++i) {
+    workload_parsers.push_back(CreateModelParser(
+        workload_models_[i].name_, workload_models_[i].version_));
+  }
+
+  for (size_t i = 1; i < workload_parsers.size(); ++i) {
+    if ((workload_parsers[i]->MaxBatchSize() == 0) &&
+        params_->batch_size > 1) {
+      std::cerr << "can not specify batch size > 1 as model "
+                << workload_parsers[i]->ModelName()
+                << " does not support batching" << std::endl;
+      throw pa::PerfAnalyzerException(pa::GENERIC_ERROR);
+    }
+  }
+  // The sequences of a context would be interleaved with the requests to the
+  // other models
+  for (const auto& parser : workload_parsers) {
+    if (!workload_models_.empty() &&
+        ((parser->SchedulerType() == pa::ModelParser::SEQUENCE) ||
+         (parser->SchedulerType() == pa::ModelParser::ENSEMBLE_SEQUENCE))) {
+      std::cerr << "sequence model " << parser->ModelName()
+                << " is not supported in a workload" << std::endl;
+      throw pa::PerfAnalyzerException(pa::GENERIC_ERROR);
+    }
   }
 
   if ((parser_->MaxBatchSize() == 0) && params_->batch_size > 1) {
@@ -159,6 +171,14 @@ PerfAnalyzer::CreateAnalyzerObjects()
     params_->async = true;
   }
 
+  // The synchronous requests of a client can't be multiplexed
+  if ((params_->shared_client_backends != 0) && !params_->async) {
+    std::cerr << "can not share client backends with synchronous API, "
+                 "specify --async"
+              << std::endl;
+    throw pa::PerfAnalyzerException(pa::GENERIC_ERROR);
+  }
+
   std::unique_ptr<pa::LoadManager> manager;
   if (params_->targeting_concurrency()) {
     if ((parser_->SchedulerType() == pa::ModelParser::SEQUENCE) ||
@@ -234,6 +254,8 @@ PerfAnalyzer::CreateAnalyzerObjects()
             params_->output_shm_size, params_->serial_sequences, parser_,
             factory, &manager, params_->request_parameters),
         "failed to create request rate manager");
+    dynamic_cast<pa::RequestRateManager&>(*manager).SetArrivalProcessOptions(
+        params_->arrival_process_options);
 
   } else {
     if ((params_->sequence_id_range != 0) &&
@@ -255,9 +277,21 @@ PerfAnalyzer::CreateAnalyzerObjects()
         "failed to create custom load manager");
   }
 
+  if (params_->max_inflight != 0) {
+    manager->SetInflightLimit(
+        params_->max_inflight, params_->inflight_limit_policy,
+        std::chrono::milliseconds(params_->inflight_queue_timeout_ms));
+  }
+
+  std::vector<std::string> user_data{params_->user_data};
+  if (!workload_models_.empty()) {
+    manager->SetWorkload(workload_models_, workload_parsers);
+    user_data = workload_models_[0].input_data_;
+  }
+
   manager->InitManager(
       params_->string_length, params_->string_data, params_->zero_input,
-      params_->user_data, params_->start_sequence_id,
+      user_data, params_->start_sequence_id,
       params_->sequence_id_range, params_->sequence_length,
       params_->sequence_length_specified, params_->sequence_length_variation);
 
@@ -280,6 +314,80 @@ PerfAnalyzer::CreateAnalyzerObjects()
           params_->should_collect_metrics, params_->overhead_pct_threshold,
           collector_, !params_->profile_export_file.empty()),
       "failed to create profiler");
+
+  if (!workload_models_.empty()) {
+    profiler_->SetWorkload(workload_models_);
+  }
+
+  profiler_->SetWarmup(
+      params_->warmup_duration_ms, params_->warmup_request_count);
+
+  if (!params_->timeline_file.empty()) {
+    FAIL_IF_ERR(
+        pa::TimelineCollector::Create(
+            params_->timeline_interval_ms, &timeline_collector_),
+        "failed to create timeline collector");
+    profiler_->SetTimelineCollector(timeline_collector_);
+  }
+
+  if (params_->live_metrics_port != 0) {
+    FAIL_IF_ERR(
+        pa::LiveMetricsServer::Create(
+            params_->live_metrics_port,
+            [this](pa::LiveStats* stats) { profiler_->GetLiveStats(stats); },
+            &live_metrics_server_),
+        "failed to start live metrics server");
+  }
+}
+
+std::shared_ptr<pa::ModelParser>
+PerfAnalyzer::CreateModelParser(
+    const std::string& model_name, const std::string& model_version)
+{
+  auto parser = std::make_shared<pa::ModelParser>(params_->kind);
+  if (params_->kind == cb::BackendKind::TRITON ||
+      params_->kind == cb::BackendKind::TRITON_C_API) {
+    rapidjson::Document model_metadata;
+    FAIL_IF_ERR(
+        backend_->ModelMetadata(&model_metadata, model_name, model_version),
+        "failed to get model metadata");
+    rapidjson::Document model_config;
+    FAIL_IF_ERR(
+        backend_->ModelConfig(&model_config, model_name, model_version),
+        "failed to get model config");
+
+    FAIL_IF_ERR(
+        parser->InitTriton(
+            model_metadata, model_config, model_version,
+            params_->bls_composing_models, params_->input_shapes, backend_),
+        "failed to create model parser");
+  } else if (params_->kind == cb::BackendKind::TENSORFLOW_SERVING) {
+    rapidjson::Document model_metadata;
+    FAIL_IF_ERR(
+        backend_->ModelMetadata(&model_metadata, model_name, model_version),
+        "failed to get model metadata");
+    FAIL_IF_ERR(
+        parser->InitTFServe(
+            model_metadata, model_name, model_version,
+            params_->model_signature_name, params_->batch_size,
+            params_->input_shapes, backend_),
+        "failed to create model parser");
+  } else if (params_->kind == cb::BackendKind::TORCHSERVE) {
+    FAIL_IF_ERR(
+        parser->InitTorchServe(model_name, model_version, params_->batch_size),
+        "failed to create model parser");
+  } else if (params_->kind == cb::BackendKind::NULL_SERVICE) {
+    FAIL_IF_ERR(
+        parser->InitNull(
+            model_name, model_version, params_->batch_size,
+            params_->input_shapes, params_->null_service_options.decoupled),
+        "failed to create model parser");
+  } else {
+    std::cerr << "unsupported client backend kind" << std::endl;
+    throw pa::PerfAnalyzerException(pa::GENERIC_ERROR);
+  }
+
+  return parser;
 }
 
 void
@@ -297,6 +405,10 @@ PerfAnalyzer::PrerunReport()
     std::cout << "  Service Kind: TorchServe" << std::endl;
   } else if (params_->kind == cb::BackendKind::TENSORFLOW_SERVING) {
     std::cout << "  Service Kind: TensorFlow Serving" << std::endl;
+  } else if (params_->kind == cb::BackendKind::NULL_SERVICE) {
+    std::cout << "  Service Kind: Null (synthetic mean latency "
+              << params_->null_service_options.latency_us << " usec)"
+              << std::endl;
   }
 
   if (params_->measurement_mode == pa::MeasurementMode::COUNT_WINDOWS) {
@@ -312,6 +424,17 @@ PerfAnalyzer::PrerunReport()
     std::cout << "  Minimum number of samples in each window: "
               << params_->measurement_request_count << std::endl;
   }
+  if (!placed_cpus_.empty()) {
+    std::cout << "  CPU affinity: " << pa::FormatCpuList(placed_cpus_)
+              << std::endl;
+  }
+  if (params_->numa_node >= 0) {
+    std::cout << "  NUMA node: " << params_->numa_node << std::endl;
+  }
+  if (params_->warmup_duration_ms != 0 || params_->warmup_request_count != 0) {
+    std::cout << "  Warm-up: " << params_->warmup_duration_ms << " msec, "
+              << params_->warmup_request_count << " requests" << std::endl;
+  }
   if (params_->concurrency_range.end != 1) {
     std::cout << "  Latency limit: " << params_->latency_threshold_ms << " msec"
               << std::endl;
@@ -335,15 +458,44 @@ PerfAnalyzer::PrerunReport()
                 << " requests per seconds" << std::endl;
     }
   }
+  if (!load_profile_.Segments().empty()) {
+    std::cout << "  Load profile: " << load_profile_.Segments().size()
+              << " segments over " << (load_profile_.DurationNs() / 1000000)
+              << " msec" << std::endl;
+  }
   if (params_->using_request_rate_range) {
     if (params_->request_distribution == pa::Distribution::POISSON) {
       std::cout << "  Using poisson distribution on request generation"
                 << std::endl;
+    } else if (params_->request_distribution == pa::Distribution::GAMMA) {
+      std::cout << "  Using gamma distribution with CV "
+                << params_->arrival_process_options.gamma_cv_
+                << " on request generation" << std::endl;
+    } else if (params_->request_distribution == pa::Distribution::MMPP) {
+      std::cout << "  Using Markov-modulated poisson process with burst ratio "
+                << params_->arrival_process_options.mmpp_burst_ratio_
+                << " on request generation" << std::endl;
+    } else if (
+        params_->request_distribution == pa::Distribution::PARETO_ON_OFF) {
+      std::cout << "  Using pareto on-off process with alpha "
+                << params_->arrival_process_options.pareto_alpha_
+                << " on request generation" << std::endl;
     } else {
       std::cout << "  Using uniform distribution on request generation"
                 << std::endl;
     }
   }
+  if (params_->max_inflight != 0) {
+    std::cout << "  Max requests in flight: " << params_->max_inflight;
+    if (params_->inflight_limit_policy == pa::InflightLimitPolicy::DROP) {
+      std::cout << ", dropping the requests over the limit" << std::endl;
+    } else if (params_->inflight_queue_timeout_ms != 0) {
+      std::cout << ", queueing the requests over the limit for up to "
+                << params_->inflight_queue_timeout_ms << " msec" << std::endl;
+    } else {
+      std::cout << ", queueing the requests over the limit" << std::endl;
+    }
+  }
   if (params_->search_mode == pa::SearchMode::BINARY) {
     std::cout << "  Using Binary Search algorithm" << std::endl;
   }
@@ -379,6 +531,8 @@ PerfAnalyzer::Profile()
         params_->concurrency_range.step, params_->search_mode, perf_statuses_);
   } else if (params_->is_using_periodic_concurrency_mode) {
     err = profiler_->ProfilePeriodicConcurrencyMode();
+  } else if (!load_profile_.Segments().empty()) {
+    err = profiler_->ProfileLoadProfile(load_profile_, perf_statuses_);
   } else {
     err = profiler_->Profile<double>(
         params_->request_rate_range[pa::SEARCH_RANGE::kSTART],
@@ -389,6 +543,10 @@ PerfAnalyzer::Profile()
 
   params_->mpi_driver->MPIBarrierWorld();
 
+  // The timeline is most useful to look into a run that failed, so it is
+  // written before the error is handled
+  GenerateTimeline();
+
   if (!err.IsOk()) {
     std::cerr << err;
     // In the case of early_exit, the thread does not return and continues to
@@ -420,11 +578,18 @@ PerfAnalyzer::WriteReport()
     } else {
       std::cout << "Request Rate: " << status.request_rate << ", ";
     }
+    if (!status.load_segment.empty()) {
+      std::cout << "segment: " << status.load_segment << ", ";
+    }
     std::cout << "throughput: " << status.client_stats.infer_per_sec
               << " infer/sec, latency "
               << (status.stabilizing_latency_ns / 1000) << " usec" << std::endl;
   }
 
+  if (params_->kind == cb::BackendKind::NULL_SERVICE) {
+    WriteLoadGeneratorReport();
+  }
+
   bool should_output_metrics{
       params_->should_collect_metrics && params_->verbose_csv};
 
@@ -440,6 +605,63 @@ PerfAnalyzer::WriteReport()
   writer->GenerateReport();
 }
 
+void
+PerfAnalyzer::WriteLoadGeneratorReport()
+{
+  // With the null service the throughput is limited by perf_analyzer only,
+  // report the highest throughput it sustained and what each request costs
+  // on top of the synthetic latency.
+  std::string mode{"sync"};
+  if (params_->streaming) {
+    mode = "streaming";
+  } else if (params_->async) {
+    mode = "async";
+  }
+  if (params_->targeting_concurrency()) {
+    mode += ", concurrency";
+  } else if (params_->using_request_rate_range) {
+    mode += ", request rate";
+  } else {
+    mode += ", custom intervals";
+  }
+
+  const pa::PerfStatus* best{nullptr};
+  for (const pa::PerfStatus& status : perf_statuses_) {
+    const auto& stats = status.client_stats;
+    // The requests of a schedule are only sustained if perf_analyzer sent
+    // them on time
+    if (!params_->targeting_concurrency() && (stats.request_count != 0) &&
+        (((double)stats.delayed_request_count / stats.request_count) * 100 >
+         pa::DELAY_PCT_THRESHOLD)) {
+      continue;
+    }
+    if ((best == nullptr) ||
+        (stats.infer_per_sec > best->client_stats.infer_per_sec)) {
+      best = &status;
+    }
+  }
+
+  std::cout << "Load generator ceiling (" << mode << "): ";
+  if (best == nullptr) {
+    std::cout << "no load level was sustained" << std::endl;
+    return;
+  }
+  const uint64_t synthetic_latency_ns =
+      params_->null_service_options.latency_us * 1000;
+  const uint64_t overhead_ns =
+      (best->client_stats.avg_latency_ns > synthetic_latency_ns)
+          ? (best->client_stats.avg_latency_ns - synthetic_latency_ns)
+          : 0;
+  std::cout << best->client_stats.infer_per_sec << " infer/sec at ";
+  if (params_->targeting_concurrency()) {
+    std::cout << "concurrency " << best->concurrency;
+  } else {
+    std::cout << "request rate " << best->request_rate;
+  }
+  std::cout << ", per-request overhead " << (overhead_ns / 1000) << " usec"
+            << std::endl;
+}
+
 void
 PerfAnalyzer::GenerateProfileExport()
 {
@@ -450,6 +672,17 @@ PerfAnalyzer::GenerateProfileExport()
   }
 }
 
+void
+PerfAnalyzer::GenerateTimeline()
+{
+  if (timeline_collector_ != nullptr) {
+    cb::Error err{timeline_collector_->Write(params_->timeline_file)};
+    if (!err.IsOk()) {
+      std::cerr << "WARNING: " << err.Message() << std::endl;
+    }
+  }
+}
+
 void
 PerfAnalyzer::Finalize()
 {
@@ -32,13 +32,18 @@
 
 #include "command_line_parser.h"
 #include "concurrency_manager.h"
+#include "cpu_affinity.h"
 #include "custom_load_manager.h"
 #include "inference_profiler.h"
+#include "live_metrics.h"
+#include "load_profile.h"
 #include "model_parser.h"
 #include "mpi_utils.h"
 #include "perf_utils.h"
 #include "profile_data_collector.h"
 #include "profile_data_exporter.h"
+#include "timeline_collector.h"
+#include "workload.h"
 
 // Perf Analyzer provides various metrics to measure the performance of
 // the inference server. It can either be used to measure the throughput,
@@ -186,6 +191,17 @@ class PerfAnalyzer {
   std::vector<pa::PerfStatus> perf_statuses_;
   std::shared_ptr<pa::ProfileDataCollector> collector_;
   std::shared_ptr<pa::ProfileDataExporter> exporter_;
+  // The collector of the timeline of the run, null if there is no timeline
+  std::shared_ptr<pa::TimelineCollector> timeline_collector_;
+  // The server of the live metrics, null if they are not served. Declared
+  // last to stop serving before the profiler is destroyed.
+  std::unique_ptr<pa::LiveMetricsServer> live_metrics_server_;
+  // The models of a multi-model workload, empty if there is a single model
+  std::vector<pa::WorkloadModel> workload_models_;
+  // The CPU cores perf_analyzer is pinned to, empty if it is not pinned
+  std::vector<int> placed_cpus_;
+  // The time-varying request rate to follow, empty if there is none
+  pa::LoadProfile load_profile_;
 
   //
   // Helper methods
@@ -194,9 +210,16 @@ class PerfAnalyzer {
   // Parse the options out of the command line argument
   //
   void CreateAnalyzerObjects();
+  // Create the parser of the model 'model_name'.
+  std::shared_ptr<pa::ModelParser> CreateModelParser(
+      const std::string& model_name, const std::string& model_version);
   void PrerunReport();
   void Profile();
   void WriteReport();
+  // Report the throughput perf_analyzer sustains with the null service.
+  void WriteLoadGeneratorReport();
   void GenerateProfileExport();
+  // Write the timeline of the run, if requested.
+  void GenerateTimeline();
   void Finalize();
 };
@@ -36,6 +36,7 @@
 #include <string>
 
 #include "client_backend/client_backend.h"
+#include "convert_utils.h"
 #include "doctest.h"
 
 namespace triton { namespace perfanalyzer {
@@ -201,6 +202,7 @@ SerializeExplicitTensor(
         serialized.begin(), serialized.end(),
         std::back_inserter(*decoded_data));
   } else {
+    std::vector<float> fp32_values;
     for (const auto& value : tensor.GetArray()) {
       if (dt.compare("BOOL") == 0) {
         if (!value.IsBool()) {
@@ -242,14 +244,13 @@ SerializeExplicitTensor(
         int16_t element(static_cast<int16_t>(value.GetInt()));
         const char* src = reinterpret_cast<const char*>(&element);
         decoded_data->insert(decoded_data->end(), src, src + sizeof(int16_t));
-      } else if (dt.compare("FP16") == 0) {
-        return cb::Error(
-            "Can not use explicit tensor description for fp16 datatype",
-            pa::GENERIC_ERROR);
-      } else if (dt.compare("BF16") == 0) {
-        return cb::Error(
-            "Can not use explicit tensor description for bf16 datatype",
-            pa::GENERIC_ERROR);
+      } else if ((dt.compare("FP16") == 0) || (dt.compare("BF16") == 0)) {
+        if (!value.IsNumber()) {
+          return cb::Error(
+              "unable to find float data in json", pa::GENERIC_ERROR);
+        }
+        // Converted all at once after reading the values
+        fp32_values.push_back(value.GetFloat());
       } else if (dt.compare("UINT32") == 0) {
         if (!value.IsUint()) {
           return cb::Error(
@@ -300,6 +301,19 @@ SerializeExplicitTensor(
         decoded_data->insert(decoded_data->end(), src, src + sizeof(double));
       }
     }
+    if (!fp32_values.empty()) {
+      std::vector<uint16_t> converted(fp32_values.size());
+      if (dt.compare("FP16") == 0) {
+        triton::client::Fp32ToFp16(
+            fp32_values.data(), converted.data(), converted.size());
+      } else {
+        triton::client::Fp32ToBf16(
+            fp32_values.data(), converted.data(), converted.size());
+      }
+      const char* src = reinterpret_cast<const char*>(converted.data());
+      decoded_data->insert(
+          decoded_data->end(), src, src + converted.size() * sizeof(uint16_t));
+    }
   }
   return cb::Error::Success;
 }
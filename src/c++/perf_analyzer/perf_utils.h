@@ -61,7 +61,14 @@ std::string const character_set =
 // A boolean flag to mark an interrupt and commencement of early exit
 extern volatile bool early_exit;
 
-enum Distribution { POISSON = 0, CONSTANT = 1, CUSTOM = 2 };
+enum Distribution {
+  POISSON = 0,
+  CONSTANT = 1,
+  CUSTOM = 2,
+  GAMMA = 3,
+  MMPP = 4,
+  PARETO_ON_OFF = 5
+};
 enum SearchMode { LINEAR = 0, BINARY = 1, NONE = 2 };
 enum SharedMemoryType {
   SYSTEM_SHARED_MEMORY = 0,
@@ -48,6 +48,7 @@ PeriodicConcurrencyManager::MakeWorker(
       streaming_, batch_size_, wake_signal_, wake_mutex_, active_threads_,
       execute_, infer_data_manager_, sequence_manager_, request_period_,
       period_completed_callback_, request_completed_callback_);
+  worker->SetWorkload(workload_);
   return worker;
 };
 
@@ -64,7 +65,7 @@ PeriodicConcurrencyManager::AddConcurrentRequests(
 void
 PeriodicConcurrencyManager::AddConcurrentRequest(size_t seq_stat_index_offset)
 {
-  threads_stat_.emplace_back(std::make_shared<ThreadStat>());
+  AddThreadStat();
   threads_config_.emplace_back(
       std::make_shared<ConcurrencyWorker::ThreadConfig>(
           threads_config_.size(), 1, seq_stat_index_offset));
@@ -64,6 +64,19 @@ ProfileDataCollector::AddWindow(
   }
 }
 
+void
+ProfileDataCollector::SetMeasurementWindow(
+    InferenceLoadMode& id, uint64_t start_ns, uint64_t end_ns)
+{
+  auto it = FindExperiment(id);
+
+  // The windows of the measurement were added to the experiment
+  if (it != experiments_.end()) {
+    it->measurement_start_ns = start_ns;
+    it->measurement_end_ns = end_ns;
+  }
+}
+
 void
 ProfileDataCollector::AddData(
     InferenceLoadMode& id, std::vector<RequestRecord>&& request_records)
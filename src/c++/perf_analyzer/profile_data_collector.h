@@ -69,6 +69,10 @@ struct Experiment {
   InferenceLoadMode mode;
   std::vector<RequestRecord> requests;
   std::vector<uint64_t> window_boundaries;
+  // The start and the end of the windows merged into the reported
+  // measurement, 0 if the measurement didn't stabilize
+  uint64_t measurement_start_ns{0};
+  uint64_t measurement_end_ns{0};
 };
 
 #ifndef DOCTEST_CONFIG_DISABLE
@@ -89,6 +93,14 @@ class ProfileDataCollector {
   void AddWindow(
       InferenceLoadMode& id, uint64_t window_start_ns, uint64_t window_end_ns);
 
+  /// Set the span of the windows merged into the reported measurement of an
+  /// experiment
+  /// @param id Identifier for the experiment
+  /// @param start_ns The start timestamp of the first window in nanoseconds.
+  /// @param end_ns The end timestamp of the last window in nanoseconds.
+  void SetMeasurementWindow(
+      InferenceLoadMode& id, uint64_t start_ns, uint64_t end_ns);
+
   /// Add request records to an experiment
   /// @param id Identifier for the experiment
   /// @param request_records The request information for the current experiment.
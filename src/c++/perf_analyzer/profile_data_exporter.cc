@@ -69,6 +69,7 @@ ProfileDataExporter::ConvertToJson(
     AddExperiment(entry, experiment, raw_experiment);
     AddRequests(entry, requests, raw_experiment);
     AddWindowBoundaries(entry, window_boundaries, raw_experiment);
+    AddMeasurementWindow(entry, raw_experiment);
 
     experiments.PushBack(entry, document_.GetAllocator());
   }
@@ -122,6 +123,15 @@ ProfileDataExporter::AddRequests(
       request.AddMember("sequence_id", sequence_id, document_.GetAllocator());
     }
 
+    if (raw_request.scheduled_time_.time_since_epoch().count() != 0) {
+      rapidjson::Value scheduled_timestamp;
+      scheduled_timestamp.SetUint64(
+          raw_request.scheduled_time_.time_since_epoch().count());
+      request.AddMember(
+          "scheduled_timestamp", scheduled_timestamp,
+          document_.GetAllocator());
+    }
+
     rapidjson::Value responses(rapidjson::kArrayType);
     AddResponses(responses, raw_request.response_times_);
     request.AddMember(
@@ -158,6 +168,25 @@ ProfileDataExporter::AddWindowBoundaries(
       "window_boundaries", window_boundaries, document_.GetAllocator());
 }
 
+void
+ProfileDataExporter::AddMeasurementWindow(
+    rapidjson::Value& entry, const Experiment& raw_experiment)
+{
+  // Only experiments that stabilized have a reported measurement
+  if (raw_experiment.measurement_end_ns == 0) {
+    return;
+  }
+  rapidjson::Value measurement_window(rapidjson::kArrayType);
+  rapidjson::Value start;
+  start.SetUint64(raw_experiment.measurement_start_ns);
+  measurement_window.PushBack(start, document_.GetAllocator());
+  rapidjson::Value end;
+  end.SetUint64(raw_experiment.measurement_end_ns);
+  measurement_window.PushBack(end, document_.GetAllocator());
+  entry.AddMember(
+      "measurement_window", measurement_window, document_.GetAllocator());
+}
+
 void
 ProfileDataExporter::AddVersion(std::string& raw_version)
 {
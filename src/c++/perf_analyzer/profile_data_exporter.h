@@ -76,6 +76,8 @@ class ProfileDataExporter {
   void AddWindowBoundaries(
       rapidjson::Value& entry, rapidjson::Value& window_boundaries,
       const Experiment& raw_experiment);
+  void AddMeasurementWindow(
+      rapidjson::Value& entry, const Experiment& raw_experiment);
   void AddVersion(std::string& raw_version);
   void ClearDocument();
 
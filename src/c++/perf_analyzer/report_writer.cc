@@ -109,6 +109,14 @@ ReportWriter::GenerateReport()
         ofs << ",Max GPU Memory Usage";
         ofs << ",Total GPU Memory";
       }
+      ofs << ",Generator CPU Cores";
+      ofs << ",Generator Max Thread CPU";
+      ofs << ",Generator Voluntary Context Switches";
+      ofs << ",Generator Involuntary Context Switches";
+      ofs << ",Generator Page Faults";
+      ofs << ",Generator RSS Bytes";
+      ofs << ",Generator RSS Growth Bytes";
+      ofs << ",Window Start,Window End";
     }
     ofs << std::endl;
 
@@ -234,6 +242,8 @@ ReportWriter::GenerateReport()
                 GENERIC_ERROR);
           }
         }
+        WriteResourceUsage(ofs, status.resource_usage);
+        ofs << "," << status.window_start_ns << "," << status.window_end_ns;
       }
       ofs << std::endl;
     }
@@ -388,4 +398,17 @@ ReportWriter::WriteGpuMetrics(std::ostream& ofs, const Metrics& metric)
   }
 }
 
+void
+ReportWriter::WriteResourceUsage(
+    std::ostream& ofs, const ResourceUsageStats& stats)
+{
+  ofs << "," << stats.cpu_utilization;
+  ofs << "," << stats.max_thread_cpu_utilization;
+  ofs << "," << stats.voluntary_context_switches;
+  ofs << "," << stats.involuntary_context_switches;
+  ofs << "," << (stats.minor_page_faults + stats.major_page_faults);
+  ofs << "," << stats.rss_bytes;
+  ofs << "," << stats.rss_growth_bytes;
+}
+
 }}  // namespace triton::perfanalyzer
@@ -79,6 +79,12 @@ class ReportWriter {
   /// rate
   void WriteGpuMetrics(std::ostream& ofs, const Metrics& metric);
 
+  /// Output the resources used by perf_analyzer to a stream
+  /// \param ofs A stream to output the csv data
+  /// \param stats The resources used for a particular concurrency or request
+  /// rate
+  void WriteResourceUsage(std::ostream& ofs, const ResourceUsageStats& stats);
+
  private:
   ReportWriter(
       const std::string& filename, const bool target_concurrency,
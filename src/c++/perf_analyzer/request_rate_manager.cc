@@ -26,6 +26,9 @@
 
 #include "request_rate_manager.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace triton { namespace perfanalyzer {
 
 RequestRateManager::~RequestRateManager()
@@ -94,19 +97,41 @@ RequestRateManager::ChangeRequestRate(const double request_rate)
   PauseWorkers();
   ConfigureThreads();
   // Can safely update the schedule
-  GenerateSchedule(request_rate);
+  RETURN_IF_ERROR(GenerateSchedule(request_rate));
   ResumeWorkers();
 
   return cb::Error::Success;
 }
 
-void
+cb::Error
+RequestRateManager::StartLoadProfile(const LoadProfile& profile)
+{
+  PauseWorkers();
+  ConfigureThreads();
+  // Can safely update the schedule
+  GenerateLoadProfileSchedule(profile);
+  ResumeWorkers();
+
+  return cb::Error::Success;
+}
+
+cb::Error
 RequestRateManager::GenerateSchedule(const double request_rate)
 {
   std::chrono::nanoseconds max_duration;
   std::function<std::chrono::nanoseconds(std::mt19937&)> distribution;
 
-  if (request_distribution_ == Distribution::POISSON) {
+  if (request_distribution_ == Distribution::GAMMA ||
+      request_distribution_ == Distribution::MMPP ||
+      request_distribution_ == Distribution::PARETO_ON_OFF) {
+    std::shared_ptr<ArrivalProcess> process;
+    RETURN_IF_ERROR(CreateArrivalProcess(
+        request_distribution_, request_rate, arrival_process_options_,
+        &process));
+    distribution = ArrivalProcessDistribution(process);
+    // Like Poisson, the bursts need the full duration to show
+    max_duration = *gen_duration_;
+  } else if (request_distribution_ == Distribution::POISSON) {
     distribution = ScheduleDistribution<Distribution::POISSON>(request_rate);
     // Poisson distribution needs to generate a schedule for the maximum
     // possible duration to make sure that it is as random and as close to the
@@ -118,10 +143,73 @@ RequestRateManager::GenerateSchedule(const double request_rate)
     // can be repeated over and over to emulate a full schedule of any length
     max_duration = std::chrono::nanoseconds(1);
   } else {
-    return;
+    return cb::Error::Success;
   }
 
-  auto worker_schedules = CreateWorkerSchedules(max_duration, distribution);
+  if (request_distribution_ == Distribution::CONSTANT) {
+    schedule_stats_ = ScheduleStats{};
+    auto worker_schedules = CreateWorkerSchedules(max_duration, distribution);
+    GiveSchedulesToWorkers(worker_schedules);
+    return cb::Error::Success;
+  }
+
+  // Count the requests in windows holding 10 requests on average, and at
+  // least 100 msec, and call the requests under a tenth of the mean interval
+  // apart a burst
+  const double mean_interval_ns{NANOS_PER_SECOND / request_rate};
+  ScheduleStatsCollector collector(
+      std::chrono::milliseconds(std::max<uint64_t>(
+          100, std::ceil(10 * mean_interval_ns / NANOS_PER_MILLIS))),
+      std::chrono::nanoseconds(static_cast<uint64_t>(mean_interval_ns / 10)));
+  auto recorded_distribution = [&collector, distribution](
+                                   std::mt19937& gen) mutable {
+    const std::chrono::nanoseconds interval{distribution(gen)};
+    collector.Add(interval);
+    return interval;
+  };
+
+  auto worker_schedules =
+      CreateWorkerSchedules(max_duration, recorded_distribution);
+  schedule_stats_ = collector.Stats();
+  GiveSchedulesToWorkers(worker_schedules);
+
+  return cb::Error::Success;
+}
+
+void
+RequestRateManager::GenerateLoadProfileSchedule(const LoadProfile& profile)
+{
+  // The schedule covers one round of the profile, which the workers repeat,
+  // and ends exactly with it so that the repeated rounds stay aligned with
+  // the segments. It only covers more rounds if one round has too few
+  // requests for every worker to get one.
+  const std::chrono::nanoseconds round_duration(profile.DurationNs());
+  auto distribution = LoadProfileDistribution(profile);
+  std::mt19937 schedule_rng;
+
+  std::vector<RateSchedulePtr_t> worker_schedules =
+      CreateEmptyWorkerSchedules();
+  std::vector<size_t> thread_ids{CalculateThreadIds()};
+
+  std::chrono::nanoseconds duration(round_duration);
+  std::chrono::nanoseconds next_timestamp(distribution(schedule_rng));
+  size_t thread_id_index = 0;
+  size_t request_count = 0;
+  while (next_timestamp < duration || request_count < thread_ids.size()) {
+    if (next_timestamp >= duration) {
+      duration += round_duration;
+      continue;
+    }
+    const size_t worker_index = thread_ids[thread_id_index];
+    thread_id_index = (thread_id_index + 1) % thread_ids.size();
+    worker_schedules[worker_index]->intervals.emplace_back(next_timestamp);
+    request_count++;
+    next_timestamp = next_timestamp + distribution(schedule_rng);
+  }
+
+  for (auto schedule : worker_schedules) {
+    schedule->duration = duration;
+  }
   GiveSchedulesToWorkers(worker_schedules);
 }
 
@@ -235,7 +323,7 @@ RequestRateManager::ConfigureThreads()
     size_t num_of_threads = DetermineNumThreads();
     while (workers_.size() < num_of_threads) {
       // Launch new thread for inferencing
-      threads_stat_.emplace_back(new ThreadStat());
+      AddThreadStat();
       threads_config_.emplace_back(
           new RequestRateWorker::ThreadConfig(workers_.size()));
 
@@ -275,11 +363,13 @@ RequestRateManager::MakeWorker(
 {
   size_t id = workers_.size();
   size_t num_of_threads = DetermineNumThreads();
-  return std::make_shared<RequestRateWorker>(
+  auto worker = std::make_shared<RequestRateWorker>(
       id, thread_stat, thread_config, parser_, data_loader_, factory_,
       on_sequence_model_, async_, num_of_threads, using_json_data_, streaming_,
       batch_size_, wake_signal_, wake_mutex_, execute_, start_time_,
       serial_sequences_, infer_data_manager_, sequence_manager_);
+  worker->SetWorkload(workload_);
+  return worker;
 }
 
 size_t
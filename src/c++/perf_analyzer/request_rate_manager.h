@@ -27,7 +27,9 @@
 
 #include <condition_variable>
 
+#include "arrival_process.h"
 #include "load_manager.h"
+#include "load_profile.h"
 #include "request_rate_worker.h"
 
 namespace triton { namespace perfanalyzer {
@@ -104,6 +106,24 @@ class RequestRateManager : public LoadManager {
   /// \return cb::Error object indicating success or failure.
   cb::Error ChangeRequestRate(const double target_request_rate);
 
+  /// Start issuing requests at a rate that follows a load profile, from its
+  /// start and repeating it after its end.
+  /// \param profile The load profile to follow.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error StartLoadProfile(const LoadProfile& profile);
+
+  /// Set the shape of the bursty request distributions. Must be called
+  /// before the request rate is set.
+  /// \param options The shape of the arrival processes.
+  void SetArrivalProcessOptions(const ArrivalProcessOptions& options)
+  {
+    arrival_process_options_ = options;
+  }
+
+  /// \return The burstiness of the schedule of the current request rate,
+  /// with no requests when the distribution is constant.
+  const ScheduleStats& GetScheduleStats() const { return schedule_stats_; }
+
  protected:
   RequestRateManager(
       const bool async, const bool streaming, Distribution request_distribution,
@@ -120,7 +140,12 @@ class RequestRateManager : public LoadManager {
 
   /// Generates and update the request schedule as per the given request rate.
   /// \param request_rate The request rate to use for new schedule.
-  void GenerateSchedule(const double request_rate);
+  /// \return cb::Error object indicating success or failure.
+  cb::Error GenerateSchedule(const double request_rate);
+
+  /// Generates and update the request schedule as per the given load profile.
+  /// \param profile The load profile to use for new schedule.
+  void GenerateLoadProfileSchedule(const LoadProfile& profile);
 
   std::vector<RateSchedulePtr_t> CreateWorkerSchedules(
       std::chrono::nanoseconds duration,
@@ -154,6 +179,8 @@ class RequestRateManager : public LoadManager {
 
   std::shared_ptr<std::chrono::nanoseconds> gen_duration_;
   Distribution request_distribution_;
+  ArrivalProcessOptions arrival_process_options_{};
+  ScheduleStats schedule_stats_{};
   std::chrono::steady_clock::time_point start_time_;
   bool execute_;
   const size_t num_of_sequences_{0};
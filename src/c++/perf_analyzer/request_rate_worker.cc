@@ -47,7 +47,7 @@ RequestRateWorker::Infer()
 
     bool is_delayed = SleepIfNecessary();
     uint32_t ctx_id = GetCtxId();
-    SendInferRequest(ctx_id, is_delayed);
+    SendInferRequest(ctx_id, is_delayed, scheduled_time_);
     RestoreFreeCtxId(ctx_id);
 
     if (HandleExitConditions()) {
@@ -134,6 +134,10 @@ RequestRateWorker::SleepIfNecessary()
   std::chrono::nanoseconds next_timestamp = GetNextTimestamp();
   std::chrono::nanoseconds current_timestamp = now - start_time_;
   std::chrono::nanoseconds wait_time = next_timestamp - current_timestamp;
+  // The request records are in system clock time
+  scheduled_time_ = std::chrono::system_clock::now() +
+                    std::chrono::duration_cast<
+                        std::chrono::system_clock::duration>(wait_time);
 
   bool delayed = false;
   if (wait_time.count() < 0) {
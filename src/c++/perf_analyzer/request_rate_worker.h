@@ -100,6 +100,8 @@ class RequestRateWorker : public LoadWorker, public IScheduler {
   const size_t num_threads_;
   const bool serial_sequences_;
   std::chrono::steady_clock::time_point& start_time_;
+  // The time the schedule intended the next request to be sent at
+  std::chrono::time_point<std::chrono::system_clock> scheduled_time_;
 
   std::shared_ptr<ThreadConfig> thread_config_;
 
@@ -114,7 +116,8 @@ class RequestRateWorker : public LoadWorker, public IScheduler {
   void HandleExecuteOff();
   void ResetFreeCtxIds();
 
-  // Sleep until it is time for the next part of the schedule
+  // Sleep until it is time for the next part of the schedule, setting
+  // scheduled_time_ to that time
   // Returns true if the request was delayed
   bool SleepIfNecessary();
 
@@ -40,11 +40,13 @@ struct RequestRecord {
       std::vector<std::chrono::time_point<std::chrono::system_clock>>
           response_times,
       bool sequence_end, bool delayed, uint64_t sequence_id,
-      bool has_null_last_response)
+      bool has_null_last_response, size_t model_index = 0,
+      std::chrono::time_point<std::chrono::system_clock> scheduled_time = {})
       : start_time_(start_time), response_times_(response_times),
         sequence_end_(sequence_end), delayed_(delayed),
         sequence_id_(sequence_id),
-        has_null_last_response_(has_null_last_response)
+        has_null_last_response_(has_null_last_response),
+        model_index_(model_index), scheduled_time_(scheduled_time)
   {
   }
   // The timestamp of when the request was started.
@@ -60,6 +62,12 @@ struct RequestRecord {
   uint64_t sequence_id_;
   // Whether the last response is null
   bool has_null_last_response_;
+  // The index of the model of the request in a multi-model workload
+  size_t model_index_{0};
+  // The time the request was intended to be sent at by the schedule of the
+  // load, zero if the load has no schedule (concurrency mode). The request
+  // is sent later than that when the load generator falls behind.
+  std::chrono::time_point<std::chrono::system_clock> scheduled_time_;
 };
 
 }}  // namespace triton::perfanalyzer
@@ -0,0 +1,242 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "resource_usage.h"
+
+#include <dirent.h>
+#include <malloc.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "constants.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+uint64_t
+TimevalToNs(const timeval& tv)
+{
+  return tv.tv_sec * NANOS_PER_SECOND + tv.tv_usec * 1000;
+}
+
+// Read the user and system CPU time of a thread from its stat file
+bool
+ReadThreadCpuNs(const std::string& stat_path, uint64_t* cpu_ns)
+{
+  std::ifstream stat_file(stat_path);
+  std::string stat;
+  if (!std::getline(stat_file, stat)) {
+    return false;
+  }
+  // The thread name in parentheses may contain spaces, the fields after it
+  // start with the state, and utime and stime are the 12th and 13th of them
+  const size_t name_end{stat.rfind(')')};
+  if (name_end == std::string::npos) {
+    return false;
+  }
+  std::istringstream stat_stream(stat.substr(name_end + 1));
+  const std::vector<std::string> fields{
+      std::istream_iterator<std::string>(stat_stream),
+      std::istream_iterator<std::string>()};
+  if (fields.size() < 13) {
+    return false;
+  }
+  static const uint64_t ns_per_tick{
+      NANOS_PER_SECOND / static_cast<uint64_t>(sysconf(_SC_CLK_TCK))};
+  *cpu_ns = (std::stoull(fields[11]) + std::stoull(fields[12])) * ns_per_tick;
+  return true;
+}
+
+void
+SampleThreadCpu(std::map<pid_t, uint64_t>& thread_cpu_ns)
+{
+  thread_cpu_ns.clear();
+  DIR* task_dir{opendir("/proc/self/task")};
+  if (task_dir == nullptr) {
+    return;
+  }
+  while (dirent* entry = readdir(task_dir)) {
+    if (entry->d_name[0] < '0' || entry->d_name[0] > '9') {
+      continue;
+    }
+    uint64_t cpu_ns{0};
+    if (ReadThreadCpuNs(
+            std::string("/proc/self/task/") + entry->d_name + "/stat",
+            &cpu_ns)) {
+      thread_cpu_ns[std::stoi(entry->d_name)] = cpu_ns;
+    }
+  }
+  closedir(task_dir);
+}
+
+uint64_t
+Delta(const uint64_t start, const uint64_t end)
+{
+  return end > start ? end - start : 0;
+}
+
+}  // namespace
+
+cb::Error
+SampleResourceUsage(ResourceUsageSample* sample)
+{
+  sample->timestamp_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return cb::Error("failed to get the resource usage", GENERIC_ERROR);
+  }
+  sample->user_cpu_ns = TimevalToNs(usage.ru_utime);
+  sample->system_cpu_ns = TimevalToNs(usage.ru_stime);
+  sample->voluntary_context_switches = usage.ru_nvcsw;
+  sample->involuntary_context_switches = usage.ru_nivcsw;
+  sample->minor_page_faults = usage.ru_minflt;
+  sample->major_page_faults = usage.ru_majflt;
+
+  // The second field of statm is the number of resident pages
+  std::ifstream statm_file("/proc/self/statm");
+  uint64_t size_pages{0};
+  uint64_t resident_pages{0};
+  if (statm_file >> size_pages >> resident_pages) {
+    sample->rss_bytes = resident_pages * sysconf(_SC_PAGESIZE);
+  } else {
+    // Fall back to the peak resident memory
+    sample->rss_bytes = usage.ru_maxrss * 1024;
+  }
+
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  const struct mallinfo2 heap_info { mallinfo2() };
+  sample->has_heap_stats = true;
+  sample->heap_in_use_bytes = heap_info.uordblks + heap_info.hblkhd;
+#endif
+
+  SampleThreadCpu(sample->thread_cpu_ns);
+  return cb::Error::Success;
+}
+
+ResourceUsageStats
+SummarizeResourceUsage(
+    const ResourceUsageSample& start, const ResourceUsageSample& end)
+{
+  ResourceUsageStats stats;
+  stats.duration_ns = Delta(start.timestamp_ns, end.timestamp_ns);
+  stats.user_cpu_ns = Delta(start.user_cpu_ns, end.user_cpu_ns);
+  stats.system_cpu_ns = Delta(start.system_cpu_ns, end.system_cpu_ns);
+  stats.voluntary_context_switches = Delta(
+      start.voluntary_context_switches, end.voluntary_context_switches);
+  stats.involuntary_context_switches = Delta(
+      start.involuntary_context_switches, end.involuntary_context_switches);
+  stats.minor_page_faults =
+      Delta(start.minor_page_faults, end.minor_page_faults);
+  stats.major_page_faults =
+      Delta(start.major_page_faults, end.major_page_faults);
+  stats.rss_bytes = end.rss_bytes;
+  stats.rss_growth_bytes = static_cast<int64_t>(end.rss_bytes) -
+                           static_cast<int64_t>(start.rss_bytes);
+  stats.has_heap_stats = start.has_heap_stats && end.has_heap_stats;
+  if (stats.has_heap_stats) {
+    stats.heap_growth_bytes = static_cast<int64_t>(end.heap_in_use_bytes) -
+                              static_cast<int64_t>(start.heap_in_use_bytes);
+  }
+
+  if (stats.duration_ns != 0) {
+    stats.cpu_utilization =
+        static_cast<double>(stats.user_cpu_ns + stats.system_cpu_ns) /
+        stats.duration_ns;
+    // A thread started during the period used all of its CPU time in it
+    uint64_t max_thread_cpu_ns{0};
+    for (const auto& thread : end.thread_cpu_ns) {
+      const auto start_thread{start.thread_cpu_ns.find(thread.first)};
+      const uint64_t start_cpu_ns{
+          start_thread == start.thread_cpu_ns.end() ? 0
+                                                    : start_thread->second};
+      max_thread_cpu_ns =
+          std::max(max_thread_cpu_ns, Delta(start_cpu_ns, thread.second));
+    }
+    stats.max_thread_cpu_utilization =
+        static_cast<double>(max_thread_cpu_ns) / stats.duration_ns;
+  }
+  return stats;
+}
+
+void
+AccumulateResourceUsage(
+    const ResourceUsageStats& period, ResourceUsageStats* total)
+{
+  total->duration_ns += period.duration_ns;
+  total->user_cpu_ns += period.user_cpu_ns;
+  total->system_cpu_ns += period.system_cpu_ns;
+  total->voluntary_context_switches += period.voluntary_context_switches;
+  total->involuntary_context_switches += period.involuntary_context_switches;
+  total->minor_page_faults += period.minor_page_faults;
+  total->major_page_faults += period.major_page_faults;
+  total->rss_bytes = period.rss_bytes;
+  total->rss_growth_bytes += period.rss_growth_bytes;
+  total->has_heap_stats = period.has_heap_stats;
+  total->heap_growth_bytes += period.heap_growth_bytes;
+  if (total->duration_ns != 0) {
+    total->cpu_utilization =
+        static_cast<double>(total->user_cpu_ns + total->system_cpu_ns) /
+        total->duration_ns;
+  }
+  total->max_thread_cpu_utilization = std::max(
+      total->max_thread_cpu_utilization, period.max_thread_cpu_utilization);
+}
+
+size_t
+AvailableCpuCount()
+{
+  cpu_set_t cpu_set;
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    return CPU_COUNT(&cpu_set);
+  }
+  const long cpu_count{sysconf(_SC_NPROCESSORS_ONLN)};
+  return cpu_count > 0 ? cpu_count : 1;
+}
+
+bool
+IsCpuSaturated(const ResourceUsageStats& stats, const size_t cpu_count)
+{
+  return stats.cpu_utilization >= kCpuSaturationThreshold * cpu_count ||
+         stats.max_thread_cpu_utilization >= kCpuSaturationThreshold;
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,105 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <map>
+
+#include "client_backend/client_backend.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// The fraction of the available CPU cores, or of one core for a single
+/// thread, above which perf_analyzer is considered to be CPU bound.
+constexpr double kCpuSaturationThreshold{0.9};
+
+/// The resources used by perf_analyzer since its start at a point in time.
+struct ResourceUsageSample {
+  // The time of the sample from a steady clock
+  uint64_t timestamp_ns{0};
+  uint64_t user_cpu_ns{0};
+  uint64_t system_cpu_ns{0};
+  uint64_t voluntary_context_switches{0};
+  uint64_t involuntary_context_switches{0};
+  uint64_t minor_page_faults{0};
+  uint64_t major_page_faults{0};
+  uint64_t rss_bytes{0};
+  // The bytes allocated from the heap, when the allocator provides them
+  bool has_heap_stats{false};
+  uint64_t heap_in_use_bytes{0};
+  // The user and system CPU time of each thread of the process by thread id
+  std::map<pid_t, uint64_t> thread_cpu_ns{};
+};
+
+/// The resources used by perf_analyzer over a period of time, such as a
+/// measurement window.
+struct ResourceUsageStats {
+  uint64_t duration_ns{0};
+  // The CPU time used on average over the period, in number of cores
+  double cpu_utilization{0.0};
+  // The CPU time used by the busiest thread, as a fraction of one core
+  double max_thread_cpu_utilization{0.0};
+  uint64_t user_cpu_ns{0};
+  uint64_t system_cpu_ns{0};
+  uint64_t voluntary_context_switches{0};
+  uint64_t involuntary_context_switches{0};
+  uint64_t minor_page_faults{0};
+  uint64_t major_page_faults{0};
+  // The resident memory at the end of the period and its growth over it
+  uint64_t rss_bytes{0};
+  int64_t rss_growth_bytes{0};
+  // The growth of the bytes allocated from the heap, when the allocator
+  // provides them
+  bool has_heap_stats{false};
+  int64_t heap_growth_bytes{0};
+};
+
+/// Sample the resources used by perf_analyzer from getrusage(2) and
+/// /proc/self.
+/// \param sample Returns the sample.
+/// \return cb::Error object indicating success or failure.
+cb::Error SampleResourceUsage(ResourceUsageSample* sample);
+
+/// \return The resources used between the samples 'start' and 'end'.
+ResourceUsageStats SummarizeResourceUsage(
+    const ResourceUsageSample& start, const ResourceUsageSample& end);
+
+/// Add the resources used over a period to 'total', the resources used over
+/// the periods before it.
+void AccumulateResourceUsage(
+    const ResourceUsageStats& period, ResourceUsageStats* total);
+
+/// \return The number of CPU cores perf_analyzer is allowed to run on.
+size_t AvailableCpuCount();
+
+/// \return Whether perf_analyzer used almost all of the 'cpu_count' cores it
+/// can run on, or its busiest thread almost a whole core, during 'stats'.
+bool IsCpuSaturated(const ResourceUsageStats& stats, const size_t cpu_count);
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,217 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "arrival_process.h"
+#include "doctest.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// Draw 'duration' worth of requests from 'distribution' and return their
+// stats, counting them in 1 sec windows
+ScheduleStats
+DrawSchedule(
+    std::function<std::chrono::nanoseconds(std::mt19937&)> distribution,
+    const std::chrono::seconds duration, const double request_rate)
+{
+  std::mt19937 gen;
+  ScheduleStatsCollector collector(
+      std::chrono::seconds(1),
+      std::chrono::nanoseconds(
+          static_cast<uint64_t>(0.1 * NANOS_PER_SECOND / request_rate)));
+  std::chrono::nanoseconds timestamp{0};
+  while (timestamp < duration) {
+    const auto interval{distribution(gen)};
+    timestamp += interval;
+    collector.Add(interval);
+  }
+  return collector.Stats();
+}
+
+}  // namespace
+
+TEST_CASE("arrival_process: mean rate and burstiness")
+{
+  const double request_rate{1000.0};
+  const std::chrono::seconds duration{1000};
+  const double expected_requests{request_rate * duration.count()};
+  ArrivalProcessOptions options{};
+
+  SUBCASE("poisson")
+  {
+    const ScheduleStats stats{DrawSchedule(
+        ScheduleDistribution<Distribution::POISSON>(request_rate), duration,
+        request_rate)};
+    CHECK(stats.requests_ == doctest::Approx(expected_requests).epsilon(0.01));
+    CHECK(stats.interval_cv_ == doctest::Approx(1.0).epsilon(0.02));
+    CHECK(stats.count_dispersion_ == doctest::Approx(1.0).epsilon(0.2));
+  }
+
+  SUBCASE("gamma")
+  {
+    options.gamma_cv_ = 4.0;
+    std::shared_ptr<ArrivalProcess> process;
+    REQUIRE(CreateArrivalProcess(
+                Distribution::GAMMA, request_rate, options, &process)
+                .IsOk());
+    const ScheduleStats stats{DrawSchedule(
+        ArrivalProcessDistribution(process), duration, request_rate)};
+    CHECK(stats.requests_ == doctest::Approx(expected_requests).epsilon(0.05));
+    CHECK(stats.interval_cv_ == doctest::Approx(4.0).epsilon(0.1));
+    CHECK(stats.count_dispersion_ > 4.0);
+  }
+
+  SUBCASE("markov modulated")
+  {
+    options.mmpp_burst_ratio_ = 20.0;
+    options.mmpp_burst_ms_ = 100.0;
+    options.mmpp_idle_ms_ = 900.0;
+    std::shared_ptr<ArrivalProcess> process;
+    REQUIRE(CreateArrivalProcess(
+                Distribution::MMPP, request_rate, options, &process)
+                .IsOk());
+    const ScheduleStats stats{DrawSchedule(
+        ArrivalProcessDistribution(process), duration, request_rate)};
+    CHECK(stats.requests_ == doctest::Approx(expected_requests).epsilon(0.05));
+    CHECK(stats.interval_cv_ > 1.5);
+    CHECK(stats.count_dispersion_ > 10.0);
+    CHECK(stats.peak_to_mean_ > 2.0);
+  }
+
+  SUBCASE("pareto on-off")
+  {
+    // A lighter tail than the default for the mean to converge quickly
+    options.pareto_alpha_ = 2.5;
+    options.pareto_on_ms_ = 100.0;
+    options.pareto_off_ms_ = 400.0;
+    std::shared_ptr<ArrivalProcess> process;
+    REQUIRE(CreateArrivalProcess(
+                Distribution::PARETO_ON_OFF, request_rate, options, &process)
+                .IsOk());
+    const ScheduleStats stats{DrawSchedule(
+        ArrivalProcessDistribution(process), duration, request_rate)};
+    CHECK(stats.requests_ == doctest::Approx(expected_requests).epsilon(0.1));
+    CHECK(stats.interval_cv_ > 1.5);
+    CHECK(stats.count_dispersion_ > 10.0);
+    CHECK(stats.longest_burst_ > 1);
+  }
+
+  SUBCASE("no arrival process")
+  {
+    std::shared_ptr<ArrivalProcess> process;
+    CHECK_FALSE(CreateArrivalProcess(
+                    Distribution::POISSON, request_rate, options, &process)
+                    .IsOk());
+    CHECK_FALSE(
+        CreateArrivalProcess(Distribution::GAMMA, 0.0, options, &process)
+            .IsOk());
+  }
+}
+
+TEST_CASE("arrival_process: schedule stats")
+{
+  ScheduleStatsCollector collector(
+      std::chrono::milliseconds(100), std::chrono::milliseconds(5));
+
+  // 10 evenly spaced requests in the first window, a burst of 5 requests 1
+  // msec apart, nothing in the third window and one request in the fourth
+  for (int i = 0; i < 10; i++) {
+    collector.Add(std::chrono::milliseconds(10));
+  }
+  for (int i = 0; i < 5; i++) {
+    collector.Add(std::chrono::milliseconds(1));
+  }
+  collector.Add(std::chrono::milliseconds(200));
+
+  const ScheduleStats stats{collector.Stats()};
+  CHECK(stats.requests_ == 16);
+  CHECK(stats.window_ms_ == 100);
+  // The windows of 9, 6 and 0 requests are over, the last one is not
+  CHECK(stats.count_dispersion_ == doctest::Approx(14.0 / 5.0));
+  CHECK(stats.peak_to_mean_ == doctest::Approx(9.0 / 5.0));
+  CHECK(stats.longest_burst_ == 6);
+  CHECK(stats.interval_cv_ > 1.0);
+}
+
+TEST_CASE("arrival_process: parse options")
+{
+  ArrivalProcessOptions options{};
+
+  SUBCASE("list")
+  {
+    REQUIRE(ParseArrivalProcessOptions(
+                "cv=8,burst_ratio=20,burst_ms=50,idle_ms=450,alpha=1.2,"
+                "on_ms=10,off_ms=90",
+                &options)
+                .IsOk());
+    CHECK(options.gamma_cv_ == doctest::Approx(8));
+    CHECK(options.mmpp_burst_ratio_ == doctest::Approx(20));
+    CHECK(options.mmpp_burst_ms_ == doctest::Approx(50));
+    CHECK(options.mmpp_idle_ms_ == doctest::Approx(450));
+    CHECK(options.pareto_alpha_ == doctest::Approx(1.2));
+    CHECK(options.pareto_on_ms_ == doctest::Approx(10));
+    CHECK(options.pareto_off_ms_ == doctest::Approx(90));
+  }
+
+  SUBCASE("defaults are kept")
+  {
+    REQUIRE(ParseArrivalProcessOptions("cv=2", &options).IsOk());
+    CHECK(options.gamma_cv_ == doctest::Approx(2));
+    CHECK(options.mmpp_burst_ratio_ == doctest::Approx(10));
+  }
+
+  SUBCASE("json")
+  {
+    rapidjson::Document d{};
+    d.Parse(R"({"burst_ratio": 5, "burst_ms": 20})");
+    REQUIRE(ParseArrivalProcessJson(d, &options).IsOk());
+    CHECK(options.mmpp_burst_ratio_ == doctest::Approx(5));
+    CHECK(options.mmpp_burst_ms_ == doctest::Approx(20));
+
+    d.Parse(R"({"burst_ratio": "high"})");
+    CHECK_FALSE(ParseArrivalProcessJson(d, &options).IsOk());
+  }
+
+  SUBCASE("invalid")
+  {
+    CHECK_FALSE(ParseArrivalProcessOptions("cv", &options).IsOk());
+    CHECK_FALSE(ParseArrivalProcessOptions("cv=", &options).IsOk());
+    CHECK_FALSE(ParseArrivalProcessOptions("cv=2x", &options).IsOk());
+    CHECK_FALSE(ParseArrivalProcessOptions("cv=0", &options).IsOk());
+    CHECK_FALSE(ParseArrivalProcessOptions("burst_ratio=0.5", &options).IsOk());
+    CHECK_FALSE(ParseArrivalProcessOptions("alpha=1", &options).IsOk());
+    CHECK_FALSE(ParseArrivalProcessOptions("off_ms=-1", &options).IsOk());
+    CHECK_FALSE(ParseArrivalProcessOptions("rate=10", &options).IsOk());
+  }
+}
+
+}}  // namespace triton::perfanalyzer
@@ -25,8 +25,11 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //
 #include <getopt.h>
+#include <unistd.h>
 
 #include <array>
+#include <cstdio>
+#include <cstdlib>
 
 #include "command_line_parser.h"
 #include "doctest.h"
@@ -113,14 +116,60 @@ CHECK_PARAMS(PAParamsPtr act, PAParamsPtr exp)
   CHECK(act->num_of_sequences == exp->num_of_sequences);
   CHECK(act->search_mode == exp->search_mode);
   CHECK(act->request_distribution == exp->request_distribution);
+  CHECK(
+      act->arrival_process_options.gamma_cv_ ==
+      exp->arrival_process_options.gamma_cv_);
+  CHECK(
+      act->arrival_process_options.mmpp_burst_ratio_ ==
+      exp->arrival_process_options.mmpp_burst_ratio_);
+  CHECK(
+      act->arrival_process_options.pareto_alpha_ ==
+      exp->arrival_process_options.pareto_alpha_);
   CHECK(act->using_custom_intervals == exp->using_custom_intervals);
   CHECK_STRING(act->request_intervals_file, exp->request_intervals_file);
+  CHECK_STRING(
+      act->request_rate_profile_file, exp->request_rate_profile_file);
+  CHECK(act->max_inflight == exp->max_inflight);
+  CHECK(act->inflight_limit_policy == exp->inflight_limit_policy);
+  CHECK(act->inflight_queue_timeout_ms == exp->inflight_queue_timeout_ms);
   CHECK(act->shared_memory_type == exp->shared_memory_type);
   CHECK(act->output_shm_size == exp->output_shm_size);
   CHECK(act->kind == exp->kind);
   CHECK_STRING(act->model_signature_name, exp->model_signature_name);
   CHECK(act->using_grpc_compression == exp->using_grpc_compression);
   CHECK(act->compression_algorithm == exp->compression_algorithm);
+  CHECK(act->using_http_compression == exp->using_http_compression);
+  CHECK(
+      act->compression_options.http_compression_algorithm ==
+      exp->compression_options.http_compression_algorithm);
+  CHECK(act->compression_options.level == exp->compression_options.level);
+  CHECK(
+      act->compression_options.min_byte_size ==
+      exp->compression_options.min_byte_size);
+  CHECK(
+      act->compression_options.min_ratio == exp->compression_options.min_ratio);
+  CHECK(
+      act->response_cache_options.max_byte_size ==
+      exp->response_cache_options.max_byte_size);
+  CHECK(
+      act->response_cache_options.ttl_ms ==
+      exp->response_cache_options.ttl_ms);
+  CHECK(
+      act->null_service_options.latency_distribution ==
+      exp->null_service_options.latency_distribution);
+  CHECK(
+      act->null_service_options.latency_us ==
+      exp->null_service_options.latency_us);
+  CHECK(
+      act->null_service_options.latency_spread_us ==
+      exp->null_service_options.latency_spread_us);
+  CHECK(
+      act->null_service_options.decoupled ==
+      exp->null_service_options.decoupled);
+  CHECK(
+      act->null_service_options.response_count ==
+      exp->null_service_options.response_count);
+  CHECK(act->shared_client_backends == exp->shared_client_backends);
   CHECK(act->measurement_mode == exp->measurement_mode);
   CHECK(act->measurement_request_count == exp->measurement_request_count);
   CHECK_STRING(act->triton_server_path, exp->triton_server_path);
@@ -167,6 +216,14 @@ CHECK_PARAMS(PAParamsPtr act, PAParamsPtr exp)
   CHECK_STRING(act->url, exp->url);
   CHECK_STRING(act->model_name, exp->model_name);
   CHECK_STRING(act->model_version, exp->model_version);
+  CHECK_STRING(act->workload_file, exp->workload_file);
+  CHECK_STRING(act->timeline_file, exp->timeline_file);
+  CHECK(act->timeline_interval_ms == exp->timeline_interval_ms);
+  CHECK(act->live_metrics_port == exp->live_metrics_port);
+  CHECK(act->warmup_duration_ms == exp->warmup_duration_ms);
+  CHECK(act->warmup_request_count == exp->warmup_request_count);
+  CHECK(act->cpu_affinity == exp->cpu_affinity);
+  CHECK(act->numa_node == exp->numa_node);
   CHECK(act->batch_size == exp->batch_size);
   CHECK(act->using_batch_size == exp->using_batch_size);
   CHECK(act->concurrent_request_count == exp->concurrent_request_count);
@@ -286,6 +343,11 @@ TEST_CASE("Testing PerfAnalyzerParameters")
   CHECK(params->request_distribution == Distribution::CONSTANT);
   CHECK(params->using_custom_intervals == false);
   CHECK_STRING("request_intervals_file", params->request_intervals_file, "");
+  CHECK_STRING(
+      "request_rate_profile_file", params->request_rate_profile_file, "");
+  CHECK(params->max_inflight == 0);
+  CHECK(params->inflight_limit_policy == InflightLimitPolicy::QUEUE);
+  CHECK(params->inflight_queue_timeout_ms == 0);
   CHECK(params->shared_memory_type == NO_SHARED_MEMORY);
   CHECK(params->output_shm_size == 102400);
   CHECK(params->kind == clientbackend::BackendKind::TRITON);
@@ -295,6 +357,16 @@ TEST_CASE("Testing PerfAnalyzerParameters")
   CHECK(
       params->compression_algorithm ==
       clientbackend::GrpcCompressionAlgorithm::COMPRESS_NONE);
+  CHECK(params->using_http_compression == false);
+  CHECK(
+      params->compression_options.http_compression_algorithm ==
+      clientbackend::HTTP_COMPRESS_NONE);
+  CHECK(params->compression_options.level == 0);
+  CHECK(params->compression_options.min_byte_size == 0);
+  CHECK(params->compression_options.min_ratio == 0.0);
+  CHECK(params->response_cache_options.max_byte_size == 0);
+  CHECK(params->response_cache_options.ttl_ms == 0);
+  CHECK(params->shared_client_backends == 0);
   CHECK(params->measurement_mode == MeasurementMode::TIME_WINDOWS);
   CHECK(params->measurement_request_count == 50);
   CHECK_STRING(
@@ -338,6 +410,14 @@ TEST_CASE("Testing PerfAnalyzerParameters")
   CHECK_STRING("url", params->url, "localhost:8000");
   CHECK_STRING("model_name", params->model_name, "");
   CHECK_STRING("model_version", params->model_version, "");
+  CHECK_STRING("workload_file", params->workload_file, "");
+  CHECK_STRING("timeline_file", params->timeline_file, "");
+  CHECK(params->timeline_interval_ms == 1000);
+  CHECK(params->live_metrics_port == 0);
+  CHECK(params->warmup_duration_ms == 0);
+  CHECK(params->warmup_request_count == 0);
+  CHECK(params->cpu_affinity.empty());
+  CHECK(params->numa_node == -1);
   CHECK(params->batch_size == 1);
   CHECK(params->using_batch_size == false);
   CHECK(params->concurrent_request_count == 1);
@@ -1485,6 +1565,21 @@ TEST_CASE("Testing Command Line Parser")
 
       check_params = false;
     }
+
+    SUBCASE("with unix domain socket url")
+    {
+      int argc = 6;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--collect-metrics", "-u",
+          "unix:/tmp/triton.sock"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->url_specified = true;
+      exp->url = "unix:/tmp/triton.sock";
+      CHECK_STRING(act->metrics_url, "localhost:8002/metrics");
+    }
   }
 
   SUBCASE("Option : --metrics-url")
@@ -1536,6 +1631,689 @@ TEST_CASE("Testing Command Line Parser")
     }
   }
 
+  SUBCASE("Option : --http-compression-algorithm")
+  {
+    SUBCASE("with adaptive options")
+    {
+      int argc = 11;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--http-compression-algorithm",
+                          "zstd",
+                          "--compression-level",
+                          "3",
+                          "--compression-threshold",
+                          "4096",
+                          "--compression-min-ratio",
+                          "1.5"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->using_http_compression = true;
+      exp->compression_options.http_compression_algorithm =
+          cb::HTTP_COMPRESS_ZSTD;
+      exp->compression_options.level = 3;
+      exp->compression_options.min_byte_size = 4096;
+      exp->compression_options.min_ratio = 1.5;
+    }
+
+    SUBCASE("unsupported algorithm")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--http-compression-algorithm", "brotli"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --http-compression-algorithm. Unsupported type "
+          "provided: 'brotli'. The available options are 'gzip', 'deflate', "
+          "'zstd', 'lz4', or 'none'.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    SUBCASE("with grpc protocol")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name, "-m", model_name, "-i", "grpc",
+                          "--http-compression-algorithm", "gzip"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Using HTTP compression algorithm is only allowed with HTTP "
+          "protocol.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    SUBCASE("missing --http-compression-algorithm")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--compression-min-ratio", "2"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Must specify --http-compression-algorithm when using the "
+          "--compression-level or --compression-min-ratio option.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --response-cache-size")
+  {
+    SUBCASE("with ttl")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--response-cache-size",
+                          "1048576",
+                          "--response-cache-ttl",
+                          "500"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->response_cache_options.max_byte_size = 1048576;
+      exp->response_cache_options.ttl_ms = 500;
+    }
+
+    SUBCASE("negative size")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--response-cache-size", "-1"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --response-cache-size. The value must be >= 0.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    SUBCASE("missing --response-cache-size")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--response-cache-ttl", "500"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Must specify --response-cache-size when using the "
+          "--response-cache-ttl option.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --service-kind=null")
+  {
+    SUBCASE("normal latency")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--service-kind",
+                          "null",
+                          "--null-latency",
+                          "normal:500:100"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->kind = cb::BackendKind::NULL_SERVICE;
+      exp->protocol = cb::ProtocolType::UNKNOWN;
+      exp->null_service_options.latency_distribution =
+          cb::NullServiceOptions::LatencyDistribution::NORMAL;
+      exp->null_service_options.latency_us = 500;
+      exp->null_service_options.latency_spread_us = 100;
+    }
+
+    SUBCASE("decoupled")
+    {
+      int argc = 8;
+      char* argv[argc] = {app_name,      "-m",
+                          model_name,    "--service-kind",
+                          "null",        "--null-response-count",
+                          "4",           "--streaming"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->kind = cb::BackendKind::NULL_SERVICE;
+      exp->protocol = cb::ProtocolType::UNKNOWN;
+      exp->streaming = true;
+      exp->null_service_options.decoupled = true;
+      exp->null_service_options.response_count = 4;
+    }
+
+    SUBCASE("spread with exponential latency")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--service-kind",
+                          "null",
+                          "--null-latency",
+                          "exponential:500:100"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --null-latency. Only the uniform and normal "
+          "distributions take a <spread_us> value.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    SUBCASE("decoupled without streaming")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,       "-m", model_name,
+                          "--service-kind", "null", "--null-response-count",
+                          "4"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Must specify --streaming when using the --null-response-count "
+          "option.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --shared-client-backends")
+  {
+    SUBCASE("async")
+    {
+      int argc = 6;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--shared-client-backends", "4", "-a"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->async = true;
+      exp->shared_client_backends = 4;
+    }
+
+    SUBCASE("negative count")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--shared-client-backends", "-1"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --shared-client-backends. The value must be >= 0.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    SUBCASE("sync")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name, "-m", model_name,
+                          "--shared-client-backends", "4", "--sync"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Cannot specify --shared-client-backends and --sync "
+          "simultaneously.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --request-distribution")
+  {
+    SUBCASE("bursty distribution with params")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--request-distribution",
+                          "mmpp",
+                          "--request-distribution-params",
+                          "burst_ratio=20,alpha=1.2"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->request_distribution = Distribution::MMPP;
+      exp->arrival_process_options.mmpp_burst_ratio_ = 20;
+      exp->arrival_process_options.pareto_alpha_ = 1.2;
+    }
+
+    SUBCASE("unknown distribution")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--request-distribution", "weibull"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --request-distribution. Unsupported type provided: "
+          "'weibull'. Choices are 'poisson', 'constant', 'gamma', 'mmpp' or "
+          "'pareto-on-off'.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    SUBCASE("invalid params")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--request-distribution-params",
+          "alpha=0.5"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --request-distribution-params. alpha must be > 1.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --max-inflight")
+  {
+    SUBCASE("queue with timeout")
+    {
+      int argc = 9;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--request-rate-range",
+                          "100",
+                          "--max-inflight",
+                          "32",
+                          "--inflight-queue-timeout",
+                          "50"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->using_request_rate_range = true;
+      exp->request_rate_range[SEARCH_RANGE::kSTART] = 100;
+      exp->max_threads = 4;
+      exp->max_inflight = 32;
+      exp->inflight_queue_timeout_ms = 50;
+    }
+
+    SUBCASE("drop")
+    {
+      int argc = 9;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--request-rate-range",
+                          "100",
+                          "--max-inflight",
+                          "32",
+                          "--inflight-limit-policy",
+                          "drop"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->using_request_rate_range = true;
+      exp->request_rate_range[SEARCH_RANGE::kSTART] = 100;
+      exp->max_threads = 4;
+      exp->max_inflight = 32;
+      exp->inflight_limit_policy = InflightLimitPolicy::DROP;
+    }
+
+    SUBCASE("zero")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name, "-m", model_name, "--request-rate-range",
+                          "100",    "--max-inflight", "0"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --max-inflight. The value must be > 0.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    SUBCASE("unknown policy")
+    {
+      int argc = 9;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--request-rate-range",
+                          "100",
+                          "--max-inflight",
+                          "32",
+                          "--inflight-limit-policy",
+                          "reject"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --inflight-limit-policy. Unsupported type "
+          "provided: 'reject'. Choices are 'queue' or 'drop'.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    SUBCASE("concurrency mode")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--max-inflight", "32"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "--max-inflight can only be used in request rate mode, with "
+          "--request-rate-range, --request-intervals or "
+          "--request-rate-profile.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --request-rate-profile")
+  {
+    char profile_path[] = "/tmp/pa_load_profile_XXXXXX";
+    const int profile_fd{mkstemp(profile_path)};
+    REQUIRE(profile_fd != -1);
+    close(profile_fd);
+
+    SUBCASE("valid file")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--request-rate-profile", profile_path};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->request_rate_profile_file = profile_path;
+      exp->using_request_rate_range = true;
+      exp->max_threads = 4;
+    }
+
+    SUBCASE("missing file")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--request-rate-profile",
+          "/tmp/pa_missing_load_profile.json"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --request-rate-profile. The value must be a valid "
+          "file path",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    SUBCASE("with request rate range")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--request-rate-profile",
+                          profile_path,
+                          "--request-rate-range",
+                          "10:20:5"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Cannot use --request-rate-range along with --request-rate-profile.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    std::remove(profile_path);
+  }
+
+  SUBCASE("Option : --workload-file")
+  {
+    SUBCASE("without -m")
+    {
+      int argc = 3;
+      char* argv[argc] = {app_name, "--workload-file", "workload.json"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->model_name = "";
+      exp->workload_file = "workload.json";
+    }
+
+    SUBCASE("with -m")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--workload-file", "workload.json"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Cannot specify -m and --workload-file simultaneously.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    SUBCASE("with input data")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "--workload-file", "workload.json", "--data-directory",
+          "/usr/data"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Cannot specify --input-data and --workload-file simultaneously. "
+          "Specify the input data of each model in the workload file.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    SUBCASE("with shared memory")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "--workload-file", "workload.json", "--shared-memory",
+          "system"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Shared memory is not supported with --workload-file.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --timeline-file")
+  {
+    SUBCASE("default interval")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--timeline-file", "timeline.csv"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->timeline_file = "timeline.csv";
+    }
+
+    SUBCASE("with interval")
+    {
+      int argc = 7;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--timeline-file", "timeline.csv",
+          "--timeline-interval", "100"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->timeline_file = "timeline.csv";
+      exp->timeline_interval_ms = 100;
+    }
+
+    SUBCASE("zero interval")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--timeline-interval", "0"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --timeline-interval. The value must be > 0.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --warmup-duration")
+  {
+    SUBCASE("with request count")
+    {
+      int argc = 7;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--warmup-duration", "2000",
+          "--warmup-request-count", "100"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->warmup_duration_ms = 2000;
+      exp->warmup_request_count = 100;
+    }
+
+    SUBCASE("negative duration")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--warmup-duration", "-1"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --warmup-duration. The value must be >= 0.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    SUBCASE("negative request count")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--warmup-request-count", "-1"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --warmup-request-count. The value must be >= 0.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --live-metrics-port")
+  {
+    SUBCASE("valid port")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--live-metrics-port", "9100"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->live_metrics_port = 9100;
+    }
+
+    SUBCASE("out of range port")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--live-metrics-port", "65536"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --live-metrics-port. The value must be between 1 "
+          "and 65535.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --cpu-affinity")
+  {
+    SUBCASE("with NUMA node")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,         "-m",    model_name,
+                          "--cpu-affinity", "0-2,8", "--numa-node",
+                          "1"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->cpu_affinity = {0, 1, 2, 8};
+      exp->numa_node = 1;
+    }
+
+    SUBCASE("invalid range")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--cpu-affinity", "3-1"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --cpu-affinity. invalid CPU core or range '3-1' in "
+          "'3-1'.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+
+    SUBCASE("negative NUMA node")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--numa-node", "-1"};
+
+      CHECK_THROWS_WITH_AS(
+          act = parser.Parse(argc, argv),
+          "Failed to parse --numa-node. The value must be >= 0.",
+          PerfAnalyzerException);
+
+      check_params = false;
+    }
+  }
+
   SUBCASE("Option : --bls-composing-models")
   {
     int argc = 5;
@@ -0,0 +1,131 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cpu_affinity.h"
+#include "doctest.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("cpu_affinity: parse and format CPU lists")
+{
+  std::vector<int> cpus;
+
+  SUBCASE("cores and ranges")
+  {
+    REQUIRE(ParseCpuList("8,0-3,10-11,2", &cpus).IsOk());
+    CHECK(cpus == std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+    CHECK(FormatCpuList(cpus) == "0-3,8,10-11");
+  }
+
+  SUBCASE("single core")
+  {
+    REQUIRE(ParseCpuList("5", &cpus).IsOk());
+    CHECK(cpus == std::vector<int>{5});
+    CHECK(FormatCpuList(cpus) == "5");
+  }
+
+  SUBCASE("invalid lists")
+  {
+    CHECK_FALSE(ParseCpuList("", &cpus).IsOk());
+    CHECK_FALSE(ParseCpuList("a", &cpus).IsOk());
+    CHECK_FALSE(ParseCpuList("-1", &cpus).IsOk());
+    CHECK_FALSE(ParseCpuList("3-1", &cpus).IsOk());
+    CHECK_FALSE(ParseCpuList("0,,1", &cpus).IsOk());
+    CHECK_FALSE(ParseCpuList("0-", &cpus).IsOk());
+    CHECK_FALSE(ParseCpuList("99999999", &cpus).IsOk());
+  }
+}
+
+TEST_CASE("cpu_affinity: NUMA node CPUs")
+{
+  char node_dir_template[] = "/tmp/pa_numa_XXXXXX";
+  REQUIRE(mkdtemp(node_dir_template) != nullptr);
+  const std::string node_dir{node_dir_template};
+  REQUIRE(mkdir((node_dir + "/node1").c_str(), 0700) == 0);
+  std::ofstream(node_dir + "/node1/cpulist") << "4-7,12\n";
+
+  std::vector<int> cpus;
+  REQUIRE(GetNumaNodeCpus(1, &cpus, node_dir).IsOk());
+  CHECK(cpus == std::vector<int>{4, 5, 6, 7, 12});
+  CHECK_FALSE(GetNumaNodeCpus(0, &cpus, node_dir).IsOk());
+
+  std::remove((node_dir + "/node1/cpulist").c_str());
+  rmdir((node_dir + "/node1").c_str());
+  rmdir(node_dir.c_str());
+}
+
+TEST_CASE("cpu_affinity: pin a thread")
+{
+  cpu_set_t allowed;
+  REQUIRE(sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+  int allowed_cpu{0};
+  while (!CPU_ISSET(allowed_cpu, &allowed)) {
+    ++allowed_cpu;
+  }
+
+  // Pin a separate thread so the placement doesn't leak into the other tests
+  std::thread thread([allowed_cpu]() {
+    std::vector<int> placed_cpus;
+    REQUIRE(SetCpuPlacement({allowed_cpu}, -1, &placed_cpus).IsOk());
+    CHECK(placed_cpus == std::vector<int>{allowed_cpu});
+
+    cpu_set_t pinned;
+    REQUIRE(
+        pthread_getaffinity_np(pthread_self(), sizeof(pinned), &pinned) == 0);
+    CHECK(CPU_COUNT(&pinned) == 1);
+    CHECK(CPU_ISSET(allowed_cpu, &pinned));
+
+    // Threads created afterwards inherit the placement
+    std::thread child([allowed_cpu]() {
+      cpu_set_t inherited;
+      REQUIRE(
+          pthread_getaffinity_np(
+              pthread_self(), sizeof(inherited), &inherited) == 0);
+      CHECK(CPU_COUNT(&inherited) == 1);
+      CHECK(CPU_ISSET(allowed_cpu, &inherited));
+    });
+    child.join();
+
+    // No placement is requested
+    REQUIRE(SetCpuPlacement({}, -1, &placed_cpus).IsOk());
+    CHECK(placed_cpus.empty());
+  });
+  thread.join();
+}
+
+}}  // namespace triton::perfanalyzer
@@ -26,6 +26,7 @@
 
 #include "data_loader.h"
 #include "doctest.h"
+#include "convert_utils.h"
 #include "mock_data_loader.h"
 
 namespace triton { namespace perfanalyzer {
@@ -513,6 +514,50 @@ TEST_CASE("dataloader: ParseData: Valid Data")
   CHECK_EQ(data.batch1_size, 4);
 }
 
+TEST_CASE(
+    "dataloader: ParseData: FP16 and BF16 content" *
+    doctest::description(
+        "Explicit FP16 and BF16 tensors are converted from the JSON numbers"))
+{
+  std::string json_str = R"({
+   "data": [
+     { "INPUT1": [1.0, -2.5, 0.1], "INPUT2": [1.0, -2.5, 0.1] }
+   ]})";
+
+  MockDataLoader dataloader;
+  std::shared_ptr<ModelTensorMap> inputs = std::make_shared<ModelTensorMap>();
+  std::shared_ptr<ModelTensorMap> outputs = std::make_shared<ModelTensorMap>();
+
+  ModelTensor input1 = TestDataLoader::CreateTensor("INPUT1");
+  input1.datatype_ = "FP16";
+  input1.shape_ = {3};
+  ModelTensor input2 = TestDataLoader::CreateTensor("INPUT2");
+  input2.datatype_ = "BF16";
+  input2.shape_ = {3};
+  inputs->insert(std::make_pair(input1.name_, input1));
+  inputs->insert(std::make_pair(input2.name_, input2));
+
+  cb::Error status = dataloader.ReadDataFromStr(json_str, inputs, outputs);
+  REQUIRE(status.IsOk());
+
+  TensorData data;
+  status = dataloader.GetInputData(input1, 0, 0, data);
+  REQUIRE(status.IsOk());
+  REQUIRE_EQ(data.batch1_size, 6);
+  const uint16_t* fp16_data = reinterpret_cast<const uint16_t*>(data.data_ptr);
+  CHECK_EQ(fp16_data[0], 0x3c00);
+  CHECK_EQ(fp16_data[1], 0xc100);
+  CHECK_EQ(fp16_data[2], 0x2e66);
+
+  status = dataloader.GetInputData(input2, 0, 0, data);
+  REQUIRE(status.IsOk());
+  REQUIRE_EQ(data.batch1_size, 6);
+  const uint16_t* bf16_data = reinterpret_cast<const uint16_t*>(data.data_ptr);
+  CHECK_EQ(bf16_data[0], 0x3f80);
+  CHECK_EQ(bf16_data[1], 0xc020);
+  CHECK_EQ(bf16_data[2], 0x3dcd);
+}
+
 TEST_CASE("dataloader: ParseData: Multiple Streams Invalid Cases")
 {
   // Mismatch because one stream with wrong number of steps
@@ -1097,6 +1142,54 @@ TEST_CASE(
   }
 }
 
+TEST_CASE(
+    "dataloader: GenerateData: FP16 and BF16" *
+    doctest::description(
+        "Calling GenerateData for FP16 or BF16 datatype without the zero input "
+        "flag should result in random values in [0, 1], never NaN or "
+        "infinity"))
+{
+  std::string datatype;
+  SUBCASE("FP16")
+  {
+    datatype = "FP16";
+  }
+  SUBCASE("BF16")
+  {
+    datatype = "BF16";
+  }
+
+  MockDataLoader dataloader;
+  std::shared_ptr<ModelTensorMap> inputs = std::make_shared<ModelTensorMap>();
+
+  ModelTensor input1 = TestDataLoader::CreateTensor("INPUT1");
+  input1.datatype_ = datatype;
+  input1.shape_ = {64};
+  inputs->insert(std::make_pair(input1.name_, input1));
+
+  cb::Error status = dataloader.GenerateData(inputs, false, 5, "");
+  REQUIRE(status.IsOk());
+
+  TensorData data;
+  status = dataloader.GetInputData(input1, 0, 0, data);
+  REQUIRE(status.IsOk());
+  CHECK(data.is_valid);
+  // 64 elements of 16-bit data is 128 bytes
+  REQUIRE_EQ(data.batch1_size, 128);
+
+  std::vector<float> values(64);
+  const uint16_t* input_data = reinterpret_cast<const uint16_t*>(data.data_ptr);
+  if (datatype == "FP16") {
+    triton::client::Fp16ToFp32(input_data, values.data(), values.size());
+  } else {
+    triton::client::Bf16ToFp32(input_data, values.data(), values.size());
+  }
+  for (const auto value : values) {
+    CHECK_GE(value, 0.0f);
+    CHECK_LE(value, 1.0f);
+  }
+}
+
 TEST_CASE("dataloader: GenerateData: Dynamic shape")
 {
   bool zero_input = false;
@@ -48,6 +48,72 @@ class TestInferenceProfiler : public InferenceProfiler {
         response_count, valid_requests);
   }
 
+  static WorkloadModelStats SummarizeWorkloadModel(
+      std::vector<uint64_t> latencies, const uint64_t duration_ns,
+      const size_t batch_size, const uint64_t slo_latency_ms)
+  {
+    InferenceProfiler inference_profiler{};
+    inference_profiler.extra_percentile_ = false;
+    WorkloadModelStats stats{};
+    stats.slo_latency_ms = slo_latency_ms;
+    inference_profiler.SummarizeWorkloadModel(
+        std::move(latencies), duration_ns, batch_size, stats);
+    return stats;
+  }
+
+  static ClientSideStats SummarizeScheduleLag(
+      const std::vector<RequestRecord>& valid_requests)
+  {
+    InferenceProfiler inference_profiler{};
+    inference_profiler.extra_percentile_ = false;
+    PerfStatus summary{};
+    inference_profiler.SummarizeScheduleLag(valid_requests, summary);
+    return summary.client_stats;
+  }
+
+  /// Warm up while a thread completes 'completed_requests' requests, one
+  /// every 50 msec.
+  static cb::Error WarmUp(
+      const uint64_t duration_ms, const uint64_t request_count,
+      const uint64_t completed_requests = 0)
+  {
+    InferenceProfiler inference_profiler{};
+    inference_profiler.verbose_ = false;
+    inference_profiler.manager_ = std::make_unique<MockLoadManager>();
+    inference_profiler.SetWarmup(duration_ms, request_count);
+    WindowController& window_controller{
+        inference_profiler.manager_->GetWindowController()};
+    std::thread worker([&window_controller, completed_requests]() {
+      for (uint64_t i = 0; i < completed_requests; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        window_controller.RequestCompleted();
+      }
+    });
+    cb::Error err{inference_profiler.WarmUp()};
+    worker.join();
+    return err;
+  }
+
+  /// Warm up while a worker thread fails after 'failure_ms'.
+  static cb::Error WarmUpWithFailure(
+      const uint64_t duration_ms, const uint64_t failure_ms)
+  {
+    InferenceProfiler inference_profiler{};
+    inference_profiler.verbose_ = false;
+    auto manager{std::make_unique<MockLoadManager>()};
+    std::shared_ptr<ThreadStat> thread_stat{manager->AddThreadStat()};
+    inference_profiler.manager_ = std::move(manager);
+    inference_profiler.SetWarmup(duration_ms, 0);
+    std::thread worker([thread_stat, failure_ms]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(failure_ms));
+      std::lock_guard<std::mutex> lock(thread_stat->mu_);
+      thread_stat->status_ = cb::Error("worker failed", pa::GENERIC_ERROR);
+    });
+    cb::Error err{inference_profiler.WarmUp()};
+    worker.join();
+    return err;
+  }
+
   static std::tuple<uint64_t, uint64_t> GetMeanAndStdDev(
       const std::vector<uint64_t>& latencies)
   {
@@ -227,6 +293,151 @@ TEST_CASE("testing the ValidLatencyMeasurement function")
       convert_request_record_to_latency(all_request_records[3]));
 }
 
+TEST_CASE("testing the SummarizeWorkloadModel function")
+{
+  // 10 requests of batch 2 in half a second, with latencies of 1 to 10 msec
+  std::vector<uint64_t> latencies;
+  for (uint64_t i = 1; i <= 10; ++i) {
+    latencies.push_back(i * NANOS_PER_MILLIS);
+  }
+
+  SUBCASE("with latency objective")
+  {
+    const auto stats{TestInferenceProfiler::SummarizeWorkloadModel(
+        latencies, NANOS_PER_SECOND / 2, 2, 7)};
+    CHECK(stats.request_count == 10);
+    CHECK(stats.infer_per_sec == doctest::Approx(40.0));
+    CHECK(stats.avg_latency_ns == 5500000);
+    CHECK(stats.percentile_latency_ns.at(50) == 6 * NANOS_PER_MILLIS);
+    CHECK(stats.percentile_latency_ns.at(99) == 10 * NANOS_PER_MILLIS);
+    CHECK(stats.slo_violation_count == 3);
+  }
+
+  SUBCASE("without latency objective")
+  {
+    const auto stats{TestInferenceProfiler::SummarizeWorkloadModel(
+        latencies, NANOS_PER_SECOND / 2, 2, 0)};
+    CHECK(stats.slo_violation_count == 0);
+  }
+
+  SUBCASE("no requests")
+  {
+    const auto stats{TestInferenceProfiler::SummarizeWorkloadModel(
+        {}, NANOS_PER_SECOND / 2, 2, 7)};
+    CHECK(stats.request_count == 0);
+    CHECK(stats.infer_per_sec == 0.0);
+    CHECK(stats.percentile_latency_ns.empty());
+  }
+}
+
+TEST_CASE("testing the SummarizeScheduleLag function")
+{
+  using std::chrono::microseconds;
+  const auto clock_epoch{std::chrono::time_point<std::chrono::system_clock>()};
+  const auto record{[&](uint64_t scheduled_us, uint64_t start_us,
+                        uint64_t end_us) {
+    return RequestRecord{
+        clock_epoch + microseconds(start_us),
+        {clock_epoch + microseconds(end_us)},
+        false,
+        false,
+        0,
+        false,
+        0,
+        scheduled_us ? clock_epoch + microseconds(scheduled_us) : clock_epoch};
+  }};
+
+  SUBCASE("requests behind schedule")
+  {
+    // Sent on time, 50 usec late, 5 msec late and 2 sec late, each served in
+    // 100 usec
+    const std::vector<RequestRecord> requests{
+        record(1000, 1000, 1100), record(2000, 2050, 2150),
+        record(3000, 8000, 8100), record(4000, 2004000, 2004100)};
+    const auto stats{TestInferenceProfiler::SummarizeScheduleLag(requests)};
+    CHECK(
+        stats.corrected_latencies ==
+        std::vector<uint64_t>{100000, 150000, 5100000, 2000100000});
+    CHECK(stats.avg_corrected_latency_ns == 501362500);
+    CHECK(stats.corrected_percentile_latency_ns.at(50) == 5100000);
+    CHECK(stats.corrected_percentile_latency_ns.at(99) == 2000100000);
+    CHECK(
+        stats.schedule_lag_histogram ==
+        std::map<uint64_t, uint64_t>{
+            {10, 1}, {100, 1}, {10000, 1}, {UINT64_MAX, 1}});
+  }
+
+  SUBCASE("request sent ahead of schedule")
+  {
+    const auto stats{TestInferenceProfiler::SummarizeScheduleLag(
+        {record(2000, 1000, 1100)})};
+    CHECK(stats.corrected_latencies == std::vector<uint64_t>{100000});
+    CHECK(
+        stats.schedule_lag_histogram == std::map<uint64_t, uint64_t>{{10, 1}});
+  }
+
+  SUBCASE("requests without schedule")
+  {
+    const auto stats{TestInferenceProfiler::SummarizeScheduleLag(
+        {record(0, 1000, 1100)})};
+    CHECK(stats.corrected_latencies.empty());
+    CHECK(stats.corrected_percentile_latency_ns.empty());
+    CHECK(stats.schedule_lag_histogram.empty());
+  }
+}
+
+TEST_CASE("testing the WarmUp function")
+{
+  using std::chrono::milliseconds;
+  using std::chrono::steady_clock;
+
+  SUBCASE("no warm-up")
+  {
+    const auto start{steady_clock::now()};
+    CHECK(TestInferenceProfiler::WarmUp(0, 0).IsOk());
+    CHECK(steady_clock::now() - start < milliseconds(50));
+  }
+
+  SUBCASE("warm-up duration")
+  {
+    const auto start{steady_clock::now()};
+    CHECK(TestInferenceProfiler::WarmUp(150, 0).IsOk());
+    const auto elapsed{steady_clock::now() - start};
+    CHECK(elapsed >= milliseconds(150));
+    CHECK(elapsed < milliseconds(1000));
+  }
+
+  SUBCASE("warm-up request count")
+  {
+    // The warm-up ends when the third request completes, without waiting
+    // for the timeout of the health checks
+    const auto start{steady_clock::now()};
+    CHECK(TestInferenceProfiler::WarmUp(0, 3, 3).IsOk());
+    const auto elapsed{steady_clock::now() - start};
+    CHECK(elapsed >= milliseconds(150));
+    CHECK(elapsed < milliseconds(1000));
+  }
+
+  SUBCASE("warm-up duration and request count")
+  {
+    // The requests complete before the end of the warm-up duration
+    const auto start{steady_clock::now()};
+    CHECK(TestInferenceProfiler::WarmUp(300, 3, 3).IsOk());
+    const auto elapsed{steady_clock::now() - start};
+    CHECK(elapsed >= milliseconds(300));
+    CHECK(elapsed < milliseconds(1000));
+  }
+
+  SUBCASE("worker failure during the warm-up duration")
+  {
+    // The failure is reported within a second instead of at the end of the
+    // warm-up duration
+    const auto start{steady_clock::now()};
+    CHECK(!TestInferenceProfiler::WarmUpWithFailure(10000, 100).IsOk());
+    CHECK(steady_clock::now() - start < milliseconds(2000));
+  }
+}
+
 TEST_CASE("test_check_window_for_stability")
 {
   LoadStatus ls;
@@ -1021,6 +1232,36 @@ TEST_CASE(
     CHECK(
         summary_status.client_stats.responses_per_sec == doctest::Approx(3.0));
   }
+
+  SUBCASE("testing the span of the merged windows")
+  {
+    PerfStatus perf_status1{};
+    perf_status1.client_stats.duration_ns = 2000000000;
+    perf_status1.window_start_ns = 1000000000;
+    perf_status1.window_end_ns = 3000000000;
+
+    PerfStatus perf_status2{};
+    perf_status2.client_stats.duration_ns = 2000000000;
+    perf_status2.window_start_ns = 3000000000;
+    perf_status2.window_end_ns = 5000000000;
+
+    std::deque<PerfStatus> perf_status{perf_status1, perf_status2};
+    PerfStatus summary_status{};
+
+    EXPECT_CALL(
+        mock_inference_profiler, MergeServerSideStats(testing::_, testing::_))
+        .WillOnce(testing::Return(cb::Error::Success));
+    EXPECT_CALL(
+        mock_inference_profiler, SummarizeLatency(testing::_, testing::_))
+        .WillOnce(testing::Return(cb::Error::Success));
+
+    cb::Error error{mock_inference_profiler.MergePerfStatusReports(
+        perf_status, summary_status)};
+
+    REQUIRE(error.IsOk() == true);
+    CHECK(summary_status.window_start_ns == 1000000000);
+    CHECK(summary_status.window_end_ns == 5000000000);
+  }
 }
 
 TEST_CASE("summarize_client_stat: testing the SummarizeClientStat function")
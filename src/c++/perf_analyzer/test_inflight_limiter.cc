@@ -0,0 +1,172 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+#include "inflight_limiter.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("inflight_limiter: drop")
+{
+  InflightLimiter limiter(2, InflightLimitPolicy::DROP, {});
+  const auto now{std::chrono::system_clock::now()};
+
+  CHECK(limiter.Acquire(now));
+  CHECK(limiter.Acquire(now));
+  CHECK_FALSE(limiter.Acquire(now));
+  CHECK(limiter.InflightRequests() == 2);
+
+  limiter.Release();
+  CHECK(limiter.Acquire(now));
+
+  // The ends of the sequences go over the limit
+  limiter.ForceAcquire();
+  CHECK(limiter.InflightRequests() == 3);
+
+  const InflightLimitStats stats{limiter.SwapStats()};
+  CHECK(stats.max_inflight == 2);
+  CHECK(stats.admitted_requests == 3);
+  CHECK(stats.shed_requests == 1);
+  CHECK(stats.queued_requests == 0);
+
+  // The stats are reset but not the limit
+  const InflightLimitStats next_stats{limiter.SwapStats()};
+  CHECK(next_stats.max_inflight == 2);
+  CHECK(next_stats.admitted_requests == 0);
+  CHECK(next_stats.shed_requests == 0);
+}
+
+TEST_CASE("inflight_limiter: queue")
+{
+  SUBCASE("admitted when a request completes")
+  {
+    InflightLimiter limiter(1, InflightLimitPolicy::QUEUE, {});
+    REQUIRE(limiter.Acquire(std::chrono::system_clock::now()));
+
+    std::thread release_thread([&limiter]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      limiter.Release();
+    });
+    CHECK(limiter.Acquire(std::chrono::system_clock::now()));
+    release_thread.join();
+
+    const InflightLimitStats stats{limiter.SwapStats()};
+    CHECK(stats.admitted_requests == 2);
+    CHECK(stats.queued_requests == 1);
+    CHECK(stats.shed_requests == 0);
+    CHECK(stats.max_queue_delay_ns >= 40000000);
+    CHECK(stats.queue_delay_sum_ns >= stats.max_queue_delay_ns);
+  }
+
+  SUBCASE("shed after the timeout")
+  {
+    InflightLimiter limiter(
+        1, InflightLimitPolicy::QUEUE, std::chrono::milliseconds(20));
+    REQUIRE(limiter.Acquire(std::chrono::system_clock::now()));
+
+    const auto start{std::chrono::steady_clock::now()};
+    CHECK_FALSE(limiter.Acquire(std::chrono::system_clock::now()));
+    CHECK(
+        std::chrono::steady_clock::now() - start >=
+        std::chrono::milliseconds(15));
+
+    // A request arriving long before is shed without waiting
+    CHECK_FALSE(limiter.Acquire(
+        std::chrono::system_clock::now() - std::chrono::seconds(1)));
+
+    const InflightLimitStats stats{limiter.SwapStats()};
+    CHECK(stats.admitted_requests == 1);
+    CHECK(stats.shed_requests == 2);
+  }
+}
+
+TEST_CASE("inflight_limiter: concurrent requests stay under the limit")
+{
+  const size_t max_inflight{4};
+  InflightLimiter limiter(max_inflight, InflightLimitPolicy::QUEUE, {});
+  std::atomic<size_t> inflight{0};
+  std::atomic<size_t> max_seen{0};
+  std::atomic<size_t> shed{0};
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 16; i++) {
+    threads.emplace_back([&]() {
+      for (size_t j = 0; j < 100; j++) {
+        if (!limiter.Acquire(std::chrono::system_clock::now())) {
+          shed++;
+          continue;
+        }
+        const size_t current{++inflight};
+        size_t seen{max_seen};
+        while (current > seen &&
+               !max_seen.compare_exchange_weak(seen, current)) {
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        inflight--;
+        limiter.Release();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  CHECK(shed == 0);
+  CHECK(max_seen <= max_inflight);
+  CHECK(limiter.InflightRequests() == 0);
+  const InflightLimitStats stats{limiter.SwapStats()};
+  CHECK(stats.admitted_requests == 1600);
+  CHECK(stats.shed_requests == 0);
+}
+
+TEST_CASE("inflight_limiter: accumulate stats")
+{
+  InflightLimitStats total{};
+  InflightLimitStats stats{};
+  stats.max_inflight = 8;
+  stats.admitted_requests = 10;
+  stats.shed_requests = 2;
+  stats.queued_requests = 3;
+  stats.queue_delay_sum_ns = 500;
+  stats.max_queue_delay_ns = 200;
+  AccumulateInflightLimitStats(stats, &total);
+  stats.max_queue_delay_ns = 100;
+  AccumulateInflightLimitStats(stats, &total);
+
+  CHECK(total.max_inflight == 8);
+  CHECK(total.admitted_requests == 20);
+  CHECK(total.shed_requests == 4);
+  CHECK(total.queued_requests == 6);
+  CHECK(total.queue_delay_sum_ns == 1000);
+  CHECK(total.max_queue_delay_ns == 200);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,191 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "doctest.h"
+#include "live_metrics.h"
+
+namespace triton { namespace perfanalyzer {
+
+class TestLiveMetrics {
+ public:
+  // Send 'request' to the server on 'port' and return the response
+  static std::string Scrape(const uint16_t port, const std::string& request)
+  {
+    int fd{socket(AF_INET, SOCK_STREAM, 0)};
+    REQUIRE(fd >= 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    REQUIRE(
+        connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) ==
+        0);
+    REQUIRE(
+        send(fd, request.data(), request.size(), 0) ==
+        static_cast<ssize_t>(request.size()));
+    std::string response;
+    char buffer[1024];
+    ssize_t n;
+    while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+      response.append(buffer, n);
+    }
+    close(fd);
+    return response;
+  }
+};
+
+TEST_CASE("live_metrics: latency histogram")
+{
+  LiveLatencyHistogram histogram;
+  histogram.Add(50000);           // 50 usec
+  histogram.Add(100000);          // 100 usec, on the bound
+  histogram.Add(3000000);         // 3 msec
+  histogram.Add(20000000000ULL);  // 20 sec
+
+  std::vector<uint64_t> counts;
+  uint64_t sum_ns{0};
+  histogram.AccumulateTo(counts, sum_ns);
+  REQUIRE(counts.size() == LiveLatencyHistogram::kBucketBoundsUs.size() + 1);
+  CHECK(counts[0] == 2);
+  CHECK(counts[5] == 1);
+  CHECK(counts.back() == 1);
+  CHECK(sum_ns == 20003150000ULL);
+
+  // Accumulating another thread adds to the counts
+  histogram.AccumulateTo(counts, sum_ns);
+  CHECK(counts[0] == 4);
+  CHECK(sum_ns == 40006300000ULL);
+}
+
+TEST_CASE("live_metrics: format")
+{
+  LiveStats stats{};
+  stats.sent_request_count = 5;
+  stats.delayed_request_count = 1;
+  stats.latency_bucket_counts.resize(
+      LiveLatencyHistogram::kBucketBoundsUs.size() + 1, 0);
+  stats.latency_bucket_counts[0] = 2;
+  stats.latency_bucket_counts[3] = 1;
+  stats.latency_sum_ns = 1500000;
+  stats.worker_in_flight_requests = {2, 0};
+  stats.infer_per_sec = 250.5;
+  stats.overhead_pct = 20;
+
+  const std::string metrics{FormatLiveMetrics(stats)};
+  CHECK(
+      metrics.find("# TYPE perf_analyzer_requests_sent_total counter\n"
+                   "perf_analyzer_requests_sent_total 5\n") !=
+      std::string::npos);
+  CHECK(
+      metrics.find("perf_analyzer_requests_completed_total 3\n") !=
+      std::string::npos);
+  CHECK(
+      metrics.find("perf_analyzer_requests_delayed_total 1\n") !=
+      std::string::npos);
+  CHECK(
+      metrics.find("perf_analyzer_requests_in_flight 2\n") !=
+      std::string::npos);
+  CHECK(
+      metrics.find(
+          "perf_analyzer_worker_requests_in_flight{worker=\"1\"} 0\n") !=
+      std::string::npos);
+  CHECK(
+      metrics.find(
+          "perf_analyzer_request_latency_seconds_bucket{le=\"0.0001\"} 2\n"
+          "perf_analyzer_request_latency_seconds_bucket{le=\"0.00025\"} 2\n"
+          "perf_analyzer_request_latency_seconds_bucket{le=\"0.0005\"} 2\n"
+          "perf_analyzer_request_latency_seconds_bucket{le=\"0.001\"} 3\n") !=
+      std::string::npos);
+  CHECK(
+      metrics.find(
+          "perf_analyzer_request_latency_seconds_bucket{le=\"+Inf\"} 3\n"
+          "perf_analyzer_request_latency_seconds_sum 0.0015\n"
+          "perf_analyzer_request_latency_seconds_count 3\n") !=
+      std::string::npos);
+  CHECK(
+      metrics.find(
+          "perf_analyzer_window_throughput_infer_per_second 250.5\n") !=
+      std::string::npos);
+  CHECK(
+      metrics.find("perf_analyzer_window_overhead_ratio 0.2\n") !=
+      std::string::npos);
+}
+
+TEST_CASE("live_metrics: server")
+{
+  size_t scrape_count{0};
+  std::unique_ptr<LiveMetricsServer> server;
+  REQUIRE(LiveMetricsServer::Create(
+              0,
+              [&scrape_count](LiveStats* stats) {
+                scrape_count++;
+                stats->sent_request_count = 7;
+              },
+              &server)
+              .IsOk());
+  REQUIRE(server->Port() != 0);
+
+  SUBCASE("metrics")
+  {
+    const std::string response{TestLiveMetrics::Scrape(
+        server->Port(), "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n")};
+    CHECK(response.rfind("HTTP/1.1 200 OK\r\n", 0) == 0);
+    CHECK(
+        response.find("\r\n\r\n# HELP perf_analyzer_requests_sent_total") !=
+        std::string::npos);
+    CHECK(
+        response.find("perf_analyzer_requests_sent_total 7\n") !=
+        std::string::npos);
+    CHECK(scrape_count == 1);
+  }
+
+  SUBCASE("unknown path")
+  {
+    const std::string response{TestLiveMetrics::Scrape(
+        server->Port(), "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n")};
+    CHECK(response.rfind("HTTP/1.1 404 Not Found\r\n", 0) == 0);
+    CHECK(scrape_count == 0);
+  }
+
+  SUBCASE("port in use")
+  {
+    std::unique_ptr<LiveMetricsServer> other_server;
+    CHECK(!LiveMetricsServer::Create(
+               server->Port(), [](LiveStats*) {}, &other_server)
+               .IsOk());
+  }
+}
+
+}}  // namespace triton::perfanalyzer
@@ -24,6 +24,8 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <thread>
+
 #include "command_line_parser.h"
 #include "doctest.h"
 #include "load_manager.h"
@@ -340,6 +342,50 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
     }
   }
 
+  /// Test that the worker thread statistics share the window controller
+  /// that the count based measurement windows wait on
+  ///
+  void TestWindowController()
+  {
+    auto stat1 = AddThreadStat();
+    auto stat2 = AddThreadStat();
+    REQUIRE(threads_stat_.size() == 2);
+    REQUIRE(stat1->window_controller_ != nullptr);
+    CHECK(stat1->window_controller_ == stat2->window_controller_);
+
+    WindowController& window_controller{GetWindowController()};
+    CHECK(window_controller.CompletedRequests() == 0);
+
+    SUBCASE("Target already reached")
+    {
+      stat1->window_controller_->RequestCompleted();
+      stat2->window_controller_->RequestCompleted();
+      CHECK(window_controller.CompletedRequests() == 2);
+      CHECK(window_controller.WaitForCompletedRequests(
+          2, std::chrono::milliseconds(0)));
+    }
+    SUBCASE("Target not reached")
+    {
+      stat1->window_controller_->RequestCompleted();
+      CHECK_FALSE(window_controller.WaitForCompletedRequests(
+          2, std::chrono::milliseconds(10)));
+    }
+    SUBCASE("Woken up by the worker threads")
+    {
+      std::thread worker([&stat1, &stat2]() {
+        for (size_t i = 0; i < 5; i++) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          stat1->window_controller_->RequestCompleted();
+          stat2->window_controller_->RequestCompleted();
+        }
+      });
+      CHECK(window_controller.WaitForCompletedRequests(
+          10, std::chrono::seconds(10)));
+      worker.join();
+      CHECK(window_controller.CompletedRequests() == 10);
+    }
+  }
+
   void TestIdle()
   {
     auto stat1 = std::make_shared<ThreadStat>();
@@ -400,6 +446,14 @@ TEST_CASE(
   tlm.TestCountCollectedRequests();
 }
 
+TEST_CASE(
+    "load_manager_window_controller: Test the completed request count shared "
+    "with the worker threads")
+{
+  TestLoadManager tlm(PerfAnalyzerParameters{});
+  tlm.TestWindowController();
+}
+
 TEST_CASE("load_manager_batch_size: Test the public function BatchSize()")
 {
   PerfAnalyzerParameters params;
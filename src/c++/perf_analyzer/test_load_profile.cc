@@ -0,0 +1,205 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "doctest.h"
+#include "load_profile.h"
+
+namespace triton { namespace perfanalyzer {
+
+cb::Error
+ParseLoadProfileStr(const std::string& str, LoadProfile* profile)
+{
+  rapidjson::Document d{};
+  d.Parse(str.c_str());
+  return ParseLoadProfile(d, profile);
+}
+
+TEST_CASE("load_profile: parse")
+{
+  LoadProfile profile;
+
+  SUBCASE("all segment types")
+  {
+    REQUIRE(ParseLoadProfileStr(
+                R"({"segments": [
+                  {"type": "constant", "duration_ms": 1000, "rate": 100},
+                  {"name": "up", "type": "ramp", "duration_ms": 2000,
+                   "start_rate": 100, "end_rate": 300},
+                  {"name": "stairs", "type": "step", "duration_ms": 1000,
+                   "rates": [10, 20, 30]},
+                  {"type": "sine", "duration_ms": 4000, "mean_rate": 50,
+                   "amplitude": 20, "period_ms": 2000},
+                  {"type": "spike", "duration_ms": 1000, "rate": 10,
+                   "spike_rate": 1000, "spike_start_ms": 200,
+                   "spike_duration_ms": 100}
+                ]})",
+                &profile)
+                .IsOk());
+    const auto& segments{profile.Segments()};
+    REQUIRE(segments.size() == 7);
+    CHECK(profile.DurationNs() == 9000000000);
+
+    CHECK(segments[0].shape_ == LoadShape::CONSTANT);
+    CHECK(segments[0].MeanRate() == doctest::Approx(100));
+    CHECK(segments[0].Description() == "constant 100 infer/sec over 1000 msec");
+
+    CHECK(segments[1].shape_ == LoadShape::RAMP);
+    CHECK(segments[1].RateAt(500000000) == doctest::Approx(150));
+    CHECK(segments[1].MaxRate() == doctest::Approx(300));
+    CHECK(segments[1].MeanRate() == doctest::Approx(200));
+    CHECK(
+        segments[1].Description() ==
+        "up: ramp from 100 to 300 infer/sec over 2000 msec");
+
+    // The steps are split into constant segments, the last one taking the
+    // remainder of the duration
+    CHECK(segments[2].shape_ == LoadShape::CONSTANT);
+    CHECK(segments[2].rate_ == doctest::Approx(10));
+    CHECK(segments[2].duration_ms_ == 333);
+    CHECK(segments[2].name_ == "stairs step 0");
+    CHECK(segments[4].rate_ == doctest::Approx(30));
+    CHECK(segments[4].duration_ms_ == 334);
+
+    CHECK(segments[5].shape_ == LoadShape::SINE);
+    CHECK(segments[5].RateAt(500000000) == doctest::Approx(70));
+    CHECK(segments[5].RateAt(1500000000) == doctest::Approx(30));
+    CHECK(segments[5].MaxRate() == doctest::Approx(70));
+    CHECK(segments[5].MeanRate() == doctest::Approx(50));
+
+    CHECK(segments[6].shape_ == LoadShape::SPIKE);
+    CHECK(segments[6].RateAt(100000000) == doctest::Approx(10));
+    CHECK(segments[6].RateAt(250000000) == doctest::Approx(1000));
+    CHECK(segments[6].RateAt(300000000) == doctest::Approx(10));
+    CHECK(segments[6].MaxRate() == doctest::Approx(1000));
+    CHECK(segments[6].MeanRate() == doctest::Approx(109));
+
+    CHECK(profile.SegmentAt(0) == 0);
+    CHECK(profile.SegmentAt(1000000000) == 1);
+    CHECK(profile.RateAt(2000000000) == doctest::Approx(200));
+    // The profile repeats after its duration
+    CHECK(profile.SegmentAt(9000000000) == 0);
+    CHECK(profile.RateAt(11000000000) == doctest::Approx(200));
+  }
+
+  SUBCASE("invalid profiles")
+  {
+    CHECK_FALSE(ParseLoadProfileStr("bad json text", &profile).IsOk());
+    CHECK_FALSE(ParseLoadProfileStr(R"({"segments": []})", &profile).IsOk());
+    CHECK_FALSE(ParseLoadProfileStr(
+                    R"({"segments": [{"type": "constant", "rate": 1}]})",
+                    &profile)
+                    .IsOk());
+    CHECK_FALSE(ParseLoadProfileStr(
+                    R"({"segments": [{"type": "wave", "duration_ms": 1}]})",
+                    &profile)
+                    .IsOk());
+    CHECK_FALSE(
+        ParseLoadProfileStr(
+            R"({"segments": [{"type": "constant", "duration_ms": 1,
+                "rate": -1}]})",
+            &profile)
+            .IsOk());
+    CHECK_FALSE(
+        ParseLoadProfileStr(
+            R"({"segments": [{"type": "constant", "duration_ms": 1,
+                "rate": 0}]})",
+            &profile)
+            .IsOk());
+    CHECK_FALSE(
+        ParseLoadProfileStr(
+            R"({"segments": [{"type": "sine", "duration_ms": 1,
+                "mean_rate": 10, "amplitude": 20, "period_ms": 1}]})",
+            &profile)
+            .IsOk());
+    CHECK_FALSE(
+        ParseLoadProfileStr(
+            R"({"segments": [{"type": "spike", "duration_ms": 100, "rate": 1,
+                "spike_rate": 10, "spike_start_ms": 90,
+                "spike_duration_ms": 20}]})",
+            &profile)
+            .IsOk());
+    CHECK_FALSE(
+        ParseLoadProfileStr(
+            R"({"segments": [{"type": "step", "duration_ms": 1,
+                "rates": [1, 2]}]})",
+            &profile)
+            .IsOk());
+  }
+}
+
+TEST_CASE("load_profile: non-homogeneous Poisson arrivals")
+{
+  LoadSegment constant;
+  constant.duration_ms_ = 1000;
+  constant.rate_ = 2000;
+  LoadSegment idle;
+  idle.duration_ms_ = 500;
+  LoadSegment ramp;
+  ramp.shape_ = LoadShape::RAMP;
+  ramp.duration_ms_ = 1000;
+  ramp.rate_ = 0;
+  ramp.end_rate_ = 4000;
+  const LoadProfile profile({constant, idle, ramp});
+
+  auto distribution{LoadProfileDistribution(profile)};
+  std::mt19937 rng;
+
+  // Count the requests of each segment and of each half of the ramp over
+  // two rounds of the profile
+  std::vector<size_t> counts(4, 0);
+  std::chrono::nanoseconds timestamp{0};
+  const uint64_t duration_ns{profile.DurationNs()};
+  while (true) {
+    timestamp += distribution(rng);
+    const uint64_t time_ns = timestamp.count();
+    if (time_ns >= 2 * duration_ns) {
+      break;
+    }
+    const uint64_t offset_ns{time_ns % duration_ns};
+    if (offset_ns < 1000000000) {
+      counts[0]++;
+    } else if (offset_ns < 1500000000) {
+      counts[1]++;
+    } else if (offset_ns < 2000000000) {
+      counts[2]++;
+    } else {
+      counts[3]++;
+    }
+  }
+
+  // Within 5 standard deviations of the expected counts
+  CHECK(counts[0] == doctest::Approx(4000).epsilon(0.08));
+  CHECK(counts[1] == 0);
+  CHECK(counts[2] == doctest::Approx(1000).epsilon(0.16));
+  CHECK(counts[3] == doctest::Approx(3000).epsilon(0.1));
+}
+
+}}  // namespace triton::perfanalyzer
@@ -124,4 +124,23 @@ TEST_CASE("profile_data_collector: AddWindow")
   CHECK(collector.experiments_[0].window_boundaries[3] == window_end2);
 }
 
+TEST_CASE("profile_data_collector: SetMeasurementWindow")
+{
+  MockProfileDataCollector collector{};
+  InferenceLoadMode infer_mode{10, 20.0};
+
+  // Experiments without windows have no measurement
+  collector.SetMeasurementWindow(infer_mode, 123, 912);
+  CHECK(collector.experiments_.empty());
+
+  collector.AddWindow(infer_mode, 123, 456);
+  collector.AddWindow(infer_mode, 456, 912);
+  CHECK(collector.experiments_[0].measurement_start_ns == 0);
+  CHECK(collector.experiments_[0].measurement_end_ns == 0);
+
+  collector.SetMeasurementWindow(infer_mode, 123, 912);
+  CHECK(collector.experiments_[0].measurement_start_ns == 123);
+  CHECK(collector.experiments_[0].measurement_end_ns == 912);
+}
+
 }}  // namespace triton::perfanalyzer
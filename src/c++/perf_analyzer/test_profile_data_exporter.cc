@@ -110,6 +110,7 @@ TEST_CASE("profile_data_exporter: ConvertToJson")
 
   CHECK(actual_request["timestamp"] == expected_request["timestamp"]);
   CHECK(actual_request["sequence_id"] == expected_request["sequence_id"]);
+  CHECK(!actual_request.HasMember("scheduled_timestamp"));
   CHECK(
       actual_request["response_timestamps"][0] ==
       expected_request["response_timestamps"][0]);
@@ -120,6 +121,7 @@ TEST_CASE("profile_data_exporter: ConvertToJson")
   CHECK(actual_windows[0] == expected_windows[0]);
   CHECK(actual_windows[1] == expected_windows[1]);
   CHECK(actual_windows[2] == expected_windows[2]);
+  CHECK(!exporter.document_["experiments"][0].HasMember("measurement_window"));
 
   CHECK(actual_version == expected_version);
 }
@@ -155,6 +157,22 @@ TEST_CASE("profile_data_exporter: AddExperiment")
   }
 }
 
+TEST_CASE("profile_data_exporter: AddMeasurementWindow")
+{
+  MockProfileDataExporter exporter{};
+
+  Experiment raw_experiment;
+  raw_experiment.measurement_start_ns = 1;
+  raw_experiment.measurement_end_ns = 6;
+  rapidjson::Value entry(rapidjson::kObjectType);
+
+  exporter.AddMeasurementWindow(entry, raw_experiment);
+  REQUIRE(entry.HasMember("measurement_window"));
+  REQUIRE(entry["measurement_window"].Size() == 2);
+  CHECK(entry["measurement_window"][0] == 1);
+  CHECK(entry["measurement_window"][1] == 6);
+}
+
 TEST_CASE("profile_data_exporter: OutputToFile")
 {
   MockProfileDataExporter exporter{};
@@ -37,6 +37,11 @@ class TestReportWriter : ReportWriter {
   {
     ReportWriter::WriteGpuMetrics(ofs, metrics);
   }
+
+  void WriteResourceUsage(std::ostream& ofs, const ResourceUsageStats& stats)
+  {
+    ReportWriter::WriteResourceUsage(ofs, stats);
+  }
 };
 
 TEST_CASE("testing WriteGpuMetrics")
@@ -90,4 +95,23 @@ TEST_CASE("testing WriteGpuMetrics")
   }
 }
 
+TEST_CASE("testing WriteResourceUsage")
+{
+  TestReportWriter trw{};
+  ResourceUsageStats stats{};
+  stats.cpu_utilization = 1.5;
+  stats.max_thread_cpu_utilization = 0.75;
+  stats.voluntary_context_switches = 10;
+  stats.involuntary_context_switches = 2;
+  stats.minor_page_faults = 7;
+  stats.major_page_faults = 1;
+  stats.rss_bytes = 4096;
+  stats.rss_growth_bytes = -1024;
+  std::ostringstream actual_output{};
+
+  trw.WriteResourceUsage(actual_output, stats);
+  const std::string expected_output{",1.5,0.75,10,2,8,4096,-1024"};
+  CHECK(actual_output.str() == expected_output);
+}
+
 }}  // namespace triton::perfanalyzer
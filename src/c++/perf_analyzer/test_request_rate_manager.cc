@@ -175,6 +175,85 @@ class TestRequestRateManager : public TestLoadManagerBase,
     }
   }
 
+  /// Test that the schedule of a load profile follows its rate
+  ///
+  void TestLoadProfileSchedule(const LoadProfile& profile)
+  {
+    PauseWorkers();
+    ConfigureThreads();
+    GenerateLoadProfileSchedule(profile);
+
+    // Count the requests of the round of the profile in each segment. The
+    // schedule ends with the round, so that the repeated rounds stay aligned
+    // with the segments.
+    std::vector<size_t> segment_counts(profile.Segments().size(), 0);
+    for (auto worker : workers_) {
+      auto w = std::dynamic_pointer_cast<RequestRateWorker>(worker);
+      CHECK(w->schedule_->duration.count() == profile.DurationNs());
+      for (const auto& timestamp : w->schedule_->intervals) {
+        REQUIRE(timestamp.count() < profile.DurationNs());
+        segment_counts[profile.SegmentAt(timestamp.count())]++;
+      }
+    }
+    early_exit = true;
+
+    for (size_t i = 0; i < segment_counts.size(); i++) {
+      const auto& segment{profile.Segments()[i]};
+      const double expected_count{
+          segment.MeanRate() * segment.duration_ms_ / 1000};
+      CHECK(
+          segment_counts[i] ==
+          doctest::Approx(expected_count).epsilon(0.1).scale(10));
+    }
+  }
+
+  /// Test that the schedule of a load profile with fewer requests per round
+  /// than workers covers whole rounds, and gives every worker a request
+  ///
+  void TestShortLoadProfileSchedule(const LoadProfile& profile)
+  {
+    PauseWorkers();
+    ConfigureThreads();
+    GenerateLoadProfileSchedule(profile);
+    early_exit = true;
+
+    for (auto worker : workers_) {
+      auto w = std::dynamic_pointer_cast<RequestRateWorker>(worker);
+      const int64_t duration_ns{w->schedule_->duration.count()};
+      CHECK(duration_ns > 0);
+      CHECK(duration_ns % profile.DurationNs() == 0);
+      REQUIRE(!w->schedule_->intervals.empty());
+      CHECK(w->schedule_->intervals.back().count() < duration_ns);
+    }
+  }
+
+  /// Test the burstiness reported for the schedule of a request rate
+  ///
+  void TestScheduleStats(
+      double rate, double min_interval_cv, double max_interval_cv)
+  {
+    PauseWorkers();
+    ConfigureThreads();
+    REQUIRE(GenerateSchedule(rate).IsOk());
+    early_exit = true;
+
+    const ScheduleStats& stats{GetScheduleStats()};
+    if (request_distribution_ == Distribution::CONSTANT) {
+      CHECK(stats.requests_ == 0);
+      return;
+    }
+
+    // The schedule covers all the trials
+    const double expected_requests{
+        rate * params_.max_trials * params_.measurement_window_ms / 1000};
+    CHECK(
+        stats.requests_ ==
+        doctest::Approx(expected_requests).epsilon(0.1).scale(10));
+    CHECK(stats.interval_cv_ >= min_interval_cv);
+    CHECK(stats.interval_cv_ <= max_interval_cv);
+    CHECK(stats.window_ms_ == 100);
+  }
+
   /// Test that the correct Infer function is called in the backend
   ///
   void TestInferType()
@@ -1743,6 +1822,38 @@ TEST_CASE("Request rate - Shared memory infer input calls")
   }
 }
 
+TEST_CASE("request_rate drop over the in-flight limit with serial sequences")
+{
+  // The requests shed under the limit of requests in flight give their
+  // context back, so that the worker keeps sending the requests of the
+  // sequences instead of waiting forever for a free context
+  PerfAnalyzerParameters params;
+  params.async = true;
+  params.serial_sequences = true;
+  params.num_of_sequences = 2;
+  params.max_threads = 1;
+  bool is_sequence_model = true;
+
+  TestRequestRateManager trrm(params, is_sequence_model);
+  trrm.InitManager(
+      params.string_length, params.string_data, params.zero_input,
+      params.user_data, params.start_sequence_id, params.sequence_id_range,
+      params.sequence_length, params.sequence_length_specified,
+      params.sequence_length_variation);
+  trrm.SetInflightLimit(1, InflightLimitPolicy::DROP, nanoseconds(0));
+  trrm.stats_->SetDelays({20});
+
+  TestWatchDog watchdog(1000);
+  trrm.ChangeRequestRate(1000);
+  std::this_thread::sleep_for(milliseconds(200));
+  const InflightLimitStats stats{trrm.GetInflightLimiter()->SwapStats()};
+  trrm.StopWorkerThreads();
+  watchdog.stop();
+
+  CHECK(stats.shed_requests > params.num_of_sequences);
+  CHECK(stats.admitted_requests > params.num_of_sequences);
+}
+
 TEST_CASE("request_rate_deadlock")
 {
   PerfAnalyzerParameters params{};
@@ -2065,6 +2176,111 @@ TEST_CASE("request rate manager - Calculate thread ids")
   trrm.TestCalculateThreadIds(expected_thread_ids);
 }
 
+TEST_CASE("request rate load profile schedule")
+{
+  PerfAnalyzerParameters params;
+  params.max_threads = 4;
+
+  LoadSegment constant;
+  constant.duration_ms_ = 1000;
+  constant.rate_ = 2000;
+  LoadSegment idle;
+  idle.duration_ms_ = 500;
+  LoadSegment ramp;
+  ramp.shape_ = LoadShape::RAMP;
+  ramp.duration_ms_ = 1000;
+  ramp.rate_ = 4000;
+  ramp.end_rate_ = 1000;
+  const LoadProfile profile({constant, idle, ramp});
+
+  TestRequestRateManager trrm(params);
+  trrm.InitManager(
+      params.string_length, params.string_data, params.zero_input,
+      params.user_data, params.start_sequence_id, params.sequence_id_range,
+      params.sequence_length, params.sequence_length_specified,
+      params.sequence_length_variation);
+  trrm.TestLoadProfileSchedule(profile);
+}
+
+TEST_CASE("request rate load profile schedule with fewer requests than workers")
+{
+  PerfAnalyzerParameters params;
+  params.max_threads = 4;
+
+  // About one request per round
+  LoadSegment constant;
+  constant.duration_ms_ = 10;
+  constant.rate_ = 100;
+  const LoadProfile profile({constant});
+
+  TestRequestRateManager trrm(params);
+  trrm.InitManager(
+      params.string_length, params.string_data, params.zero_input,
+      params.user_data, params.start_sequence_id, params.sequence_id_range,
+      params.sequence_length, params.sequence_length_specified,
+      params.sequence_length_variation);
+  trrm.TestShortLoadProfileSchedule(profile);
+}
+
+TEST_CASE("request rate schedule stats")
+{
+  PerfAnalyzerParameters params;
+  // Long enough for the mean rate of the bursty distributions to converge
+  params.measurement_window_ms = 1000;
+  params.max_trials = 40;
+  params.max_threads = 4;
+  double min_interval_cv{0.0};
+  double max_interval_cv{0.0};
+
+  SUBCASE("constant")
+  {
+    params.request_distribution = CONSTANT;
+  }
+
+  SUBCASE("poisson")
+  {
+    params.request_distribution = POISSON;
+    min_interval_cv = 0.9;
+    max_interval_cv = 1.1;
+  }
+
+  SUBCASE("gamma")
+  {
+    params.request_distribution = GAMMA;
+    params.arrival_process_options.gamma_cv_ = 3.0;
+    min_interval_cv = 2.5;
+    max_interval_cv = 3.5;
+  }
+
+  SUBCASE("mmpp")
+  {
+    params.request_distribution = MMPP;
+    params.arrival_process_options.mmpp_burst_ms_ = 10;
+    params.arrival_process_options.mmpp_idle_ms_ = 90;
+    min_interval_cv = 1.2;
+    max_interval_cv = 100.0;
+  }
+
+  SUBCASE("pareto on-off")
+  {
+    params.request_distribution = PARETO_ON_OFF;
+    params.arrival_process_options.pareto_alpha_ = 2.5;
+    params.arrival_process_options.pareto_on_ms_ = 5;
+    params.arrival_process_options.pareto_off_ms_ = 20;
+    min_interval_cv = 1.2;
+    max_interval_cv = 100.0;
+  }
+
+  TestRequestRateManager trrm(params);
+  trrm.SetArrivalProcessOptions(params.arrival_process_options);
+  trrm.InitManager(
+      params.string_length, params.string_data, params.zero_input,
+      params.user_data, params.start_sequence_id, params.sequence_id_range,
+      params.sequence_length, params.sequence_length_specified,
+      params.sequence_length_variation);
+  trrm.TestScheduleStats(1000, min_interval_cv, max_interval_cv);
+}
+
 TEST_CASE("request rate create schedule")
 {
   PerfAnalyzerParameters params;
@@ -0,0 +1,143 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "doctest.h"
+#include "resource_usage.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("resource_usage: sample the process")
+{
+  ResourceUsageSample start;
+  REQUIRE(SampleResourceUsage(&start).IsOk());
+  CHECK(start.rss_bytes > 0);
+  CHECK(start.thread_cpu_ns.count(getpid()) == 1);
+
+  // Use some CPU time in a new thread
+  std::thread busy_thread([]() {
+    const auto end{
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(50)};
+    volatile uint64_t spins{0};
+    while (std::chrono::steady_clock::now() < end) {
+      spins = spins + 1;
+    }
+  });
+  busy_thread.join();
+
+  ResourceUsageSample end;
+  REQUIRE(SampleResourceUsage(&end).IsOk());
+  const ResourceUsageStats stats{SummarizeResourceUsage(start, end)};
+  CHECK(stats.duration_ns >= 50000000);
+  CHECK(stats.user_cpu_ns + stats.system_cpu_ns > 0);
+  CHECK(stats.cpu_utilization > 0.0);
+}
+
+TEST_CASE("resource_usage: summarize samples")
+{
+  ResourceUsageSample start;
+  start.timestamp_ns = 1000;
+  start.user_cpu_ns = 100;
+  start.system_cpu_ns = 50;
+  start.voluntary_context_switches = 3;
+  start.involuntary_context_switches = 1;
+  start.minor_page_faults = 10;
+  start.major_page_faults = 0;
+  start.rss_bytes = 4096;
+  start.has_heap_stats = true;
+  start.heap_in_use_bytes = 2000;
+  start.thread_cpu_ns = {{1, 100}, {2, 50}};
+
+  ResourceUsageSample end{start};
+  end.timestamp_ns = 2000;
+  end.user_cpu_ns = 700;
+  end.system_cpu_ns = 250;
+  end.voluntary_context_switches = 8;
+  end.involuntary_context_switches = 3;
+  end.minor_page_faults = 15;
+  end.major_page_faults = 1;
+  end.rss_bytes = 2048;
+  end.heap_in_use_bytes = 3000;
+  // Thread 2 exited and thread 3 started during the period
+  end.thread_cpu_ns = {{1, 400}, {3, 450}};
+
+  const ResourceUsageStats stats{SummarizeResourceUsage(start, end)};
+  CHECK(stats.duration_ns == 1000);
+  CHECK(stats.user_cpu_ns == 600);
+  CHECK(stats.system_cpu_ns == 200);
+  CHECK(stats.voluntary_context_switches == 5);
+  CHECK(stats.involuntary_context_switches == 2);
+  CHECK(stats.minor_page_faults == 5);
+  CHECK(stats.major_page_faults == 1);
+  CHECK(stats.rss_bytes == 2048);
+  CHECK(stats.rss_growth_bytes == -2048);
+  CHECK(stats.has_heap_stats);
+  CHECK(stats.heap_growth_bytes == 1000);
+  CHECK(stats.cpu_utilization == doctest::Approx(0.8));
+  CHECK(stats.max_thread_cpu_utilization == doctest::Approx(0.45));
+
+  SUBCASE("accumulate periods")
+  {
+    ResourceUsageStats total;
+    AccumulateResourceUsage(stats, &total);
+    ResourceUsageStats second{stats};
+    second.user_cpu_ns = 1000;
+    second.system_cpu_ns = 800;
+    second.max_thread_cpu_utilization = 0.95;
+    second.rss_bytes = 8192;
+    second.rss_growth_bytes = 6144;
+    AccumulateResourceUsage(second, &total);
+
+    CHECK(total.duration_ns == 2000);
+    CHECK(total.user_cpu_ns == 1600);
+    CHECK(total.system_cpu_ns == 1000);
+    CHECK(total.voluntary_context_switches == 10);
+    CHECK(total.rss_bytes == 8192);
+    CHECK(total.rss_growth_bytes == 4096);
+    CHECK(total.heap_growth_bytes == 2000);
+    CHECK(total.cpu_utilization == doctest::Approx(1.3));
+    CHECK(total.max_thread_cpu_utilization == doctest::Approx(0.95));
+  }
+
+  SUBCASE("CPU saturation")
+  {
+    CHECK_FALSE(IsCpuSaturated(stats, 2));
+    CHECK_FALSE(IsCpuSaturated(stats, 1));
+    ResourceUsageStats saturated{stats};
+    saturated.cpu_utilization = 1.85;
+    CHECK(IsCpuSaturated(saturated, 2));
+    saturated.cpu_utilization = 0.5;
+    saturated.max_thread_cpu_utilization = 0.97;
+    CHECK(IsCpuSaturated(saturated, 8));
+  }
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,116 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "doctest.h"
+#include "timeline_collector.h"
+
+namespace triton { namespace perfanalyzer {
+
+class TestTimelineCollector {
+ public:
+  static std::string WriteTimeline(
+      const uint64_t interval_ms, const std::vector<RequestRecord>& requests,
+      const std::vector<Metrics>& metrics = {})
+  {
+    std::shared_ptr<TimelineCollector> collector;
+    REQUIRE(TimelineCollector::Create(interval_ms, &collector).IsOk());
+    collector->AddRequests(requests);
+    collector->AddMetrics(metrics);
+    std::stringstream ss;
+    collector->WriteTimeline(ss);
+    return ss.str();
+  }
+};
+
+TEST_CASE("timeline_collector: write timeline")
+{
+  const auto clock_epoch{std::chrono::time_point<std::chrono::system_clock>()};
+  const auto record{[&](uint64_t start_ms, uint64_t end_ms, bool delayed) {
+    return RequestRecord{
+        clock_epoch + std::chrono::milliseconds(start_ms),
+        {clock_epoch + std::chrono::milliseconds(end_ms)},
+        false,
+        delayed,
+        0,
+        false};
+  }};
+
+  SUBCASE("requests")
+  {
+    // Two requests completing in the first interval and one in flight over
+    // the second and third. The p50 latency of the first interval is the
+    // recorded minimum, the higher percentiles are clamped to the maximum.
+    const std::string timeline{TestTimelineCollector::WriteTimeline(
+        100,
+        {record(0, 20, false), record(50, 60, true), record(150, 250, false)})};
+    CHECK(
+        timeline ==
+        "Timestamp,Request Count,Response Count,Delayed Request Count,"
+        "Requests/Second,Avg In Flight,p50 latency,p90 latency,p95 latency,"
+        "p99 latency,Max latency\n"
+        "0,2,2,1,20,0.3,10000,20000,20000,20000,20000\n"
+        "100000000,0,0,0,0,0.5,0,0,0,0,0\n"
+        "200000000,1,1,0,10,0.5,100000,100000,100000,100000,100000\n");
+  }
+
+  SUBCASE("metrics")
+  {
+    Metrics metrics{};
+    metrics.gpu_utilization_per_gpu = {{"gpu0", 0.5}};
+    metrics.gpu_power_usage_per_gpu = {{"gpu0", 100.0}};
+    metrics.gpu_memory_used_bytes_per_gpu = {{"gpu0", 1000}};
+    metrics.gpu_memory_total_bytes_per_gpu = {{"gpu0", 4000}};
+    metrics.timestamp_ns = 10000000;
+    Metrics later_metrics{metrics};
+    later_metrics.gpu_utilization_per_gpu = {{"gpu0", 1.0}};
+    later_metrics.gpu_memory_used_bytes_per_gpu = {{"gpu0", 2000}};
+    later_metrics.timestamp_ns = 60000000;
+
+    const std::string timeline{TestTimelineCollector::WriteTimeline(
+        100, {record(0, 20, false)}, {metrics, later_metrics})};
+    CHECK(
+        timeline ==
+        "Timestamp,Request Count,Response Count,Delayed Request Count,"
+        "Requests/Second,Avg In Flight,p50 latency,p90 latency,p95 latency,"
+        "p99 latency,Max latency,Avg GPU Utilization,Avg GPU Power Usage,"
+        "Max GPU Memory Usage,Total GPU Memory\n"
+        "0,1,1,0,10,0.2,20000,20000,20000,20000,20000,gpu0:0.75;,gpu0:100;,"
+        "gpu0:2000;,gpu0:4000;\n");
+  }
+
+  SUBCASE("zero interval")
+  {
+    std::shared_ptr<TimelineCollector> collector;
+    CHECK(!TimelineCollector::Create(0, &collector).IsOk());
+  }
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,129 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "doctest.h"
+#include "workload.h"
+
+namespace triton { namespace perfanalyzer {
+
+cb::Error
+ParseWorkloadStr(const std::string& str, std::vector<WorkloadModel>* models)
+{
+  rapidjson::Document d{};
+  d.Parse(str.c_str());
+  return ParseWorkload(d, models);
+}
+
+TEST_CASE("workload: parse")
+{
+  std::vector<WorkloadModel> models;
+
+  SUBCASE("all fields")
+  {
+    REQUIRE(ParseWorkloadStr(
+                R"({"models": [
+                  {"name": "a", "version": "2", "weight": 3,
+                   "input_data": ["a0.json", "a1.json"], "slo_latency_ms": 20},
+                  {"name": "b", "input_data": "b.json"}
+                ]})",
+                &models)
+                .IsOk());
+    REQUIRE(models.size() == 2);
+    CHECK(models[0].name_ == "a");
+    CHECK(models[0].version_ == "2");
+    CHECK(models[0].weight_ == doctest::Approx(3.0));
+    CHECK(
+        models[0].input_data_ ==
+        std::vector<std::string>{"a0.json", "a1.json"});
+    CHECK(models[0].slo_latency_ms_ == 20);
+    CHECK(models[1].name_ == "b");
+    CHECK(models[1].version_ == "");
+    CHECK(models[1].weight_ == doctest::Approx(1.0));
+    CHECK(models[1].input_data_ == std::vector<std::string>{"b.json"});
+    CHECK(models[1].slo_latency_ms_ == 0);
+  }
+
+  SUBCASE("invalid workloads")
+  {
+    CHECK_FALSE(ParseWorkloadStr("bad json text", &models).IsOk());
+    CHECK_FALSE(ParseWorkloadStr(R"({"models": []})", &models).IsOk());
+    CHECK_FALSE(ParseWorkloadStr(R"({"model": [{"name": "a"}]})", &models)
+                    .IsOk());
+    CHECK_FALSE(
+        ParseWorkloadStr(R"({"models": [{"version": "1"}]})", &models).IsOk());
+    CHECK_FALSE(
+        ParseWorkloadStr(R"({"models": [{"name": "a", "weight": 0}]})", &models)
+            .IsOk());
+    CHECK_FALSE(ParseWorkloadStr(
+                    R"({"models": [{"name": "a", "input_data": 1}]})", &models)
+                    .IsOk());
+    CHECK_FALSE(
+        ParseWorkloadStr(
+            R"({"models": [{"name": "a", "slo_latency_ms": -1}]})", &models)
+            .IsOk());
+    CHECK_FALSE(ParseWorkloadStr(
+                    R"({"models": [{"name": "a"}, {"name": "a"}]})", &models)
+                    .IsOk());
+  }
+}
+
+TEST_CASE("workload: model selector")
+{
+  SUBCASE("requests follow the weights")
+  {
+    ModelSelector selector({3.0, 1.0, 2.0});
+    std::map<size_t, size_t> counts;
+    for (size_t i = 0; i < 600; ++i) {
+      counts[selector.Next()]++;
+    }
+    CHECK(counts[0] == 300);
+    CHECK(counts[1] == 100);
+    CHECK(counts[2] == 200);
+  }
+
+  SUBCASE("models are interleaved")
+  {
+    ModelSelector selector({1.0, 1.0});
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < 4; ++i) {
+      indices.push_back(selector.Next());
+    }
+    CHECK(indices == std::vector<size_t>{0, 1, 0, 1});
+
+    ModelSelector weighted_selector({2.0, 1.0});
+    indices.clear();
+    for (size_t i = 0; i < 6; ++i) {
+      indices.push_back(weighted_selector.Next());
+    }
+    CHECK(indices == std::vector<size_t>{0, 1, 0, 0, 1, 0});
+  }
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,197 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "timeline_collector.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// The reported percentiles of the latencies of each interval
+const std::vector<size_t> kTimelinePercentiles{50, 90, 95, 99};
+
+// Write the per GPU values of 'values' in the format of the GPU metrics of
+// the csv report
+template <typename T>
+void
+WriteGpuValues(std::ostream& os, const std::map<std::string, T>& values)
+{
+  os << ",";
+  for (const auto& entry : values) {
+    os << entry.first << ":" << entry.second << ";";
+  }
+}
+
+}  // namespace
+
+cb::Error
+TimelineCollector::Create(
+    const uint64_t interval_ms, std::shared_ptr<TimelineCollector>* collector)
+{
+  if (interval_ms == 0) {
+    return cb::Error(
+        "The interval of the timeline must be positive.", GENERIC_ERROR);
+  }
+  std::shared_ptr<TimelineCollector> local_collector{
+      new TimelineCollector(interval_ms)};
+  *collector = std::move(local_collector);
+  return cb::Error::Success;
+}
+
+void
+TimelineCollector::AddRequests(
+    const std::vector<RequestRecord>& request_records)
+{
+  for (const auto& request_record : request_records) {
+    if (request_record.response_times_.empty()) {
+      continue;
+    }
+    const uint64_t start_ns = CHRONO_TO_NANOS(request_record.start_time_);
+    uint64_t end_ns = CHRONO_TO_NANOS(request_record.response_times_.back());
+    size_t response_count{request_record.response_times_.size()};
+    // A final null response doesn't count as the end of the request
+    if (request_record.has_null_last_response_) {
+      if (--response_count == 0) {
+        continue;
+      }
+      end_ns = CHRONO_TO_NANOS(
+          request_record.response_times_[response_count - 1]);
+    }
+    if (end_ns < start_ns) {
+      continue;
+    }
+
+    auto& end_interval{intervals_[end_ns / interval_ns_]};
+    end_interval.request_count++;
+    end_interval.response_count += response_count;
+    if (request_record.delayed_) {
+      end_interval.delayed_request_count++;
+    }
+    end_interval.latency.Add(end_ns - start_ns);
+
+    for (uint64_t index = start_ns / interval_ns_;
+         index <= end_ns / interval_ns_; ++index) {
+      const uint64_t overlap_start_ns{std::max(start_ns, index * interval_ns_)};
+      const uint64_t overlap_end_ns{
+          std::min(end_ns, (index + 1) * interval_ns_)};
+      intervals_[index].in_flight_ns += overlap_end_ns - overlap_start_ns;
+    }
+  }
+}
+
+void
+TimelineCollector::AddMetrics(const std::vector<Metrics>& metrics)
+{
+  for (const auto& sample : metrics) {
+    intervals_[sample.timestamp_ns / interval_ns_].metrics.push_back(sample);
+  }
+}
+
+cb::Error
+TimelineCollector::Write(const std::string& file_path) const
+{
+  std::ofstream ofs(file_path, std::ofstream::out);
+  if (!ofs.is_open()) {
+    return cb::Error(
+        "failed to open file '" + file_path + "' for writing the timeline",
+        GENERIC_ERROR);
+  }
+  WriteTimeline(ofs);
+  return cb::Error::Success;
+}
+
+void
+TimelineCollector::WriteTimeline(std::ostream& os) const
+{
+  const bool has_metrics{std::any_of(
+      intervals_.begin(), intervals_.end(),
+      [](const std::pair<const uint64_t, TimelineInterval>& interval) {
+        return !interval.second.metrics.empty();
+      })};
+  const double interval_s{
+      static_cast<double>(interval_ns_) / NANOS_PER_SECOND};
+
+  os << "Timestamp,Request Count,Response Count,Delayed Request Count,"
+     << "Requests/Second,Avg In Flight";
+  for (const auto percentile : kTimelinePercentiles) {
+    os << ",p" << percentile << " latency";
+  }
+  os << ",Max latency";
+  if (has_metrics) {
+    os << ",Avg GPU Utilization,Avg GPU Power Usage,Max GPU Memory Usage,"
+       << "Total GPU Memory";
+  }
+  os << std::endl;
+
+  for (const auto& entry : intervals_) {
+    const auto& interval{entry.second};
+    os << entry.first * interval_ns_ << "," << interval.request_count << ","
+       << interval.response_count << "," << interval.delayed_request_count
+       << "," << interval.request_count / interval_s << ","
+       << static_cast<double>(interval.in_flight_ns) / interval_ns_;
+    for (const auto percentile : kTimelinePercentiles) {
+      os << "," << interval.latency.Percentile(percentile) / 1000;
+    }
+    os << "," << interval.latency.max_ns / 1000;
+
+    if (has_metrics) {
+      // Average the utilization and power and take the peak memory usage of
+      // the samples in the interval
+      std::map<std::string, double> gpu_utilization;
+      std::map<std::string, double> gpu_power_usage;
+      std::map<std::string, uint64_t> gpu_memory_used_bytes;
+      std::map<std::string, uint64_t> gpu_memory_total_bytes;
+      for (const auto& sample : interval.metrics) {
+        for (const auto& gpu : sample.gpu_utilization_per_gpu) {
+          gpu_utilization[gpu.first] +=
+              gpu.second / interval.metrics.size();
+        }
+        for (const auto& gpu : sample.gpu_power_usage_per_gpu) {
+          gpu_power_usage[gpu.first] +=
+              gpu.second / interval.metrics.size();
+        }
+        for (const auto& gpu : sample.gpu_memory_used_bytes_per_gpu) {
+          gpu_memory_used_bytes[gpu.first] =
+              std::max(gpu_memory_used_bytes[gpu.first], gpu.second);
+        }
+        for (const auto& gpu : sample.gpu_memory_total_bytes_per_gpu) {
+          gpu_memory_total_bytes[gpu.first] = gpu.second;
+        }
+      }
+      WriteGpuValues(os, gpu_utilization);
+      WriteGpuValues(os, gpu_power_usage);
+      WriteGpuValues(os, gpu_memory_used_bytes);
+      WriteGpuValues(os, gpu_memory_total_bytes);
+    }
+    os << std::endl;
+  }
+}
+
+}}  // namespace triton::perfanalyzer
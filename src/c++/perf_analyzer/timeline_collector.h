@@ -0,0 +1,111 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "client_backend/client_backend.h"
+#include "common.h"
+#include "metrics.h"
+#include "perf_utils.h"
+#include "request_record.h"
+
+namespace triton { namespace perfanalyzer {
+
+#ifndef DOCTEST_CONFIG_DISABLE
+class TestTimelineCollector;
+#endif
+
+/// The measurements of one interval of the timeline.
+struct TimelineInterval {
+  // The number of requests that completed in the interval
+  uint64_t request_count{0};
+  uint64_t response_count{0};
+  // The number of the completed requests that missed their schedule
+  uint64_t delayed_request_count{0};
+  // The total time the requests were in flight during the interval, divided
+  // by the length of the interval it is the average number of requests in
+  // flight
+  uint64_t in_flight_ns{0};
+  // The latencies of the requests that completed in the interval
+  triton::client::LatencyHistogram latency{};
+  // The server-side metrics scraped in the interval
+  std::vector<Metrics> metrics{};
+};
+
+/// Collects the request records and server-side metrics of all the
+/// measurement windows into a timeline of fixed length intervals, to show
+/// how throughput and latency change within a run.
+class TimelineCollector {
+ public:
+  /// Create a timeline collector.
+  /// \param interval_ms The length of the intervals of the timeline.
+  /// \param collector Returns a new TimelineCollector object.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Create(
+      const uint64_t interval_ms,
+      std::shared_ptr<TimelineCollector>* collector);
+
+  /// Add the request records of a measurement window to the timeline. A
+  /// request counts in the interval it completed in and in flight in each
+  /// interval it overlaps.
+  void AddRequests(const std::vector<RequestRecord>& request_records);
+
+  /// Add the server-side metrics scraped during a measurement window.
+  void AddMetrics(const std::vector<Metrics>& metrics);
+
+  /// Write the timeline as a csv file, one row per interval that has any
+  /// request or metrics.
+  /// \param file_path The path of the file to write.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Write(const std::string& file_path) const;
+
+ private:
+  TimelineCollector(const uint64_t interval_ms)
+      : interval_ns_(interval_ms * NANOS_PER_MILLIS)
+  {
+  }
+
+  void WriteTimeline(std::ostream& os) const;
+
+  uint64_t interval_ns_{NANOS_PER_SECOND};
+  // The intervals by their index since the clock epoch
+  std::map<uint64_t, TimelineInterval> intervals_{};
+
+#ifndef DOCTEST_CONFIG_DISABLE
+  friend TestTimelineCollector;
+
+ public:
+  TimelineCollector() = default;
+#endif
+};
+
+}}  // namespace triton::perfanalyzer
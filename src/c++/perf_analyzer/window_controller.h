@@ -0,0 +1,79 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace triton { namespace perfanalyzer {
+
+/// Counts the completed requests of all the worker threads and wakes the
+/// profiler when a target count is reached, so a count based measurement
+/// window ends as soon as it has enough requests without polling the worker
+/// threads. Counting a request only takes the lock when it reaches the
+/// target.
+class WindowController {
+ public:
+  /// Count a completed request. Called by the worker threads.
+  void RequestCompleted()
+  {
+    if (++completed_requests_ == target_) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cv_.notify_all();
+    }
+  }
+
+  /// \return The number of requests completed since the start of the run.
+  uint64_t CompletedRequests() const { return completed_requests_; }
+
+  /// Wait until the number of completed requests reaches 'target'.
+  /// \param target The number of completed requests to wait for.
+  /// \param timeout The maximum time to wait.
+  /// \return Whether the target was reached.
+  bool WaitForCompletedRequests(
+      const uint64_t target, const std::chrono::nanoseconds timeout)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Set the target before checking the count, a request that reaches the
+    // target after the check finds it and wakes the wait
+    target_ = target;
+    return cv_.wait_for(lock, timeout, [this, target]() {
+      return completed_requests_ >= target;
+    });
+  }
+
+ private:
+  std::atomic<uint64_t> completed_requests_{0};
+  std::atomic<uint64_t> target_{UINT64_MAX};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+}}  // namespace triton::perfanalyzer
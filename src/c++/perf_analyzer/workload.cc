@@ -0,0 +1,188 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "workload.h"
+
+#include <rapidjson/filereadstream.h>
+
+#include <cstdio>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+cb::Error
+ParseWorkloadModel(const rapidjson::Value& json, WorkloadModel* model)
+{
+  if (!json.IsObject()) {
+    return cb::Error(
+        "The models of the workload file must be objects", pa::GENERIC_ERROR);
+  }
+
+  const auto name = json.FindMember("name");
+  if ((name == json.MemberEnd()) || !name->value.IsString() ||
+      (name->value.GetStringLength() == 0)) {
+    return cb::Error(
+        "The models of the workload file must have a name", pa::GENERIC_ERROR);
+  }
+  model->name_ = name->value.GetString();
+
+  const auto version = json.FindMember("version");
+  if (version != json.MemberEnd()) {
+    if (!version->value.IsString()) {
+      return cb::Error(
+          "The version of model '" + model->name_ + "' must be a string",
+          pa::GENERIC_ERROR);
+    }
+    model->version_ = version->value.GetString();
+  }
+
+  const auto weight = json.FindMember("weight");
+  if (weight != json.MemberEnd()) {
+    if (!weight->value.IsNumber() || (weight->value.GetDouble() <= 0.0)) {
+      return cb::Error(
+          "The weight of model '" + model->name_ + "' must be > 0",
+          pa::GENERIC_ERROR);
+    }
+    model->weight_ = weight->value.GetDouble();
+  }
+
+  const auto input_data = json.FindMember("input_data");
+  if (input_data != json.MemberEnd()) {
+    if (input_data->value.IsString()) {
+      model->input_data_.push_back(input_data->value.GetString());
+    } else if (input_data->value.IsArray()) {
+      for (const auto& path : input_data->value.GetArray()) {
+        if (!path.IsString()) {
+          return cb::Error(
+              "The input data of model '" + model->name_ +
+                  "' must be paths",
+              pa::GENERIC_ERROR);
+        }
+        model->input_data_.push_back(path.GetString());
+      }
+    } else {
+      return cb::Error(
+          "The input data of model '" + model->name_ +
+              "' must be a path or an array of paths",
+          pa::GENERIC_ERROR);
+    }
+  }
+
+  const auto slo_latency = json.FindMember("slo_latency_ms");
+  if (slo_latency != json.MemberEnd()) {
+    if (!slo_latency->value.IsUint64()) {
+      return cb::Error(
+          "The latency objective of model '" + model->name_ +
+              "' must be >= 0",
+          pa::GENERIC_ERROR);
+    }
+    model->slo_latency_ms_ = slo_latency->value.GetUint64();
+  }
+
+  return cb::Error::Success;
+}
+
+}  // namespace
+
+cb::Error
+ReadWorkloadFile(const std::string& path, std::vector<WorkloadModel>* models)
+{
+  FILE* workload_file = fopen(path.c_str(), "r");
+  if (workload_file == nullptr) {
+    return cb::Error(
+        "failed to open workload file '" + path + "'", pa::GENERIC_ERROR);
+  }
+
+  char readBuffer[65536];
+  rapidjson::FileReadStream fs(workload_file, readBuffer, sizeof(readBuffer));
+
+  rapidjson::Document d{};
+  d.ParseStream(fs);
+
+  fclose(workload_file);
+
+  return ParseWorkload(d, models);
+}
+
+cb::Error
+ParseWorkload(
+    const rapidjson::Document& json, std::vector<WorkloadModel>* models)
+{
+  if (json.HasParseError()) {
+    return cb::Error("failed to parse the workload file", pa::GENERIC_ERROR);
+  }
+
+  if (!json.IsObject() || !json.HasMember("models") ||
+      !json["models"].IsArray() || json["models"].Empty()) {
+    return cb::Error(
+        "The workload file must contain a non-empty models array",
+        pa::GENERIC_ERROR);
+  }
+
+  models->clear();
+  for (const auto& model_json : json["models"].GetArray()) {
+    WorkloadModel model;
+    RETURN_IF_ERROR(ParseWorkloadModel(model_json, &model));
+    for (const auto& other : *models) {
+      if ((other.name_ == model.name_) && (other.version_ == model.version_)) {
+        return cb::Error(
+            "Model '" + model.name_ + "' is listed twice in the workload file",
+            pa::GENERIC_ERROR);
+      }
+    }
+    models->push_back(std::move(model));
+  }
+
+  return cb::Error::Success;
+}
+
+ModelSelector::ModelSelector(const std::vector<double>& weights)
+    : weights_(weights), current_weights_(weights.size(), 0.0)
+{
+  for (const auto weight : weights_) {
+    total_weight_ += weight;
+  }
+}
+
+size_t
+ModelSelector::Next()
+{
+  // Every model gains its weight and the one ahead is chosen and set back by
+  // the total weight, so a model with twice the weight of another is chosen
+  // twice as often without the two being chosen in bursts
+  size_t next = 0;
+  for (size_t i = 0; i < weights_.size(); ++i) {
+    current_weights_[i] += weights_[i];
+    if (current_weights_[i] > current_weights_[next]) {
+      next = i;
+    }
+  }
+  current_weights_[next] -= total_weight_;
+  return next;
+}
+
+}}  // namespace triton::perfanalyzer
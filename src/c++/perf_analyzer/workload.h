@@ -0,0 +1,99 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <rapidjson/document.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "data_loader.h"
+#include "iinfer_data_manager.h"
+#include "model_parser.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// A model of a multi-model workload, as listed in the workload file.
+struct WorkloadModel {
+  std::string name_;
+  std::string version_;
+  // The share of the requests sent to the model, relative to the weights of
+  // the other models
+  double weight_{1.0};
+  // The paths to the input data of the model, generated data is used if empty
+  std::vector<std::string> input_data_;
+  // The latency objective of the requests to the model, 0 if none
+  uint64_t slo_latency_ms_{0};
+};
+
+/// Read the models of a workload file.
+/// \param path The path to the workload file.
+/// \param models Returns the models of the workload.
+/// \return cb::Error object indicating success or failure.
+cb::Error ReadWorkloadFile(
+    const std::string& path, std::vector<WorkloadModel>* models);
+
+/// Parse the models of a workload.
+/// \param json The workload, as a json object with a "models" array.
+/// \param models Returns the models of the workload.
+/// \return cb::Error object indicating success or failure.
+cb::Error ParseWorkload(
+    const rapidjson::Document& json, std::vector<WorkloadModel>* models);
+
+/// The objects the requests to a model of a workload are prepared with.
+struct ModelLoad {
+  std::shared_ptr<ModelParser> parser_;
+  std::shared_ptr<DataLoader> data_loader_;
+  std::shared_ptr<IInferDataManager> infer_data_manager_;
+  bool using_json_data_{false};
+  double weight_{1.0};
+};
+
+/// The models requests are spread over, the first one being the model of the
+/// load manager.
+using Workload = std::vector<ModelLoad>;
+
+/// Chooses the model of each request so that the models receive requests in
+/// proportion to their weights, interleaved as evenly as possible (smooth
+/// weighted round robin).
+class ModelSelector {
+ public:
+  ModelSelector() = default;
+
+  ModelSelector(const std::vector<double>& weights);
+
+  /// \return The index of the model of the next request.
+  size_t Next();
+
+ private:
+  std::vector<double> weights_;
+  std::vector<double> current_weights_;
+  double total_weight_{0.0};
+};
+
+}}  // namespace triton::perfanalyzer
@@ -24,13 +24,22 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+#include <unistd.h>
+
+#include <array>
 #include <fstream>
 
 #define TRITON_INFERENCE_SERVER_CLIENT_CLASS InferenceServerHttpClient
+#include "convert_utils.h"
 #include "grpc_client.h"
 #include "gtest/gtest.h"
 #include "http_client.cc"
 #include "http_client.h"
+#include "mock_server.h"
 
 namespace tc = triton::client;
 
@@ -101,6 +110,53 @@ class ClientTest : public ::testing::Test {
     return tc::Error::Success;
   }
 
+  // Prepares 3 requests with distinct 'options', 'inputs' and 'outputs',
+  // along with the outputs they are expected to produce.
+  tc::Error PrepareRequests(
+      std::vector<tc::InferOptions>* options,
+      std::vector<std::vector<tc::InferInput*>>* inputs,
+      std::vector<std::vector<const tc::InferRequestedOutput*>>* outputs,
+      std::vector<std::map<std::string, std::vector<int32_t>>>*
+          expected_outputs)
+  {
+    for (size_t i = 0; i < 3; ++i) {
+      options->emplace_back(this->model_name_);
+      // Not swap
+      options->back().model_version_ = "1";
+
+      const auto& input_0 = this->input_data_[i % this->input_data_.size()];
+      const auto& input_1 =
+          this->input_data_[(i + 1) % this->input_data_.size()];
+      inputs->emplace_back();
+      auto err = this->PrepareInputs(input_0, input_1, &inputs->back());
+      if (!err.IsOk()) {
+        return err;
+      }
+
+      tc::InferRequestedOutput* output;
+      outputs->emplace_back();
+      err = tc::InferRequestedOutput::Create(&output, "OUTPUT0");
+      if (!err.IsOk()) {
+        return err;
+      }
+      outputs->back().emplace_back(output);
+      err = tc::InferRequestedOutput::Create(&output, "OUTPUT1");
+      if (!err.IsOk()) {
+        return err;
+      }
+      outputs->back().emplace_back(output);
+
+      expected_outputs->emplace_back();
+      auto& expected_0 = expected_outputs->back()["OUTPUT0"];
+      auto& expected_1 = expected_outputs->back()["OUTPUT1"];
+      for (size_t j = 0; j < 16; ++j) {
+        expected_0.emplace_back(input_0[j] + input_1[j]);
+        expected_1.emplace_back(input_0[j] - input_1[j]);
+      }
+    }
+    return tc::Error::Success;
+  }
+
   void ValidateOutput(
       const std::vector<tc::InferResult*>& results,
       const std::vector<std::map<std::string, std::vector<int32_t>>>&
@@ -354,6 +410,104 @@ TYPED_TEST_P(ClientTest, InferMulti)
   EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(results, expected_outputs));
 }
 
+TYPED_TEST_P(ClientTest, InferZeroCopyInput)
+{
+  // Same as 'InferMulti' but with the input contents sent by reference,
+  // the split input checks that a tensor assembled from several buffers
+  // is delivered in order.
+  std::vector<tc::InferOptions> options;
+  std::vector<std::vector<tc::InferInput*>> inputs;
+  std::vector<std::vector<const tc::InferRequestedOutput*>> outputs;
+  std::vector<std::map<std::string, std::vector<int32_t>>> expected_outputs;
+  tc::Error err =
+      this->PrepareRequests(&options, &inputs, &outputs, &expected_outputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare requests: " << err.Message();
+  for (size_t i = 0; i < options.size(); ++i) {
+    options[i].zero_copy_input_ = true;
+
+    const auto& input_0 = this->input_data_[i % this->input_data_.size()];
+    tc::InferInput* input = inputs[i][0];
+    err = input->Reset();
+    ASSERT_TRUE(err.IsOk()) << "failed to reset input: " << err.Message();
+    for (size_t j = 0; j < input_0.size(); j += 4) {
+      err = input->AppendRaw(
+          reinterpret_cast<const uint8_t*>(input_0.data() + j),
+          4 * sizeof(int32_t));
+      ASSERT_TRUE(err.IsOk()) << "failed to set input: " << err.Message();
+    }
+  }
+
+  std::vector<tc::InferResult*> results;
+  err = this->client_->InferMulti(&results, options, inputs, outputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to perform multiple inferences: "
+                          << err.Message();
+  EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(results, expected_outputs));
+
+  std::promise<std::vector<tc::InferResult*>> p;
+  std::shared_future<std::vector<tc::InferResult*>> f = p.get_future();
+  err = this->client_->AsyncInferMulti(
+      [&p](std::vector<tc::InferResult*> async_results) {
+        p.set_value(std::move(async_results));
+      },
+      options, inputs, outputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to perform multiple inferences: "
+                          << err.Message();
+  EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(f.get(), expected_outputs));
+}
+
+TYPED_TEST_P(ClientTest, InferResponseCache)
+{
+  // Same as 'InferMulti' with the response cache enabled, the repeated
+  // requests must be served from the cache with identical outputs.
+  tc::ResponseCacheOptions cache_options;
+  cache_options.max_byte_size = 1 << 20;
+  tc::Error err = this->client_->SetResponseCache(cache_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to enable cache: " << err.Message();
+
+  std::vector<tc::InferOptions> options;
+  std::vector<std::vector<tc::InferInput*>> inputs;
+  std::vector<std::vector<const tc::InferRequestedOutput*>> outputs;
+  std::vector<std::map<std::string, std::vector<int32_t>>> expected_outputs;
+  err = this->PrepareRequests(&options, &inputs, &outputs, &expected_outputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare requests: " << err.Message();
+
+  std::vector<tc::InferResult*> results;
+  err = this->client_->InferMulti(&results, options, inputs, outputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to perform multiple inferences: "
+                          << err.Message();
+  EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(results, expected_outputs));
+
+  tc::InferStat infer_stat;
+  this->client_->ClientInferStat(&infer_stat);
+  EXPECT_EQ(infer_stat.cache_hit_count, 0u);
+  EXPECT_EQ(infer_stat.cache_miss_count, 3u);
+  const size_t completed_request_count = infer_stat.completed_request_count;
+
+  err = this->client_->InferMulti(&results, options, inputs, outputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to perform multiple inferences: "
+                          << err.Message();
+  EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(results, expected_outputs));
+
+  std::promise<std::vector<tc::InferResult*>> p;
+  std::shared_future<std::vector<tc::InferResult*>> f = p.get_future();
+  err = this->client_->AsyncInferMulti(
+      [&p](std::vector<tc::InferResult*> async_results) {
+        p.set_value(std::move(async_results));
+      },
+      options, inputs, outputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to perform multiple inferences: "
+                          << err.Message();
+  EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(f.get(), expected_outputs));
+
+  this->client_->ClientInferStat(&infer_stat);
+  EXPECT_EQ(infer_stat.cache_hit_count, 6u);
+  EXPECT_EQ(infer_stat.cache_miss_count, 3u);
+  EXPECT_EQ(infer_stat.completed_request_count, completed_request_count);
+
+  err = this->client_->SetResponseCache(tc::ResponseCacheOptions());
+  ASSERT_TRUE(err.IsOk()) << "failed to disable cache: " << err.Message();
+}
+
 TYPED_TEST_P(ClientTest, InferMultiDifferentOutputs)
 {
   tc::Error err = tc::Error::Success;
@@ -771,6 +925,146 @@ TYPED_TEST_P(ClientTest, AsyncInferMulti)
   EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(results, expected_outputs));
 }
 
+TYPED_TEST_P(ClientTest, AsyncInferAdmissionControl)
+{
+  // Limit the requests in flight to 1 so that the requests of
+  // AsyncInferMulti() are sent one after another.
+  tc::AdmissionControlOptions admission_options;
+  admission_options.max_in_flight = 1;
+  admission_options.policy = tc::AdmissionControlOptions::Policy::BLOCK;
+  tc::Error err = this->client_->SetAdmissionControl(admission_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to set admission control: "
+                          << err.Message();
+
+  std::vector<tc::InferOptions> options;
+  std::vector<std::vector<tc::InferInput*>> inputs;
+  std::vector<std::vector<const tc::InferRequestedOutput*>> outputs;
+  std::vector<std::map<std::string, std::vector<int32_t>>> expected_outputs;
+  err = this->PrepareRequests(&options, &inputs, &outputs, &expected_outputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare requests: " << err.Message();
+
+  std::vector<tc::InferResult*> results;
+  std::condition_variable cv;
+  std::mutex mu;
+  err = this->client_->AsyncInferMulti(
+      [&results, &cv, &mu](std::vector<tc::InferResult*> res) {
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          results.swap(res);
+        }
+        cv.notify_one();
+      },
+      options, inputs, outputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to perform multiple inferences: "
+                          << err.Message();
+
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [this, &results] { return !results.empty(); });
+  }
+  EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(results, expected_outputs));
+
+  tc::InferStat infer_stat;
+  err = this->client_->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.in_flight_limit, 1u);
+  EXPECT_EQ(infer_stat.in_flight_request_count, 0u);
+  EXPECT_EQ(infer_stat.queued_request_count, 0u);
+  EXPECT_EQ(infer_stat.shed_request_count, 0u);
+}
+
+TYPED_TEST_P(ClientTest, AsyncInferCancelled)
+{
+  // A request sent with a cancellation that is already cancelled must
+  // complete with an error instead of a response.
+  tc::InferOptions options(this->model_name_);
+  options.model_version_ = "1";
+  options.cancellation_ = std::make_shared<tc::InferCancellation>();
+  options.cancellation_->Cancel();
+  ASSERT_TRUE(options.cancellation_->IsCancelled());
+
+  std::vector<tc::InferInput*> inputs;
+  tc::Error err = this->PrepareInputs(
+      this->input_data_[0], this->input_data_[1], &inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  tc::InferResult* result = nullptr;
+  bool completed = false;
+  std::condition_variable cv;
+  std::mutex mu;
+  err = this->client_->AsyncInfer(
+      [&result, &completed, &cv, &mu](tc::InferResult* res) {
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          result = res;
+          completed = true;
+        }
+        cv.notify_one();
+      },
+      options, inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to send inference: " << err.Message();
+
+  std::unique_lock<std::mutex> lk(mu);
+  cv.wait(lk, [&completed] { return completed; });
+  std::unique_ptr<tc::InferResult> result_ptr(result);
+  EXPECT_FALSE(result->RequestStatus().IsOk())
+      << "expect the cancelled request to fail";
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TYPED_TEST_P(ClientTest, AsyncInferWarmup)
+{
+  // The asynchronous requests sent after the warmup must reuse the
+  // connections that it established.
+  tc::Error err = this->client_->Warmup(2);
+  ASSERT_TRUE(err.IsOk()) << "failed to warm up: " << err.Message();
+
+  tc::InferStat warm_stat;
+  err = this->client_->ClientInferStat(&warm_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(warm_stat.tls_handshake_count, 0u);
+
+  tc::InferOptions options(this->model_name_);
+  options.model_version_ = "1";
+  std::vector<tc::InferInput*> inputs;
+  err = this->PrepareInputs(
+      this->input_data_[0], this->input_data_[1], &inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  tc::InferResult* result = nullptr;
+  bool completed = false;
+  std::condition_variable cv;
+  std::mutex mu;
+  err = this->client_->AsyncInfer(
+      [&result, &completed, &cv, &mu](tc::InferResult* res) {
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          result = res;
+          completed = true;
+        }
+        cv.notify_one();
+      },
+      options, inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to send inference: " << err.Message();
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&completed] { return completed; });
+  }
+  std::unique_ptr<tc::InferResult> result_ptr(result);
+  EXPECT_TRUE(result->RequestStatus().IsOk())
+      << "inference failed: " << result->RequestStatus().Message();
+
+  tc::InferStat infer_stat;
+  err = this->client_->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.connection_count, warm_stat.connection_count);
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
 TYPED_TEST_P(ClientTest, AsyncInferMultiDifferentOutputs)
 {
   tc::Error err = tc::Error::Success;
@@ -2147,11 +2441,806 @@ TEST_F(HTTPJSONDataTest, ConvertJSONOutputToBinary)
   EXPECT_TRUE(err.IsOk() == false);
 }
 
+class HTTPRequestTemplateTest : public ::testing::Test {};
+
+TEST_F(HTTPRequestTemplateTest, ReplayHeader)
+{
+  // This tests that a request header replayed from HttpRequestTemplateCache
+  // is identical to the header generated from the JSON DOM, for requests
+  // that only differ in the request id and sequence fields.
+
+  tc::InferInput* input{};
+  tc::InferInput::Create(&input, "INPUT0", {1, 4}, "INT32");
+  std::shared_ptr<tc::InferInput> input_ptr(input);
+  int32_t input_data[4] = {1, 2, 3, 4};
+  input->AppendRaw(reinterpret_cast<uint8_t*>(input_data), sizeof(input_data));
+  std::vector<tc::InferInput*> inputs{input};
+
+  tc::InferRequestedOutput* output{};
+  tc::InferRequestedOutput::Create(&output, "OUTPUT0");
+  std::shared_ptr<tc::InferRequestedOutput> output_ptr(output);
+  std::vector<const tc::InferRequestedOutput*> outputs{output};
+
+  auto generate_header = [&](const tc::InferOptions& options) {
+    std::vector<char> request_body;
+    size_t header_length{0};
+    tc::Error err = tc::InferenceServerHttpClient::GenerateRequestBody(
+        &request_body, &header_length, options, inputs, outputs);
+    EXPECT_TRUE(err.IsOk()) << err.Message();
+    return std::string(request_body.data(), header_length);
+  };
+
+  tc::InferOptions options("model");
+  options.request_id_ = "first";
+  options.sequence_id_ = 1;
+  options.sequence_start_ = true;
+  options.priority_ = 2;
+
+  tc::HttpRequestTemplateCache cache;
+  std::string key;
+  ASSERT_TRUE(tc::HttpRequestTemplateCache::Fingerprint(
+      options, inputs, outputs, &key));
+  std::string header;
+  EXPECT_FALSE(cache.Lookup(key, options, &header));
+  cache.Insert(key, options, generate_header(options));
+
+  options.request_id_ = "second \"quoted\"\n";
+  options.sequence_id_ = 12345;
+  options.sequence_start_ = false;
+  options.sequence_end_ = true;
+  std::string next_key;
+  ASSERT_TRUE(tc::HttpRequestTemplateCache::Fingerprint(
+      options, inputs, outputs, &next_key));
+  EXPECT_EQ(key, next_key);
+  ASSERT_TRUE(cache.Lookup(next_key, options, &header));
+  EXPECT_EQ(header, generate_header(options));
+
+  // A different shape must not match the recorded template
+  input->SetShape({2, 2});
+  ASSERT_TRUE(tc::HttpRequestTemplateCache::Fingerprint(
+      options, inputs, outputs, &next_key));
+  EXPECT_NE(key, next_key);
+  EXPECT_FALSE(cache.Lookup(next_key, options, &header));
+
+  // Inputs sent as JSON embed the tensor data and can't be templated
+  input->SetBinaryData(false);
+  EXPECT_FALSE(tc::HttpRequestTemplateCache::Fingerprint(
+      options, inputs, outputs, &next_key));
+}
+
+#ifdef TRITON_ENABLE_ZLIB
+class HTTPRequestCompressorTest : public ::testing::Test {};
+
+TEST_F(HTTPRequestCompressorTest, AdaptiveCompression)
+{
+  // This tests that RequestCompressor skips the bodies below the size
+  // threshold, and stops compressing with an algorithm whose sampled ratio
+  // is poor until the next sample.
+
+  tc::HttpCompressionOptions compression_options;
+  compression_options.min_byte_size = 64;
+  compression_options.min_ratio = 2.0;
+  compression_options.sample_interval = 3;
+  tc::RequestCompressor compressor(compression_options);
+
+  std::vector<uint8_t> repetitive(4096, 7);
+  std::vector<uint8_t> random(4096);
+  uint32_t state = 1;
+  for (auto& byte : random) {
+    state = state * 1664525u + 1013904223u;
+    byte = state >> 24;
+  }
+
+  auto compress = [&](tc::InferenceServerHttpClient::CompressionType type,
+                      std::vector<uint8_t>& data, size_t byte_size) {
+    std::deque<std::pair<uint8_t*, size_t>> source{{data.data(), byte_size}};
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>> compressed_data;
+    const char* content_encoding = nullptr;
+    tc::Error err = compressor.Compress(
+        type, source, byte_size, &compressed_data, &content_encoding);
+    EXPECT_TRUE(err.IsOk()) << err.Message();
+    EXPECT_EQ(content_encoding == nullptr, compressed_data.empty());
+    return (content_encoding == nullptr) ? std::string()
+                                         : std::string(content_encoding);
+  };
+
+  using CompressionType = tc::InferenceServerHttpClient::CompressionType;
+  EXPECT_EQ(compress(CompressionType::GZIP, repetitive, 32), "");
+  EXPECT_EQ(compress(CompressionType::GZIP, repetitive, 4096), "gzip");
+
+  // The sampled request is compressed even though the ratio of random data
+  // is poor, the following requests are not until the next sample
+  EXPECT_EQ(compress(CompressionType::DEFLATE, random, 4096), "deflate");
+  EXPECT_EQ(compress(CompressionType::DEFLATE, random, 4096), "");
+  EXPECT_EQ(compress(CompressionType::DEFLATE, random, 4096), "");
+  EXPECT_EQ(compress(CompressionType::DEFLATE, repetitive, 4096), "deflate");
+  EXPECT_EQ(compress(CompressionType::DEFLATE, repetitive, 4096), "deflate");
+
+  // Samples are tracked for each algorithm
+  EXPECT_EQ(compress(CompressionType::GZIP, repetitive, 4096), "gzip");
+}
+#endif  // TRITON_ENABLE_ZLIB
+
+class LatencyHistogramTest : public ::testing::Test {};
+
+TEST_F(LatencyHistogramTest, Percentile)
+{
+  // This tests that the percentiles are within the bucket resolution of
+  // the exact values and clamped to the recorded range.
+  tc::LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Percentile(50), 0u);
+
+  for (uint64_t latency_us = 1; latency_us <= 1000; ++latency_us) {
+    histogram.Add(latency_us * 1000);
+  }
+  EXPECT_EQ(histogram.count, 1000u);
+  EXPECT_EQ(histogram.min_ns, 1000u);
+  EXPECT_EQ(histogram.max_ns, 1000000u);
+  EXPECT_EQ(histogram.sum_ns, 500500000u);
+  for (const double percentile : {50.0, 90.0, 99.0}) {
+    const double exact = percentile * 10000;
+    const uint64_t approximate = histogram.Percentile(percentile);
+    EXPECT_GE(approximate, exact) << "percentile " << percentile;
+    EXPECT_LE(approximate, exact * 1.19) << "percentile " << percentile;
+  }
+  EXPECT_EQ(histogram.Percentile(100), 1000000u);
+  EXPECT_EQ(histogram.Percentile(0), 1000u);
+
+  for (size_t bucket = 0; bucket + 1 < tc::LatencyHistogram::BUCKET_COUNT;
+       ++bucket) {
+    tc::LatencyHistogram bounds;
+    bounds.Add(tc::LatencyHistogram::BucketUpperBound(bucket));
+    bounds.Add(tc::LatencyHistogram::BucketUpperBound(bucket) + 1);
+    EXPECT_EQ(bounds.bucket_counts[bucket], 1u) << "bucket " << bucket;
+    EXPECT_EQ(bounds.bucket_counts[bucket + 1], 1u) << "bucket " << bucket;
+  }
+}
+
+class ConvertUtilsTest : public ::testing::Test {};
+
+TEST_F(ConvertUtilsTest, Conversions)
+{
+  // This tests the conversions against known values, with a count that
+  // isn't a multiple of the vector width so that both the vectorized and
+  // the scalar code are used.
+  const std::vector<std::pair<float, uint16_t>> fp16_values{
+      {1.0f, 0x3c00},     {-2.0f, 0xc000},    {65504.0f, 0x7bff},
+      {65520.0f, 0x7c00}, {1e-8f, 0x0000},    {5.9604645e-8f, 0x0001},
+      {0.1f, 0x2e66},     {1.00048828f, 0x3c00}};
+  const size_t count = 37;
+  std::vector<float> fp32(count);
+  for (size_t i = 0; i < count; ++i) {
+    fp32[i] = fp16_values[i % fp16_values.size()].first;
+  }
+  std::vector<uint16_t> fp16(count);
+  tc::Fp32ToFp16(fp32.data(), fp16.data(), count);
+  std::vector<float> roundtrip(count);
+  tc::Fp16ToFp32(fp16.data(), roundtrip.data(), count);
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(fp16[i], fp16_values[i % fp16_values.size()].second)
+        << "index " << i;
+    if ((fp16[i] != 0x7c00) && (fp16[i] != 0)) {
+      EXPECT_NEAR(roundtrip[i], fp32[i], std::fabs(fp32[i]) * 1e-3)
+          << "index " << i;
+    }
+  }
+
+  std::vector<uint16_t> bf16(count);
+  tc::Fp32ToBf16(fp32.data(), bf16.data(), count);
+  tc::Bf16ToFp32(bf16.data(), roundtrip.data(), count);
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_NEAR(roundtrip[i], fp32[i], std::fabs(fp32[i]) * 1e-2)
+        << "index " << i;
+  }
+
+  std::vector<uint8_t> int8;
+  ASSERT_TRUE(
+      tc::ConvertFromFp32(fp32.data(), count, "INT8", &int8, 0.5f, 3).IsOk());
+  ASSERT_EQ(int8.size(), count);
+  EXPECT_EQ(static_cast<int8_t>(int8[0]), 5);
+  EXPECT_EQ(static_cast<int8_t>(int8[1]), -1);
+  EXPECT_EQ(static_cast<int8_t>(int8[2]), 127);
+  EXPECT_EQ(static_cast<int8_t>(int8[4]), 3);
+  ASSERT_TRUE(tc::ConvertToFp32(
+                  int8.data(), int8.size(), "INT8", &roundtrip, 0.5f, 3)
+                  .IsOk());
+  EXPECT_EQ(roundtrip[0], 1.0f);
+  EXPECT_EQ(roundtrip[1], -2.0f);
+  EXPECT_EQ(roundtrip[2], 62.0f);
+
+  EXPECT_FALSE(tc::ConvertToFp32(int8.data(), 3, "FP16", &roundtrip).IsOk());
+  EXPECT_FALSE(
+      tc::ConvertFromFp32(fp32.data(), count, "INT32", &int8).IsOk());
+}
+
+TEST_F(ConvertUtilsTest, Transpose)
+{
+  // This tests that NCHW to NHWC transposes back to the original images
+  // for the element sizes with dedicated implementations and the others.
+  // The channels and the pixels of the second shape are multiples of 8, so
+  // that 4 byte elements are transposed in 8x8 blocks only with AVX2, and
+  // the third shape mixes the blocks with the edges.
+  const size_t n = 2;
+  const std::vector<std::array<size_t, 3>> shapes{
+      {3, 13, 11}, {8, 4, 6}, {10, 3, 6}};
+  for (const auto& shape : shapes) {
+    const size_t c = shape[0], h = shape[1], w = shape[2];
+    for (const size_t element_byte_size : {1, 2, 3, 4, 8}) {
+      std::vector<uint8_t> nchw(n * c * h * w * element_byte_size);
+      for (size_t i = 0; i < nchw.size(); ++i) {
+        nchw[i] = static_cast<uint8_t>(i * 7 + i / 251);
+      }
+      std::vector<uint8_t> nhwc(nchw.size());
+      tc::NchwToNhwc(nchw.data(), nhwc.data(), n, c, h, w, element_byte_size);
+      // Check pixel (y, x) of the last channel of the second image
+      const size_t y = h / 2, x = w / 2;
+      EXPECT_EQ(
+          std::memcmp(
+              &nhwc[(((1 * h + y) * w + x) * c + c - 1) * element_byte_size],
+              &nchw[(((1 * c + c - 1) * h + y) * w + x) * element_byte_size],
+              element_byte_size),
+          0)
+          << "c " << c << ", element size " << element_byte_size;
+
+      std::vector<uint8_t> transposed(nchw.size());
+      tc::NhwcToNchw(
+          nhwc.data(), transposed.data(), n, h, w, c, element_byte_size);
+      EXPECT_EQ(transposed, nchw)
+          << "c " << c << ", element size " << element_byte_size;
+    }
+  }
+}
+
+TEST_F(ConvertUtilsTest, AppendFromFp32)
+{
+  // This tests that the input holds the converted values and reuses its
+  // buffers after being reset.
+  tc::InferInput* input;
+  ASSERT_TRUE(tc::InferInput::Create(&input, "INPUT0", {4}, "FP16").IsOk());
+  std::shared_ptr<tc::InferInput> input_ptr(input);
+
+  const std::vector<float> values{1.0f, -2.0f, 0.5f, 0.0f};
+  ASSERT_TRUE(input->AppendFromFp32(values.data(), values.size()).IsOk());
+  size_t byte_size;
+  ASSERT_TRUE(input->ByteSize(&byte_size).IsOk());
+  EXPECT_EQ(byte_size, values.size() * sizeof(uint16_t));
+
+  ASSERT_TRUE(input->Reset().IsOk());
+  ASSERT_TRUE(input->AppendFromFp32(values.data(), 2).IsOk());
+  ASSERT_TRUE(input->AppendFromFp32(values.data() + 2, 2).IsOk());
+  ASSERT_TRUE(input->ByteSize(&byte_size).IsOk());
+  EXPECT_EQ(byte_size, values.size() * sizeof(uint16_t));
+
+  tc::InferInput* int32_input;
+  ASSERT_TRUE(
+      tc::InferInput::Create(&int32_input, "INPUT1", {4}, "INT32").IsOk());
+  std::shared_ptr<tc::InferInput> int32_input_ptr(int32_input);
+  EXPECT_FALSE(
+      int32_input->AppendFromFp32(values.data(), values.size()).IsOk());
+}
+
+class GRPCStreamStatTest : public ::testing::Test {
+ public:
+  GRPCStreamStatTest() : model_name_("onnx_int32_int32_int32") {}
+
+  void SetUp() override
+  {
+    std::string url;
+    url = "localhost:8001";
+    auto err = tc::InferenceServerGrpcClient::Create(&this->client_, url);
+    ASSERT_TRUE(err.IsOk())
+        << "failed to create GRPC client: " << err.Message();
+  }
+
+  std::string model_name_;
+  std::unique_ptr<tc::InferenceServerGrpcClient> client_;
+};
+
+TEST_F(GRPCStreamStatTest, ResponseLatencies)
+{
+  // This tests that the responses on the stream are matched with their
+  // requests by id, so that each request records one first response and
+  // one final response.
+  std::vector<int32_t> input_data(16, 1);
+  std::vector<std::unique_ptr<tc::InferInput>> inputs;
+  for (const auto& name : {"INPUT0", "INPUT1"}) {
+    tc::InferInput* input;
+    tc::Error err = tc::InferInput::Create(&input, name, {1, 16}, "INT32");
+    ASSERT_TRUE(err.IsOk()) << "failed to create input: " << err.Message();
+    inputs.emplace_back(input);
+    err = input->AppendRaw(
+        reinterpret_cast<uint8_t*>(input_data.data()),
+        input_data.size() * sizeof(int32_t));
+    ASSERT_TRUE(err.IsOk()) << "failed to set input data: " << err.Message();
+  }
+  std::vector<tc::InferInput*> raw_inputs{inputs[0].get(), inputs[1].get()};
+
+  const size_t request_count = 3;
+  size_t response_count = 0;
+  std::condition_variable cv;
+  std::mutex mu;
+  tc::Error err = this->client_->StartStream(
+      [&response_count, &cv, &mu](tc::InferResult* result) {
+        delete result;
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          response_count++;
+        }
+        cv.notify_one();
+      },
+      true /* enable_stats */);
+  ASSERT_TRUE(err.IsOk()) << "failed to start stream: " << err.Message();
+
+  for (size_t i = 0; i < request_count; ++i) {
+    tc::InferOptions options(this->model_name_);
+    options.request_id_ = std::to_string(i);
+    err = this->client_->AsyncStreamInfer(options, raw_inputs);
+    ASSERT_TRUE(err.IsOk()) << "failed to send inference: " << err.Message();
+  }
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&response_count, request_count] {
+      return response_count == request_count;
+    });
+  }
+  err = this->client_->StopStream();
+  ASSERT_TRUE(err.IsOk()) << "failed to stop stream: " << err.Message();
+
+  tc::InferStat infer_stat;
+  err = this->client_->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.completed_request_count, request_count);
+  EXPECT_EQ(infer_stat.first_response_latency.count, request_count);
+  EXPECT_EQ(infer_stat.inter_response_latency.count, 0u);
+  EXPECT_EQ(infer_stat.final_response_latency.count, request_count);
+  EXPECT_GE(
+      infer_stat.final_response_latency.min_ns,
+      infer_stat.first_response_latency.min_ns);
+}
+
+// Unlike the tests above, these tests start their own mock server and don't
+// need a running Triton server.
+class MockServerTest : public ::testing::Test {
+ public:
+  void SetUp() override
+  {
+    triton::mockserver::MockServerOptions options;
+    options.http_address = "127.0.0.1:0";
+    options.grpc_address = "127.0.0.1:0";
+    auto err = triton::mockserver::MockServer::Create(&this->server_, options);
+    ASSERT_TRUE(err.IsOk()) << "failed to start mock server: " << err.Message();
+    this->http_url_ = "127.0.0.1:" + std::to_string(this->server_->HttpPort());
+    this->grpc_url_ = "127.0.0.1:" + std::to_string(this->server_->GrpcPort());
+  }
+
+  tc::Error PrepareInputs(
+      const std::vector<int32_t>& input_data, const std::vector<int64_t>& shape,
+      const size_t count, std::vector<std::unique_ptr<tc::InferInput>>* inputs)
+  {
+    for (size_t i = 0; i < count; ++i) {
+      tc::InferInput* input;
+      auto err = tc::InferInput::Create(
+          &input, "INPUT" + std::to_string(i), shape, "INT32");
+      if (!err.IsOk()) {
+        return err;
+      }
+      inputs->emplace_back(input);
+      err = input->AppendRaw(
+          reinterpret_cast<const uint8_t*>(input_data.data()),
+          input_data.size() * sizeof(int32_t));
+      if (!err.IsOk()) {
+        return err;
+      }
+    }
+    return tc::Error::Success;
+  }
+
+  std::unique_ptr<triton::mockserver::MockServer> server_;
+  std::string http_url_;
+  std::string grpc_url_;
+};
+
+TEST_F(MockServerTest, AddSub)
+{
+  std::vector<int32_t> input_data(16);
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    input_data[i] = i;
+  }
+  std::vector<std::unique_ptr<tc::InferInput>> inputs;
+  auto err = PrepareInputs(input_data, {1, 16}, 2, &inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to create inputs: " << err.Message();
+  std::vector<tc::InferInput*> raw_inputs{inputs[0].get(), inputs[1].get()};
+  tc::InferOptions options("simple");
+
+  std::unique_ptr<tc::InferenceServerHttpClient> http_client;
+  err = tc::InferenceServerHttpClient::Create(&http_client, this->http_url_);
+  ASSERT_TRUE(err.IsOk()) << "failed to create client: " << err.Message();
+  std::unique_ptr<tc::InferenceServerGrpcClient> grpc_client;
+  err = tc::InferenceServerGrpcClient::Create(&grpc_client, this->grpc_url_);
+  ASSERT_TRUE(err.IsOk()) << "failed to create client: " << err.Message();
+
+  for (const bool http : {true, false}) {
+    tc::InferResult* result;
+    err = http ? http_client->Infer(&result, options, raw_inputs)
+               : grpc_client->Infer(&result, options, raw_inputs);
+    ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+    std::unique_ptr<tc::InferResult> result_ptr(result);
+    ASSERT_TRUE(result->RequestStatus().IsOk());
+    for (const auto& name : {"OUTPUT0", "OUTPUT1"}) {
+      const uint8_t* buf;
+      size_t byte_size;
+      err = result->RawData(name, &buf, &byte_size);
+      ASSERT_TRUE(err.IsOk()) << "failed to get output: " << err.Message();
+      ASSERT_EQ(byte_size, input_data.size() * sizeof(int32_t));
+      for (size_t i = 0; i < input_data.size(); ++i) {
+        int32_t value;
+        memcpy(&value, buf + i * sizeof(int32_t), sizeof(int32_t));
+        EXPECT_EQ(value, (name[6] == '0') ? 2 * input_data[i] : 0);
+      }
+    }
+  }
+
+  // The request of the wrong shape fails on both protocols.
+  std::vector<std::unique_ptr<tc::InferInput>> bad_inputs;
+  err = PrepareInputs(std::vector<int32_t>(8), {1, 8}, 2, &bad_inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to create inputs: " << err.Message();
+  std::vector<tc::InferInput*> raw_bad_inputs{
+      bad_inputs[0].get(), bad_inputs[1].get()};
+  tc::InferResult* result;
+  err = http_client->Infer(&result, options, raw_bad_inputs);
+  if (err.IsOk()) {
+    err = result->RequestStatus();
+    delete result;
+  }
+  EXPECT_FALSE(err.IsOk());
+  EXPECT_FALSE(grpc_client->Infer(&result, options, raw_bad_inputs).IsOk());
+
+  inference::ModelStatisticsResponse stats;
+  err = grpc_client->ModelInferenceStatistics(&stats, "simple");
+  ASSERT_TRUE(err.IsOk()) << "failed to get statistics: " << err.Message();
+  ASSERT_EQ(stats.model_stats_size(), 1);
+  EXPECT_EQ(stats.model_stats(0).inference_count(), 2u);
+  EXPECT_EQ(stats.model_stats(0).inference_stats().fail().count(), 2u);
+}
+
+TEST_F(MockServerTest, DecoupledStream)
+{
+  std::vector<std::unique_ptr<tc::InferInput>> inputs;
+  auto err = PrepareInputs({7}, {1}, 1, &inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to create inputs: " << err.Message();
+  std::vector<tc::InferInput*> raw_inputs{inputs[0].get()};
+
+  std::unique_ptr<tc::InferenceServerGrpcClient> client;
+  err = tc::InferenceServerGrpcClient::Create(&client, this->grpc_url_);
+  ASSERT_TRUE(err.IsOk()) << "failed to create client: " << err.Message();
+
+  size_t response_count = 0;
+  bool final_response = false;
+  std::condition_variable cv;
+  std::mutex mu;
+  err = client->StartStream(
+      [&response_count, &final_response, &cv, &mu](tc::InferResult* result) {
+        std::unique_ptr<tc::InferResult> result_ptr(result);
+        bool is_final = false;
+        bool is_null = false;
+        result->IsFinalResponse(&is_final);
+        result->IsNullResponse(&is_null);
+        std::lock_guard<std::mutex> lk(mu);
+        if (result->RequestStatus().IsOk() && !is_null) {
+          response_count++;
+        }
+        final_response = is_final;
+        cv.notify_one();
+      });
+  ASSERT_TRUE(err.IsOk()) << "failed to start stream: " << err.Message();
+
+  tc::InferOptions options("repeat");
+  options.triton_enable_empty_final_response_ = true;
+  err = client->AsyncStreamInfer(options, raw_inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to send inference: " << err.Message();
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&final_response] { return final_response; });
+  }
+  err = client->StopStream();
+  ASSERT_TRUE(err.IsOk()) << "failed to stop stream: " << err.Message();
+  EXPECT_EQ(response_count, 4u);
+
+  // Decoupled models can't be used without a stream.
+  tc::InferResult* result;
+  EXPECT_FALSE(client->Infer(&result, options, raw_inputs).IsOk());
+}
+
+TEST_F(MockServerTest, DecoupledStreamResponseLatencies)
+{
+  // Each request of the 'repeat' model gets 4 responses and an empty final
+  // response, which records one first response latency, 3 inter response
+  // latencies and one final response latency.
+  std::vector<std::unique_ptr<tc::InferInput>> inputs;
+  auto err = PrepareInputs({7}, {1}, 1, &inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to create inputs: " << err.Message();
+  std::vector<tc::InferInput*> raw_inputs{inputs[0].get()};
+
+  std::unique_ptr<tc::InferenceServerGrpcClient> client;
+  err = tc::InferenceServerGrpcClient::Create(&client, this->grpc_url_);
+  ASSERT_TRUE(err.IsOk()) << "failed to create client: " << err.Message();
+
+  const size_t request_count = 2;
+  size_t final_response_count = 0;
+  std::condition_variable cv;
+  std::mutex mu;
+  err = client->StartStream(
+      [&final_response_count, &cv, &mu](tc::InferResult* result) {
+        std::unique_ptr<tc::InferResult> result_ptr(result);
+        bool is_final = false;
+        result->IsFinalResponse(&is_final);
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          final_response_count += is_final ? 1 : 0;
+        }
+        cv.notify_one();
+      },
+      true /* enable_stats */);
+  ASSERT_TRUE(err.IsOk()) << "failed to start stream: " << err.Message();
+
+  for (size_t i = 0; i < request_count; ++i) {
+    tc::InferOptions options("repeat");
+    options.request_id_ = std::to_string(i);
+    options.triton_enable_empty_final_response_ = true;
+    err = client->AsyncStreamInfer(options, raw_inputs);
+    ASSERT_TRUE(err.IsOk()) << "failed to send inference: " << err.Message();
+  }
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&final_response_count, request_count] {
+      return final_response_count == request_count;
+    });
+  }
+  err = client->StopStream();
+  ASSERT_TRUE(err.IsOk()) << "failed to stop stream: " << err.Message();
+
+  tc::InferStat infer_stat;
+  err = client->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.completed_request_count, request_count);
+  EXPECT_EQ(infer_stat.first_response_latency.count, request_count);
+  EXPECT_EQ(infer_stat.inter_response_latency.count, 3 * request_count);
+  EXPECT_EQ(infer_stat.final_response_latency.count, request_count);
+  EXPECT_GE(
+      infer_stat.final_response_latency.min_ns,
+      infer_stat.first_response_latency.min_ns);
+  EXPECT_GE(
+      infer_stat.final_response_latency.max_ns,
+      infer_stat.first_response_latency.max_ns);
+}
+
+TEST_F(MockServerTest, HttpAsyncInfer)
+{
+  std::vector<int32_t> input_data(16, 3);
+  std::vector<std::unique_ptr<tc::InferInput>> inputs;
+  auto err = PrepareInputs(input_data, {1, 16}, 2, &inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to create inputs: " << err.Message();
+  std::vector<tc::InferInput*> raw_inputs{inputs[0].get(), inputs[1].get()};
+  tc::InferOptions options("simple");
+
+  std::unique_ptr<tc::InferenceServerHttpClient> client;
+  err = tc::InferenceServerHttpClient::Create(&client, this->http_url_);
+  ASSERT_TRUE(err.IsOk()) << "failed to create client: " << err.Message();
+
+  size_t completed_count = 0;
+  size_t success_count = 0;
+  std::condition_variable cv;
+  std::mutex mu;
+  auto callback = [&completed_count, &success_count, &cv,
+                   &mu](tc::InferResult* result) {
+    std::unique_ptr<tc::InferResult> result_ptr(result);
+    bool success = result->RequestStatus().IsOk();
+    const uint8_t* buf;
+    size_t byte_size;
+    if (success && result->RawData("OUTPUT0", &buf, &byte_size).IsOk() &&
+        (byte_size == 16 * sizeof(int32_t))) {
+      int32_t value;
+      memcpy(&value, buf, sizeof(int32_t));
+      success = (value == 6);
+    } else {
+      success = false;
+    }
+    {
+      std::lock_guard<std::mutex> lk(mu);
+      completed_count++;
+      success_count += success ? 1 : 0;
+    }
+    cv.notify_one();
+  };
+
+  // The worker must pick up the requests issued after the previous ones
+  // completed, one at a time and then several at once.
+  size_t expected_count = 0;
+  for (const size_t request_count : {1, 1, 4, 4}) {
+    for (size_t i = 0; i < request_count; ++i) {
+      err = client->AsyncInfer(callback, options, raw_inputs);
+      ASSERT_TRUE(err.IsOk()) << "failed to send inference: " << err.Message();
+    }
+    expected_count += request_count;
+    std::unique_lock<std::mutex> lk(mu);
+    ASSERT_TRUE(cv.wait_for(
+        lk, std::chrono::seconds(10), [&completed_count, expected_count] {
+          return completed_count == expected_count;
+        }))
+        << "timed out waiting for " << expected_count << " responses";
+  }
+  EXPECT_EQ(success_count, expected_count);
+}
+
+// Write a self-signed certificate for 'localhost' and its private key in
+// PEM files.
+bool
+GenerateCertificate(const std::string& cert_path, const std::string& key_path)
+{
+  EVP_PKEY* key = EVP_EC_gen("P-256");
+  X509* cert = X509_new();
+  bool ok = (key != nullptr) && (cert != nullptr);
+  if (ok) {
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), -60);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 24 * 60 * 60);
+    X509_set_pubkey(cert, key);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(
+        name, "CN", MBSTRING_ASC,
+        reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+
+    X509V3_CTX ctx;
+    X509V3_set_ctx_nodb(&ctx);
+    X509V3_set_ctx(&ctx, cert, cert, nullptr, nullptr, 0);
+    const std::pair<int, const char*> extensions[] = {
+        {NID_basic_constraints, "critical,CA:TRUE"},
+        {NID_subject_alt_name, "DNS:localhost,IP:127.0.0.1"}};
+    for (const auto& extension : extensions) {
+      X509_EXTENSION* ext = X509V3_EXT_conf_nid(
+          nullptr, &ctx, extension.first, extension.second);
+      ok = ok && (ext != nullptr) && (X509_add_ext(cert, ext, -1) == 1);
+      X509_EXTENSION_free(ext);
+    }
+    ok = ok && (X509_sign(cert, key, EVP_sha256()) != 0);
+  }
+  if (ok) {
+    FILE* file = fopen(cert_path.c_str(), "w");
+    ok = (file != nullptr) && (PEM_write_X509(file, cert) == 1);
+    if (file != nullptr) {
+      fclose(file);
+    }
+    file = fopen(key_path.c_str(), "w");
+    ok = ok && (file != nullptr) &&
+         (PEM_write_PrivateKey(
+              file, key, nullptr, nullptr, 0, nullptr, nullptr) == 1);
+    if (file != nullptr) {
+      fclose(file);
+    }
+  }
+  X509_free(cert);
+  EVP_PKEY_free(key);
+  return ok;
+}
+
+// Serves the mock server over TLS with a certificate generated for the
+// test.
+class MockServerTlsTest : public ::testing::Test {
+ public:
+  void SetUp() override
+  {
+    char dir[] = "/tmp/cc_client_test_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr) << "failed to create temporary directory";
+    this->dir_ = dir;
+    this->cert_path_ = this->dir_ + "/cert.pem";
+    this->key_path_ = this->dir_ + "/key.pem";
+    ASSERT_TRUE(GenerateCertificate(this->cert_path_, this->key_path_))
+        << "failed to generate certificate";
+
+    triton::mockserver::MockServerOptions options;
+    options.http_address = "127.0.0.1:0";
+    options.grpc_address = "127.0.0.1:0";
+    options.ssl_certificate_file = this->cert_path_;
+    options.ssl_private_key_file = this->key_path_;
+    auto err = triton::mockserver::MockServer::Create(&this->server_, options);
+    ASSERT_TRUE(err.IsOk()) << "failed to start mock server: " << err.Message();
+    this->http_url_ =
+        "https://localhost:" + std::to_string(this->server_->HttpPort());
+    this->grpc_url_ = "localhost:" + std::to_string(this->server_->GrpcPort());
+  }
+
+  void TearDown() override
+  {
+    this->server_.reset();
+    unlink(this->cert_path_.c_str());
+    unlink(this->key_path_.c_str());
+    rmdir(this->dir_.c_str());
+  }
+
+  std::string dir_;
+  std::string cert_path_;
+  std::string key_path_;
+  std::unique_ptr<triton::mockserver::MockServer> server_;
+  std::string http_url_;
+  std::string grpc_url_;
+};
+
+TEST_F(MockServerTlsTest, HttpSessionReuse)
+{
+  tc::HttpSslOptions ssl_options;
+  ssl_options.ca_info = this->cert_path_;
+  std::unique_ptr<tc::InferenceServerHttpClient> client;
+  auto err = tc::InferenceServerHttpClient::Create(
+      &client, this->http_url_, false /* verbose */, ssl_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create client: " << err.Message();
+
+  // The synchronous and the asynchronous requests don't share connections,
+  // the connection of the warmup must resume the TLS session established by
+  // the synchronous request.
+  bool live = false;
+  err = client->IsServerLive(&live);
+  ASSERT_TRUE(err.IsOk()) << "failed to get server liveness: "
+                          << err.Message();
+  EXPECT_TRUE(live);
+  err = client->Warmup(1);
+  ASSERT_TRUE(err.IsOk()) << "failed to warm up: " << err.Message();
+
+  tc::InferStat infer_stat;
+  err = client->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.connection_count, 2u);
+  EXPECT_EQ(infer_stat.tls_handshake_count, 2u);
+
+  const triton::mockserver::MockTlsStat tls_stat =
+      this->server_->HttpTlsStat();
+  EXPECT_EQ(tls_stat.handshake_count, 2u);
+  EXPECT_EQ(tls_stat.resumed_handshake_count, 1u);
+}
+
+TEST_F(MockServerTlsTest, GrpcSessionReuse)
+{
+  tc::SslOptions ssl_options;
+  ssl_options.root_certificates = this->cert_path_;
+
+  // Clients that don't share their channel, the second channel must resume
+  // the TLS session established by the first one.
+  for (size_t i = 0; i < 2; ++i) {
+    std::unique_ptr<tc::InferenceServerGrpcClient> client;
+    auto err = tc::InferenceServerGrpcClient::Create(
+        &client, this->grpc_url_, false /* verbose */, true /* use_ssl */,
+        ssl_options, tc::KeepAliveOptions(), false /* use_cached_channel */);
+    ASSERT_TRUE(err.IsOk()) << "failed to create client: " << err.Message();
+    err = client->Warmup(1);
+    ASSERT_TRUE(err.IsOk()) << "failed to warm up: " << err.Message();
+    // The server only sees the connection with a request.
+    bool live = false;
+    err = client->IsServerLive(&live);
+    ASSERT_TRUE(err.IsOk()) << "failed to get server liveness: "
+                            << err.Message();
+    EXPECT_TRUE(live);
+
+    tc::InferStat infer_stat;
+    err = client->ClientInferStat(&infer_stat);
+    ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+    EXPECT_EQ(infer_stat.connection_count, 1u);
+    EXPECT_EQ(infer_stat.tls_handshake_count, 1u);
+  }
+
+  const triton::mockserver::MockTlsStat tls_stat =
+      this->server_->GrpcTlsStat();
+  EXPECT_EQ(tls_stat.handshake_count, 2u);
+  EXPECT_EQ(tls_stat.resumed_handshake_count, 1u);
+}
+
 REGISTER_TYPED_TEST_SUITE_P(
-    ClientTest, InferMulti, InferMultiDifferentOutputs,
+    ClientTest, InferMulti, InferZeroCopyInput, InferResponseCache,
+    InferMultiDifferentOutputs,
     InferMultiDifferentOptions, InferMultiOneOption, InferMultiOneOutput,
     InferMultiNoOutput, InferMultiMismatchOptions, InferMultiMismatchOutputs,
-    AsyncInferMulti, AsyncInferMultiDifferentOutputs,
+    AsyncInferMulti, AsyncInferAdmissionControl, AsyncInferCancelled,
+    AsyncInferWarmup, AsyncInferMultiDifferentOutputs,
     AsyncInferMultiDifferentOptions, AsyncInferMultiOneOption,
     AsyncInferMultiOneOutput, AsyncInferMultiNoOutput,
     AsyncInferMultiMismatchOptions, AsyncInferMultiMismatchOutputs,
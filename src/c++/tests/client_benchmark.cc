@@ -0,0 +1,593 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Microbenchmarks of the client libraries: the serialization of requests,
+// the parsing of responses and the compression of request bodies for a
+// range of tensor sizes and datatypes, and the end-to-end throughput of
+// inference over loopback against an in-process mock server.
+//
+// The results are written as JSON for regression tracking with
+//
+//   client_benchmark --benchmark_out=results.json --benchmark_out_format=json
+//
+// and two result files can be compared with the 'compare.py' tool of
+// Google Benchmark.
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define TRITON_INFERENCE_SERVER_CLIENT_CLASS InferenceServerHttpClient
+#define TRITON_CLIENT_BENCHMARK_CLASS GrpcClientBenchmarkPeer
+#include "grpc_client.h"
+#include "http_client.cc"
+#include "http_client.h"
+#include "mock_server.h"
+
+namespace triton { namespace client {
+
+// Reaches the private request preparation of the GRPC client.
+class GrpcClientBenchmarkPeer {
+ public:
+  static Error PreRunProcessing(
+      InferenceServerGrpcClient* client, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs)
+  {
+    return client->PreRunProcessing(options, inputs, outputs);
+  }
+
+  static size_t RequestByteSize(InferenceServerGrpcClient* client)
+  {
+    return client->infer_request_.ByteSizeLong();
+  }
+};
+
+}}  // namespace triton::client
+
+namespace tc = triton::client;
+namespace ms = triton::mockserver;
+
+namespace {
+
+// The datatypes benchmarked, selected by index in the benchmark arguments.
+const char* kDatatypes[] = {"FP32", "INT64", "BYTES"};
+
+// The number of characters of each element of a BYTES tensor.
+constexpr size_t kStringLength = 16;
+
+// Tensor sizes, in number of elements, from a small request to a large
+// image or embedding batch.
+const std::vector<int64_t> kElementCounts = {16, 16 * 1024, 1024 * 1024};
+
+// Mark the benchmark as failed if 'err' is an error, returns whether 'err'
+// is a success.
+bool
+Ok(benchmark::State& state, const tc::Error& err)
+{
+  if (!err.IsOk()) {
+    state.SkipWithError(err.Message().c_str());
+    return false;
+  }
+  return true;
+}
+
+// An input tensor and the data it references.
+struct Tensor {
+  std::unique_ptr<tc::InferInput> input;
+  std::vector<uint8_t> raw;
+  std::vector<std::string> strings;
+  // The size of the serialized contents of the tensor.
+  size_t byte_size{0};
+};
+
+size_t
+DatatypeByteSize(const std::string& datatype)
+{
+  return (datatype == "INT64") ? sizeof(int64_t) : sizeof(float);
+}
+
+// Create input 'name' of 'count' elements of 'datatype' in 'tensor'. The
+// contents repeat a short pattern so that they compress as typical tensors
+// of quantized or padded values do.
+tc::Error
+MakeTensor(
+    const std::string& name, const std::string& datatype, const size_t count,
+    Tensor* tensor)
+{
+  tc::InferInput* input;
+  tc::Error err = tc::InferInput::Create(
+      &input, name, {1, static_cast<int64_t>(count)}, datatype);
+  if (!err.IsOk()) {
+    return err;
+  }
+  tensor->input.reset(input);
+
+  if (datatype == "BYTES") {
+    tensor->strings.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      std::string str = std::to_string(i % 1000);
+      str.resize(kStringLength, 'x');
+      tensor->strings.emplace_back(std::move(str));
+    }
+    tensor->byte_size = count * (sizeof(uint32_t) + kStringLength);
+    return input->AppendFromString(tensor->strings);
+  }
+
+  const size_t element_size = DatatypeByteSize(datatype);
+  tensor->raw.resize(count * element_size);
+  for (size_t i = 0; i < count; ++i) {
+    if (datatype == "INT64") {
+      const int64_t value = i % 256;
+      memcpy(&tensor->raw[i * element_size], &value, element_size);
+    } else {
+      const float value = (i % 256) / 8.0f;
+      memcpy(&tensor->raw[i * element_size], &value, element_size);
+    }
+  }
+  tensor->byte_size = tensor->raw.size();
+  return input->AppendRaw(tensor->raw);
+}
+
+// Serialize the HTTP/REST response of the 'identity' model returning
+// 'tensor' as OUTPUT0 into 'body', as binary data or as JSON.
+void
+MakeHttpResponse(
+    const std::string& datatype, const size_t count, const Tensor& tensor,
+    const bool binary_data, std::vector<char>* body, size_t* header_length)
+{
+  std::string header =
+      "{\"model_name\":\"identity\",\"model_version\":\"1\",\"outputs\":[{"
+      "\"name\":\"OUTPUT0\",\"datatype\":\"" +
+      datatype + "\",\"shape\":[1," + std::to_string(count) + "],";
+  if (binary_data) {
+    header += "\"parameters\":{\"binary_data_size\":" +
+              std::to_string(tensor.raw.size()) + "}}]}";
+    *header_length = header.size();
+    body->assign(header.begin(), header.end());
+    body->insert(body->end(), tensor.raw.begin(), tensor.raw.end());
+    return;
+  }
+
+  header += "\"data\":[";
+  for (size_t i = 0; i < count; ++i) {
+    if (i != 0) {
+      header += ",";
+    }
+    if (datatype == "BYTES") {
+      header += "\"" + tensor.strings[i] + "\"";
+    } else if (datatype == "INT64") {
+      header += std::to_string(i % 256);
+    } else {
+      header += std::to_string((i % 256) / 8.0f);
+    }
+  }
+  header += "]}]}";
+  *header_length = 0;
+  body->assign(header.begin(), header.end());
+}
+
+// The mock server shared by the loopback benchmarks, started on first use.
+ms::MockServer*
+LoopbackServer(benchmark::State& state)
+{
+  static std::unique_ptr<ms::MockServer> server;
+  if (server == nullptr) {
+    ms::MockServerOptions options;
+    options.http_address = "127.0.0.1:0";
+    options.grpc_address = "127.0.0.1:0";
+    options.models = ms::MockServer::DefaultModels();
+    if (!Ok(state, ms::MockServer::Create(&server, options))) {
+      server.reset();
+    }
+  }
+  return server.get();
+}
+
+void
+SetCounters(benchmark::State& state, const size_t byte_size)
+{
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * byte_size);
+}
+
+//==============================================================================
+// Serialization
+
+void
+BM_HttpGenerateRequestBody(benchmark::State& state)
+{
+  const std::string datatype = kDatatypes[state.range(1)];
+  Tensor tensor;
+  if (!Ok(state, MakeTensor("INPUT0", datatype, state.range(0), &tensor))) {
+    return;
+  }
+  tc::InferRequestedOutput* output;
+  if (!Ok(state, tc::InferRequestedOutput::Create(&output, "OUTPUT0"))) {
+    return;
+  }
+  std::unique_ptr<tc::InferRequestedOutput> output_ptr(output);
+
+  tc::InferOptions options("identity");
+  std::vector<tc::InferInput*> inputs = {tensor.input.get()};
+  std::vector<const tc::InferRequestedOutput*> outputs = {output};
+  std::vector<char> body;
+  size_t header_length;
+  for (auto _ : state) {
+    if (!Ok(state, tc::InferenceServerHttpClient::GenerateRequestBody(
+                       &body, &header_length, options, inputs, outputs))) {
+      break;
+    }
+    benchmark::DoNotOptimize(body.data());
+  }
+  SetCounters(state, tensor.byte_size);
+}
+
+// Time the header preparation of HttpInferRequest, with and without the
+// request template cache used by InferenceServerHttpClient.
+void
+BM_HttpPrepareRequestJson(benchmark::State& state)
+{
+  const bool use_template_cache = (state.range(1) != 0);
+  Tensor tensor;
+  if (!Ok(state, MakeTensor("INPUT0", "FP32", state.range(0), &tensor))) {
+    return;
+  }
+  tc::InferRequestedOutput* output;
+  if (!Ok(state, tc::InferRequestedOutput::Create(&output, "OUTPUT0"))) {
+    return;
+  }
+  std::unique_ptr<tc::InferRequestedOutput> output_ptr(output);
+
+  tc::InferOptions options("identity");
+  std::vector<tc::InferInput*> inputs = {tensor.input.get()};
+  std::vector<const tc::InferRequestedOutput*> outputs = {output};
+  tc::HttpRequestTemplateCache template_cache;
+  for (auto _ : state) {
+    tc::HttpInferRequest request;
+    if (!Ok(state, request.InitializeRequest(
+                       options, inputs, outputs,
+                       use_template_cache ? &template_cache : nullptr))) {
+      break;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void
+BM_GrpcPreRunProcessing(benchmark::State& state)
+{
+  const std::string datatype = kDatatypes[state.range(1)];
+  Tensor tensor;
+  if (!Ok(state, MakeTensor("INPUT0", datatype, state.range(0), &tensor))) {
+    return;
+  }
+  tc::InferRequestedOutput* output;
+  if (!Ok(state, tc::InferRequestedOutput::Create(&output, "OUTPUT0"))) {
+    return;
+  }
+  std::unique_ptr<tc::InferRequestedOutput> output_ptr(output);
+
+  // The channel connects lazily, no server is needed to prepare requests
+  std::unique_ptr<tc::InferenceServerGrpcClient> client;
+  if (!Ok(state,
+          tc::InferenceServerGrpcClient::Create(&client, "127.0.0.1:1"))) {
+    return;
+  }
+
+  tc::InferOptions options("identity");
+  std::vector<tc::InferInput*> inputs = {tensor.input.get()};
+  std::vector<const tc::InferRequestedOutput*> outputs = {output};
+  for (auto _ : state) {
+    if (!Ok(state, tc::GrpcClientBenchmarkPeer::PreRunProcessing(
+                       client.get(), options, inputs, outputs))) {
+      break;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.counters["request_bytes"] =
+      tc::GrpcClientBenchmarkPeer::RequestByteSize(client.get());
+  SetCounters(state, tensor.byte_size);
+}
+
+void
+BM_AppendRaw(benchmark::State& state)
+{
+  Tensor tensor;
+  if (!Ok(state, MakeTensor("INPUT0", "FP32", state.range(0), &tensor))) {
+    return;
+  }
+  for (auto _ : state) {
+    tensor.input->Reset();
+    if (!Ok(state, tensor.input->AppendRaw(tensor.raw))) {
+      break;
+    }
+  }
+  SetCounters(state, tensor.byte_size);
+}
+
+void
+BM_AppendFromString(benchmark::State& state)
+{
+  Tensor tensor;
+  if (!Ok(state, MakeTensor("INPUT0", "BYTES", state.range(0), &tensor))) {
+    return;
+  }
+  for (auto _ : state) {
+    tensor.input->Reset();
+    if (!Ok(state, tensor.input->AppendFromString(tensor.strings))) {
+      break;
+    }
+  }
+  SetCounters(state, tensor.byte_size);
+}
+
+//==============================================================================
+// Parsing
+
+// Time ParseResponseBody(), that is the construction of InferResultHttp,
+// and the access to the output, for binary and JSON outputs.
+void
+BM_HttpParseResponseBody(benchmark::State& state)
+{
+  const std::string datatype = kDatatypes[state.range(1)];
+  const bool binary_data = (state.range(2) != 0);
+  const size_t count = state.range(0);
+  Tensor tensor;
+  if (!Ok(state, MakeTensor("INPUT0", datatype, count, &tensor))) {
+    return;
+  }
+  if (binary_data && (datatype == "BYTES")) {
+    state.SkipWithError("binary BYTES outputs are not benchmarked");
+    return;
+  }
+
+  std::vector<char> body;
+  size_t header_length;
+  MakeHttpResponse(
+      datatype, count, tensor, binary_data, &body, &header_length);
+  for (auto _ : state) {
+    tc::InferResult* result;
+    if (!Ok(state, tc::InferenceServerHttpClient::ParseResponseBody(
+                       &result, body, header_length))) {
+      break;
+    }
+    std::unique_ptr<tc::InferResult> result_ptr(result);
+    const uint8_t* buf;
+    size_t byte_size;
+    if (!Ok(state, result->RequestStatus()) ||
+        !Ok(state, result->RawData("OUTPUT0", &buf, &byte_size))) {
+      break;
+    }
+    benchmark::DoNotOptimize(buf);
+  }
+  SetCounters(state, body.size());
+}
+
+//==============================================================================
+// Compression
+
+void
+BM_HttpCompressRequest(benchmark::State& state)
+{
+  const auto type =
+      static_cast<tc::InferenceServerHttpClient::CompressionType>(
+          state.range(1));
+  Tensor tensor;
+  if (!Ok(state, MakeTensor("INPUT0", "FP32", state.range(0), &tensor))) {
+    return;
+  }
+
+  tc::RequestCompressor compressor{tc::HttpCompressionOptions()};
+  const std::deque<std::pair<uint8_t*, size_t>> source{
+      {tensor.raw.data(), tensor.raw.size()}};
+  size_t compressed_byte_size = 0;
+  for (auto _ : state) {
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>> compressed_data;
+    const char* content_encoding;
+    if (!Ok(state, compressor.Compress(
+                       type, source, tensor.raw.size(), &compressed_data,
+                       &content_encoding))) {
+      break;
+    }
+    compressed_byte_size = 0;
+    for (const auto& data : compressed_data) {
+      compressed_byte_size += data.second;
+    }
+  }
+  if (compressed_byte_size != 0) {
+    state.counters["ratio"] =
+        static_cast<double>(tensor.raw.size()) / compressed_byte_size;
+  }
+  SetCounters(state, tensor.byte_size);
+}
+
+//==============================================================================
+// Loopback
+
+void
+BM_HttpInferLoopback(benchmark::State& state)
+{
+  ms::MockServer* server = LoopbackServer(state);
+  if (server == nullptr) {
+    return;
+  }
+  Tensor tensor;
+  if (!Ok(state, MakeTensor("INPUT0", "FP32", state.range(0), &tensor))) {
+    return;
+  }
+  tc::InferRequestedOutput* output;
+  if (!Ok(state, tc::InferRequestedOutput::Create(&output, "OUTPUT0"))) {
+    return;
+  }
+  std::unique_ptr<tc::InferRequestedOutput> output_ptr(output);
+
+  std::unique_ptr<tc::InferenceServerHttpClient> client;
+  if (!Ok(state, tc::InferenceServerHttpClient::Create(
+                     &client,
+                     "127.0.0.1:" + std::to_string(server->HttpPort())))) {
+    return;
+  }
+
+  tc::InferOptions options("identity");
+  std::vector<tc::InferInput*> inputs = {tensor.input.get()};
+  std::vector<const tc::InferRequestedOutput*> outputs = {output};
+  for (auto _ : state) {
+    tc::InferResult* result;
+    if (!Ok(state, client->Infer(&result, options, inputs, outputs))) {
+      break;
+    }
+    std::unique_ptr<tc::InferResult> result_ptr(result);
+    if (!Ok(state, result->RequestStatus())) {
+      break;
+    }
+  }
+  SetCounters(state, 2 * tensor.byte_size);
+}
+
+void
+BM_GrpcInferLoopback(benchmark::State& state)
+{
+  ms::MockServer* server = LoopbackServer(state);
+  if (server == nullptr) {
+    return;
+  }
+  Tensor tensor;
+  if (!Ok(state, MakeTensor("INPUT0", "FP32", state.range(0), &tensor))) {
+    return;
+  }
+  tc::InferRequestedOutput* output;
+  if (!Ok(state, tc::InferRequestedOutput::Create(&output, "OUTPUT0"))) {
+    return;
+  }
+  std::unique_ptr<tc::InferRequestedOutput> output_ptr(output);
+
+  std::unique_ptr<tc::InferenceServerGrpcClient> client;
+  if (!Ok(state, tc::InferenceServerGrpcClient::Create(
+                     &client,
+                     "127.0.0.1:" + std::to_string(server->GrpcPort())))) {
+    return;
+  }
+
+  tc::InferOptions options("identity");
+  std::vector<tc::InferInput*> inputs = {tensor.input.get()};
+  std::vector<const tc::InferRequestedOutput*> outputs = {output};
+  for (auto _ : state) {
+    tc::InferResult* result;
+    if (!Ok(state, client->Infer(&result, options, inputs, outputs))) {
+      break;
+    }
+    std::unique_ptr<tc::InferResult> result_ptr(result);
+    if (!Ok(state, result->RequestStatus())) {
+      break;
+    }
+  }
+  SetCounters(state, 2 * tensor.byte_size);
+}
+
+// Register each benchmark for every element count, and for the extra
+// arguments in 'args'.
+void
+SizesAnd(
+    benchmark::internal::Benchmark* benchmark,
+    const std::vector<std::vector<int64_t>>& args)
+{
+  for (const auto count : kElementCounts) {
+    if (args.empty()) {
+      benchmark->Arg(count);
+    }
+    for (const auto& extra : args) {
+      std::vector<int64_t> all{count};
+      all.insert(all.end(), extra.begin(), extra.end());
+      benchmark->Args(all);
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_HttpGenerateRequestBody)
+    ->ArgNames({"elements", "datatype"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      SizesAnd(b, {{0}, {1}, {2}});
+    });
+BENCHMARK(BM_HttpPrepareRequestJson)
+    ->ArgNames({"elements", "template_cache"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      SizesAnd(b, {{0}, {1}});
+    });
+BENCHMARK(BM_GrpcPreRunProcessing)
+    ->ArgNames({"elements", "datatype"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      SizesAnd(b, {{0}, {1}, {2}});
+    });
+BENCHMARK(BM_AppendRaw)->ArgNames({"elements"})->Apply(
+    [](benchmark::internal::Benchmark* b) { SizesAnd(b, {}); });
+BENCHMARK(BM_AppendFromString)
+    ->ArgNames({"elements"})
+    ->Apply([](benchmark::internal::Benchmark* b) { SizesAnd(b, {}); });
+BENCHMARK(BM_HttpParseResponseBody)
+    ->ArgNames({"elements", "datatype", "binary"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      SizesAnd(b, {{0, 1}, {1, 1}, {0, 0}, {1, 0}, {2, 0}});
+    });
+#if defined(TRITON_ENABLE_ZLIB) || defined(TRITON_ENABLE_ZSTD) || \
+    defined(TRITON_ENABLE_LZ4)
+BENCHMARK(BM_HttpCompressRequest)
+    ->ArgNames({"elements", "algorithm"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      // Only the algorithms the client library is built with
+      using CompressionType = tc::InferenceServerHttpClient::CompressionType;
+      std::vector<std::vector<int64_t>> algorithms;
+#ifdef TRITON_ENABLE_ZLIB
+      algorithms.push_back({static_cast<int64_t>(CompressionType::DEFLATE)});
+      algorithms.push_back({static_cast<int64_t>(CompressionType::GZIP)});
+#endif  // TRITON_ENABLE_ZLIB
+#ifdef TRITON_ENABLE_ZSTD
+      algorithms.push_back({static_cast<int64_t>(CompressionType::ZSTD)});
+#endif  // TRITON_ENABLE_ZSTD
+#ifdef TRITON_ENABLE_LZ4
+      algorithms.push_back({static_cast<int64_t>(CompressionType::LZ4)});
+#endif  // TRITON_ENABLE_LZ4
+      SizesAnd(b, algorithms);
+    });
+#endif  // TRITON_ENABLE_ZLIB || TRITON_ENABLE_ZSTD || TRITON_ENABLE_LZ4
+BENCHMARK(BM_HttpInferLoopback)
+    ->ArgNames({"elements"})
+    ->Apply([](benchmark::internal::Benchmark* b) { SizesAnd(b, {}); })
+    ->UseRealTime();
+BENCHMARK(BM_GrpcInferLoopback)
+    ->ArgNames({"elements"})
+    ->Apply([](benchmark::internal::Benchmark* b) { SizesAnd(b, {}); })
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
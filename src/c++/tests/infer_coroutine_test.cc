@@ -0,0 +1,248 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+#include "infer_coroutine.h"
+
+namespace tc = triton::client;
+
+namespace {
+
+// A result carrying only the status of the request.
+class TestInferResult : public tc::InferResult {
+ public:
+  explicit TestInferResult(const tc::Error& status) : status_(status) {}
+
+  tc::Error ModelName(std::string* name) const override
+  {
+    return tc::Error::Success;
+  }
+  tc::Error ModelVersion(std::string* version) const override
+  {
+    return tc::Error::Success;
+  }
+  tc::Error Id(std::string* id) const override { return tc::Error::Success; }
+  tc::Error Shape(
+      const std::string& output_name,
+      std::vector<int64_t>* shape) const override
+  {
+    return tc::Error::Success;
+  }
+  tc::Error Datatype(
+      const std::string& output_name, std::string* datatype) const override
+  {
+    return tc::Error::Success;
+  }
+  tc::Error RawData(
+      const std::string& output_name, const uint8_t** buf,
+      size_t* byte_size) const override
+  {
+    return tc::Error::Success;
+  }
+  tc::Error IsFinalResponse(bool* is_final_response) const override
+  {
+    return tc::Error::Success;
+  }
+  tc::Error IsNullResponse(bool* is_null_response) const override
+  {
+    return tc::Error::Success;
+  }
+  tc::Error StringData(
+      const std::string& output_name,
+      std::vector<std::string>* string_result) const override
+  {
+    return tc::Error::Success;
+  }
+  std::string DebugString() const override { return ""; }
+  tc::Error RequestStatus() const override { return status_; }
+
+ private:
+  tc::Error status_;
+};
+
+// A client holding the request sent with AsyncInfer() until the test
+// completes it, from another thread as the client worker would.
+class TestClient {
+ public:
+  tc::Error AsyncInfer(
+      std::function<void(tc::InferResult*)> callback,
+      const tc::InferOptions& options,
+      const std::vector<tc::InferInput*>& inputs,
+      const std::vector<const tc::InferRequestedOutput*>& outputs)
+  {
+    infer_count_++;
+    if (!send_error_.IsOk()) {
+      return send_error_;
+    }
+    callback_ = std::move(callback);
+    cancellation_ = options.cancellation_;
+    return tc::Error::Success;
+  }
+
+  void Complete(const tc::Error& status)
+  {
+    auto callback = std::move(callback_);
+    std::thread worker([callback, status] {
+      callback(new TestInferResult(status));
+    });
+    worker_id_ = worker.get_id();
+    worker.join();
+  }
+
+  size_t infer_count_{0};
+  tc::Error send_error_{tc::Error::Success};
+  std::function<void(tc::InferResult*)> callback_;
+  std::shared_ptr<tc::InferCancellation> cancellation_;
+  std::thread::id worker_id_;
+};
+
+// A coroutine that starts eagerly and records the outcome of the awaited
+// request.
+struct Outcome {
+  bool resumed{false};
+  std::thread::id resume_thread_id;
+  tc::InferAsyncResult result;
+};
+
+struct Task {
+  struct promise_type {
+    Task get_return_object() { return {}; }
+    std::suspend_never initial_suspend() { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+Task
+AwaitInfer(
+    TestClient& client, Outcome* outcome, tc::InferExecutor executor = nullptr,
+    std::stop_token stop_token = {})
+{
+  tc::InferOptions options("model");
+  std::vector<tc::InferInput*> inputs;
+  outcome->result = co_await tc::InferAsync(
+      client, options, inputs, {}, std::move(executor),
+      std::move(stop_token));
+  outcome->resume_thread_id = std::this_thread::get_id();
+  outcome->resumed = true;
+}
+
+TEST(InferCoroutineTest, ResumeOnCompletion)
+{
+  TestClient client;
+  Outcome outcome;
+  AwaitInfer(client, &outcome);
+  EXPECT_EQ(client.infer_count_, 1u);
+  EXPECT_FALSE(outcome.resumed) << "expect the coroutine to be suspended";
+
+  client.Complete(tc::Error::Success);
+  ASSERT_TRUE(outcome.resumed);
+  EXPECT_EQ(outcome.resume_thread_id, client.worker_id_);
+  EXPECT_TRUE(outcome.result.status.IsOk());
+  ASSERT_NE(outcome.result.result, nullptr);
+  EXPECT_TRUE(outcome.result.result->RequestStatus().IsOk());
+}
+
+TEST(InferCoroutineTest, ResumeOnExecutor)
+{
+  std::queue<std::function<void()>> queue;
+  TestClient client;
+  Outcome outcome;
+  AwaitInfer(client, &outcome, [&queue](std::function<void()> fn) {
+    queue.push(std::move(fn));
+  });
+
+  client.Complete(tc::Error::Success);
+  EXPECT_FALSE(outcome.resumed)
+      << "expect the coroutine to be resumed by the executor";
+  ASSERT_EQ(queue.size(), 1u);
+  queue.front()();
+  ASSERT_TRUE(outcome.resumed);
+  EXPECT_EQ(outcome.resume_thread_id, std::this_thread::get_id());
+  EXPECT_TRUE(outcome.result.status.IsOk());
+}
+
+TEST(InferCoroutineTest, SendError)
+{
+  TestClient client;
+  client.send_error_ = tc::Error("failed to send");
+  Outcome outcome;
+  AwaitInfer(client, &outcome);
+  ASSERT_TRUE(outcome.resumed) << "expect the coroutine not to suspend";
+  EXPECT_EQ(outcome.result.status.Message(), "failed to send");
+  EXPECT_EQ(outcome.result.result, nullptr);
+}
+
+TEST(InferCoroutineTest, CancelWithStopToken)
+{
+  std::stop_source stop_source;
+  TestClient client;
+  Outcome outcome;
+  AwaitInfer(client, &outcome, nullptr, stop_source.get_token());
+  ASSERT_NE(client.cancellation_, nullptr)
+      << "expect the request to be sent with a cancellation";
+  EXPECT_FALSE(client.cancellation_->IsCancelled());
+
+  stop_source.request_stop();
+  EXPECT_TRUE(client.cancellation_->IsCancelled());
+  EXPECT_FALSE(outcome.resumed);
+
+  // The client completes a cancelled request with an error result.
+  client.Complete(tc::Error("Cancelled"));
+  ASSERT_TRUE(outcome.resumed);
+  EXPECT_FALSE(outcome.result.status.IsOk());
+  ASSERT_NE(outcome.result.result, nullptr);
+}
+
+TEST(InferCoroutineTest, StopRequestedBeforeAwait)
+{
+  std::stop_source stop_source;
+  stop_source.request_stop();
+  TestClient client;
+  Outcome outcome;
+  AwaitInfer(client, &outcome, nullptr, stop_source.get_token());
+  EXPECT_EQ(client.infer_count_, 0u) << "expect no request to be sent";
+  ASSERT_TRUE(outcome.resumed);
+  EXPECT_FALSE(outcome.result.status.IsOk());
+  EXPECT_EQ(outcome.result.result, nullptr);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,2915 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "mock_server.h"
+
+#include <fcntl.h>
+#include <grpc/grpc_security_constants.h>
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/support/server_interceptor.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#include "grpc_service.grpc.pb.h"
+
+#define TRITONJSON_STATUSTYPE triton::client::Error
+#define TRITONJSON_STATUSRETURN(M) return triton::client::Error(M)
+#define TRITONJSON_STATUSSUCCESS triton::client::Error::Success
+#include "triton/common/triton_json.h"
+
+#define RETURN_IF_ERR(S)              \
+  do {                                \
+    const tc::Error& status__ = (S);  \
+    if (!status__.IsOk()) {           \
+      return status__;                \
+    }                                 \
+  } while (false)
+
+namespace triton { namespace mockserver {
+
+namespace {
+
+using TritonJson = triton::common::TritonJson;
+
+const std::string kModelVersion = "1";
+const std::string kPlatform = "mock";
+
+constexpr char kInferHeaderContentLength[] = "inference-header-content-length";
+
+// The largest HTTP request header accepted.
+constexpr size_t kMaxHttpHeaderSize = 64 * 1024;
+
+// Returns the byte size of an element of 'datatype', 0 for BYTES and -1
+// for an unknown datatype.
+int64_t
+DatatypeByteSize(const std::string& datatype)
+{
+  static const std::unordered_map<std::string, int64_t> sizes{
+      {"BOOL", 1},  {"UINT8", 1}, {"UINT16", 2}, {"UINT32", 4},
+      {"UINT64", 8}, {"INT8", 1}, {"INT16", 2},  {"INT32", 4},
+      {"INT64", 8},  {"FP16", 2}, {"FP32", 4},   {"FP64", 8},
+      {"BF16", 2},   {"BYTES", 0}};
+  const auto itr = sizes.find(datatype);
+  return (itr == sizes.end()) ? -1 : itr->second;
+}
+
+std::string
+ShapeString(const std::vector<int64_t>& shape)
+{
+  std::string str("[");
+  for (size_t i = 0; i < shape.size(); ++i) {
+    str += ((i == 0) ? "" : ",") + std::to_string(shape[i]);
+  }
+  return str + "]";
+}
+
+// Returns the index <i> of a tensor named '<prefix><i>' with i < 'count'.
+bool
+TensorIndex(
+    const std::string& prefix, const std::string& name, const size_t count,
+    size_t* index)
+{
+  for (size_t i = 0; i < count; ++i) {
+    if (name == prefix + std::to_string(i)) {
+      *index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the number of serialized elements of a BYTES tensor, or false if
+// the serialization is truncated.
+bool
+CountStrings(const uint8_t* data, const size_t byte_size, size_t* count)
+{
+  size_t offset = 0;
+  *count = 0;
+  while (offset + sizeof(uint32_t) <= byte_size) {
+    uint32_t len;
+    memcpy(&len, data + offset, sizeof(len));
+    offset += sizeof(len) + len;
+    ++(*count);
+  }
+  return offset == byte_size;
+}
+
+template <typename T>
+T
+Load(const uint8_t* src)
+{
+  T value;
+  memcpy(&value, src, sizeof(T));
+  return value;
+}
+
+template <typename T>
+void
+Store(uint8_t* dst, const T value)
+{
+  memcpy(dst, &value, sizeof(T));
+}
+
+// Computes the sum and the difference of 'count' elements. Integers are
+// computed as unsigned to wrap around on overflow as the 'simple' models do.
+template <typename T>
+void
+AddSub(
+    const uint8_t* in0, const uint8_t* in1, const size_t count, uint8_t* sum,
+    uint8_t* diff)
+{
+  for (size_t i = 0; i < count; ++i) {
+    const T a = Load<T>(in0 + i * sizeof(T));
+    const T b = Load<T>(in1 + i * sizeof(T));
+    Store<T>(sum + i * sizeof(T), a + b);
+    Store<T>(diff + i * sizeof(T), a - b);
+  }
+}
+
+uint64_t
+SampleLatencyUs(const MockLatency& latency)
+{
+  thread_local std::mt19937_64 rng(std::random_device{}());
+  double us = latency.mean_us;
+  switch (latency.distribution) {
+    case MockLatency::Distribution::CONSTANT:
+      return latency.mean_us;
+    case MockLatency::Distribution::UNIFORM:
+      us = std::uniform_real_distribution<double>(
+          latency.min_us, latency.max_us)(rng);
+      break;
+    case MockLatency::Distribution::NORMAL:
+      if (latency.stddev_us > 0) {
+        us = std::normal_distribution<double>(
+            latency.mean_us, latency.stddev_us)(rng);
+      }
+      break;
+    case MockLatency::Distribution::EXPONENTIAL:
+      if (latency.mean_us > 0) {
+        us = std::exponential_distribution<double>(1.0 / latency.mean_us)(rng);
+      }
+      break;
+  }
+  us = std::max(us, static_cast<double>(latency.min_us));
+  if (latency.max_us != 0) {
+    us = std::min(us, static_cast<double>(latency.max_us));
+  }
+  return static_cast<uint64_t>(us);
+}
+
+uint64_t
+NsSince(const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+std::string
+ToLower(std::string str)
+{
+  std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+  return str;
+}
+
+void
+AddString(TritonJson::Value* json, const char* name, const std::string& value)
+{
+  json->AddString(name, value.c_str(), value.size());
+}
+
+// Converts the JSON 'data' of an input to its binary form.
+tc::Error
+JsonToBinary(
+    TritonJson::Value& data_json, const std::string& datatype,
+    std::vector<uint8_t>* buffer)
+{
+  const size_t count = data_json.ArraySize();
+  const int64_t element_size = DatatypeByteSize(datatype);
+  if ((datatype == "FP16") || (datatype == "BF16")) {
+    return tc::Error(
+        "datatype '" + datatype + "' is not supported with JSON data");
+  } else if (datatype == "BYTES") {
+    buffer->clear();
+    for (size_t i = 0; i < count; ++i) {
+      const char* str;
+      size_t len;
+      RETURN_IF_ERR(data_json.IndexAsString(i, &str, &len));
+      const uint32_t len32 = len;
+      buffer->insert(
+          buffer->end(), reinterpret_cast<const uint8_t*>(&len32),
+          reinterpret_cast<const uint8_t*>(&len32) + sizeof(len32));
+      buffer->insert(buffer->end(), str, str + len);
+    }
+    return tc::Error::Success;
+  }
+
+  buffer->resize(count * element_size);
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t* dst = buffer->data() + i * element_size;
+    if (datatype == "BOOL") {
+      bool value;
+      RETURN_IF_ERR(data_json.IndexAsBool(i, &value));
+      Store<uint8_t>(dst, value ? 1 : 0);
+    } else if (datatype[0] == 'U') {
+      uint64_t value;
+      RETURN_IF_ERR(data_json.IndexAsUInt(i, &value));
+      switch (element_size) {
+        case 1:
+          Store<uint8_t>(dst, value);
+          break;
+        case 2:
+          Store<uint16_t>(dst, value);
+          break;
+        case 4:
+          Store<uint32_t>(dst, value);
+          break;
+        default:
+          Store<uint64_t>(dst, value);
+      }
+    } else if (datatype[0] == 'I') {
+      int64_t value;
+      RETURN_IF_ERR(data_json.IndexAsInt(i, &value));
+      switch (element_size) {
+        case 1:
+          Store<int8_t>(dst, value);
+          break;
+        case 2:
+          Store<int16_t>(dst, value);
+          break;
+        case 4:
+          Store<int32_t>(dst, value);
+          break;
+        default:
+          Store<int64_t>(dst, value);
+      }
+    } else {
+      double value;
+      RETURN_IF_ERR(data_json.IndexAsDouble(i, &value));
+      if (datatype == "FP32") {
+        Store<float>(dst, value);
+      } else {
+        Store<double>(dst, value);
+      }
+    }
+  }
+  return tc::Error::Success;
+}
+
+}  // namespace
+
+//==============================================================================
+// A tensor of a request or a response. 'data' points into the request, into
+// a shared memory region or into 'buffer'.
+//
+// Read the contents of a file.
+tc::Error
+ReadFile(const std::string& path, std::string* contents)
+{
+  std::ifstream file(path);
+  if (!file) {
+    return tc::Error("unable to open '" + path + "'");
+  }
+  std::stringstream ss;
+  ss << file.rdbuf();
+  *contents = ss.str();
+  return tc::Error::Success;
+}
+
+// Records the TLS handshakes of the connections of a frontend.
+class MockTlsRecorder {
+ public:
+  // Record the handshake of a new connection. With a non-empty 'peer', the
+  // handshake is only recorded for the first request of the connection.
+  void Record(const bool resumed, const std::string& peer = std::string())
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (!peer.empty() && !peers_.insert(peer).second) {
+      return;
+    }
+    stat_.handshake_count++;
+    if (resumed) {
+      stat_.resumed_handshake_count++;
+    }
+  }
+
+  MockTlsStat Stat() const
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    return stat_;
+  }
+
+ private:
+  mutable std::mutex mu_;
+  MockTlsStat stat_;
+  std::set<std::string> peers_;
+};
+
+struct MockTensor {
+  std::string name;
+  std::string datatype;
+  std::vector<int64_t> shape;
+  const uint8_t* data{nullptr};
+  size_t byte_size{0};
+  std::vector<uint8_t> buffer;
+};
+
+//==============================================================================
+// An output requested by a request, returned in a shared memory region when
+// 'shm_region' is not empty.
+//
+struct MockRequestedOutput {
+  std::string name;
+  bool binary_data{true};
+  std::string shm_region;
+  size_t shm_byte_size{0};
+  size_t shm_offset{0};
+};
+
+//==============================================================================
+// A registered system shared memory region. It is unmapped when the last
+// request using it completes.
+//
+struct MockSharedMemoryRegion {
+  ~MockSharedMemoryRegion()
+  {
+    if (base != nullptr) {
+      munmap(base, mapped_size);
+    }
+  }
+
+  std::string name;
+  std::string key;
+  size_t offset{0};
+  size_t byte_size{0};
+  uint8_t* base{nullptr};
+  size_t mapped_size{0};
+};
+
+//==============================================================================
+// The statistics of a model, in the units of the KServe statistics
+// extension.
+//
+struct MockModelStats {
+  uint64_t last_inference_ms{0};
+  uint64_t inference_count{0};
+  uint64_t execution_count{0};
+  uint64_t success_count{0};
+  uint64_t success_ns{0};
+  uint64_t fail_count{0};
+  uint64_t fail_ns{0};
+  uint64_t compute_infer_count{0};
+  uint64_t compute_infer_ns{0};
+};
+
+//==============================================================================
+// The models, statistics and shared memory regions shared by the HTTP/REST
+// and GRPC frontends.
+//
+class MockServerCore {
+ public:
+  static tc::Error Create(
+      const std::vector<MockModelConfig>& models, const bool verbose,
+      std::unique_ptr<MockServerCore>* core);
+
+  const std::vector<MockModelConfig>& Models() const { return models_; }
+  bool Verbose() const { return verbose_; }
+
+  // Find a model, an empty version selects the only version "1".
+  tc::Error FindModel(
+      const std::string& name, const std::string& version,
+      const MockModelConfig** model) const;
+
+  // Check the inputs of a request against 'model', sort them by index and
+  // return the batch size of the request.
+  tc::Error CheckInputs(
+      const MockModelConfig& model, std::vector<MockTensor>* inputs,
+      size_t* batch_size) const;
+
+  // Find the index of an output of 'model'.
+  tc::Error OutputIndex(
+      const MockModelConfig& model, const std::string& name,
+      size_t* index) const;
+
+  // Compute the outputs of a request with checked inputs, after waiting for
+  // the latency of 'model'.
+  void Execute(
+      const MockModelConfig& model, const std::vector<MockTensor>& inputs,
+      std::vector<MockTensor>* outputs) const;
+
+  // Record the statistics of a request.
+  void Report(
+      const MockModelConfig& model, const size_t batch_size,
+      const bool success, const uint64_t request_ns,
+      const uint64_t compute_ns);
+
+  // Return the statistics of a model, or of all the models if 'name' is
+  // empty.
+  tc::Error Statistics(
+      const std::string& name, const std::string& version,
+      std::vector<std::pair<const MockModelConfig*, MockModelStats>>* stats);
+
+  tc::Error RegisterSystemSharedMemory(
+      const std::string& name, const std::string& key, const size_t offset,
+      const size_t byte_size);
+
+  // Unregister a region, or all the regions if 'name' is empty.
+  void UnregisterSystemSharedMemory(const std::string& name);
+
+  // Return a region, or all the regions if 'name' is empty.
+  tc::Error SystemSharedMemoryStatus(
+      const std::string& name,
+      std::vector<std::shared_ptr<MockSharedMemoryRegion>>* regions);
+
+  // Return the address of 'byte_size' bytes at 'offset' in a region, which
+  // stays mapped while 'region' is held.
+  tc::Error SharedMemory(
+      const std::string& name, const size_t offset, const size_t byte_size,
+      std::shared_ptr<MockSharedMemoryRegion>* region, uint8_t** addr);
+
+  // Copy an output into the shared memory region requested for it.
+  tc::Error WriteSharedMemory(
+      const MockRequestedOutput& requested, const MockTensor& output);
+
+ private:
+  explicit MockServerCore(const bool verbose) : verbose_(verbose) {}
+
+  const bool verbose_;
+  std::vector<MockModelConfig> models_;
+  std::unordered_map<std::string, size_t> model_index_;
+
+  std::mutex stats_mu_;
+  std::vector<MockModelStats> stats_;
+
+  std::mutex shm_mu_;
+  std::map<std::string, std::shared_ptr<MockSharedMemoryRegion>> shm_regions_;
+};
+
+tc::Error
+MockServerCore::Create(
+    const std::vector<MockModelConfig>& models, const bool verbose,
+    std::unique_ptr<MockServerCore>* core)
+{
+  std::unique_ptr<MockServerCore> lcore(new MockServerCore(verbose));
+  for (MockModelConfig model : models) {
+    const std::string prefix = "mock model '" + model.name + "' ";
+    if (model.name.empty()) {
+      return tc::Error("mock models must have a name");
+    }
+    if (lcore->model_index_.find(model.name) != lcore->model_index_.end()) {
+      return tc::Error(prefix + "is defined more than once");
+    }
+    if (DatatypeByteSize(model.datatype) < 0) {
+      return tc::Error(
+          prefix + "has unsupported datatype '" + model.datatype + "'");
+    }
+    if (model.kind == MockModelConfig::Kind::ADD_SUB) {
+      if ((model.datatype != "INT32") && (model.datatype != "INT64") &&
+          (model.datatype != "FP32") && (model.datatype != "FP64")) {
+        return tc::Error(
+            prefix + "of kind add_sub only supports INT32, INT64, FP32 and "
+                     "FP64");
+      }
+      model.input_count = 2;
+    }
+    if (model.input_count == 0) {
+      return tc::Error(prefix + "must have at least one input");
+    }
+    if (model.max_batch_size < 0) {
+      return tc::Error(prefix + "must have a non-negative max_batch_size");
+    }
+    for (const int64_t dim : model.dims) {
+      if (dim < -1) {
+        return tc::Error(
+            prefix + "has invalid dims " + ShapeString(model.dims));
+      }
+    }
+    if ((model.latency.distribution == MockLatency::Distribution::UNIFORM) &&
+        (model.latency.max_us < model.latency.min_us)) {
+      return tc::Error(
+          prefix + "must have a latency 'max_us' not less than 'min_us'");
+    }
+    lcore->model_index_[model.name] = lcore->models_.size();
+    lcore->models_.push_back(model);
+  }
+  lcore->stats_.resize(lcore->models_.size());
+
+  *core = std::move(lcore);
+  return tc::Error::Success;
+}
+
+tc::Error
+MockServerCore::FindModel(
+    const std::string& name, const std::string& version,
+    const MockModelConfig** model) const
+{
+  const auto itr = model_index_.find(name);
+  if (itr == model_index_.end()) {
+    return tc::Error(
+        "Request for unknown model: '" + name + "' is not found");
+  }
+  if (!version.empty() && (version != kModelVersion)) {
+    return tc::Error(
+        "Request for unknown model: '" + name + "' version " + version +
+        " is not found");
+  }
+  *model = &models_[itr->second];
+  return tc::Error::Success;
+}
+
+tc::Error
+MockServerCore::CheckInputs(
+    const MockModelConfig& model, std::vector<MockTensor>* inputs,
+    size_t* batch_size) const
+{
+  if (inputs->size() != model.input_count) {
+    return tc::Error(
+        "expected " + std::to_string(model.input_count) +
+        " inputs but got " + std::to_string(inputs->size()) +
+        " inputs for model '" + model.name + "'");
+  }
+
+  std::vector<int64_t> expected_shape;
+  if (model.max_batch_size > 0) {
+    expected_shape.push_back(-1);
+  }
+  expected_shape.insert(
+      expected_shape.end(), model.dims.begin(), model.dims.end());
+
+  std::vector<bool> seen(model.input_count, false);
+  *batch_size = 1;
+  for (size_t i = 0; i < inputs->size(); ++i) {
+    const MockTensor& input = (*inputs)[i];
+    size_t index;
+    if (!TensorIndex("INPUT", input.name, model.input_count, &index) ||
+        seen[index]) {
+      return tc::Error(
+          "unexpected inference input '" + input.name + "' for model '" +
+          model.name + "'");
+    }
+    seen[index] = true;
+
+    if (input.datatype != model.datatype) {
+      return tc::Error(
+          "inference input '" + input.name + "' data-type is '" +
+          input.datatype + "', but model '" + model.name + "' expects '" +
+          model.datatype + "'");
+    }
+
+    bool shape_match = (input.shape.size() == expected_shape.size());
+    int64_t element_count = 1;
+    for (size_t d = 0; shape_match && (d < input.shape.size()); ++d) {
+      shape_match =
+          (input.shape[d] >= 0) &&
+          ((expected_shape[d] == -1) || (expected_shape[d] == input.shape[d]));
+      element_count *= input.shape[d];
+    }
+    if (!shape_match) {
+      return tc::Error(
+          "unexpected shape for input '" + input.name + "' for model '" +
+          model.name + "'. Expected " + ShapeString(expected_shape) +
+          ", got " + ShapeString(input.shape));
+    }
+
+    if (model.max_batch_size > 0) {
+      const int64_t request_batch_size = input.shape[0];
+      if ((request_batch_size < 1) ||
+          (request_batch_size > model.max_batch_size)) {
+        return tc::Error(
+            "inference request batch-size must be <= " +
+            std::to_string(model.max_batch_size) + " for '" + model.name +
+            "'");
+      }
+      if ((i != 0) &&
+          (static_cast<size_t>(request_batch_size) != *batch_size)) {
+        return tc::Error(
+            "input '" + input.name +
+            "' batch size does not match other inputs for '" + model.name +
+            "'");
+      }
+      *batch_size = request_batch_size;
+    }
+
+    if (model.datatype == "BYTES") {
+      size_t string_count;
+      if (!CountStrings(input.data, input.byte_size, &string_count) ||
+          (string_count != static_cast<size_t>(element_count))) {
+        return tc::Error(
+            "expected " + std::to_string(element_count) +
+            " strings for inference input '" + input.name + "', got " +
+            std::to_string(string_count));
+      }
+    } else {
+      const size_t expected_byte_size =
+          element_count * DatatypeByteSize(model.datatype);
+      if (input.byte_size != expected_byte_size) {
+        return tc::Error(
+            "unexpected total byte size " + std::to_string(input.byte_size) +
+            " for input '" + input.name + "', expecting " +
+            std::to_string(expected_byte_size));
+      }
+    }
+  }
+
+  std::sort(
+      inputs->begin(), inputs->end(),
+      [](const MockTensor& a, const MockTensor& b) {
+        return (a.name.size() < b.name.size()) ||
+               ((a.name.size() == b.name.size()) && (a.name < b.name));
+      });
+
+  if ((model.kind == MockModelConfig::Kind::ADD_SUB) &&
+      ((*inputs)[0].shape != (*inputs)[1].shape)) {
+    return tc::Error(
+        "input 'INPUT1' must have the same shape as 'INPUT0' for model '" +
+        model.name + "'");
+  }
+
+  return tc::Error::Success;
+}
+
+tc::Error
+MockServerCore::OutputIndex(
+    const MockModelConfig& model, const std::string& name, size_t* index) const
+{
+  if (!TensorIndex("OUTPUT", name, model.input_count, index)) {
+    return tc::Error(
+        "unexpected inference output '" + name + "' for model '" + model.name +
+        "'");
+  }
+  return tc::Error::Success;
+}
+
+void
+MockServerCore::Execute(
+    const MockModelConfig& model, const std::vector<MockTensor>& inputs,
+    std::vector<MockTensor>* outputs) const
+{
+  const uint64_t latency_us = SampleLatencyUs(model.latency);
+  if (latency_us > 0) {
+    std::this_thread::sleep_for(std::chrono::microseconds(latency_us));
+  }
+
+  outputs->clear();
+  outputs->resize(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    MockTensor& output = (*outputs)[i];
+    output.name = "OUTPUT" + std::to_string(i);
+    output.datatype = inputs[i].datatype;
+    output.shape = inputs[i].shape;
+    output.data = inputs[i].data;
+    output.byte_size = inputs[i].byte_size;
+  }
+
+  if (model.kind == MockModelConfig::Kind::ADD_SUB) {
+    const size_t byte_size = inputs[0].byte_size;
+    for (auto& output : *outputs) {
+      output.buffer.resize(byte_size);
+      output.data = output.buffer.data();
+    }
+    const uint8_t* in0 = inputs[0].data;
+    const uint8_t* in1 = inputs[1].data;
+    uint8_t* sum = (*outputs)[0].buffer.data();
+    uint8_t* diff = (*outputs)[1].buffer.data();
+    if (model.datatype == "INT32") {
+      AddSub<uint32_t>(in0, in1, byte_size / sizeof(uint32_t), sum, diff);
+    } else if (model.datatype == "INT64") {
+      AddSub<uint64_t>(in0, in1, byte_size / sizeof(uint64_t), sum, diff);
+    } else if (model.datatype == "FP32") {
+      AddSub<float>(in0, in1, byte_size / sizeof(float), sum, diff);
+    } else {
+      AddSub<double>(in0, in1, byte_size / sizeof(double), sum, diff);
+    }
+  }
+}
+
+void
+MockServerCore::Report(
+    const MockModelConfig& model, const size_t batch_size, const bool success,
+    const uint64_t request_ns, const uint64_t compute_ns)
+{
+  std::lock_guard<std::mutex> lk(stats_mu_);
+  MockModelStats& stats = stats_[&model - models_.data()];
+  if (success) {
+    stats.last_inference_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    stats.inference_count += batch_size;
+    stats.execution_count++;
+    stats.success_count++;
+    stats.success_ns += request_ns;
+    stats.compute_infer_count++;
+    stats.compute_infer_ns += compute_ns;
+  } else {
+    stats.fail_count++;
+    stats.fail_ns += request_ns;
+  }
+}
+
+tc::Error
+MockServerCore::Statistics(
+    const std::string& name, const std::string& version,
+    std::vector<std::pair<const MockModelConfig*, MockModelStats>>* stats)
+{
+  stats->clear();
+  std::lock_guard<std::mutex> lk(stats_mu_);
+  if (name.empty()) {
+    for (size_t i = 0; i < models_.size(); ++i) {
+      stats->emplace_back(&models_[i], stats_[i]);
+    }
+  } else {
+    const MockModelConfig* model;
+    RETURN_IF_ERR(FindModel(name, version, &model));
+    stats->emplace_back(model, stats_[model - models_.data()]);
+  }
+  return tc::Error::Success;
+}
+
+tc::Error
+MockServerCore::RegisterSystemSharedMemory(
+    const std::string& name, const std::string& key, const size_t offset,
+    const size_t byte_size)
+{
+  std::lock_guard<std::mutex> lk(shm_mu_);
+  if (shm_regions_.find(name) != shm_regions_.end()) {
+    return tc::Error(
+        "shared memory region '" + name + "' already in manager");
+  }
+
+  const int fd = shm_open(key.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd == -1) {
+    return tc::Error(
+        "Unable to open shared memory region: '" + key +
+        "': " + strerror(errno));
+  }
+  void* base = mmap(
+      nullptr, offset + byte_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const int mmap_errno = errno;
+  close(fd);
+  if (base == MAP_FAILED) {
+    return tc::Error(
+        "unable to map shared memory region '" + key +
+        "': " + strerror(mmap_errno));
+  }
+
+  std::shared_ptr<MockSharedMemoryRegion> region(new MockSharedMemoryRegion());
+  region->name = name;
+  region->key = key;
+  region->offset = offset;
+  region->byte_size = byte_size;
+  region->base = reinterpret_cast<uint8_t*>(base);
+  region->mapped_size = offset + byte_size;
+  shm_regions_[name] = region;
+  return tc::Error::Success;
+}
+
+void
+MockServerCore::UnregisterSystemSharedMemory(const std::string& name)
+{
+  std::lock_guard<std::mutex> lk(shm_mu_);
+  if (name.empty()) {
+    shm_regions_.clear();
+  } else {
+    shm_regions_.erase(name);
+  }
+}
+
+tc::Error
+MockServerCore::SystemSharedMemoryStatus(
+    const std::string& name,
+    std::vector<std::shared_ptr<MockSharedMemoryRegion>>* regions)
+{
+  regions->clear();
+  std::lock_guard<std::mutex> lk(shm_mu_);
+  if (name.empty()) {
+    for (const auto& region : shm_regions_) {
+      regions->push_back(region.second);
+    }
+  } else {
+    const auto itr = shm_regions_.find(name);
+    if (itr == shm_regions_.end()) {
+      return tc::Error(
+          "Unable to find system shared memory region: '" + name + "'");
+    }
+    regions->push_back(itr->second);
+  }
+  return tc::Error::Success;
+}
+
+tc::Error
+MockServerCore::SharedMemory(
+    const std::string& name, const size_t offset, const size_t byte_size,
+    std::shared_ptr<MockSharedMemoryRegion>* region, uint8_t** addr)
+{
+  {
+    std::lock_guard<std::mutex> lk(shm_mu_);
+    const auto itr = shm_regions_.find(name);
+    if (itr == shm_regions_.end()) {
+      return tc::Error(
+          "Unable to find shared memory region: '" + name + "'");
+    }
+    *region = itr->second;
+  }
+  if ((offset > (*region)->byte_size) ||
+      (byte_size > (*region)->byte_size - offset)) {
+    return tc::Error(
+        "Invalid offset + byte size for shared memory region: '" + name +
+        "'");
+  }
+  *addr = (*region)->base + (*region)->offset + offset;
+  return tc::Error::Success;
+}
+
+tc::Error
+MockServerCore::WriteSharedMemory(
+    const MockRequestedOutput& requested, const MockTensor& output)
+{
+  if (output.byte_size > requested.shm_byte_size) {
+    return tc::Error(
+        "shared memory size specified with the request for output '" +
+        output.name + "' (" + std::to_string(requested.shm_byte_size) +
+        " bytes) should be at least " + std::to_string(output.byte_size) +
+        " bytes to hold the results");
+  }
+  std::shared_ptr<MockSharedMemoryRegion> region;
+  uint8_t* addr;
+  RETURN_IF_ERR(SharedMemory(
+      requested.shm_region, requested.shm_offset, requested.shm_byte_size,
+      &region, &addr));
+  // An IDENTITY output may already be in place, or overlap its input.
+  if ((output.byte_size > 0) && (addr != output.data)) {
+    memmove(addr, output.data, output.byte_size);
+  }
+  return tc::Error::Success;
+}
+
+//==============================================================================
+// Serves the HTTP/REST protocol. Each accepted connection is served by its
+// own thread, which handles the requests of the connection in order.
+//
+class MockHttpFrontend {
+ public:
+  explicit MockHttpFrontend(MockServerCore* core) : core_(core) {}
+  ~MockHttpFrontend()
+  {
+    Stop();
+    SSL_CTX_free(ssl_ctx_);
+  }
+
+  // Start serving on 'address', over TLS if 'certificate_file' and
+  // 'private_key_file' are set.
+  tc::Error Start(
+      const std::string& address, const std::string& certificate_file,
+      const std::string& private_key_file);
+  void Stop();
+  int Port() const { return port_; }
+  MockTlsStat TlsStat() const { return tls_recorder_.Stat(); }
+
+ private:
+  struct Connection {
+    int fd{-1};
+    // The TLS connection, null for plain HTTP.
+    SSL* ssl{nullptr};
+    std::thread thread;
+    std::atomic<bool> done{false};
+  };
+
+  struct HttpRequest {
+    std::string method;
+    std::string path;
+    std::string version;
+    // The header names are in lower case.
+    std::map<std::string, std::string> headers;
+    std::string body;
+    // Set if the request can't be served, the connection is then closed.
+    std::string error;
+  };
+
+  struct HttpResponse {
+    int code{200};
+    std::vector<std::string> headers;
+    // The JSON body, followed by the binary data.
+    std::string body;
+    std::vector<std::pair<const uint8_t*, size_t>> binary;
+    // The tensors the binary data points into.
+    std::vector<MockTensor> tensors;
+  };
+
+  tc::Error InitSsl(
+      const std::string& certificate_file,
+      const std::string& private_key_file);
+  void Accept(const int listen_fd);
+  void Serve(Connection* connection);
+  // Receive up to 'size' bytes, returns 0 or less once the connection is
+  // closed.
+  static ssize_t Receive(Connection* connection, void* buf, const size_t size);
+  static bool ReadRequest(
+      Connection* connection, std::string* buffer, HttpRequest* request);
+  static bool WriteResponse(
+      Connection* connection, const HttpResponse& response,
+      const bool keep_alive);
+
+  void Handle(const HttpRequest& request, HttpResponse* response);
+  void HandleModel(
+      const HttpRequest& request, const std::vector<std::string>& segments,
+      HttpResponse* response);
+  void HandleSystemSharedMemory(
+      const HttpRequest& request, const std::vector<std::string>& segments,
+      HttpResponse* response);
+  void HandleInfer(
+      const std::string& model_name, const std::string& model_version,
+      const HttpRequest& request, HttpResponse* response);
+  tc::Error Infer(
+      const MockModelConfig& model, const HttpRequest& request,
+      HttpResponse* response, size_t* batch_size, uint64_t* compute_ns);
+
+  void ServerMetadata(HttpResponse* response);
+  void ModelMetadata(const MockModelConfig& model, HttpResponse* response);
+  void ModelConfig(const MockModelConfig& model, HttpResponse* response);
+  void ModelStatistics(
+      const std::string& name, const std::string& version,
+      HttpResponse* response);
+  void RepositoryIndex(HttpResponse* response);
+
+  static void SetJson(TritonJson::Value& json, HttpResponse* response);
+  static void SetError(
+      const tc::Error& err, HttpResponse* response, const int code = 400);
+
+  MockServerCore* core_;
+  // The TLS context, null for plain HTTP.
+  SSL_CTX* ssl_ctx_{nullptr};
+  MockTlsRecorder tls_recorder_;
+  int listen_fd_{-1};
+  int port_{0};
+  std::string unix_path_;
+  std::thread acceptor_;
+  std::mutex mu_;
+  std::list<std::unique_ptr<Connection>> connections_;
+};
+
+tc::Error
+MockHttpFrontend::InitSsl(
+    const std::string& certificate_file, const std::string& private_key_file)
+{
+  ssl_ctx_ = SSL_CTX_new(TLS_server_method());
+  if ((ssl_ctx_ == nullptr) ||
+      (SSL_CTX_use_certificate_chain_file(
+           ssl_ctx_, certificate_file.c_str()) != 1) ||
+      (SSL_CTX_use_PrivateKey_file(
+           ssl_ctx_, private_key_file.c_str(), SSL_FILETYPE_PEM) != 1)) {
+    char msg[256];
+    ERR_error_string_n(ERR_get_error(), msg, sizeof(msg));
+    return tc::Error(
+        "unable to load the TLS certificate '" + certificate_file +
+        "' and key '" + private_key_file + "': " + msg);
+  }
+  return tc::Error::Success;
+}
+
+tc::Error
+MockHttpFrontend::Start(
+    const std::string& address, const std::string& certificate_file,
+    const std::string& private_key_file)
+{
+  if (!certificate_file.empty() && !private_key_file.empty()) {
+    RETURN_IF_ERR(InitSsl(certificate_file, private_key_file));
+  }
+  if (address.compare(0, 5, "unix:") == 0) {
+    unix_path_ = address.substr(5);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    if (unix_path_.size() >= sizeof(addr.sun_path)) {
+      return tc::Error("socket path '" + unix_path_ + "' is too long");
+    }
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, unix_path_.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(unix_path_.c_str());
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ((listen_fd_ < 0) ||
+        (bind(
+             listen_fd_, reinterpret_cast<struct sockaddr*>(&addr),
+             sizeof(addr)) != 0)) {
+      const std::string msg = strerror(errno);
+      Stop();
+      return tc::Error(
+          "unable to listen for HTTP/REST on '" + address + "': " + msg);
+    }
+  } else {
+    const size_t colon = address.rfind(':');
+    if (colon == std::string::npos) {
+      return tc::Error(
+          "invalid address '" + address +
+          "', expected '<host>:<port>' or 'unix:<path>'");
+    }
+    std::string host = address.substr(0, colon);
+    const std::string port = address.substr(colon + 1);
+    if ((host.size() >= 2) && (host.front() == '[') && (host.back() == ']')) {
+      host = host.substr(1, host.size() - 2);
+    }
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE | AI_NUMERICSERV;
+    struct addrinfo* result;
+    const int rc = getaddrinfo(
+        host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &result);
+    if (rc != 0) {
+      return tc::Error(
+          "invalid address '" + address + "': " + gai_strerror(rc));
+    }
+    listen_fd_ =
+        socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    int one = 1;
+    const bool bound =
+        (listen_fd_ >= 0) &&
+        (setsockopt(
+             listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) == 0) &&
+        (bind(listen_fd_, result->ai_addr, result->ai_addrlen) == 0);
+    const std::string msg = strerror(errno);
+    freeaddrinfo(result);
+    if (!bound) {
+      Stop();
+      return tc::Error(
+          "unable to listen for HTTP/REST on '" + address + "': " + msg);
+    }
+
+    struct sockaddr_storage addr;
+    socklen_t len = sizeof(addr);
+    getsockname(listen_fd_, reinterpret_cast<struct sockaddr*>(&addr), &len);
+    if (addr.ss_family == AF_INET) {
+      port_ = ntohs(reinterpret_cast<struct sockaddr_in*>(&addr)->sin_port);
+    } else if (addr.ss_family == AF_INET6) {
+      port_ = ntohs(reinterpret_cast<struct sockaddr_in6*>(&addr)->sin6_port);
+    }
+  }
+
+  if (listen(listen_fd_, SOMAXCONN) != 0) {
+    const std::string msg = strerror(errno);
+    Stop();
+    return tc::Error(
+        "unable to listen for HTTP/REST on '" + address + "': " + msg);
+  }
+  acceptor_ = std::thread(&MockHttpFrontend::Accept, this, listen_fd_);
+  return tc::Error::Success;
+}
+
+void
+MockHttpFrontend::Stop()
+{
+  if (listen_fd_ < 0) {
+    return;
+  }
+  shutdown(listen_fd_, SHUT_RDWR);
+  if (acceptor_.joinable()) {
+    acceptor_.join();
+  }
+  close(listen_fd_);
+  listen_fd_ = -1;
+
+  for (auto& connection : connections_) {
+    shutdown(connection->fd, SHUT_RDWR);
+  }
+  for (auto& connection : connections_) {
+    connection->thread.join();
+    close(connection->fd);
+  }
+  connections_.clear();
+  if (!unix_path_.empty()) {
+    unlink(unix_path_.c_str());
+  }
+}
+
+void
+MockHttpFrontend::Accept(const int listen_fd)
+{
+  while (true) {
+    const int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd < 0) {
+      if ((errno == EINTR) || (errno == ECONNABORTED)) {
+        continue;
+      }
+      return;
+    }
+    if (unix_path_.empty()) {
+      int one = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+
+    std::lock_guard<std::mutex> lk(mu_);
+    // Reap the connections closed since the last one was accepted.
+    for (auto itr = connections_.begin(); itr != connections_.end();) {
+      if ((*itr)->done) {
+        (*itr)->thread.join();
+        close((*itr)->fd);
+        itr = connections_.erase(itr);
+      } else {
+        ++itr;
+      }
+    }
+    connections_.emplace_back(new Connection());
+    Connection* connection = connections_.back().get();
+    connection->fd = fd;
+    connection->thread =
+        std::thread(&MockHttpFrontend::Serve, this, connection);
+  }
+}
+
+void
+MockHttpFrontend::Serve(Connection* connection)
+{
+  bool serving = true;
+  if (ssl_ctx_ != nullptr) {
+    // OpenSSL writes to the socket without MSG_NOSIGNAL, don't let a client
+    // closing its connection raise SIGPIPE.
+    sigset_t sigpipe;
+    sigemptyset(&sigpipe);
+    sigaddset(&sigpipe, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigpipe, nullptr);
+
+    connection->ssl = SSL_new(ssl_ctx_);
+    serving = (connection->ssl != nullptr) &&
+              (SSL_set_fd(connection->ssl, connection->fd) == 1) &&
+              (SSL_accept(connection->ssl) == 1);
+    if (serving) {
+      tls_recorder_.Record(SSL_session_reused(connection->ssl) == 1);
+    }
+  }
+
+  std::string buffer;
+  HttpRequest request;
+  while (serving && ReadRequest(connection, &buffer, &request)) {
+    if (core_->Verbose()) {
+      std::cout << "HTTP " << request.method << " " << request.path
+                << std::endl;
+    }
+    HttpResponse response;
+    Handle(request, &response);
+
+    bool keep_alive = (request.version != "HTTP/1.0") && request.error.empty();
+    const auto itr = request.headers.find("connection");
+    if (itr != request.headers.end()) {
+      const std::string value = ToLower(itr->second);
+      if (value == "close") {
+        keep_alive = false;
+      } else if ((value == "keep-alive") && request.error.empty()) {
+        keep_alive = true;
+      }
+    }
+    if (!WriteResponse(connection, response, keep_alive) || !keep_alive) {
+      break;
+    }
+  }
+  if (connection->ssl != nullptr) {
+    SSL_free(connection->ssl);
+    connection->ssl = nullptr;
+  }
+  shutdown(connection->fd, SHUT_RDWR);
+  connection->done = true;
+}
+
+ssize_t
+MockHttpFrontend::Receive(Connection* connection, void* buf, const size_t size)
+{
+  if (connection->ssl != nullptr) {
+    return SSL_read(
+        connection->ssl, buf,
+        static_cast<int>(std::min(size, static_cast<size_t>(INT_MAX))));
+  }
+  while (true) {
+    const ssize_t n = recv(connection->fd, buf, size, 0);
+    if ((n >= 0) || (errno != EINTR)) {
+      return n;
+    }
+  }
+}
+
+bool
+MockHttpFrontend::ReadRequest(
+    Connection* connection, std::string* buffer, HttpRequest* request)
+{
+  *request = HttpRequest();
+  char chunk[16 * 1024];
+  size_t header_end;
+  while ((header_end = buffer->find("\r\n\r\n")) == std::string::npos) {
+    if (buffer->size() > kMaxHttpHeaderSize) {
+      return false;
+    }
+    const ssize_t n = Receive(connection, chunk, sizeof(chunk));
+    if (n <= 0) {
+      return false;
+    }
+    buffer->append(chunk, n);
+  }
+
+  size_t line_end = buffer->find("\r\n");
+  std::istringstream request_line(buffer->substr(0, line_end));
+  request_line >> request->method >> request->path >> request->version;
+  request->path = request->path.substr(0, request->path.find('?'));
+  for (size_t pos = line_end + 2; pos < header_end; pos = line_end + 2) {
+    line_end = buffer->find("\r\n", pos);
+    const std::string line = buffer->substr(pos, line_end - pos);
+    const size_t colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    const size_t value_begin = line.find_first_not_of(" \t", colon + 1);
+    const size_t value_end = line.find_last_not_of(" \t");
+    request->headers[ToLower(line.substr(0, colon))] =
+        (value_begin == std::string::npos)
+            ? ""
+            : line.substr(value_begin, value_end - value_begin + 1);
+  }
+  buffer->erase(0, header_end + 4);
+
+  const auto transfer_encoding = request->headers.find("transfer-encoding");
+  if ((transfer_encoding != request->headers.end()) &&
+      (ToLower(transfer_encoding->second) != "identity")) {
+    request->error =
+        "the mock server does not support the transfer encoding '" +
+        transfer_encoding->second + "'";
+    return true;
+  }
+  const auto content_encoding = request->headers.find("content-encoding");
+  if ((content_encoding != request->headers.end()) &&
+      (ToLower(content_encoding->second) != "identity")) {
+    request->error =
+        "the mock server does not support the content encoding '" +
+        content_encoding->second + "'";
+    return true;
+  }
+
+  size_t content_length = 0;
+  const auto length_itr = request->headers.find("content-length");
+  if (length_itr != request->headers.end()) {
+    content_length = std::strtoull(length_itr->second.c_str(), nullptr, 10);
+  }
+  if (buffer->size() < content_length) {
+    const auto expect = request->headers.find("expect");
+    if ((expect != request->headers.end()) &&
+        (ToLower(expect->second) == "100-continue")) {
+      static const char kContinue[] = "HTTP/1.1 100 Continue\r\n\r\n";
+      const bool sent =
+          (connection->ssl != nullptr)
+              ? (SSL_write(connection->ssl, kContinue, sizeof(kContinue) - 1) >
+                 0)
+              : (send(
+                     connection->fd, kContinue, sizeof(kContinue) - 1,
+                     MSG_NOSIGNAL) > 0);
+      if (!sent) {
+        return false;
+      }
+    }
+    // Read the rest of the body in place.
+    size_t received = buffer->size();
+    buffer->resize(content_length);
+    while (received < content_length) {
+      const ssize_t n = Receive(
+          connection, &(*buffer)[received], content_length - received);
+      if (n <= 0) {
+        return false;
+      }
+      received += n;
+    }
+  }
+  if (buffer->size() == content_length) {
+    request->body.swap(*buffer);
+    buffer->clear();
+  } else {
+    request->body = buffer->substr(0, content_length);
+    buffer->erase(0, content_length);
+  }
+  return true;
+}
+
+bool
+MockHttpFrontend::WriteResponse(
+    Connection* connection, const HttpResponse& response,
+    const bool keep_alive)
+{
+  size_t content_length = response.body.size();
+  for (const auto& binary : response.binary) {
+    content_length += binary.second;
+  }
+  std::string header =
+      "HTTP/1.1 " + std::to_string(response.code) +
+      ((response.code == 200)   ? " OK\r\n"
+       : (response.code == 404) ? " Not Found\r\n"
+                                : " Bad Request\r\n");
+  if (!response.body.empty()) {
+    header += response.binary.empty()
+                  ? "Content-Type: application/json\r\n"
+                  : "Content-Type: application/octet-stream\r\n";
+  }
+  for (const auto& line : response.headers) {
+    header += line + "\r\n";
+  }
+  header += "Content-Length: " + std::to_string(content_length) + "\r\n";
+  header += keep_alive ? "Connection: keep-alive\r\n\r\n"
+                       : "Connection: close\r\n\r\n";
+
+  std::vector<struct iovec> iov;
+  iov.push_back({const_cast<char*>(header.data()), header.size()});
+  if (!response.body.empty()) {
+    iov.push_back(
+        {const_cast<char*>(response.body.data()), response.body.size()});
+  }
+  for (const auto& binary : response.binary) {
+    if (binary.second > 0) {
+      iov.push_back({const_cast<uint8_t*>(binary.first), binary.second});
+    }
+  }
+
+  if (connection->ssl != nullptr) {
+    // TLS has no scatter write, send the buffers one after another.
+    for (const auto& buf : iov) {
+      if (SSL_write(
+              connection->ssl, buf.iov_base, static_cast<int>(buf.iov_len)) <=
+          0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Send everything with as few system calls as possible.
+  size_t next = 0;
+  while (next < iov.size()) {
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov[next];
+    msg.msg_iovlen = std::min(iov.size() - next, static_cast<size_t>(IOV_MAX));
+    ssize_t n = sendmsg(connection->fd, &msg, MSG_NOSIGNAL);
+    if ((n < 0) && (errno == EINTR)) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    while ((next < iov.size()) &&
+           (static_cast<size_t>(n) >= iov[next].iov_len)) {
+      n -= iov[next].iov_len;
+      ++next;
+    }
+    if (n > 0) {
+      iov[next].iov_base = reinterpret_cast<char*>(iov[next].iov_base) + n;
+      iov[next].iov_len -= n;
+    }
+  }
+  return true;
+}
+
+void
+MockHttpFrontend::Handle(const HttpRequest& request, HttpResponse* response)
+{
+  if (!request.error.empty()) {
+    SetError(tc::Error(request.error), response);
+    return;
+  }
+
+  std::vector<std::string> segments;
+  std::istringstream path(request.path);
+  for (std::string segment; std::getline(path, segment, '/');) {
+    if (!segment.empty()) {
+      segments.push_back(segment);
+    }
+  }
+
+  const bool get = (request.method == "GET");
+  const bool post = (request.method == "POST");
+  if (segments.empty() || (segments[0] != "v2")) {
+    SetError(tc::Error("Not Found"), response, 404);
+  } else if (segments.size() == 1) {
+    if (get) {
+      ServerMetadata(response);
+      return;
+    }
+  } else if (segments[1] == "health") {
+    if (get && (segments.size() == 3) &&
+        ((segments[2] == "live") || (segments[2] == "ready"))) {
+      return;
+    }
+  } else if (segments[1] == "models") {
+    HandleModel(request, segments, response);
+    return;
+  } else if (segments[1] == "repository") {
+    if (post && (segments.size() == 3) && (segments[2] == "index")) {
+      RepositoryIndex(response);
+      return;
+    }
+  } else if (segments[1] == "systemsharedmemory") {
+    HandleSystemSharedMemory(request, segments, response);
+    return;
+  } else if (segments[1] == "cudasharedmemory") {
+    if (get && (segments.back() == "status")) {
+      response->body = "[]";
+      return;
+    }
+    SetError(
+        tc::Error("CUDA shared memory is not supported by the mock server"),
+        response);
+    return;
+  }
+  SetError(tc::Error("Not Found"), response, 404);
+}
+
+void
+MockHttpFrontend::HandleModel(
+    const HttpRequest& request, const std::vector<std::string>& segments,
+    HttpResponse* response)
+{
+  const bool get = (request.method == "GET");
+  const bool post = (request.method == "POST");
+  if ((segments.size() == 3) && (segments[2] == "stats") && get) {
+    ModelStatistics("", "", response);
+    return;
+  }
+  if (segments.size() < 3) {
+    SetError(tc::Error("Not Found"), response, 404);
+    return;
+  }
+
+  // /v2/models/<name>[/versions/<version>][/<action>]
+  const std::string& name = segments[2];
+  std::string version;
+  size_t next = 3;
+  if ((segments.size() >= 5) && (segments[3] == "versions")) {
+    version = segments[4];
+    next = 5;
+  }
+  if (segments.size() > next + 1) {
+    SetError(tc::Error("Not Found"), response, 404);
+    return;
+  }
+  const std::string action = (next < segments.size()) ? segments[next] : "";
+
+  if (post && (action == "infer")) {
+    HandleInfer(name, version, request, response);
+    return;
+  }
+  if (!get) {
+    SetError(tc::Error("Not Found"), response, 404);
+    return;
+  }
+  if (action == "stats") {
+    ModelStatistics(name, version, response);
+    return;
+  }
+
+  const MockModelConfig* model;
+  tc::Error err = core_->FindModel(name, version, &model);
+  if (!err.IsOk()) {
+    SetError(err, response);
+  } else if (action.empty()) {
+    ModelMetadata(*model, response);
+  } else if (action == "config") {
+    ModelConfig(*model, response);
+  } else if (action != "ready") {
+    SetError(tc::Error("Not Found"), response, 404);
+  }
+}
+
+void
+MockHttpFrontend::HandleSystemSharedMemory(
+    const HttpRequest& request, const std::vector<std::string>& segments,
+    HttpResponse* response)
+{
+  // /v2/systemsharedmemory[/region/<name>]/<action>
+  std::string name;
+  if ((segments.size() == 5) && (segments[2] == "region")) {
+    name = segments[3];
+  } else if (segments.size() != 3) {
+    SetError(tc::Error("Not Found"), response, 404);
+    return;
+  }
+  const std::string& action = segments.back();
+
+  if ((action == "status") && (request.method == "GET")) {
+    std::vector<std::shared_ptr<MockSharedMemoryRegion>> regions;
+    tc::Error err = core_->SystemSharedMemoryStatus(name, &regions);
+    if (!err.IsOk()) {
+      SetError(err, response);
+      return;
+    }
+    TritonJson::Value status_json(TritonJson::ValueType::ARRAY);
+    for (const auto& region : regions) {
+      TritonJson::Value region_json(
+          status_json, TritonJson::ValueType::OBJECT);
+      AddString(&region_json, "name", region->name);
+      AddString(&region_json, "key", region->key);
+      region_json.AddUInt("offset", region->offset);
+      region_json.AddUInt("byte_size", region->byte_size);
+      status_json.Append(std::move(region_json));
+    }
+    SetJson(status_json, response);
+  } else if ((action == "register") && (request.method == "POST")) {
+    TritonJson::Value register_json;
+    std::string key;
+    uint64_t offset = 0;
+    uint64_t byte_size = 0;
+    tc::Error err =
+        register_json.Parse(request.body.data(), request.body.size());
+    if (err.IsOk()) {
+      err = register_json.MemberAsString("key", &key);
+    }
+    if (err.IsOk()) {
+      TritonJson::Value offset_json;
+      if (register_json.Find("offset", &offset_json)) {
+        err = register_json.MemberAsUInt("offset", &offset);
+      }
+    }
+    if (err.IsOk()) {
+      err = register_json.MemberAsUInt("byte_size", &byte_size);
+    }
+    if (err.IsOk()) {
+      err = core_->RegisterSystemSharedMemory(name, key, offset, byte_size);
+    }
+    if (!err.IsOk()) {
+      SetError(err, response);
+    }
+  } else if ((action == "unregister") && (request.method == "POST")) {
+    core_->UnregisterSystemSharedMemory(name);
+  } else {
+    SetError(tc::Error("Not Found"), response, 404);
+  }
+}
+
+void
+MockHttpFrontend::HandleInfer(
+    const std::string& model_name, const std::string& model_version,
+    const HttpRequest& request, HttpResponse* response)
+{
+  const auto start = std::chrono::steady_clock::now();
+  const MockModelConfig* model;
+  tc::Error err = core_->FindModel(model_name, model_version, &model);
+  if (!err.IsOk()) {
+    SetError(err, response);
+    return;
+  }
+  if (model->kind == MockModelConfig::Kind::DECOUPLED) {
+    SetError(
+        tc::Error(
+            "HTTP end point doesn't support models with decoupled "
+            "transaction policy"),
+        response);
+    return;
+  }
+
+  size_t batch_size = 0;
+  uint64_t compute_ns = 0;
+  err = Infer(*model, request, response, &batch_size, &compute_ns);
+  core_->Report(*model, batch_size, err.IsOk(), NsSince(start), compute_ns);
+  if (!err.IsOk()) {
+    *response = HttpResponse();
+    SetError(err, response);
+  }
+}
+
+tc::Error
+MockHttpFrontend::Infer(
+    const MockModelConfig& model, const HttpRequest& request,
+    HttpResponse* response, size_t* batch_size, uint64_t* compute_ns)
+{
+  size_t header_length = request.body.size();
+  const auto length_itr = request.headers.find(kInferHeaderContentLength);
+  if (length_itr != request.headers.end()) {
+    header_length = std::strtoull(length_itr->second.c_str(), nullptr, 10);
+    if ((header_length == 0) || (header_length > request.body.size())) {
+      return tc::Error(
+          "inference header size should be in range (0, " +
+          std::to_string(request.body.size()) + "], got: " +
+          length_itr->second);
+    }
+  }
+
+  TritonJson::Value request_json;
+  RETURN_IF_ERR(request_json.Parse(request.body.data(), header_length));
+
+  TritonJson::Value value_json;
+  std::string id;
+  if (request_json.Find("id", &value_json)) {
+    RETURN_IF_ERR(request_json.MemberAsString("id", &id));
+  }
+  bool binary_data_output = false;
+  TritonJson::Value params_json;
+  if (request_json.Find("parameters", &params_json) &&
+      params_json.Find("binary_data_output", &value_json)) {
+    RETURN_IF_ERR(
+        params_json.MemberAsBool("binary_data_output", &binary_data_output));
+  }
+
+  // Inputs, with their binary data following the JSON header in order.
+  std::vector<MockTensor> inputs;
+  std::vector<std::shared_ptr<MockSharedMemoryRegion>> regions;
+  size_t binary_offset = header_length;
+  TritonJson::Value inputs_json;
+  if (!request_json.Find("inputs", &inputs_json)) {
+    return tc::Error("expected 'inputs' in the inference request");
+  }
+  for (size_t i = 0; i < inputs_json.ArraySize(); ++i) {
+    TritonJson::Value input_json;
+    RETURN_IF_ERR(inputs_json.IndexAsObject(i, &input_json));
+    MockTensor input;
+    RETURN_IF_ERR(input_json.MemberAsString("name", &input.name));
+    RETURN_IF_ERR(input_json.MemberAsString("datatype", &input.datatype));
+    TritonJson::Value shape_json;
+    if (!input_json.Find("shape", &shape_json)) {
+      return tc::Error("expected 'shape' for input '" + input.name + "'");
+    }
+    for (size_t d = 0; d < shape_json.ArraySize(); ++d) {
+      int64_t dim;
+      RETURN_IF_ERR(shape_json.IndexAsInt(d, &dim));
+      input.shape.push_back(dim);
+    }
+
+    TritonJson::Value io_params_json;
+    const bool has_params = input_json.Find("parameters", &io_params_json);
+    TritonJson::Value data_json;
+    if (has_params &&
+        io_params_json.Find("shared_memory_region", &value_json)) {
+      std::string region_name;
+      uint64_t byte_size = 0;
+      uint64_t offset = 0;
+      RETURN_IF_ERR(
+          io_params_json.MemberAsString("shared_memory_region", &region_name));
+      RETURN_IF_ERR(
+          io_params_json.MemberAsUInt("shared_memory_byte_size", &byte_size));
+      if (io_params_json.Find("shared_memory_offset", &value_json)) {
+        RETURN_IF_ERR(
+            io_params_json.MemberAsUInt("shared_memory_offset", &offset));
+      }
+      std::shared_ptr<MockSharedMemoryRegion> region;
+      uint8_t* addr;
+      RETURN_IF_ERR(
+          core_->SharedMemory(region_name, offset, byte_size, &region, &addr));
+      regions.push_back(region);
+      input.data = addr;
+      input.byte_size = byte_size;
+    } else if (
+        has_params && io_params_json.Find("binary_data_size", &value_json)) {
+      uint64_t byte_size = 0;
+      RETURN_IF_ERR(
+          io_params_json.MemberAsUInt("binary_data_size", &byte_size));
+      if (byte_size > request.body.size() - binary_offset) {
+        return tc::Error(
+            "unexpected size for input '" + input.name + "', expecting " +
+            std::to_string(byte_size) + " bytes for model '" + model.name +
+            "'");
+      }
+      input.data =
+          reinterpret_cast<const uint8_t*>(request.body.data()) + binary_offset;
+      input.byte_size = byte_size;
+      binary_offset += byte_size;
+    } else if (input_json.Find("data", &data_json)) {
+      RETURN_IF_ERR(JsonToBinary(data_json, input.datatype, &input.buffer));
+      input.data = input.buffer.data();
+      input.byte_size = input.buffer.size();
+    } else {
+      return tc::Error(
+          "expected 'data' or binary data for input '" + input.name + "'");
+    }
+    inputs.push_back(std::move(input));
+  }
+  if (binary_offset != request.body.size()) {
+    return tc::Error(
+        "unexpected additional input data for model '" + model.name + "'");
+  }
+
+  // The requested outputs, all the outputs if none are given.
+  std::vector<MockRequestedOutput> requested;
+  TritonJson::Value outputs_json;
+  if (request_json.Find("outputs", &outputs_json)) {
+    for (size_t i = 0; i < outputs_json.ArraySize(); ++i) {
+      TritonJson::Value output_json;
+      RETURN_IF_ERR(outputs_json.IndexAsObject(i, &output_json));
+      MockRequestedOutput output;
+      output.binary_data = binary_data_output;
+      RETURN_IF_ERR(output_json.MemberAsString("name", &output.name));
+      size_t index;
+      RETURN_IF_ERR(core_->OutputIndex(model, output.name, &index));
+      TritonJson::Value io_params_json;
+      if (output_json.Find("parameters", &io_params_json)) {
+        if (io_params_json.Find("shared_memory_region", &value_json)) {
+          uint64_t byte_size = 0;
+          uint64_t offset = 0;
+          RETURN_IF_ERR(io_params_json.MemberAsString(
+              "shared_memory_region", &output.shm_region));
+          RETURN_IF_ERR(io_params_json.MemberAsUInt(
+              "shared_memory_byte_size", &byte_size));
+          if (io_params_json.Find("shared_memory_offset", &value_json)) {
+            RETURN_IF_ERR(
+                io_params_json.MemberAsUInt("shared_memory_offset", &offset));
+          }
+          output.shm_byte_size = byte_size;
+          output.shm_offset = offset;
+        } else if (io_params_json.Find("binary_data", &value_json)) {
+          RETURN_IF_ERR(
+              io_params_json.MemberAsBool("binary_data", &output.binary_data));
+        }
+      }
+      requested.push_back(output);
+    }
+  } else {
+    for (size_t i = 0; i < model.input_count; ++i) {
+      MockRequestedOutput output;
+      output.name = "OUTPUT" + std::to_string(i);
+      output.binary_data = binary_data_output;
+      requested.push_back(output);
+    }
+  }
+
+  RETURN_IF_ERR(core_->CheckInputs(model, &inputs, batch_size));
+  std::vector<MockTensor> outputs;
+  const auto compute_start = std::chrono::steady_clock::now();
+  core_->Execute(model, inputs, &outputs);
+  *compute_ns = NsSince(compute_start);
+
+  TritonJson::Value response_json(TritonJson::ValueType::OBJECT);
+  response_json.AddStringRef(
+      "model_name", model.name.c_str(), model.name.size());
+  response_json.AddStringRef(
+      "model_version", kModelVersion.c_str(), kModelVersion.size());
+  if (!id.empty()) {
+    AddString(&response_json, "id", id);
+  }
+  TritonJson::Value response_outputs_json(
+      response_json, TritonJson::ValueType::ARRAY);
+  for (const auto& output_request : requested) {
+    size_t index;
+    RETURN_IF_ERR(core_->OutputIndex(model, output_request.name, &index));
+    const MockTensor& output = outputs[index];
+
+    TritonJson::Value output_json(response_json, TritonJson::ValueType::OBJECT);
+    output_json.AddStringRef("name", output.name.c_str(), output.name.size());
+    output_json.AddStringRef(
+        "datatype", output.datatype.c_str(), output.datatype.size());
+    TritonJson::Value shape_json(response_json, TritonJson::ValueType::ARRAY);
+    for (const int64_t dim : output.shape) {
+      shape_json.AppendInt(dim);
+    }
+    output_json.Add("shape", std::move(shape_json));
+
+    if (!output_request.shm_region.empty()) {
+      RETURN_IF_ERR(core_->WriteSharedMemory(output_request, output));
+    } else if (output_request.binary_data) {
+      TritonJson::Value io_params_json(
+          response_json, TritonJson::ValueType::OBJECT);
+      io_params_json.AddUInt("binary_data_size", output.byte_size);
+      output_json.Add("parameters", std::move(io_params_json));
+      response->binary.emplace_back(output.data, output.byte_size);
+    } else {
+      const int64_t element_size = DatatypeByteSize(output.datatype);
+      TritonJson::Value data_json(response_json, TritonJson::ValueType::ARRAY);
+      if ((output.datatype == "FP16") || (output.datatype == "BF16")) {
+        return tc::Error(
+            "datatype '" + output.datatype +
+            "' is not supported with JSON data");
+      } else if (output.datatype == "BYTES") {
+        size_t offset = 0;
+        while (offset + sizeof(uint32_t) <= output.byte_size) {
+          const uint32_t len = Load<uint32_t>(output.data + offset);
+          data_json.AppendStringRef(
+              reinterpret_cast<const char*>(output.data) + offset +
+                  sizeof(uint32_t),
+              len);
+          offset += sizeof(uint32_t) + len;
+        }
+      } else {
+        for (size_t offset = 0; offset < output.byte_size;
+             offset += element_size) {
+          const uint8_t* src = output.data + offset;
+          const std::string& dt = output.datatype;
+          if (dt == "BOOL") {
+            data_json.AppendBool(*src != 0);
+          } else if (dt == "UINT8") {
+            data_json.AppendUInt(Load<uint8_t>(src));
+          } else if (dt == "UINT16") {
+            data_json.AppendUInt(Load<uint16_t>(src));
+          } else if (dt == "UINT32") {
+            data_json.AppendUInt(Load<uint32_t>(src));
+          } else if (dt == "UINT64") {
+            data_json.AppendUInt(Load<uint64_t>(src));
+          } else if (dt == "INT8") {
+            data_json.AppendInt(Load<int8_t>(src));
+          } else if (dt == "INT16") {
+            data_json.AppendInt(Load<int16_t>(src));
+          } else if (dt == "INT32") {
+            data_json.AppendInt(Load<int32_t>(src));
+          } else if (dt == "INT64") {
+            data_json.AppendInt(Load<int64_t>(src));
+          } else if (dt == "FP32") {
+            data_json.AppendDouble(Load<float>(src));
+          } else {
+            data_json.AppendDouble(Load<double>(src));
+          }
+        }
+      }
+      output_json.Add("data", std::move(data_json));
+    }
+    response_outputs_json.Append(std::move(output_json));
+  }
+  response_json.Add("outputs", std::move(response_outputs_json));
+  SetJson(response_json, response);
+  if (!response->binary.empty()) {
+    response->headers.push_back(
+        "Inference-Header-Content-Length: " +
+        std::to_string(response->body.size()));
+  }
+
+  // Keep the tensors the binary data points into until the response is
+  // written. The data of the other inputs is in the request.
+  response->tensors = std::move(outputs);
+  for (auto& input : inputs) {
+    response->tensors.push_back(std::move(input));
+  }
+  return tc::Error::Success;
+}
+
+void
+MockHttpFrontend::ServerMetadata(HttpResponse* response)
+{
+  static const char* extensions[] = {
+      "classification", "model_repository", "schedule_policy",
+      "model_configuration", "system_shared_memory", "binary_tensor_data",
+      "statistics"};
+  TritonJson::Value metadata_json(TritonJson::ValueType::OBJECT);
+  metadata_json.AddStringRef("name", "triton", strlen("triton"));
+  metadata_json.AddStringRef(
+      "version", kPlatform.c_str(), kPlatform.size());
+  TritonJson::Value extensions_json(
+      metadata_json, TritonJson::ValueType::ARRAY);
+  for (const char* extension : extensions) {
+    extensions_json.AppendStringRef(extension, strlen(extension));
+  }
+  metadata_json.Add("extensions", std::move(extensions_json));
+  SetJson(metadata_json, response);
+}
+
+void
+MockHttpFrontend::ModelMetadata(
+    const MockModelConfig& model, HttpResponse* response)
+{
+  std::vector<int64_t> shape;
+  if (model.max_batch_size > 0) {
+    shape.push_back(-1);
+  }
+  shape.insert(shape.end(), model.dims.begin(), model.dims.end());
+
+  TritonJson::Value metadata_json(TritonJson::ValueType::OBJECT);
+  metadata_json.AddStringRef("name", model.name.c_str(), model.name.size());
+  TritonJson::Value versions_json(metadata_json, TritonJson::ValueType::ARRAY);
+  versions_json.AppendStringRef(kModelVersion.c_str(), kModelVersion.size());
+  metadata_json.Add("versions", std::move(versions_json));
+  metadata_json.AddStringRef(
+      "platform", kPlatform.c_str(), kPlatform.size());
+  for (const char* io : {"inputs", "outputs"}) {
+    TritonJson::Value tensors_json(metadata_json, TritonJson::ValueType::ARRAY);
+    for (size_t i = 0; i < model.input_count; ++i) {
+      TritonJson::Value tensor_json(
+          metadata_json, TritonJson::ValueType::OBJECT);
+      AddString(
+          &tensor_json, "name",
+          ((io[0] == 'i') ? "INPUT" : "OUTPUT") + std::to_string(i));
+      tensor_json.AddStringRef(
+          "datatype", model.datatype.c_str(), model.datatype.size());
+      TritonJson::Value shape_json(metadata_json, TritonJson::ValueType::ARRAY);
+      for (const int64_t dim : shape) {
+        shape_json.AppendInt(dim);
+      }
+      tensor_json.Add("shape", std::move(shape_json));
+      tensors_json.Append(std::move(tensor_json));
+    }
+    metadata_json.Add(io, std::move(tensors_json));
+  }
+  SetJson(metadata_json, response);
+}
+
+void
+MockHttpFrontend::ModelConfig(
+    const MockModelConfig& model, HttpResponse* response)
+{
+  const std::string data_type =
+      "TYPE_" + ((model.datatype == "BYTES") ? "STRING" : model.datatype);
+
+  TritonJson::Value config_json(TritonJson::ValueType::OBJECT);
+  config_json.AddStringRef("name", model.name.c_str(), model.name.size());
+  config_json.AddStringRef(
+      "platform", kPlatform.c_str(), kPlatform.size());
+  config_json.AddStringRef("backend", kPlatform.c_str(), kPlatform.size());
+  config_json.AddInt("max_batch_size", model.max_batch_size);
+  for (const char* io : {"input", "output"}) {
+    TritonJson::Value tensors_json(config_json, TritonJson::ValueType::ARRAY);
+    for (size_t i = 0; i < model.input_count; ++i) {
+      TritonJson::Value tensor_json(config_json, TritonJson::ValueType::OBJECT);
+      AddString(
+          &tensor_json, "name",
+          ((io[0] == 'i') ? "INPUT" : "OUTPUT") + std::to_string(i));
+      AddString(&tensor_json, "data_type", data_type);
+      TritonJson::Value dims_json(config_json, TritonJson::ValueType::ARRAY);
+      for (const int64_t dim : model.dims) {
+        dims_json.AppendInt(dim);
+      }
+      tensor_json.Add("dims", std::move(dims_json));
+      tensors_json.Append(std::move(tensor_json));
+    }
+    config_json.Add(io, std::move(tensors_json));
+  }
+  TritonJson::Value policy_json(config_json, TritonJson::ValueType::OBJECT);
+  policy_json.AddBool(
+      "decoupled", model.kind == MockModelConfig::Kind::DECOUPLED);
+  config_json.Add("model_transaction_policy", std::move(policy_json));
+  SetJson(config_json, response);
+}
+
+void
+MockHttpFrontend::ModelStatistics(
+    const std::string& name, const std::string& version,
+    HttpResponse* response)
+{
+  std::vector<std::pair<const MockModelConfig*, MockModelStats>> stats;
+  tc::Error err = core_->Statistics(name, version, &stats);
+  if (!err.IsOk()) {
+    SetError(err, response);
+    return;
+  }
+
+  TritonJson::Value stats_json(TritonJson::ValueType::OBJECT);
+  TritonJson::Value models_json(stats_json, TritonJson::ValueType::ARRAY);
+  for (const auto& model_stats : stats) {
+    const MockModelConfig& model = *model_stats.first;
+    const MockModelStats& s = model_stats.second;
+    TritonJson::Value model_json(stats_json, TritonJson::ValueType::OBJECT);
+    model_json.AddStringRef("name", model.name.c_str(), model.name.size());
+    model_json.AddStringRef(
+        "version", kModelVersion.c_str(), kModelVersion.size());
+    model_json.AddUInt("last_inference", s.last_inference_ms);
+    model_json.AddUInt("inference_count", s.inference_count);
+    model_json.AddUInt("execution_count", s.execution_count);
+
+    TritonJson::Value infer_json(stats_json, TritonJson::ValueType::OBJECT);
+    const auto add_duration = [&stats_json, &infer_json](
+                                  const char* duration_name,
+                                  const uint64_t count, const uint64_t ns) {
+      TritonJson::Value duration_json(
+          stats_json, TritonJson::ValueType::OBJECT);
+      duration_json.AddUInt("count", count);
+      duration_json.AddUInt("ns", ns);
+      infer_json.Add(duration_name, std::move(duration_json));
+    };
+    add_duration("success", s.success_count, s.success_ns);
+    add_duration("fail", s.fail_count, s.fail_ns);
+    add_duration("queue", s.success_count, 0);
+    add_duration("compute_input", s.compute_infer_count, 0);
+    add_duration("compute_infer", s.compute_infer_count, s.compute_infer_ns);
+    add_duration("compute_output", s.compute_infer_count, 0);
+    add_duration("cache_hit", 0, 0);
+    add_duration("cache_miss", 0, 0);
+    model_json.Add("inference_stats", std::move(infer_json));
+    model_json.Add(
+        "batch_stats",
+        TritonJson::Value(stats_json, TritonJson::ValueType::ARRAY));
+    models_json.Append(std::move(model_json));
+  }
+  stats_json.Add("model_stats", std::move(models_json));
+  SetJson(stats_json, response);
+}
+
+void
+MockHttpFrontend::RepositoryIndex(HttpResponse* response)
+{
+  TritonJson::Value index_json(TritonJson::ValueType::ARRAY);
+  for (const auto& model : core_->Models()) {
+    TritonJson::Value model_json(index_json, TritonJson::ValueType::OBJECT);
+    model_json.AddStringRef("name", model.name.c_str(), model.name.size());
+    model_json.AddStringRef(
+        "version", kModelVersion.c_str(), kModelVersion.size());
+    model_json.AddStringRef("state", "READY", strlen("READY"));
+    index_json.Append(std::move(model_json));
+  }
+  SetJson(index_json, response);
+}
+
+void
+MockHttpFrontend::SetJson(TritonJson::Value& json, HttpResponse* response)
+{
+  TritonJson::WriteBuffer buffer;
+  tc::Error err = json.Write(&buffer);
+  if (!err.IsOk()) {
+    SetError(err, response);
+    return;
+  }
+  response->body = buffer.Contents();
+}
+
+void
+MockHttpFrontend::SetError(
+    const tc::Error& err, HttpResponse* response, const int code)
+{
+  TritonJson::Value error_json(TritonJson::ValueType::OBJECT);
+  AddString(&error_json, "error", err.Message());
+  TritonJson::WriteBuffer buffer;
+  error_json.Write(&buffer);
+  response->code = code;
+  response->body = buffer.Contents();
+}
+
+//==============================================================================
+// Implements the GRPC protocol with the synchronous API. Streamed requests
+// are run concurrently, each by its own thread, so their responses may be
+// written out of order as they are by Triton.
+//
+class MockGrpcService final
+    : public inference::GRPCInferenceService::Service {
+ public:
+  explicit MockGrpcService(MockServerCore* core) : core_(core) {}
+
+  grpc::Status ServerLive(
+      grpc::ServerContext* context, const inference::ServerLiveRequest* request,
+      inference::ServerLiveResponse* response) override
+  {
+    response->set_live(true);
+    return grpc::Status::OK;
+  }
+
+  grpc::Status ServerReady(
+      grpc::ServerContext* context,
+      const inference::ServerReadyRequest* request,
+      inference::ServerReadyResponse* response) override
+  {
+    response->set_ready(true);
+    return grpc::Status::OK;
+  }
+
+  grpc::Status ModelReady(
+      grpc::ServerContext* context, const inference::ModelReadyRequest* request,
+      inference::ModelReadyResponse* response) override
+  {
+    const MockModelConfig* model;
+    response->set_ready(
+        core_->FindModel(request->name(), request->version(), &model).IsOk());
+    return grpc::Status::OK;
+  }
+
+  grpc::Status ServerMetadata(
+      grpc::ServerContext* context,
+      const inference::ServerMetadataRequest* request,
+      inference::ServerMetadataResponse* response) override;
+
+  grpc::Status ModelMetadata(
+      grpc::ServerContext* context,
+      const inference::ModelMetadataRequest* request,
+      inference::ModelMetadataResponse* response) override;
+
+  grpc::Status ModelConfig(
+      grpc::ServerContext* context,
+      const inference::ModelConfigRequest* request,
+      inference::ModelConfigResponse* response) override;
+
+  grpc::Status ModelStatistics(
+      grpc::ServerContext* context,
+      const inference::ModelStatisticsRequest* request,
+      inference::ModelStatisticsResponse* response) override;
+
+  grpc::Status RepositoryIndex(
+      grpc::ServerContext* context,
+      const inference::RepositoryIndexRequest* request,
+      inference::RepositoryIndexResponse* response) override;
+
+  grpc::Status SystemSharedMemoryStatus(
+      grpc::ServerContext* context,
+      const inference::SystemSharedMemoryStatusRequest* request,
+      inference::SystemSharedMemoryStatusResponse* response) override;
+
+  grpc::Status SystemSharedMemoryRegister(
+      grpc::ServerContext* context,
+      const inference::SystemSharedMemoryRegisterRequest* request,
+      inference::SystemSharedMemoryRegisterResponse* response) override;
+
+  grpc::Status SystemSharedMemoryUnregister(
+      grpc::ServerContext* context,
+      const inference::SystemSharedMemoryUnregisterRequest* request,
+      inference::SystemSharedMemoryUnregisterResponse* response) override;
+
+  grpc::Status ModelInfer(
+      grpc::ServerContext* context, const inference::ModelInferRequest* request,
+      inference::ModelInferResponse* response) override;
+
+  grpc::Status ModelStreamInfer(
+      grpc::ServerContext* context,
+      grpc::ServerReaderWriter<
+          inference::ModelStreamInferResponse, inference::ModelInferRequest>*
+          stream) override;
+
+ private:
+  // Run 'request', calling 'send' with each of its 'response_count'
+  // responses and whether it is the last one.
+  tc::Error Infer(
+      const inference::ModelInferRequest& request,
+      const MockModelConfig& model, const size_t response_count,
+      const std::function<void(inference::ModelInferResponse*, bool)>& send);
+
+  static grpc::Status ToStatus(const tc::Error& err)
+  {
+    return err.IsOk() ? grpc::Status::OK
+                      : grpc::Status(
+                            grpc::StatusCode::INVALID_ARGUMENT, err.Message());
+  }
+
+  static uint64_t UIntParameter(
+      const google::protobuf::Map<std::string, inference::InferParameter>&
+          params,
+      const std::string& name)
+  {
+    const auto itr = params.find(name);
+    if (itr == params.end()) {
+      return 0;
+    }
+    return (itr->second.parameter_choice_case() ==
+            inference::InferParameter::kUint64Param)
+               ? itr->second.uint64_param()
+               : itr->second.int64_param();
+  }
+
+  MockServerCore* core_;
+};
+
+grpc::Status
+MockGrpcService::ServerMetadata(
+    grpc::ServerContext* context,
+    const inference::ServerMetadataRequest* request,
+    inference::ServerMetadataResponse* response)
+{
+  response->set_name("triton");
+  response->set_version(kPlatform);
+  for (const char* extension :
+       {"classification", "model_repository", "schedule_policy",
+        "model_configuration", "system_shared_memory", "binary_tensor_data",
+        "statistics"}) {
+    response->add_extensions(extension);
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status
+MockGrpcService::ModelMetadata(
+    grpc::ServerContext* context,
+    const inference::ModelMetadataRequest* request,
+    inference::ModelMetadataResponse* response)
+{
+  const MockModelConfig* model;
+  tc::Error err = core_->FindModel(request->name(), request->version(), &model);
+  if (!err.IsOk()) {
+    return ToStatus(err);
+  }
+  response->set_name(model->name);
+  response->add_versions(kModelVersion);
+  response->set_platform(kPlatform);
+  for (size_t i = 0; i < model->input_count; ++i) {
+    auto input = response->add_inputs();
+    input->set_name("INPUT" + std::to_string(i));
+    auto output = response->add_outputs();
+    output->set_name("OUTPUT" + std::to_string(i));
+    for (auto tensor : {input, output}) {
+      tensor->set_datatype(model->datatype);
+      if (model->max_batch_size > 0) {
+        tensor->add_shape(-1);
+      }
+      for (const int64_t dim : model->dims) {
+        tensor->add_shape(dim);
+      }
+    }
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status
+MockGrpcService::ModelConfig(
+    grpc::ServerContext* context, const inference::ModelConfigRequest* request,
+    inference::ModelConfigResponse* response)
+{
+  const MockModelConfig* model;
+  tc::Error err = core_->FindModel(request->name(), request->version(), &model);
+  if (!err.IsOk()) {
+    return ToStatus(err);
+  }
+  inference::DataType data_type = inference::DataType::TYPE_INVALID;
+  inference::DataType_Parse(
+      "TYPE_" + ((model->datatype == "BYTES") ? "STRING" : model->datatype),
+      &data_type);
+
+  inference::ModelConfig* config = response->mutable_config();
+  config->set_name(model->name);
+  config->set_platform(kPlatform);
+  config->set_backend(kPlatform);
+  config->set_max_batch_size(model->max_batch_size);
+  for (size_t i = 0; i < model->input_count; ++i) {
+    inference::ModelInput* input = config->add_input();
+    input->set_name("INPUT" + std::to_string(i));
+    input->set_data_type(data_type);
+    inference::ModelOutput* output = config->add_output();
+    output->set_name("OUTPUT" + std::to_string(i));
+    output->set_data_type(data_type);
+    for (const int64_t dim : model->dims) {
+      input->add_dims(dim);
+      output->add_dims(dim);
+    }
+  }
+  config->mutable_model_transaction_policy()->set_decoupled(
+      model->kind == MockModelConfig::Kind::DECOUPLED);
+  return grpc::Status::OK;
+}
+
+grpc::Status
+MockGrpcService::ModelStatistics(
+    grpc::ServerContext* context,
+    const inference::ModelStatisticsRequest* request,
+    inference::ModelStatisticsResponse* response)
+{
+  std::vector<std::pair<const MockModelConfig*, MockModelStats>> stats;
+  tc::Error err =
+      core_->Statistics(request->name(), request->version(), &stats);
+  if (!err.IsOk()) {
+    return ToStatus(err);
+  }
+  for (const auto& model_stats : stats) {
+    const MockModelStats& s = model_stats.second;
+    inference::ModelStatistics* model = response->add_model_stats();
+    model->set_name(model_stats.first->name);
+    model->set_version(kModelVersion);
+    model->set_last_inference(s.last_inference_ms);
+    model->set_inference_count(s.inference_count);
+    model->set_execution_count(s.execution_count);
+    inference::InferStatistics* infer = model->mutable_inference_stats();
+    infer->mutable_success()->set_count(s.success_count);
+    infer->mutable_success()->set_ns(s.success_ns);
+    infer->mutable_fail()->set_count(s.fail_count);
+    infer->mutable_fail()->set_ns(s.fail_ns);
+    infer->mutable_queue()->set_count(s.success_count);
+    infer->mutable_compute_input()->set_count(s.compute_infer_count);
+    infer->mutable_compute_infer()->set_count(s.compute_infer_count);
+    infer->mutable_compute_infer()->set_ns(s.compute_infer_ns);
+    infer->mutable_compute_output()->set_count(s.compute_infer_count);
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status
+MockGrpcService::RepositoryIndex(
+    grpc::ServerContext* context,
+    const inference::RepositoryIndexRequest* request,
+    inference::RepositoryIndexResponse* response)
+{
+  for (const auto& model : core_->Models()) {
+    auto index = response->add_models();
+    index->set_name(model.name);
+    index->set_version(kModelVersion);
+    index->set_state("READY");
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status
+MockGrpcService::SystemSharedMemoryStatus(
+    grpc::ServerContext* context,
+    const inference::SystemSharedMemoryStatusRequest* request,
+    inference::SystemSharedMemoryStatusResponse* response)
+{
+  std::vector<std::shared_ptr<MockSharedMemoryRegion>> regions;
+  tc::Error err = core_->SystemSharedMemoryStatus(request->name(), &regions);
+  if (!err.IsOk()) {
+    return ToStatus(err);
+  }
+  for (const auto& region : regions) {
+    auto& status = (*response->mutable_regions())[region->name];
+    status.set_name(region->name);
+    status.set_key(region->key);
+    status.set_offset(region->offset);
+    status.set_byte_size(region->byte_size);
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status
+MockGrpcService::SystemSharedMemoryRegister(
+    grpc::ServerContext* context,
+    const inference::SystemSharedMemoryRegisterRequest* request,
+    inference::SystemSharedMemoryRegisterResponse* response)
+{
+  return ToStatus(core_->RegisterSystemSharedMemory(
+      request->name(), request->key(), request->offset(),
+      request->byte_size()));
+}
+
+grpc::Status
+MockGrpcService::SystemSharedMemoryUnregister(
+    grpc::ServerContext* context,
+    const inference::SystemSharedMemoryUnregisterRequest* request,
+    inference::SystemSharedMemoryUnregisterResponse* response)
+{
+  core_->UnregisterSystemSharedMemory(request->name());
+  return grpc::Status::OK;
+}
+
+grpc::Status
+MockGrpcService::ModelInfer(
+    grpc::ServerContext* context, const inference::ModelInferRequest* request,
+    inference::ModelInferResponse* response)
+{
+  const MockModelConfig* model;
+  tc::Error err = core_->FindModel(
+      request->model_name(), request->model_version(), &model);
+  if (err.IsOk() && (model->kind == MockModelConfig::Kind::DECOUPLED)) {
+    err = tc::Error(
+        "ModelInfer RPC doesn't support models with decoupled transaction "
+        "policy");
+  }
+  if (err.IsOk()) {
+    err = Infer(
+        *request, *model, 1,
+        [response](inference::ModelInferResponse* r, bool last) {
+          response->Swap(r);
+        });
+  }
+  return ToStatus(err);
+}
+
+grpc::Status
+MockGrpcService::ModelStreamInfer(
+    grpc::ServerContext* context,
+    grpc::ServerReaderWriter<
+        inference::ModelStreamInferResponse, inference::ModelInferRequest>*
+        stream)
+{
+  std::mutex write_mu;
+  std::mutex mu;
+  std::condition_variable cv;
+  size_t pending = 0;
+
+  auto request = std::make_shared<inference::ModelInferRequest>();
+  while (stream->Read(request.get())) {
+    {
+      std::lock_guard<std::mutex> lk(mu);
+      ++pending;
+    }
+    std::thread([this, request, stream, &write_mu, &mu, &cv, &pending]() {
+      const auto write = [stream, &write_mu](
+                             const inference::ModelStreamInferResponse& r) {
+        std::lock_guard<std::mutex> lk(write_mu);
+        stream->Write(r);
+      };
+
+      bool empty_final_response = false;
+      const auto itr =
+          request->parameters().find("triton_enable_empty_final_response");
+      if (itr != request->parameters().end()) {
+        empty_final_response = itr->second.bool_param();
+      }
+
+      const MockModelConfig* model = nullptr;
+      tc::Error err = core_->FindModel(
+          request->model_name(), request->model_version(), &model);
+      bool decoupled = false;
+      if (err.IsOk()) {
+        decoupled = (model->kind == MockModelConfig::Kind::DECOUPLED);
+        err = Infer(
+            *request, *model, decoupled ? model->response_count : 1,
+            [&write, decoupled, empty_final_response](
+                inference::ModelInferResponse* r, bool last) {
+              inference::ModelStreamInferResponse stream_response;
+              stream_response.mutable_infer_response()->Swap(r);
+              (*stream_response.mutable_infer_response()
+                    ->mutable_parameters())["triton_final_response"]
+                  .set_bool_param(
+                      last && !(decoupled && empty_final_response));
+              write(stream_response);
+            });
+      }
+
+      if (!err.IsOk()) {
+        inference::ModelStreamInferResponse stream_response;
+        stream_response.set_error_message(err.Message());
+        stream_response.mutable_infer_response()->set_model_name(
+            request->model_name());
+        stream_response.mutable_infer_response()->set_id(request->id());
+        write(stream_response);
+      } else if (
+          decoupled && (empty_final_response || (model->response_count == 0))) {
+        // Complete the request with a response without outputs.
+        inference::ModelStreamInferResponse stream_response;
+        auto response = stream_response.mutable_infer_response();
+        response->set_model_name(model->name);
+        response->set_model_version(kModelVersion);
+        response->set_id(request->id());
+        (*response->mutable_parameters())["triton_final_response"]
+            .set_bool_param(true);
+        write(stream_response);
+      }
+
+      // Notify while holding the lock, the handler returns and destroys
+      // 'cv' as soon as it sees that no requests are pending.
+      std::lock_guard<std::mutex> lk(mu);
+      --pending;
+      cv.notify_all();
+    }).detach();
+    request = std::make_shared<inference::ModelInferRequest>();
+  }
+
+  std::unique_lock<std::mutex> lk(mu);
+  cv.wait(lk, [&pending] { return pending == 0; });
+  return grpc::Status::OK;
+}
+
+tc::Error
+MockGrpcService::Infer(
+    const inference::ModelInferRequest& request, const MockModelConfig& model,
+    const size_t response_count,
+    const std::function<void(inference::ModelInferResponse*, bool)>& send)
+{
+  if (core_->Verbose()) {
+    std::cout << "GRPC infer " << request.model_name() << std::endl;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<MockTensor> inputs;
+  std::vector<std::shared_ptr<MockSharedMemoryRegion>> regions;
+  size_t batch_size = 0;
+  uint64_t compute_ns = 0;
+
+  tc::Error err;
+  int raw_index = 0;
+  for (const auto& tensor : request.inputs()) {
+    MockTensor input;
+    input.name = tensor.name();
+    input.datatype = tensor.datatype();
+    input.shape.assign(tensor.shape().begin(), tensor.shape().end());
+    const auto& params = tensor.parameters();
+    const auto region_itr = params.find("shared_memory_region");
+    if (region_itr != params.end()) {
+      std::shared_ptr<MockSharedMemoryRegion> region;
+      uint8_t* addr;
+      input.byte_size = UIntParameter(params, "shared_memory_byte_size");
+      err = core_->SharedMemory(
+          region_itr->second.string_param(),
+          UIntParameter(params, "shared_memory_offset"), input.byte_size,
+          &region, &addr);
+      if (!err.IsOk()) {
+        break;
+      }
+      regions.push_back(region);
+      input.data = addr;
+    } else if (raw_index < request.raw_input_contents_size()) {
+      const std::string& raw = request.raw_input_contents(raw_index++);
+      input.data = reinterpret_cast<const uint8_t*>(raw.data());
+      input.byte_size = raw.size();
+    } else {
+      err = tc::Error(
+          "the mock server only supports input data in "
+          "'raw_input_contents', got none for input '" +
+          input.name + "'");
+      break;
+    }
+    inputs.push_back(std::move(input));
+  }
+
+  std::vector<MockRequestedOutput> requested;
+  if (err.IsOk() && (request.outputs_size() > 0)) {
+    for (const auto& tensor : request.outputs()) {
+      MockRequestedOutput output;
+      output.name = tensor.name();
+      size_t index;
+      err = core_->OutputIndex(model, output.name, &index);
+      if (!err.IsOk()) {
+        break;
+      }
+      const auto& params = tensor.parameters();
+      const auto region_itr = params.find("shared_memory_region");
+      if (region_itr != params.end()) {
+        output.shm_region = region_itr->second.string_param();
+        output.shm_byte_size = UIntParameter(params, "shared_memory_byte_size");
+        output.shm_offset = UIntParameter(params, "shared_memory_offset");
+      }
+      requested.push_back(output);
+    }
+  } else if (err.IsOk()) {
+    for (size_t i = 0; i < model.input_count; ++i) {
+      MockRequestedOutput output;
+      output.name = "OUTPUT" + std::to_string(i);
+      requested.push_back(output);
+    }
+  }
+
+  if (err.IsOk()) {
+    err = core_->CheckInputs(model, &inputs, &batch_size);
+  }
+  for (size_t r = 0; err.IsOk() && (r < response_count); ++r) {
+    std::vector<MockTensor> outputs;
+    const auto compute_start = std::chrono::steady_clock::now();
+    core_->Execute(model, inputs, &outputs);
+    compute_ns += NsSince(compute_start);
+
+    inference::ModelInferResponse response;
+    response.set_model_name(model.name);
+    response.set_model_version(kModelVersion);
+    response.set_id(request.id());
+    for (const auto& output_request : requested) {
+      size_t index;
+      core_->OutputIndex(model, output_request.name, &index);
+      const MockTensor& output = outputs[index];
+      auto tensor = response.add_outputs();
+      tensor->set_name(output.name);
+      tensor->set_datatype(output.datatype);
+      for (const int64_t dim : output.shape) {
+        tensor->add_shape(dim);
+      }
+      // The client matches the raw contents to the outputs by position, so
+      // outputs returned in shared memory have empty contents.
+      std::string* raw = response.add_raw_output_contents();
+      if (!output_request.shm_region.empty()) {
+        err = core_->WriteSharedMemory(output_request, output);
+        if (!err.IsOk()) {
+          break;
+        }
+      } else if (output.byte_size > 0) {
+        raw->assign(
+            reinterpret_cast<const char*>(output.data), output.byte_size);
+      }
+    }
+    if (err.IsOk()) {
+      send(&response, r + 1 == response_count);
+    }
+  }
+
+  core_->Report(model, batch_size, err.IsOk(), NsSince(start), compute_ns);
+  return err;
+}
+
+// Records the TLS handshake of each GRPC connection with its first request.
+class MockTlsInterceptor : public grpc::experimental::Interceptor {
+ public:
+  MockTlsInterceptor(
+      grpc::experimental::ServerRpcInfo* info, MockTlsRecorder* recorder)
+      : info_(info), recorder_(recorder)
+  {
+  }
+
+  void Intercept(grpc::experimental::InterceptorBatchMethods* methods) override
+  {
+    if (methods->QueryInterceptionHookPoint(
+            grpc::experimental::InterceptionHookPoints::
+                POST_RECV_INITIAL_METADATA)) {
+      grpc::ServerContextBase* context = info_->server_context();
+      bool resumed = false;
+      for (const auto& value : context->auth_context()->FindPropertyValues(
+               GRPC_SSL_SESSION_REUSED_PROPERTY)) {
+        resumed = (value == "true");
+      }
+      recorder_->Record(resumed, context->peer());
+    }
+    methods->Proceed();
+  }
+
+ private:
+  grpc::experimental::ServerRpcInfo* info_;
+  MockTlsRecorder* recorder_;
+};
+
+class MockTlsInterceptorFactory
+    : public grpc::experimental::ServerInterceptorFactoryInterface {
+ public:
+  explicit MockTlsInterceptorFactory(MockTlsRecorder* recorder)
+      : recorder_(recorder)
+  {
+  }
+
+  grpc::experimental::Interceptor* CreateServerInterceptor(
+      grpc::experimental::ServerRpcInfo* info) override
+  {
+    return new MockTlsInterceptor(info, recorder_);
+  }
+
+ private:
+  MockTlsRecorder* recorder_;
+};
+
+//==============================================================================
+// Serves the GRPC protocol.
+//
+class MockGrpcFrontend {
+ public:
+  explicit MockGrpcFrontend(MockServerCore* core) : service_(core) {}
+  ~MockGrpcFrontend() { Stop(); }
+
+  // Start serving on 'address', over TLS if 'certificate_file' and
+  // 'private_key_file' are set.
+  tc::Error Start(
+      const std::string& address, const std::string& certificate_file,
+      const std::string& private_key_file)
+  {
+    grpc::ServerBuilder builder;
+    std::shared_ptr<grpc::ServerCredentials> credentials =
+        grpc::InsecureServerCredentials();
+    if (!certificate_file.empty() && !private_key_file.empty()) {
+      grpc::SslServerCredentialsOptions::PemKeyCertPair key_cert;
+      RETURN_IF_ERR(ReadFile(certificate_file, &key_cert.cert_chain));
+      RETURN_IF_ERR(ReadFile(private_key_file, &key_cert.private_key));
+      grpc::SslServerCredentialsOptions ssl_options;
+      ssl_options.pem_key_cert_pairs.push_back(key_cert);
+      credentials = grpc::SslServerCredentials(ssl_options);
+
+      std::vector<std::unique_ptr<
+          grpc::experimental::ServerInterceptorFactoryInterface>>
+          interceptor_creators;
+      interceptor_creators.emplace_back(
+          new MockTlsInterceptorFactory(&tls_recorder_));
+      builder.experimental().SetInterceptorCreators(
+          std::move(interceptor_creators));
+    }
+    builder.AddListeningPort(address, credentials, &port_);
+    builder.SetMaxReceiveMessageSize(INT32_MAX);
+    builder.SetMaxSendMessageSize(INT32_MAX);
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    if (server_ == nullptr) {
+      return tc::Error("unable to listen for GRPC on '" + address + "'");
+    }
+    if (address.compare(0, 5, "unix:") == 0) {
+      port_ = 0;
+    }
+    return tc::Error::Success;
+  }
+
+  void Stop()
+  {
+    if (server_ != nullptr) {
+      // Cancel the streams the clients haven't closed.
+      server_->Shutdown(
+          std::chrono::system_clock::now() + std::chrono::seconds(1));
+      server_->Wait();
+      server_.reset();
+    }
+  }
+
+  int Port() const { return port_; }
+  MockTlsStat TlsStat() const { return tls_recorder_.Stat(); }
+
+ private:
+  MockGrpcService service_;
+  MockTlsRecorder tls_recorder_;
+  std::unique_ptr<grpc::Server> server_;
+  int port_{0};
+};
+
+//==============================================================================
+
+tc::Error
+MockServer::Create(
+    std::unique_ptr<MockServer>* server, const MockServerOptions& options)
+{
+  std::unique_ptr<MockServer> lserver(new MockServer());
+  RETURN_IF_ERR(MockServerCore::Create(
+      options.models.empty() ? DefaultModels() : options.models,
+      options.verbose, &lserver->core_));
+  if (!options.http_address.empty()) {
+    lserver->http_.reset(new MockHttpFrontend(lserver->core_.get()));
+    RETURN_IF_ERR(lserver->http_->Start(
+        options.http_address, options.ssl_certificate_file,
+        options.ssl_private_key_file));
+  }
+  if (!options.grpc_address.empty()) {
+    lserver->grpc_.reset(new MockGrpcFrontend(lserver->core_.get()));
+    RETURN_IF_ERR(lserver->grpc_->Start(
+        options.grpc_address, options.ssl_certificate_file,
+        options.ssl_private_key_file));
+  }
+
+  *server = std::move(lserver);
+  return tc::Error::Success;
+}
+
+tc::Error
+MockServer::ReadModelConfigs(
+    const std::string& path, std::vector<MockModelConfig>* models)
+{
+  std::ifstream file(path);
+  if (!file) {
+    return tc::Error("unable to open mock model configurations '" + path + "'");
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  const std::string json = contents.str();
+
+  TritonJson::Value config_json;
+  RETURN_IF_ERR(config_json.Parse(json.data(), json.size()));
+  TritonJson::Value models_json;
+  if (!config_json.Find("models", &models_json)) {
+    return tc::Error("expected 'models' in '" + path + "'");
+  }
+
+  models->clear();
+  for (size_t i = 0; i < models_json.ArraySize(); ++i) {
+    TritonJson::Value model_json;
+    RETURN_IF_ERR(models_json.IndexAsObject(i, &model_json));
+    MockModelConfig model;
+    RETURN_IF_ERR(model_json.MemberAsString("name", &model.name));
+
+    TritonJson::Value value_json;
+    if (model_json.Find("kind", &value_json)) {
+      std::string kind;
+      RETURN_IF_ERR(model_json.MemberAsString("kind", &kind));
+      if (kind == "identity") {
+        model.kind = MockModelConfig::Kind::IDENTITY;
+      } else if (kind == "add_sub") {
+        model.kind = MockModelConfig::Kind::ADD_SUB;
+      } else if (kind == "decoupled") {
+        model.kind = MockModelConfig::Kind::DECOUPLED;
+      } else {
+        return tc::Error(
+            "unknown kind '" + kind + "' for mock model '" + model.name +
+            "', expected identity, add_sub or decoupled");
+      }
+    }
+    if (model_json.Find("datatype", &value_json)) {
+      RETURN_IF_ERR(model_json.MemberAsString("datatype", &model.datatype));
+    }
+    if (model_json.Find("dims", &value_json)) {
+      model.dims.clear();
+      for (size_t d = 0; d < value_json.ArraySize(); ++d) {
+        int64_t dim;
+        RETURN_IF_ERR(value_json.IndexAsInt(d, &dim));
+        model.dims.push_back(dim);
+      }
+    }
+    if (model_json.Find("max_batch_size", &value_json)) {
+      int64_t max_batch_size;
+      RETURN_IF_ERR(model_json.MemberAsInt("max_batch_size", &max_batch_size));
+      model.max_batch_size = max_batch_size;
+    }
+    uint64_t count;
+    if (model_json.Find("input_count", &value_json)) {
+      RETURN_IF_ERR(model_json.MemberAsUInt("input_count", &count));
+      model.input_count = count;
+    }
+    if (model_json.Find("response_count", &value_json)) {
+      RETURN_IF_ERR(model_json.MemberAsUInt("response_count", &count));
+      model.response_count = count;
+    }
+
+    TritonJson::Value latency_json;
+    if (model_json.Find("latency", &latency_json)) {
+      MockLatency& latency = model.latency;
+      if (latency_json.Find("distribution", &value_json)) {
+        std::string distribution;
+        RETURN_IF_ERR(
+            latency_json.MemberAsString("distribution", &distribution));
+        if (distribution == "constant") {
+          latency.distribution = MockLatency::Distribution::CONSTANT;
+        } else if (distribution == "uniform") {
+          latency.distribution = MockLatency::Distribution::UNIFORM;
+        } else if (distribution == "normal") {
+          latency.distribution = MockLatency::Distribution::NORMAL;
+        } else if (distribution == "exponential") {
+          latency.distribution = MockLatency::Distribution::EXPONENTIAL;
+        } else {
+          return tc::Error(
+              "unknown latency distribution '" + distribution +
+              "' for mock model '" + model.name +
+              "', expected constant, uniform, normal or exponential");
+        }
+      }
+      const std::pair<const char*, uint64_t*> fields[] = {
+          {"mean_us", &latency.mean_us},
+          {"stddev_us", &latency.stddev_us},
+          {"min_us", &latency.min_us},
+          {"max_us", &latency.max_us}};
+      for (const auto& field : fields) {
+        if (latency_json.Find(field.first, &value_json)) {
+          RETURN_IF_ERR(latency_json.MemberAsUInt(field.first, field.second));
+        }
+      }
+    }
+    models->push_back(model);
+  }
+  return tc::Error::Success;
+}
+
+std::vector<MockModelConfig>
+MockServer::DefaultModels()
+{
+  std::vector<MockModelConfig> models(3);
+  models[0].name = "simple";
+  models[0].kind = MockModelConfig::Kind::ADD_SUB;
+  models[0].datatype = "INT32";
+  models[0].dims = {16};
+  models[0].max_batch_size = 8;
+
+  models[1].name = "identity";
+  models[1].kind = MockModelConfig::Kind::IDENTITY;
+  models[1].datatype = "FP32";
+  models[1].dims = {-1};
+  models[1].max_batch_size = 8;
+
+  models[2].name = "repeat";
+  models[2].kind = MockModelConfig::Kind::DECOUPLED;
+  models[2].datatype = "INT32";
+  models[2].dims = {1};
+  models[2].response_count = 4;
+  return models;
+}
+
+MockServer::MockServer() = default;
+
+MockServer::~MockServer()
+{
+  Stop();
+}
+
+void
+MockServer::Stop()
+{
+  if (http_ != nullptr) {
+    http_->Stop();
+  }
+  if (grpc_ != nullptr) {
+    grpc_->Stop();
+  }
+}
+
+int
+MockServer::HttpPort() const
+{
+  return (http_ == nullptr) ? 0 : http_->Port();
+}
+
+int
+MockServer::GrpcPort() const
+{
+  return (grpc_ == nullptr) ? 0 : grpc_->Port();
+}
+
+MockTlsStat
+MockServer::HttpTlsStat() const
+{
+  return (http_ == nullptr) ? MockTlsStat() : http_->TlsStat();
+}
+
+MockTlsStat
+MockServer::GrpcTlsStat() const
+{
+  return (grpc_ == nullptr) ? MockTlsStat() : grpc_->TlsStat();
+}
+
+}}  // namespace triton::mockserver
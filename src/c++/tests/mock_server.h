@@ -0,0 +1,197 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+/// \file
+/// A lightweight stand-in for Triton that serves the KServe v2 HTTP/REST
+/// and GRPC protocols from simple models that run on the CPU, so that the
+/// client libraries and perf_analyzer can be tested and benchmarked on a
+/// machine without a GPU or a real server. It can be started in-process
+/// with MockServer::Create() or as the standalone 'mock_server' program.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common.h"
+
+namespace triton { namespace mockserver {
+
+namespace tc = triton::client;
+
+//==============================================================================
+/// The distribution of the time a mock model takes to compute a response.
+///
+struct MockLatency {
+  enum class Distribution {
+    /// Always 'mean_us'.
+    CONSTANT,
+    /// Uniform in ['min_us', 'max_us'].
+    UNIFORM,
+    /// Normal with 'mean_us' and 'stddev_us', clamped to
+    /// ['min_us', 'max_us'] when 'max_us' is not 0.
+    NORMAL,
+    /// Exponential with 'mean_us', clamped to 'max_us' when not 0.
+    EXPONENTIAL
+  };
+
+  Distribution distribution{Distribution::CONSTANT};
+  uint64_t mean_us{0};
+  uint64_t stddev_us{0};
+  uint64_t min_us{0};
+  uint64_t max_us{0};
+};
+
+//==============================================================================
+/// The configuration of a model served by the mock server.
+///
+struct MockModelConfig {
+  enum class Kind {
+    /// Returns each input INPUT<i> unchanged as output OUTPUT<i>.
+    IDENTITY,
+    /// Returns OUTPUT0 = INPUT0 + INPUT1 and OUTPUT1 = INPUT0 - INPUT1, the
+    /// same as the 'simple' models used by the examples and the tests.
+    /// Supports INT32, INT64, FP32 and FP64.
+    ADD_SUB,
+    /// A decoupled model that only accepts streaming GRPC requests, and
+    /// returns 'response_count' responses echoing the inputs as IDENTITY
+    /// does for each request.
+    DECOUPLED
+  };
+
+  std::string name;
+  Kind kind{Kind::IDENTITY};
+  /// The datatype of the inputs and outputs.
+  std::string datatype{"INT32"};
+  /// The shape of the inputs and outputs, without the batch dimension. A
+  /// dimension of -1 accepts any size.
+  std::vector<int64_t> dims{16};
+  /// The number of inputs, and of outputs. ADD_SUB always has 2.
+  size_t input_count{1};
+  /// The maximum batch size, 0 if the model doesn't support batching.
+  int max_batch_size{0};
+  /// The time taken to compute each response.
+  MockLatency latency;
+  /// The number of responses returned for each request by DECOUPLED.
+  size_t response_count{1};
+};
+
+//==============================================================================
+/// The options of the mock server.
+///
+struct MockServerOptions {
+  /// The address to serve HTTP/REST on, "<host>:<port>" or
+  /// "unix:<path>". A port of 0 selects any available port. An empty
+  /// address disables HTTP/REST.
+  std::string http_address{"0.0.0.0:8000"};
+  /// The address to serve GRPC on, in the same form as 'http_address'.
+  std::string grpc_address{"0.0.0.0:8001"};
+  /// The models to serve.
+  std::vector<MockModelConfig> models;
+  /// The PEM files of the certificate and of the private key of the
+  /// server. When both are set, HTTP/REST and GRPC are served over TLS.
+  std::string ssl_certificate_file;
+  std::string ssl_private_key_file;
+  /// Whether to log the requests.
+  bool verbose{false};
+};
+
+//==============================================================================
+/// The TLS handshakes of the connections accepted by the mock server.
+///
+struct MockTlsStat {
+  /// The number of TLS handshakes, one per connection.
+  size_t handshake_count{0};
+  /// The number of handshakes that resumed the session of an earlier
+  /// connection instead of performing a full handshake.
+  size_t resumed_handshake_count{0};
+};
+
+class MockServerCore;
+class MockHttpFrontend;
+class MockGrpcFrontend;
+
+//==============================================================================
+/// A mock server serving the models in the options until it is stopped or
+/// destroyed. It supports the health, metadata, configuration, statistics,
+/// inference and system shared memory APIs of the KServe v2 protocols.
+/// Tensors must be sent as binary data or JSON data for HTTP/REST, and as
+/// raw contents for GRPC. CUDA shared memory is not supported.
+///
+class MockServer {
+ public:
+  /// Create a mock server and start serving.
+  /// \param server Returns the new mock server.
+  /// \param options The options of the server.
+  /// \return Error object indicating success or failure.
+  static tc::Error Create(
+      std::unique_ptr<MockServer>* server, const MockServerOptions& options);
+
+  /// Read model configurations from a JSON file of the form
+  /// {"models": [{"name": "simple", "kind": "add_sub", "datatype": "INT32",
+  /// "dims": [16], "max_batch_size": 8, "latency": {"distribution":
+  /// "normal", "mean_us": 500, "stddev_us": 100}}, ...]}. The members other
+  /// than "name" are optional and default to the values of
+  /// MockModelConfig.
+  /// \param path The path of the file.
+  /// \param models Returns the model configurations.
+  /// \return Error object indicating success or failure.
+  static tc::Error ReadModelConfigs(
+      const std::string& path, std::vector<MockModelConfig>* models);
+
+  /// The models served when none are given: 'simple' (ADD_SUB, INT32
+  /// [16], max batch size 8), 'identity' (IDENTITY, FP32 [-1], max batch
+  /// size 8) and 'repeat' (DECOUPLED, INT32 [1], 4 responses).
+  static std::vector<MockModelConfig> DefaultModels();
+
+  ~MockServer();
+
+  /// Stop serving. Called by the destructor.
+  void Stop();
+
+  /// \return The HTTP/REST port, or 0 if not served on a TCP port.
+  int HttpPort() const;
+
+  /// \return The GRPC port, or 0 if not served on a TCP port.
+  int GrpcPort() const;
+
+  /// \return The TLS handshakes of the HTTP/REST connections.
+  MockTlsStat HttpTlsStat() const;
+
+  /// \return The TLS handshakes of the GRPC connections. A connection is
+  /// only seen once a request is received on it.
+  MockTlsStat GrpcTlsStat() const;
+
+ private:
+  MockServer();
+
+  std::unique_ptr<MockServerCore> core_;
+  std::unique_ptr<MockHttpFrontend> http_;
+  std::unique_ptr<MockGrpcFrontend> grpc_;
+};
+
+}}  // namespace triton::mockserver
@@ -0,0 +1,177 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Serves the KServe v2 protocols from mock models until interrupted, see
+// mock_server.h.
+
+#include <getopt.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <string>
+
+#include "mock_server.h"
+
+namespace ms = triton::mockserver;
+namespace tc = triton::client;
+
+#define FAIL_IF_ERR(X, MSG)                                        \
+  {                                                                \
+    tc::Error err = (X);                                           \
+    if (!err.IsOk()) {                                             \
+      std::cerr << "error: " << (MSG) << ": " << err << std::endl; \
+      exit(1);                                                     \
+    }                                                              \
+  }
+
+namespace {
+
+void
+Usage(char** argv, const std::string& msg = std::string())
+{
+  if (!msg.empty()) {
+    std::cerr << "error: " << msg << std::endl;
+  }
+
+  std::cerr << "Usage: " << argv[0] << " [options]" << std::endl;
+  std::cerr << "\t-v" << std::endl;
+  std::cerr << "\t--http-address <host:port or unix:path, empty to disable>"
+            << " default is 0.0.0.0:8000." << std::endl;
+  std::cerr << "\t--grpc-address <host:port or unix:path, empty to disable>"
+            << " default is 0.0.0.0:8001." << std::endl;
+  std::cerr << "\t--models <JSON file of the models to serve>" << std::endl;
+  std::cerr << "\t--ssl-certificate <PEM file of the server certificate>"
+            << std::endl;
+  std::cerr << "\t--ssl-private-key <PEM file of the server private key>"
+            << std::endl;
+  std::cerr << std::endl;
+  std::cerr
+      << "Without --models, serves 'simple' (INT32 add/sub, dims [16], max "
+         "batch size 8), 'identity' (FP32 echo, dims [-1], max batch size 8) "
+         "and 'repeat' (decoupled INT32 echo, dims [1], 4 responses)."
+      << std::endl;
+  std::cerr << "With --ssl-certificate and --ssl-private-key, HTTP/REST and "
+               "GRPC are served over TLS."
+            << std::endl;
+
+  exit(1);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  ms::MockServerOptions options;
+  std::string models_path;
+
+  static struct option long_options[] = {
+      {"http-address", required_argument, 0, 0},
+      {"grpc-address", required_argument, 0, 1},
+      {"models", required_argument, 0, 2},
+      {"ssl-certificate", required_argument, 0, 3},
+      {"ssl-private-key", required_argument, 0, 4},
+      {0, 0, 0, 0}};
+
+  // Parse commandline...
+  int opt;
+  while ((opt = getopt_long(argc, argv, "v", long_options, NULL)) != -1) {
+    switch (opt) {
+      case 0:
+        options.http_address = optarg;
+        break;
+      case 1:
+        options.grpc_address = optarg;
+        break;
+      case 2:
+        models_path = optarg;
+        break;
+      case 3:
+        options.ssl_certificate_file = optarg;
+        break;
+      case 4:
+        options.ssl_private_key_file = optarg;
+        break;
+      case 'v':
+        options.verbose = true;
+        break;
+      case '?':
+        Usage(argv);
+        break;
+    }
+  }
+  if (optind < argc) {
+    Usage(argv, "unexpected argument '" + std::string(argv[optind]) + "'");
+  }
+  if (options.http_address.empty() && options.grpc_address.empty()) {
+    Usage(argv, "at least one of HTTP/REST and GRPC must be served");
+  }
+  if (options.ssl_certificate_file.empty() !=
+      options.ssl_private_key_file.empty()) {
+    Usage(
+        argv, "--ssl-certificate and --ssl-private-key must be used together");
+  }
+  if (!models_path.empty()) {
+    FAIL_IF_ERR(
+        ms::MockServer::ReadModelConfigs(models_path, &options.models),
+        "unable to read the mock models");
+  }
+
+  // Block the termination signals before the server threads are started,
+  // so that they are only received by sigwait() below.
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  std::unique_ptr<ms::MockServer> server;
+  FAIL_IF_ERR(
+      ms::MockServer::Create(&server, options),
+      "unable to start the mock server");
+  if (!options.http_address.empty()) {
+    std::cout << "Serving HTTP/REST on " << options.http_address;
+    if (server->HttpPort() != 0) {
+      std::cout << " (port " << server->HttpPort() << ")";
+    }
+    std::cout << std::endl;
+  }
+  if (!options.grpc_address.empty()) {
+    std::cout << "Serving GRPC on " << options.grpc_address;
+    if (server->GrpcPort() != 0) {
+      std::cout << " (port " << server->GrpcPort() << ")";
+    }
+    std::cout << std::endl;
+  }
+
+  int signal;
+  sigwait(&signals, &signal);
+  std::cout << "Stopping" << std::endl;
+  server->Stop();
+
+  return 0;
+}
@@ -0,0 +1,505 @@
+// Copyright 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Compares the latency of small inference requests sent over loopback
+// TCP and over a Unix domain socket. The requests are served by stand-in
+// HTTP and GRPC servers started in this process that return a fixed
+// response, so the measurement covers the client and the transport only.
+
+#include <arpa/inet.h>
+#include <grpcpp/grpcpp.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "grpc_client.h"
+#include "grpc_service.grpc.pb.h"
+#include "http_client.h"
+
+namespace tc = triton::client;
+
+#define FAIL_IF_ERR(X, MSG)                                        \
+  {                                                                \
+    tc::Error err = (X);                                           \
+    if (!err.IsOk()) {                                             \
+      std::cerr << "error: " << (MSG) << ": " << err << std::endl; \
+      exit(1);                                                     \
+    }                                                              \
+  }
+
+#define INPUT_DIM 16
+
+namespace {
+
+const std::string kModelName = "identity";
+
+// Minimal HTTP/1.1 server that answers every request on a connection with
+// the same inference response. Each accepted connection is served by its
+// own thread until the client closes it.
+class StandInHttpServer {
+ public:
+  ~StandInHttpServer() { Stop(); }
+
+  // Listen on an ephemeral loopback TCP port, returns the server URL.
+  std::string ListenTcp()
+  {
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    Listen(reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+    socklen_t len = sizeof(addr);
+    getsockname(listen_fd_, reinterpret_cast<struct sockaddr*>(&addr), &len);
+    return "127.0.0.1:" + std::to_string(ntohs(addr.sin_port));
+  }
+
+  // Listen on the Unix domain socket at 'path', returns the server URL.
+  std::string ListenUnix(const std::string& path)
+  {
+    unlink(path.c_str());
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    Listen(reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+    unix_path_ = path;
+    return "unix:" + path;
+  }
+
+  void Stop()
+  {
+    if (listen_fd_ < 0) {
+      return;
+    }
+    shutdown(listen_fd_, SHUT_RDWR);
+    close(listen_fd_);
+    listen_fd_ = -1;
+    if (acceptor_.joinable()) {
+      acceptor_.join();
+    }
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      for (int fd : connection_fds_) {
+        shutdown(fd, SHUT_RDWR);
+      }
+    }
+    for (auto& connection : connections_) {
+      connection.join();
+    }
+    connections_.clear();
+    for (int fd : connection_fds_) {
+      close(fd);
+    }
+    connection_fds_.clear();
+    if (!unix_path_.empty()) {
+      unlink(unix_path_.c_str());
+    }
+  }
+
+ private:
+  void Listen(const struct sockaddr* addr, socklen_t len)
+  {
+    if ((listen_fd_ < 0) || (bind(listen_fd_, addr, len) != 0) ||
+        (listen(listen_fd_, 16) != 0)) {
+      std::cerr << "error: unable to start stand-in HTTP server: "
+                << strerror(errno) << std::endl;
+      exit(1);
+    }
+    acceptor_ = std::thread(&StandInHttpServer::Accept, this, listen_fd_);
+  }
+
+  void Accept(int listen_fd)
+  {
+    while (true) {
+      int fd = accept(listen_fd, nullptr, nullptr);
+      if (fd < 0) {
+        return;
+      }
+      std::lock_guard<std::mutex> lk(mu_);
+      connection_fds_.push_back(fd);
+      connections_.emplace_back(&StandInHttpServer::Serve, fd);
+    }
+  }
+
+  static void Serve(int fd)
+  {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    static const std::string body =
+        "{\"model_name\":\"" + kModelName +
+        "\",\"model_version\":\"1\",\"outputs\":[{\"name\":\"OUTPUT0\","
+        "\"datatype\":\"INT32\",\"shape\":[1,16],\"data\":[0,1,2,3,4,5,6,7,"
+        "8,9,10,11,12,13,14,15]}]}";
+    static const std::string response =
+        "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+        "Content-Length: " +
+        std::to_string(body.size()) + "\r\n\r\n" + body;
+
+    std::string buffer;
+    char chunk[4096];
+    while (true) {
+      // Read the request header, then the body announced by its
+      // Content-Length.
+      size_t header_end;
+      while ((header_end = buffer.find("\r\n\r\n")) == std::string::npos) {
+        ssize_t n = read(fd, chunk, sizeof(chunk));
+        if (n <= 0) {
+          return;
+        }
+        buffer.append(chunk, n);
+      }
+      // Only match the header at the start of a line, binary requests
+      // also carry an 'Inference-Header-Content-Length' header.
+      size_t content_length = 0;
+      std::string header = "\r\n" + buffer.substr(0, header_end);
+      std::transform(header.begin(), header.end(), header.begin(), ::tolower);
+      size_t pos = header.find("\r\ncontent-length:");
+      if (pos != std::string::npos) {
+        content_length = std::stoul(header.substr(pos + 17));
+      }
+      const size_t request_size = header_end + 4 + content_length;
+      while (buffer.size() < request_size) {
+        ssize_t n = read(fd, chunk, sizeof(chunk));
+        if (n <= 0) {
+          return;
+        }
+        buffer.append(chunk, n);
+      }
+      buffer.erase(0, request_size);
+
+      size_t written = 0;
+      while (written < response.size()) {
+        ssize_t n =
+            write(fd, response.data() + written, response.size() - written);
+        if (n <= 0) {
+          return;
+        }
+        written += n;
+      }
+    }
+  }
+
+  int listen_fd_{-1};
+  std::string unix_path_;
+  std::thread acceptor_;
+  std::mutex mu_;
+  std::vector<int> connection_fds_;
+  std::vector<std::thread> connections_;
+};
+
+// GRPC service that answers every ModelInfer call with the same response.
+class StandInGrpcService final
+    : public inference::GRPCInferenceService::Service {
+ public:
+  StandInGrpcService()
+  {
+    response_.set_model_name(kModelName);
+    response_.set_model_version("1");
+    auto output = response_.add_outputs();
+    output->set_name("OUTPUT0");
+    output->set_datatype("INT32");
+    output->add_shape(1);
+    output->add_shape(INPUT_DIM);
+    std::vector<int32_t> data(INPUT_DIM);
+    for (size_t i = 0; i < INPUT_DIM; ++i) {
+      data[i] = i;
+    }
+    response_.add_raw_output_contents(
+        reinterpret_cast<const char*>(data.data()),
+        data.size() * sizeof(int32_t));
+  }
+
+  grpc::Status ModelInfer(
+      grpc::ServerContext* context,
+      const inference::ModelInferRequest* request,
+      inference::ModelInferResponse* response) override
+  {
+    *response = response_;
+    return grpc::Status::OK;
+  }
+
+ private:
+  inference::ModelInferResponse response_;
+};
+
+struct LatencySummary {
+  uint64_t p50_us;
+  uint64_t p90_us;
+  uint64_t p99_us;
+  uint64_t avg_us;
+};
+
+LatencySummary
+Summarize(std::vector<uint64_t>& latencies_ns)
+{
+  std::sort(latencies_ns.begin(), latencies_ns.end());
+  auto percentile = [&latencies_ns](size_t p) {
+    return latencies_ns[(latencies_ns.size() - 1) * p / 100] / 1000;
+  };
+  uint64_t total = 0;
+  for (const auto latency : latencies_ns) {
+    total += latency;
+  }
+  return LatencySummary{
+      percentile(50), percentile(90), percentile(99),
+      total / latencies_ns.size() / 1000};
+}
+
+template <typename Client>
+LatencySummary
+Measure(
+    Client* client, const uint32_t warmup_count, const uint32_t request_count)
+{
+  std::vector<int32_t> input_data(INPUT_DIM);
+  for (size_t i = 0; i < INPUT_DIM; ++i) {
+    input_data[i] = i;
+  }
+  tc::InferInput* input;
+  FAIL_IF_ERR(
+      tc::InferInput::Create(&input, "INPUT0", {1, INPUT_DIM}, "INT32"),
+      "unable to create 'INPUT0'");
+  std::shared_ptr<tc::InferInput> input_ptr(input);
+  FAIL_IF_ERR(
+      input_ptr->AppendRaw(
+          reinterpret_cast<uint8_t*>(input_data.data()),
+          input_data.size() * sizeof(int32_t)),
+      "unable to set data for 'INPUT0'");
+
+  tc::InferOptions options(kModelName);
+  std::vector<tc::InferInput*> inputs = {input_ptr.get()};
+
+  std::vector<uint64_t> latencies_ns;
+  latencies_ns.reserve(request_count);
+  for (uint32_t i = 0; i < warmup_count + request_count; ++i) {
+    tc::InferResult* result;
+    auto start = std::chrono::steady_clock::now();
+    FAIL_IF_ERR(client->Infer(&result, options, inputs), "unable to run model");
+    auto end = std::chrono::steady_clock::now();
+    FAIL_IF_ERR(result->RequestStatus(), "inference failed");
+    delete result;
+    if (i >= warmup_count) {
+      latencies_ns.push_back(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+              .count());
+    }
+  }
+  return Summarize(latencies_ns);
+}
+
+void
+Report(
+    const std::string& protocol, const LatencySummary& tcp,
+    const LatencySummary& uds)
+{
+  std::cout << protocol << " latency (usec)" << std::endl;
+  std::cout << "  " << std::setw(10) << std::left << "transport"
+            << std::setw(8) << "p50" << std::setw(8) << "p90" << std::setw(8)
+            << "p99" << std::setw(8) << "avg" << std::endl;
+  for (const auto& row : {std::make_pair("tcp", tcp),
+                          std::make_pair("uds", uds)}) {
+    std::cout << "  " << std::setw(10) << std::left << row.first
+              << std::setw(8) << row.second.p50_us << std::setw(8)
+              << row.second.p90_us << std::setw(8) << row.second.p99_us
+              << std::setw(8) << row.second.avg_us << std::endl;
+  }
+  if (tcp.p50_us != 0) {
+    std::cout << "  uds p50 change: " << std::fixed << std::setprecision(1)
+              << (100.0 * ((double)uds.p50_us - (double)tcp.p50_us) /
+                  (double)tcp.p50_us)
+              << "%" << std::endl;
+  }
+}
+
+void
+RunHttp(
+    const std::string& socket_path, const uint32_t warmup_count,
+    const uint32_t request_count, const bool verbose)
+{
+  StandInHttpServer tcp_server;
+  StandInHttpServer uds_server;
+  const std::string tcp_url = tcp_server.ListenTcp();
+  const std::string uds_url = uds_server.ListenUnix(socket_path);
+
+  LatencySummary tcp, uds;
+  {
+    std::unique_ptr<tc::InferenceServerHttpClient> client;
+    FAIL_IF_ERR(
+        tc::InferenceServerHttpClient::Create(&client, tcp_url, verbose),
+        "unable to create http client");
+    tcp = Measure(client.get(), warmup_count, request_count);
+  }
+  {
+    std::unique_ptr<tc::InferenceServerHttpClient> client;
+    FAIL_IF_ERR(
+        tc::InferenceServerHttpClient::Create(&client, uds_url, verbose),
+        "unable to create http client");
+    uds = Measure(client.get(), warmup_count, request_count);
+  }
+  Report("HTTP", tcp, uds);
+}
+
+void
+RunGrpc(
+    const std::string& socket_path, const uint32_t warmup_count,
+    const uint32_t request_count, const bool verbose)
+{
+  unlink(socket_path.c_str());
+  StandInGrpcService service;
+  int tcp_port = 0;
+  grpc::ServerBuilder builder;
+  builder.AddListeningPort(
+      "127.0.0.1:0", grpc::InsecureServerCredentials(), &tcp_port);
+  builder.AddListeningPort(
+      "unix:" + socket_path, grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  std::unique_ptr<grpc::Server> server = builder.BuildAndStart();
+  if ((server == nullptr) || (tcp_port == 0)) {
+    std::cerr << "error: unable to start stand-in GRPC server" << std::endl;
+    exit(1);
+  }
+
+  LatencySummary tcp, uds;
+  {
+    std::unique_ptr<tc::InferenceServerGrpcClient> client;
+    FAIL_IF_ERR(
+        tc::InferenceServerGrpcClient::Create(
+            &client, "127.0.0.1:" + std::to_string(tcp_port), verbose),
+        "unable to create grpc client");
+    tcp = Measure(client.get(), warmup_count, request_count);
+  }
+  {
+    std::unique_ptr<tc::InferenceServerGrpcClient> client;
+    FAIL_IF_ERR(
+        tc::InferenceServerGrpcClient::Create(
+            &client, "unix:" + socket_path, verbose),
+        "unable to create grpc client");
+    uds = Measure(client.get(), warmup_count, request_count);
+  }
+  Report("GRPC", tcp, uds);
+
+  server->Shutdown();
+  unlink(socket_path.c_str());
+}
+
+void
+Usage(char** argv, const std::string& msg = std::string())
+{
+  if (!msg.empty()) {
+    std::cerr << "error: " << msg << std::endl;
+  }
+
+  std::cerr << "Usage: " << argv[0] << " [options]" << std::endl;
+  std::cerr << "\t-v" << std::endl;
+  std::cerr << "\t-i <http/grpc> default is to benchmark both." << std::endl;
+  std::cerr << "\t-s <path of the Unix domain socket> default is "
+               "/tmp/transport_latency_benchmark.sock."
+            << std::endl;
+  std::cerr << "\t-r <number of measured requests> default is 10000."
+            << std::endl;
+  std::cerr << "\t-w <number of warmup requests> default is 1000."
+            << std::endl;
+  std::cerr << std::endl;
+
+  exit(1);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  bool verbose = false;
+  std::string protocol = "all";
+  std::string socket_path = "/tmp/transport_latency_benchmark.sock";
+  uint32_t request_count = 10000;
+  uint32_t warmup_count = 1000;
+
+  // Parse commandline...
+  int opt;
+  while ((opt = getopt(argc, argv, "vi:s:r:w:")) != -1) {
+    switch (opt) {
+      case 'v':
+        verbose = true;
+        break;
+      case 'i': {
+        std::string p(optarg);
+        std::transform(p.begin(), p.end(), p.begin(), ::tolower);
+        if (p == "grpc" || p == "http") {
+          protocol = p;
+        } else {
+          protocol = "unknown";
+        }
+        break;
+      }
+      case 's':
+        socket_path = optarg;
+        break;
+      case 'r':
+        request_count = std::stoi(optarg);
+        break;
+      case 'w':
+        warmup_count = std::stoi(optarg);
+        break;
+      case '?':
+        Usage(argv);
+        break;
+    }
+  }
+
+  // Option validations
+  if (protocol == "unknown") {
+    Usage(argv, "supports only http and grpc protocols");
+  }
+  if (request_count == 0) {
+    Usage(argv, "number of measured requests must be > 0");
+  }
+
+  if (protocol != "grpc") {
+    RunHttp(socket_path, warmup_count, request_count, verbose);
+  }
+  if (protocol != "http") {
+    RunGrpc(socket_path, warmup_count, request_count, verbose);
+  }
+
+  return 0;
+}